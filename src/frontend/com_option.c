@@ -49,6 +49,7 @@ com_option(wordlist *wl)
         printf("xmu = %g\n", circuit->CKTxmu);
         printf("indverbosity = %d\n", circuit->CKTindverbosity);
         printf("epsmin = %g\n", circuit->CKTepsmin);
+        printf("sparsecsc = %s\n", circuit->CKTsparseCsc ? "yes" : "no");
 
         printf("\nTolerances (absolute):\n");
         printf("abstol      (current) = %g\n", circuit->CKTabstol);
@@ -93,5 +93,7 @@ dvec_free(struct dvec *v)
         tfree(v->v_realdata);
     if (v->v_compdata)
         tfree(v->v_compdata);
+    if (v->v_rawmap)
+        raw_unmap(v->v_rawmap);
     tfree(v);
 }
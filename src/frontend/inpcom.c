@@ -35,6 +35,8 @@ Author: 1985 Wayne A. Christopher
 #include "ngspice/stringutil.h"
 #include "ngspice/stringskip.h"
 #include "ngspice/wordlist.h"
+#include "ngspice/hash.h"
+#include "../misc/misc_time.h"
 
 #ifdef XSPICE
 /* gtri - add - 12/12/90 - wbk - include new stuff */
@@ -57,13 +59,40 @@ static struct library {
     char *realpath;
     char *habitat;
     struct line *deck;
+    NGHASHPTR sections;         /* section name -> `.lib <section-name>' card */
 } libraries[N_LIBRARIES];
 
 static int  num_libraries;
+static NGHASHPTR lib_table;     /* lower case realpath -> library */
+
+/* With "libcache" set, library files are read once per session and kept
+ * in the form inp_read() returns them, before any section expansion.  An
+ * entry stays valid as long as the library file and all the files it
+ * includes keep their modification time and size.
+ */
+
+struct libdep {
+    struct libdep *next;
+    char *path;
+    time_t mtime;
+    off_t size;
+};
+
+static struct libcache {
+    struct libcache *next;
+    char *realpath;
+    COMPATMODE_T compat_mode;
+    struct libdep *deps;        /* the library file and its .include files */
+    struct line *deck;
+} *libcache;
+
+/* where inp_read() records the .include files of a library, or NULL */
+static struct libdep **libdeps;
 
 struct names {
     char *names[N_SUBCKT_W_PARAMS];
     int  num_names;
+    NGHASHPTR table;            /* name -> first entry of names[] */
 };
 
 struct function_env
@@ -193,14 +222,29 @@ insert_deck(struct line *card, struct line *new_card)
 
 
 static struct library *
-new_lib(void)
+new_lib(char *realpath)
 {
+    struct library *lib;
+    char *key;
+
     if (num_libraries >= N_LIBRARIES) {
         fprintf(stderr, "ERROR, N_LIBRARIES overflow\n");
         controlled_exit(EXIT_FAILURE);
     }
 
-    return & libraries[num_libraries++];
+    lib = & libraries[num_libraries++];
+    lib->realpath = strdup(realpath);
+    lib->sections = NULL;
+
+    if (!lib_table)
+        lib_table = nghash_init(NGHASH_MIN_SIZE);
+
+    key = copy(realpath);
+    strtolower(key);
+    nghash_insert(lib_table, key, lib);
+    tfree(key);
+
+    return lib;
 }
 
 
@@ -213,27 +257,47 @@ delete_libs(void)
         tfree(libraries[i].realpath);
         tfree(libraries[i].habitat);
         line_free_x(libraries[i].deck, TRUE);
+        if (libraries[i].sections)
+            nghash_free(libraries[i].sections, NULL, NULL);
+        libraries[i].sections = NULL;
     }
+
+    if (lib_table)
+        nghash_free(lib_table, NULL, NULL);
+    lib_table = NULL;
 }
 
 
 static struct library *
 find_lib(char *name)
 {
-    int i;
+    struct library *lib;
+    char *key;
 
-    for (i = 0; i < num_libraries; i++)
-        if (cieq(libraries[i].realpath, name))
-            return & libraries[i];
+    if (!lib_table)
+        return NULL;
 
-    return NULL;
+    key = copy(name);
+    strtolower(key);
+    lib = (struct library *) nghash_find(lib_table, key);
+    tfree(key);
+
+    return lib;
 }
 
 
-static struct line *
-find_section_definition(struct line *c, char *name)
+/* index the library section definitions `.lib <section-name>' of a
+ * library deck by their lower case name, the first definition wins
+ */
+
+static void
+index_section_definitions(struct library *lib)
 {
-    for (; c; c = c->li_next) {
+    struct line *c;
+
+    lib->sections = nghash_init(NGHASH_MIN_SIZE);
+
+    for (c = lib->deck; c; c = c->li_next) {
 
         char *line = c->li_line;
 
@@ -253,23 +317,152 @@ find_section_definition(struct line *c, char *name)
             if (!*y) {
                 /* library section definition: `.lib <section-name>' .. `.endl' */
 
-                char keep_char = *t;
-                *t = '\0';
-
-                if (strcasecmp(name, s) == 0) {
-                    *t = keep_char;
-                    return c;
-                }
-
-                *t = keep_char;
+                char *key = copy_substring(s, t);
+                strtolower(key);
+                nghash_insert(lib->sections, key, c);
+                tfree(key);
             }
         }
     }
+}
+
+
+static struct line *
+find_section_definition(struct library *lib, char *name)
+{
+    struct line *c;
+    char *key;
+
+    if (!lib->sections)
+        index_section_definitions(lib);
+
+    key = copy(name);
+    strtolower(key);
+    c = (struct line *) nghash_find(lib->sections, key);
+    tfree(key);
+
+    return c;
+}
+
+
+static struct libdep *
+libdep_new(const char *path, struct libdep *next)
+{
+    struct libdep *d = TMALLOC(struct libdep, 1);
+    struct stat st;
+
+    d->next = next;
+    d->path = copy(path);
+    if (stat(path, &st) == 0) {
+        d->mtime = st.st_mtime;
+        d->size = st.st_size;
+    } else {
+        d->mtime = 0;
+        d->size = -1;
+    }
+
+    return d;
+}
+
+
+static void
+libdeps_free(struct libdep *d)
+{
+    while (d) {
+        struct libdep *next = d->next;
+        tfree(d->path);
+        tfree(d);
+        d = next;
+    }
+}
+
+
+static bool
+libdeps_valid(struct libdep *d)
+{
+    struct stat st;
+
+    for (; d; d = d->next)
+        if (stat(d->path, &st) != 0 ||
+            st.st_mtime != d->mtime || st.st_size != d->size)
+            return FALSE;
+
+    return TRUE;
+}
+
+
+/* copy a library deck, keeping the original line numbers */
+
+static struct line *
+lib_deckcopy(struct line *deck)
+{
+    struct line *nd = NULL, *end = NULL;
+
+    for (; deck; deck = deck->li_next) {
+        end = insert_new_line(end, copy(deck->li_line),
+                              deck->li_linenum, deck->li_linenum_orig);
+        if (!nd)
+            nd = end;
+    }
+
+    return nd;
+}
+
+
+static void
+libcache_free(void)
+{
+    while (libcache) {
+        struct libcache *next = libcache->next;
+        tfree(libcache->realpath);
+        libdeps_free(libcache->deps);
+        line_free_x(libcache->deck, TRUE);
+        tfree(libcache);
+        libcache = next;
+    }
+}
+
+
+/* return a valid cache entry for the library file `realpath',
+ * an outdated one is dropped
+ */
+
+static struct libcache *
+libcache_find(char *realpath)
+{
+    struct libcache **pe, *e;
+
+    for (pe = &libcache; (e = *pe) != NULL; pe = &e->next)
+        if (strcmp(e->realpath, realpath) == 0) {
+            if (e->compat_mode == inp_compat_mode && libdeps_valid(e->deps))
+                return e;
+            *pe = e->next;
+            e->next = NULL;
+            tfree(e->realpath);
+            libdeps_free(e->deps);
+            line_free_x(e->deck, TRUE);
+            tfree(e);
+            return NULL;
+        }
 
     return NULL;
 }
 
 
+static void
+libcache_add(char *realpath, struct libdep *deps, struct line *deck)
+{
+    struct libcache *e = TMALLOC(struct libcache, 1);
+
+    e->realpath = copy(realpath);
+    e->compat_mode = inp_compat_mode;
+    e->deps = deps;
+    e->deck = deck;
+    e->next = libcache;
+    libcache = e;
+}
+
+
 static struct library *
 read_a_lib(char *y, char *dir_name)
 {
@@ -299,22 +492,46 @@ read_a_lib(char *y, char *dir_name)
 
     if (!lib) {
 
-        FILE *newfp = fopen(y_resolved, "r");
+        bool use_cache = cp_getvar("libcache", CP_BOOL, NULL);
+        struct libcache *cached = NULL;
 
-        if (!newfp) {
-            fprintf(cp_err, "Error: Could not open library file %s\n", y);
-            return NULL;
-        }
+        if (use_cache)
+            cached = libcache_find(yy);
+        else
+            libcache_free();
+
+        if (cached) {
+            lib = new_lib(yy);
+            lib->habitat = ngdirname(yy);
+            lib->deck = lib_deckcopy(cached->deck);
+        } else {
+            struct libdep *deps = NULL, **saved_libdeps = libdeps;
+            FILE *newfp = fopen(y_resolved, "r");
+
+            if (!newfp) {
+                fprintf(cp_err, "Error: Could not open library file %s\n", y);
+                return NULL;
+            }
+
+            /* lib points to a new entry in global lib array libraries[N_LIBRARIES] */
+            lib = new_lib(yy);
+
+            lib->habitat = ngdirname(yy);
+
+            if (use_cache) {
+                deps = libdep_new(yy, NULL);
+                libdeps = &deps;
+            }
 
-        /* lib points to a new entry in global lib array libraries[N_LIBRARIES] */
-        lib = new_lib();
+            lib->deck = inp_read(newfp, 1 /*dummy*/, lib->habitat, FALSE, FALSE) . cc;
 
-        lib->realpath = strdup(yy);
-        lib->habitat = ngdirname(yy);
+            libdeps = saved_libdeps;
 
-        lib->deck = inp_read(newfp, 1 /*dummy*/, lib->habitat, FALSE, FALSE) . cc;
+            fclose(newfp);
 
-        fclose(newfp);
+            if (use_cache)
+                libcache_add(yy, deps, lib_deckcopy(lib->deck));
+        }
     }
 
     free(yy);
@@ -329,6 +546,7 @@ new_names(void)
 {
     struct names *p = TMALLOC(struct names, 1);
     p -> num_names = 0;
+    p -> table = nghash_init(NGHASH_MIN_SIZE);
 
     return p;
 }
@@ -340,6 +558,7 @@ delete_names(struct names *p)
     int i;
     for (i = 0; i < p->num_names; i++)
         tfree(p->names[i]);
+    nghash_free(p->table, NULL, NULL);
     tfree(p);
 }
 
@@ -512,11 +731,28 @@ find_back_assignment(const char *p, const char *start)
   debug printout to debug-out.txt
   *-------------------------------------------------------------------------*/
 
+/* with ngdebug set, report the time spent in a pass of inp_readall() */
+
+static void
+inp_pass_time(const char *pass, double *start)
+{
+    double now;
+
+    if (!ft_ngdebug)
+        return;
+
+    now = seconds();
+    fprintf(stdout, "  %-38s %10.4f s\n", pass, now - *start);
+    *start = now;
+}
+
+
 struct line *
 inp_readall(FILE *fp, char *dir_name, bool comfile, bool intfile, bool *expr_w_temper_p)
 {
     struct line *cc;
     struct inp_read_t rv;
+    double pass_start = seconds();
 
     num_libraries = 0;
     inp_compat_mode = ngspice_compat_mode();
@@ -540,13 +776,17 @@ inp_readall(FILE *fp, char *dir_name, bool comfile, bool intfile, bool *expr_w_t
 
         struct line *working = cc->li_next;
 
+        inp_pass_time("read, includes and libraries", &pass_start);
+
         delete_libs();
         inp_fix_for_numparam(subckt_w_params, working);
-
+        inp_pass_time("inp_fix_for_numparam", &pass_start);
 
         inp_remove_excess_ws(working);
+        inp_pass_time("inp_remove_excess_ws", &pass_start);
 
         comment_out_unused_subckt_models(working);
+        inp_pass_time("comment_out_unused_subckt_models", &pass_start);
 
         subckt_params_to_param(working);
 
@@ -557,9 +797,13 @@ inp_readall(FILE *fp, char *dir_name, bool comfile, bool intfile, bool *expr_w_t
 
         inp_expand_macros_in_deck(NULL, working);
         inp_fix_param_values(working);
+        inp_pass_time("macros, params, multi param lines", &pass_start);
 
         inp_reorder_params(subckt_w_params, cc);
+        inp_pass_time("inp_reorder_params", &pass_start);
+
         inp_fix_inst_calls_for_numparam(subckt_w_params, working);
+        inp_pass_time("inp_fix_inst_calls_for_numparam", &pass_start);
 
         delete_names(subckt_w_params);
         subckt_w_params = NULL;
@@ -584,6 +828,7 @@ inp_readall(FILE *fp, char *dir_name, bool comfile, bool intfile, bool *expr_w_t
             inp_dot_if(working);
             expr_w_temper = inp_temper_compat(working);
         }
+        inp_pass_time("compatibility transformations", &pass_start);
         if (expr_w_temper_p)
             *expr_w_temper_p = expr_w_temper;
 
@@ -825,6 +1070,9 @@ inp_read(FILE *fp, int call_depth, char *dir_name, bool comfile, bool intfile)
 
                 y_dir_name = ngdirname(y_resolved);
 
+                if (libdeps)
+                    *libdeps = libdep_new(y_resolved, *libdeps);
+
                 newcard = inp_read(newfp, call_depth+1, y_dir_name, FALSE, FALSE) . cc;  /* read stuff in include file into netlist */
 
                 tfree(y_dir_name);
@@ -1661,28 +1909,44 @@ struct nlist {
     char **names;
     int num_names;
     int size;
+    NGHASHPTR table;            /* name -> names[] entry */
 };
 
 
 static const char *
 nlist_find(const struct nlist *nlist, const char *name)
 {
-    int i;
-    for (i = 0; i < nlist->num_names; i++)
-        if (strcmp(nlist->names[i], name) == 0)
-            return nlist->names[i];
-    return NULL;
+    return (const char *) nghash_find(nlist->table, (void *) name);
 }
 
 
+/* find the entry `token' of nlist which model_name_match() matches with
+ * `name', either exact or modulo a binning extension '\.[0-9]+' of `name'
+ */
+
 static const char *
 nlist_model_find(const struct nlist *nlist, const char *name)
 {
-    int i;
-    for (i = 0; i < nlist->num_names; i++)
-        if (model_name_match(nlist->names[i], name))
-            return nlist->names[i];
-    return NULL;
+    const char *found = nlist_find(nlist, name);
+    const char *dot, *p;
+
+    if (found)
+        return found;
+
+    dot = strrchr(name, '.');
+    if (!dot || !dot[1])
+        return NULL;
+    for (p = dot + 1; *p; p++)
+        if (!isdigit_c(*p))
+            return NULL;
+
+    {
+        char *token = copy_substring(name, dot);
+        found = nlist_find(nlist, token);
+        tfree(token);
+    }
+
+    return found;
 }
 
 
@@ -1697,6 +1961,7 @@ nlist_adjoin(struct nlist *nlist, char *name)
     if (nlist->num_names >= nlist->size)
         nlist->names = TREALLOC(char *, nlist->names, nlist->size *= 2);
 
+    nghash_insert(nlist->table, name, name);
     nlist->names[nlist->num_names++] = name;
 }
 
@@ -1708,6 +1973,7 @@ nlist_allocate(int size)
 
     t->names = TMALLOC(char *, size);
     t->size = size;
+    t->table = nghash_init(size);
 
     return t;
 }
@@ -1720,13 +1986,42 @@ nlist_destroy(struct nlist *nlist)
     for (i = 0; i < nlist->num_names; i++)
         tfree(nlist->names[i]);
 
+    nghash_free(nlist->table, NULL, NULL);
     tfree(nlist->names);
     tfree(nlist);
 }
 
 
+/* index the `.subckt' and `.macro' cards of the deck by subcircuit name,
+ * the first definition wins
+ */
+
+static NGHASHPTR
+index_subckt_definitions(struct line *start_card)
+{
+    NGHASHPTR subckt_defs = nghash_init(NGHASH_MIN_SIZE);
+    struct line *card;
+
+    for (card = start_card; card; card = card->li_next) {
+
+        char *line = card->li_line;
+
+        if (*line == '*')
+            continue;
+
+        if (ciprefix(".subckt", line) || ciprefix(".macro", line)) {
+            char *subckt_name = get_subckt_model_name(line);
+            nghash_insert(subckt_defs, subckt_name, card);
+            tfree(subckt_name);
+        }
+    }
+
+    return subckt_defs;
+}
+
+
 static void
-get_subckts_for_subckt(struct line *start_card, char *subckt_name,
+get_subckts_for_subckt(NGHASHPTR subckt_defs, char *subckt_name,
                        struct nlist *used_subckts, struct nlist *used_models,
                        bool has_models)
 {
@@ -1736,7 +2031,9 @@ get_subckts_for_subckt(struct line *start_card, char *subckt_name,
     bool found_subckt = FALSE;
     int  i, fence;
 
-    for (card = start_card; card; card = card->li_next) {
+    card = (struct line *) nghash_find(subckt_defs, subckt_name);
+
+    for (; card; card = card->li_next) {
 
         char *line = card->li_line;
 
@@ -1778,7 +2075,7 @@ get_subckts_for_subckt(struct line *start_card, char *subckt_name,
     // now make recursive call on instances just found above
     fence = used_subckts->num_names;
     for (i = first_new_subckt; i < fence; i++)
-        get_subckts_for_subckt(start_card, used_subckts->names[i],
+        get_subckts_for_subckt(subckt_defs, used_subckts->names[i],
                                used_subckts, used_models, has_models);
 }
 
@@ -1794,6 +2091,7 @@ comment_out_unused_subckt_models(struct line *start_card)
 {
     struct line *card;
     struct nlist *used_subckts, *used_models;
+    NGHASHPTR subckt_defs;
     int  i = 0, fence;
     bool processing_subckt = FALSE, remove_subckt = FALSE, has_models = FALSE;
     int skip_control = 0, nested_subckt = 0;
@@ -1856,11 +2154,15 @@ comment_out_unused_subckt_models(struct line *start_card)
         } /* if (!processing_subckt) */
     } /* for loop through all cards */
 
+    subckt_defs = index_subckt_definitions(start_card);
+
     fence = used_subckts->num_names;
     for (i = 0; i < fence; i++)
-        get_subckts_for_subckt(start_card, used_subckts->names[i],
+        get_subckts_for_subckt(subckt_defs, used_subckts->names[i],
                                used_subckts, used_models, has_models);
 
+    nghash_free(subckt_defs, NULL, NULL);
+
     /* comment out any unused subckts, currently only at top level */
     for (card = start_card; card; card = card->li_next) {
 
@@ -2141,6 +2443,9 @@ add_name(struct names *p, char *name)
         controlled_exit(EXIT_FAILURE);
     }
 
+    /* keeps the first entry of a name */
+    nghash_insert(p->table, name, & p->names[p->num_names]);
+
     p->names[p->num_names++] = name;
 }
 
@@ -2148,13 +2453,7 @@ add_name(struct names *p, char *name)
 static char **
 find_name(struct names *p, char *name)
 {
-    int i;
-
-    for (i = 0; i < p->num_names; i++)
-        if (strcmp(p->names[i], name) == 0)
-            return & p->names[i];
-
-    return NULL;
+    return (char **) nghash_find(p->table, name);
 }
 
 
@@ -2403,7 +2702,7 @@ expand_section_ref(struct line *c, char *dir_name)
             controlled_exit(EXIT_FAILURE);
         }
 
-        section_def = find_section_definition(lib->deck, y);
+        section_def = find_section_definition(lib, y);
 
         if (!section_def) {
             fprintf(stderr, "ERROR, library file %s, section definition %s not found\n", s, y);
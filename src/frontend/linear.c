@@ -41,6 +41,7 @@ com_linearize(wordlist *wl)
         fprintf(cp_err, "Error: plot must be a transient analysis\n");
         return;
     }
+    raw_loadvec(plot_cur->pl_scale);
     /* check if circuit is loaded and TSTART, TSTOP, TSTEP are available
        if no circuit is loaded, but vectors are available, obtain
        start, stop, step data from scale vector */
@@ -102,6 +103,7 @@ com_linearize(wordlist *wl)
         for (v = old->pl_dvecs; v; v = v->v_next) {
             if (v == old->pl_scale)
                 continue;
+            raw_loadvec(v);
             lincopy(v, newtime->v_realdata, len, oldtime);
         }
     }
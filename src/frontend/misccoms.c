@@ -236,7 +236,7 @@ com_version(wordlist *wl)
             fprintf(cp_out, "** Adms interface enabled\n");
 #endif
 #ifdef USE_OMP
-            fprintf(cp_out, "** OpenMP multithreading for BSIM3, BSIM4 enabled\n");
+            fprintf(cp_out, "** OpenMP multithreading for BSIM3, BSIM4, diode enabled\n");
 #endif
 #if defined(X_DISPLAY_MISSING) && !defined(HAS_WINGUI)
             fprintf(cp_out, "** X11 interface not compiled into ngspice\n");
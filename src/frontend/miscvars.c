@@ -72,6 +72,8 @@ char *ft_setkwords[] = {
     "itl3",
     "itl4",
     "itl5",
+    "lazyload",
+    "libcache",
     "list",
     "lprplot5",
     "lprps",
@@ -99,6 +101,7 @@ char *ft_setkwords[] = {
     "opts",
     "pivrel",
     "pivtol",
+    "plotmemory",
     "plots",
     "pointchars",
     "polydegree",
@@ -42,6 +42,7 @@ typedef struct {                /* the input scanner data structure */
     NGHASHPTR *symbols;         /* stack of scopes for symbol lookup */
                                 /*  [0] denotes global scope */
     NGHASHPTR inst_symbols;     /* instance qualified symbols - after a pop */
+    NGHASHPTR formulas;         /* scanned formulas, by their text */
     char **inst_name;           /* name of subcircuit */
     char **dynrefptr;
     char *dyncategory;
@@ -51,6 +52,7 @@ typedef struct {                /* the input scanner data structure */
 
 void initdico(dico_t *);
 int donedico(dico_t *);
+void dico_free_formulas(dico_t *);
 void dico_free_entry(entry_t *);
 bool defsubckt(dico_t *, char *s, int w, char categ);
 int findsubckt(dico_t *, char *s, SPICE_DSTRINGPTR subname);
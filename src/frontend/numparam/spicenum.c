@@ -476,6 +476,7 @@ nupa_del_dicoS(void)
     txfree(dicoS->inst_name);
     nghash_free(dicoS->symbols[0], del_attrib, NULL);
     txfree(dicoS->symbols);
+    dico_free_formulas(dicoS);
     txfree(dicoS);
     dicoS = NULL;
 }
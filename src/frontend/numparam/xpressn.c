@@ -263,6 +263,7 @@ initdico(dico_t *dico)
     nghash_unique(dico->symbols[0], TRUE); /* no rewrite of global symbols */
 
     dico->inst_symbols = NULL;          /* instance qualified are lazily allocated */
+    dico->formulas = NULL;              /* lazily allocated by formula() */
 
     compat_mode = ngspice_compat_mode();
 
@@ -359,6 +360,7 @@ int
 donedico(dico_t *dico)
 {
     int sze = nghash_get_size(dico->symbols[0]);
+    dico_free_formulas(dico);
     return sze;
 }
 
@@ -886,62 +888,96 @@ operate(char op, double x, double y)
 
 #define nprece 9 /* maximal nb of precedence levels */
 
-static double
-formula(dico_t *dico, const char *s, const char *s_end, bool *perror)
+
+/* A formula is scanned once into the atoms, operators and parenthesized
+ * sub formulas that formula_eval() works on, and kept in dico->formulas
+ * by its text.  The many subcircuit instances repeating an expression
+ * then only look up the parameters, instead of scanning the text again.
+ */
+
+typedef struct formula_s formula_t;
+
+typedef struct {
+    char kind;                  /* 'n'umber, 'i'dentifier, 'f'unction,
+                                   'o'perator or '(' sub formula */
+    char c;                     /* operator */
+    unsigned char state;        /* ... its interpreter state, */
+    unsigned char level;        /* ... and precedence level */
+    unsigned char fu;           /* math function */
+    bool at_end;                /* last token of the formula */
+    double u;                   /* number */
+    char *name;                 /* identifier, upper case */
+    formula_t *v, *w, *arg;     /* arguments of a sub formula */
+} ftoken_t;
+
+struct formula_s {
+    char *text;                 /* copy of the text, only in the outermost */
+    const char *s_orig;         /* for error messages */
+    ftoken_t *tok;
+    int ntok;
+};
+
+
+static void
+formula_free(formula_t *f)
 {
-    /* Expression parser.
-       s is a formula with parentheses and math ops +-* / ...
-       State machine and an array of accumulators handle operator precedence.
-       Parentheses handled by recursion.
-       Empty expression is forbidden: must find at least 1 atom.
-       Syntax error if no toggle between binoperator && (unop/state1) !
-       States : 1=atom, 2=binOp, 3=unOp, 4= stop-codon.
-       Allowed transitions:  1->2->(3,1) and 3->(3,1).
-    */
-    bool error = *perror;
-    bool negate = 0;
-    unsigned char state, oldstate, topop, ustack, level, fu;
-    double u = 0.0;
-    double accu[nprece + 1];
-    char oper[nprece + 1];
-    char uop[nprece + 1];
-    int i, natom;
-    bool ok;
-    SPICE_DSTRING tstr;
-    const char *s_orig = s;
+    int i;
 
-    spice_dstring_init(&tstr);
+    if (!f)
+        return;
 
-    for (i = 0; i <= nprece; i++) {
-        accu[i] = 0.0;
-        oper[i] = ' ';
+    for (i = 0; i < f->ntok; i++) {
+        tfree(f->tok[i].name);
+        formula_free(f->tok[i].v);
+        formula_free(f->tok[i].w);
+        formula_free(f->tok[i].arg);
     }
 
+    tfree(f->tok);
+    tfree(f->text);
+    tfree(f);
+}
+
+
+static void
+del_formula(void *f)
+{
+    formula_free((formula_t *) f);
+}
+
+
+static formula_t *
+formula_compile(dico_t *dico, const char *s, const char *s_end)
+{
+    /* Scan s up to s_end.  Parentheses are scanned by recursion,
+       return NULL after a syntax error.
+    */
+    formula_t *f = TMALLOC(formula_t, 1);
+    int maxtok = 0;
+    bool error = 0;
+
+    f->s_orig = s;
+
     /* trim trailing whitespace */
     while ((s_end > s) && (s_end[-1] <= ' '))
         s_end--;
 
-    state = S_init;
-    natom = 0;
-    ustack = 0;
-    topop = 0;
-    oldstate = S_init;
-    fu = 0;
-    error = 0;
-    level = 0;
-
     while ((s < s_end) && !error) {
+        ftoken_t tok;
         char c = *s;
+
+        memset(&tok, 0, sizeof(tok));
+        tok.c = c;
+
         if (c == '(') {
             /* sub-formula or math function */
-            double v = 1.0, w = 0.0;
             /* new: must support multi-arg functions */
             const char *kptr = ++s;
             const char *arg2 = NULL;
             const char *arg3 = NULL;
+            int level = 1;
             char d;
 
-            level = 1;
             do
             {
                 d = *kptr++;
@@ -962,67 +998,165 @@ formula(dico_t *dico, const char *s, const char *s_end, bool *perror)
 
             } while ((kptr <= s_end) && !((d == ')') && (level <= 0)));
 
-            // fixme, here level = 0 !!!!! (almost)
-
             if (kptr > s_end) {
                 error = message(dico, "Closing \")\" not found.\n");
-                natom++;        /* shut up other error message */
-            } else {
-                if (arg2 > s) {
-                    v = formula(dico, s, arg2 - 1, &error);
-                    s = arg2;
-                }
-                if (arg3 > s) {
-                    w = formula(dico, s, arg3 - 1, &error);
-                    s = arg3;
-                }
-                u = formula(dico, s, kptr - 1, &error);
-                state = S_atom;
-                if (fu > 0) {
-                    if ((fu == XFU_TERNARY_FCN))
-                        u = ternary_fcn(v, w, u);
-                    else if ((fu == XFU_AGAUSS))
-                        u = agauss(v, w, u);
-                    else if ((fu == XFU_GAUSS))
-                        u = gauss(v, w, u);
-                    else if ((fu == XFU_UNIF))
-                        u = unif(v, u);
-                    else if ((fu == XFU_AUNIF))
-                        u = aunif(v, u);
-                    else if ((fu == XFU_LIMIT))
-                        u = limit(v, u);
-                    else
-                        u = mathfunction(fu, v, u);
-                }
+                break;
+            }
+
+            if (arg2 > s) {
+                tok.v = formula_compile(dico, s, arg2 - 1);
+                s = arg2;
+            }
+            if (arg3 > s) {
+                tok.w = formula_compile(dico, s, arg3 - 1);
+                s = arg3;
             }
+            tok.arg = formula_compile(dico, s, kptr - 1);
+            tok.kind = '(';
             s = kptr;
-            fu = 0;
+
+            error = (arg2 && !tok.v) || (arg3 && !tok.w) || !tok.arg;
         } else if (alfa(c)) {
             const char *s_next = fetchid(s, s_end);
-            fu = keyword(fmathS, s, s_next); /* numeric function? */
-            if (fu > 0) {
-                state = S_init;  /* S_init means: ignore for the moment */
+            tok.fu = keyword(fmathS, s, s_next); /* numeric function? */
+            if (tok.fu > 0) {
+                tok.kind = 'f';
             } else {
-                spice_dstring_reinit(&tstr);
+                char *p = tok.name = TMALLOC(char, s_next - s + 1);
                 while (s < s_next)
-                    cadd(&tstr, upcase(*s++));
-                u = fetchnumentry(dico, spice_dstring_value(&tstr), &error);
-                state = S_atom;
+                    *p++ = upcase(*s++);
+                *p = '\0';
+                tok.kind = 'i';
             }
             s = s_next;
         } else if (((c == '.') || ((c >= '0') && (c <= '9')))) {
-            u = fetchnumber(dico, &s, &error);
+            tok.u = fetchnumber(dico, &s, &error);
+            tok.kind = 'n';
+        } else {
+            unsigned char state = S_init, level = 0;
+            tok.c = fetchoperator(dico, s_end, &s, &state, &level, &error);
+            /* control chars <' '  ignored */
+            if (state == S_init)
+                continue;
+            tok.kind = 'o';
+            tok.state = state;
+            tok.level = level;
+        }
+
+        tok.at_end = (s >= s_end);
+
+        if (f->ntok >= maxtok) {
+            maxtok = maxtok ? 2 * maxtok : 8;
+            f->tok = TREALLOC(ftoken_t, f->tok, maxtok);
+        }
+        f->tok[f->ntok++] = tok;
+
+        if (error)
+            break;
+    }
+
+    if (error) {
+        formula_free(f);
+        return NULL;
+    }
+
+    return f;
+}
+
+
+static double
+formula_eval(dico_t *dico, formula_t *f, bool *perror)
+{
+    /* Expression evaluator.
+       State machine and an array of accumulators handle operator precedence.
+       Parentheses handled by recursion.
+       Empty expression is forbidden: must find at least 1 atom.
+       Syntax error if no toggle between binoperator && (unop/state1) !
+       States : 1=atom, 2=binOp, 3=unOp, 4= stop-codon.
+       Allowed transitions:  1->2->(3,1) and 3->(3,1).
+    */
+    bool error = *perror;
+    bool negate = 0;
+    unsigned char state, oldstate, topop, ustack, level, fu;
+    double u = 0.0;
+    double accu[nprece + 1];
+    char oper[nprece + 1];
+    char uop[nprece + 1];
+    int i, k, natom;
+    bool ok;
+
+    for (i = 0; i <= nprece; i++) {
+        accu[i] = 0.0;
+        oper[i] = ' ';
+    }
+
+    state = S_init;
+    natom = 0;
+    ustack = 0;
+    topop = 0;
+    oldstate = S_init;
+    fu = 0;
+    error = 0;
+    level = 0;
+
+    for (k = 0; (k < f->ntok) && !error; k++) {
+        ftoken_t *tok = &f->tok[k];
+        char c = tok->c;
+
+        switch (tok->kind) {
+        case '(': {
+            double v = 1.0, w = 0.0;
+
+            level = 0;
+            if (tok->v)
+                v = formula_eval(dico, tok->v, &error);
+            if (tok->w)
+                w = formula_eval(dico, tok->w, &error);
+            u = formula_eval(dico, tok->arg, &error);
+            state = S_atom;
+            if (fu > 0) {
+                if ((fu == XFU_TERNARY_FCN))
+                    u = ternary_fcn(v, w, u);
+                else if ((fu == XFU_AGAUSS))
+                    u = agauss(v, w, u);
+                else if ((fu == XFU_GAUSS))
+                    u = gauss(v, w, u);
+                else if ((fu == XFU_UNIF))
+                    u = unif(v, u);
+                else if ((fu == XFU_AUNIF))
+                    u = aunif(v, u);
+                else if ((fu == XFU_LIMIT))
+                    u = limit(v, u);
+                else
+                    u = mathfunction(fu, v, u);
+            }
+            fu = 0;
+            break;
+        }
+        case 'f':
+            fu = tok->fu;
+            state = S_init;  /* S_init means: ignore for the moment */
+            break;
+        case 'i':
+            u = fetchnumentry(dico, tok->name, &error);
+            state = S_atom;
+            break;
+        case 'n':
+            u = tok->u;
             if (negate) {
                 u = -1 * u;
                 negate = 0;
             }
             state = S_atom;
-        } else {
-            c = fetchoperator(dico, s_end, &s, &state, &level, &error);
+            break;
+        default:
+            state = tok->state;
+            if (state == S_binop)
+                level = tok->level;
+            break;
         }
 
         /* may change c to some other operator char! */
-        /* control chars <' '  ignored */
 
         ok = (oldstate == S_init) || (state == S_init) ||
             ((oldstate == S_atom) && (state == S_binop)) ||
@@ -1043,7 +1177,7 @@ formula(dico_t *dico, const char *s, const char *s_end, bool *perror)
         } else if (state == S_atom) {
             /* atom pending */
             natom++;
-            if (s >= s_end) {
+            if (tok->at_end) {
                 state = S_stop;
                 level = topop;
             } /* close all ops below */
@@ -1093,7 +1227,7 @@ formula(dico_t *dico, const char *s, const char *s_end, bool *perror)
     }
 
     if ((natom == 0) || (oldstate != S_stop))
-        error = message(dico, " Expression err: %s\n", s_orig);
+        error = message(dico, " Expression err: %s\n", f->s_orig);
 
     if (negate == 1)
         error = message(dico,
@@ -1101,8 +1235,6 @@ formula(dico_t *dico, const char *s, const char *s_end, bool *perror)
 
     *perror = error;
 
-    spice_dstring_free(&tstr);
-
     if (error)
         return 1.0;
     else
@@ -1110,6 +1242,48 @@ formula(dico_t *dico, const char *s, const char *s_end, bool *perror)
 }
 
 
+static double
+formula(dico_t *dico, const char *s, bool *perror)
+{
+    /* Expression parser.
+       s is a formula with parentheses and math ops +-* / ...
+       It is scanned once, later calls with the same text only evaluate.
+    */
+    formula_t *f;
+
+    if (!dico->formulas)
+        dico->formulas = nghash_init(NGHASH_MIN_SIZE);
+
+    f = (formula_t *) nghash_find(dico->formulas, (void *) s);
+
+    if (!f) {
+        char *text = copy(s);
+        f = formula_compile(dico, text, text + strlen(text));
+        if (!f) {
+            tfree(text);
+            *perror = message(dico, " Expression err: %s\n", s);
+            return 1.0;
+        }
+        f->text = text;
+        nghash_insert(dico->formulas, text, f);
+    }
+
+    return formula_eval(dico, f, perror);
+}
+
+
+/* forget the formulas scanned so far */
+
+void
+dico_free_formulas(dico_t *dico)
+{
+    if (dico->formulas)
+        nghash_free(dico->formulas, del_formula, NULL);
+
+    dico->formulas = NULL;
+}
+
+
 static bool
 evaluate(dico_t *dico, SPICE_DSTRINGPTR qstr_p, char *t, unsigned char mode)
 {
@@ -1171,7 +1345,7 @@ evaluate(dico_t *dico, SPICE_DSTRINGPTR qstr_p, char *t, unsigned char mode)
                           "\"%s\" not evaluated.%s\n", t,
                           nolookup ? " Lookup failure." : "");
     } else {
-        u = formula(dico, t, t + strlen(t), &err);
+        u = formula(dico, t, &err);
         numeric = 1;
     }
 
@@ -1528,7 +1702,7 @@ nupa_assignment(dico_t *dico, char *s, char mode)
 
             if (dtype == 'R') {
                 const char *tmp = spice_dstring_value(&ustr);
-                rval = formula(dico, tmp, tmp + strlen(tmp), &error);
+                rval = formula(dico, tmp, &error);
                 if (error)
                     message(dico,
                             " Formula() error.\n"
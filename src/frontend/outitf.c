@@ -27,8 +27,10 @@ Modified: 2000 AlansFixes, 2013/2015 patch by Krzysztof Blaszkowski
 #include <fcntl.h>
 #include "ngspice/cktdefs.h"
 #include "ngspice/inpdefs.h"
+#include "ngspice/trandefs.h"
 #include "breakp2.h"
 #include "runcoms.h"
+#include "rawfile.h"
 #include "plotting/graf.h"
 #include "../misc/misc_time.h"
 
@@ -49,11 +51,13 @@ static void fileAddComplexValue(FILE *fp, bool bin, IFcomplex value);
 static void fileEndPoint(FILE *fp, bool bin);
 static void fileEnd(runDesc *run);
 static void plotInit(runDesc *run);
+static int plotSizeHint(runDesc *run);
 static void plotAddRealValue(dataDesc *desc, double value);
 static void plotAddComplexValue(dataDesc *desc, IFcomplex value);
 static void plotEnd(runDesc *run);
 static bool parseSpecial(char *name, char *dev, char *param, char *ind);
 static bool name_eq(char *n1, char *n2);
+static void resolveSpecial(dataDesc *desc, runDesc *run);
 static bool getSpecial(dataDesc *desc, runDesc *run, IFvalue *val);
 static void freeRun(runDesc *run);
 static int InterpFileAdd(runDesc *plotPtr, IFvalue *refValue, IFvalue *valuePtr);
@@ -65,6 +69,7 @@ static int InterpPlotAdd(runDesc *plotPtr, IFvalue *refValue, IFvalue *valuePtr)
 #elif defined SHARED_MODULE
 extern int sh_ExecutePerLoop(void);
 extern void sh_vecinit(runDesc *run);
+extern void sh_vecend(runDesc *run);
 #endif
 
 /*Suppressing progress info in -o option */
@@ -85,11 +90,21 @@ static clock_t lastclock, currclock;
 static double *rowbuf;
 static size_t column, rowbuflen;
 
+/* columnar output: rows of the current chunk, one column per variable */
+static double *chunkbuf;
+static size_t chunkrows, chunkwidth;
+
 static bool shouldstop = FALSE; /* Tell simulator to stop next time it asks. */
 
 static bool interpolated = FALSE;
 static double *valueold, *valuenew;
 
+/* plot vectors grow geometrically up to this length, linearly beyond */
+static int vlengthLimit = INT_MAX;
+
+/* upper bound for the memory reserved for all vectors of a plot up front */
+#define PLOT_PRESIZE_MAX  (64 * 1048576.)
+
 /* The two "begin plot" routines share all their internals... */
 
 int
@@ -348,6 +363,11 @@ beginPlot(JOB *analysisPtr, CKTcircuit *circuitPtr, char *cktName, char *analNam
             addSpecialDesc(run, saves[i].name, namebuf, parambuf, depind);
         }
 
+        /* Find out once what each special vector asks for. */
+        for (i = 0; i < run->numData; i++)
+            if (!run->data[i].regular)
+                resolveSpecial(&run->data[i], run);
+
         if (numsaves) {
             for (i = 0; i < numsaves; i++) {
                 tfree(saves[i].analysis);
@@ -371,6 +391,9 @@ beginPlot(JOB *analysisPtr, CKTcircuit *circuitPtr, char *cktName, char *analNam
          */
         run->writeOut = ft_getOutReq(&run->fp, &run->runPlot, &run->binary,
                                      run->type, run->name);
+        /* the number of points has to be filled in for columns */
+        run->columns = run->writeOut && run->binary && rawfileColumns &&
+            run->fp != stdout;
 
         if (run->writeOut) {
             fileInit(run);
@@ -458,6 +481,8 @@ addSpecialDesc(runDesc *run, char *name, char *devname, char *param, int depind)
     data->specIndex = depind;
     data->specType = -1;
     data->specFast = NULL;
+    data->specParamId = -1;
+    data->specStatId = -1;
     data->regular = FALSE;
 
     run->numData++;
@@ -736,12 +761,89 @@ OUTendPlot(runDesc *plotPtr)
         plotEnd(run);
     }
 
+#ifdef SHARED_MODULE
+    sh_vecend(run);
+#endif
+
     freeRun(run);
 
     return (OK);
 }
 
 
+/* Add the points plotted so far by 'run' to a snapshot.  Only a plot in
+   memory is saved, the points of a rawfile are in the file already. */
+
+void
+OUTsnapSave(runDesc *run, CKTsnap *snap)
+{
+    double count;
+    char *name;
+    int i;
+
+    if (run->writeOut)
+        return;
+
+    count = run->pointCount;
+    CKTsnapPut(snap, "plot:points", &count, 1);
+
+    for (i = 0; i < run->numData; i++) {
+        struct dvec *v = run->data[i].vec;
+        name = tprintf("plot:%s", v->v_name);
+        if (isreal(v))
+            CKTsnapPut(snap, name, v->v_realdata, v->v_length);
+        else
+            CKTsnapPut(snap, name, (double *) v->v_compdata, 2 * v->v_length);
+        tfree(name);
+    }
+}
+
+
+/* Take the points saved by OUTsnapSave() over into the new plot of
+   'run', all of them or, if one of the vectors is missing, none. */
+
+int
+OUTsnapLoad(runDesc *run, CKTsnap *snap)
+{
+    double *count, *data;
+    char *name;
+    int i, pass, length;
+
+    if (run->writeOut)
+        return (OK);
+
+    count = CKTsnapGet(snap, "plot:points", 1);
+    if (!count)
+        return (E_NOTFOUND);
+
+    for (pass = 0; pass < 2; pass++)
+        for (i = 0; i < run->numData; i++) {
+            struct dvec *v = run->data[i].vec;
+            name = tprintf("plot:%s", v->v_name);
+            length = CKTsnapLength(snap, name);
+            data = CKTsnapGet(snap, name, length);
+            tfree(name);
+            if (!isreal(v))
+                length /= 2;
+            if (!data || length < 0)
+                return (E_NOTFOUND);
+            if (pass) {
+                dvec_extend(v, length);
+                if (isreal(v))
+                    memcpy(v->v_realdata, data, (size_t) length * sizeof(double));
+                else
+                    memcpy(v->v_compdata, data, (size_t) length * sizeof(ngcomplex_t));
+                v->v_length = length;
+                v->v_dims[0] = length;
+            }
+        }
+
+    run->pointCount = (int) *count;
+
+    return (OK);
+}
+
+
 /* ARGSUSED */ /* until some code gets written */
 int
 OUTbeginDomain(runDesc *plotPtr, IFuid refName, int refType, IFvalue *outerRefValue)
@@ -922,7 +1024,10 @@ fileInit_pass2(runDesc *run)
         fprintf(run->fp, "\n");
     }
 
-    fprintf(run->fp, "%s:\n", run->binary ? "Binary" : "Values");
+    if (run->columns)
+        fprintf(run->fp, "Columns: %d\n", RAW_CHUNKSIZE);
+    else
+        fprintf(run->fp, "%s:\n", run->binary ? "Binary" : "Values");
     fflush(run->fp);
 
     /*  Allocate Row buffer  */
@@ -932,6 +1037,13 @@ fileInit_pass2(runDesc *run)
         if (run->isComplex)
             rowbuflen *= 2;
         rowbuf = TMALLOC(double, rowbuflen);
+        /* and the chunk buffer, rows are written when it is full */
+        tfree(chunkbuf);
+        if (run->columns) {
+            chunkwidth = run->isComplex ? 2 : 1;
+            chunkbuf = TMALLOC(double, RAW_CHUNKSIZE * rowbuflen);
+            chunkrows = 0;
+        }
     } else {
         // fIXME rowbuflen = 0;
         rowbuf = NULL;
@@ -974,6 +1086,21 @@ fileAddComplexValue(FILE *fp, bool bin, IFcomplex value)
 }
 
 
+/* write the rows of the chunk buffer, one column after the other */
+
+static void
+fileFlushChunk(FILE *fp)
+{
+    size_t i, ncols = rowbuflen / chunkwidth;
+
+    for (i = 0; i < ncols; i++)
+        fwrite(chunkbuf + i * RAW_CHUNKSIZE * chunkwidth, sizeof(double),
+               chunkrows * chunkwidth, fp);
+
+    chunkrows = 0;
+}
+
+
 /* ARGSUSED */ /* until some code gets written */
 static void
 fileEndPoint(FILE *fp, bool bin)
@@ -981,8 +1108,18 @@ fileEndPoint(FILE *fp, bool bin)
     /*  write row buffer to file  */
     /* otherwise the data has already been written */
 
-    if (bin)
+    if (bin && chunkbuf) {
+        /* transpose the row into the chunk buffer */
+        size_t i, j, ncols = rowbuflen / chunkwidth;
+        for (i = 0; i < ncols; i++)
+            for (j = 0; j < chunkwidth; j++)
+                chunkbuf[(i * RAW_CHUNKSIZE + chunkrows) * chunkwidth + j] =
+                    rowbuf[i * chunkwidth + j];
+        if (++chunkrows == RAW_CHUNKSIZE)
+            fileFlushChunk(fp);
+    } else if (bin) {
         fwrite(rowbuf, sizeof(double), rowbuflen, fp);
+    }
 }
 
 
@@ -991,6 +1128,11 @@ fileEndPoint(FILE *fp, bool bin)
 static void
 fileEnd(runDesc *run)
 {
+    if (chunkbuf) {
+        fileFlushChunk(run->fp);
+        tfree(chunkbuf);
+    }
+
     if (run->fp != stdout) {
         long place = ftell(run->fp);
         fseek(run->fp, run->pointPos, SEEK_SET);
@@ -1018,7 +1160,7 @@ plotInit(runDesc *run)
 {
     struct plot *pl = plot_alloc(run->type);
     struct dvec *v;
-    int i;
+    int i, plotlen;
 
     pl->pl_title = copy(run->name);
     pl->pl_name = copy(run->type);
@@ -1035,6 +1177,8 @@ plotInit(runDesc *run)
         if (run->data[i].type == IF_COMPLEX)
             run->isComplex = TRUE;
 
+    plotlen = plotSizeHint(run);
+
     for (i = 0; i < run->numData; i++) {
         dataDesc *dd = &run->data[i];
         char *name;
@@ -1051,25 +1195,69 @@ plotInit(runDesc *run)
                        : (VF_REAL | VF_PERMANENT),
                        0, NULL);
 
+        if (plotlen > 0)
+            dvec_extend(v, plotlen);
+
         vec_new(v);
         dd->vec = v;
     }
 }
 
 
+/* Estimate the number of points of the plot, to reserve the memory of
+ * all vectors at once.  Only a transient analysis tells us beforehand,
+ * by TSTOP and TSTEP; the time step control may add more points, which
+ * are then left to vlength2delta().  Also set vlengthLimit from the
+ * "plotmemory" budget (in MB) for the vectors of the plot.
+ */
+
+static int
+plotSizeHint(runDesc *run)
+{
+    JOB *job = (JOB *) run->analysis;
+    size_t size = run->isComplex ? sizeof(ngcomplex_t) : sizeof(double);
+    double width = (double) size * MAX(run->numData, 1);
+    double budget, points = 0.0;
+    int mb;
+
+    if (cp_getvar("plotmemory", CP_NUM, &mb) && mb > 0) {
+        budget = mb * 1048576.;
+        vlengthLimit = (int) MIN(MAX(budget / width, 512.0), INT_MAX / 2);
+    } else {
+        budget = PLOT_PRESIZE_MAX;
+        vlengthLimit = INT_MAX;
+    }
+
+    if (job && cieq(spice_analysis_get_name(job->JOBtype), "TRAN")) {
+        TRANan *tran = (TRANan *) job;
+        if (tran->TRANstep > 0 && tran->TRANfinalTime > tran->TRANinitTime)
+            points = (tran->TRANfinalTime - tran->TRANinitTime) /
+                tran->TRANstep + 2;
+    }
+
+    /* never reserve more than the budget */
+    points = MIN(points, MIN(budget, PLOT_PRESIZE_MAX) / width);
+
+    return (int) points;
+}
+
+
+/* Below vlengthLimit the vectors grow by half their length, so that a
+ * long run copies its data only a few times.  Beyond, fall back to
+ * small steps, larger memory allocations may exhaust memory easily.
+ */
+
 static inline int
 vlength2delta(int l)
 {
+    if (l < vlengthLimit)
+        return MAX(512, MIN(l / 2, vlengthLimit - l));
     if (l < 50000)
         return 512;
     if (l < 200000)
         return 256;
     if (l < 500000)
         return 128;
-    /* larger memory allocations may exhaust memory easily
-     * this function may use better estimation depending on
-     * available memory and number of vectors (run->numData)
-     */
     return 64;
 }
 
@@ -1111,10 +1299,18 @@ plotAddComplexValue(dataDesc *desc, IFcomplex value)
 }
 
 
-/* ARGSUSED */ /* until some code gets written */
 static void
 plotEnd(runDesc *run)
 {
+    int i;
+
+    /* give back what the vectors have not used */
+    for (i = 0; i < run->numData; i++) {
+        struct dvec *v = run->data[i].vec;
+        if (v && v->v_length > 0 && v->v_length < v->v_alloc_length)
+            dvec_extend(v, v->v_length);
+    }
+
     fprintf(stderr, "\n");
     fprintf(stdout, "\nNo. of Data Rows : %d\n", run->pointCount);
 }
@@ -1194,33 +1390,94 @@ name_eq(char *n1, char *n2)
 }
 
 
+/* Look up the instance and parameter table entry, or else the
+ * statistic, of a special vector, so that getSpecial() need not search
+ * for them by name at every point.
+ */
+
+static void
+resolveSpecial(dataDesc *desc, runDesc *run)
+{
+    IFdevice *device;
+    IFparm *parm;
+    int i, options_idx;
+
+    desc->specParamId = -1;
+    desc->specStatId = -1;
+
+    if (!desc->specFast)
+        desc->specFast = ft_sim->findInstance (run->circuit, desc->specName);
+
+    if (desc->specFast) {
+        desc->specType = desc->specFast->GENmodPtr->GENmodType;
+        device = ft_sim->devices[desc->specType];
+        for (i = 0; i < *(device->numInstanceParms); i++) {
+            parm = &device->instanceParms[i];
+            if (strcmp(desc->specParamName, parm->keyword) == 0 &&
+                (parm->dataType & IF_ASK)) {
+                desc->specParamId = parm->id;
+                desc->specParamType = parm->dataType;
+                break;
+            }
+        }
+    }
+
+    options_idx = ft_find_analysis("options");
+    if (options_idx != -1) {
+        /* skip @ sign */
+        parm = ft_find_analysis_parm(options_idx, &desc->name[1]);
+        if (parm) {
+            desc->specStatId = parm->id;
+            desc->specStatType = parm->dataType & IF_VARTYPES;
+        }
+    }
+}
+
+
 static bool
 getSpecial(dataDesc *desc, runDesc *run, IFvalue *val)
 {
     IFvalue selector;
-    struct variable *vv;
 
-    selector.iValue = desc->specIndex;
-    if (INPaName(desc->specParamName, val, run->circuit, &desc->specType,
-                 desc->specName, &desc->specFast, ft_sim, &desc->type,
-                 &selector) == OK) {
-        desc->type &= (IF_REAL | IF_COMPLEX);   /* mask out other bits */
-        return TRUE;
+    if (desc->specParamId != -1) {
+        selector.iValue = desc->specIndex;
+        if (ft_sim->askInstanceQuest (run->circuit, desc->specFast,
+                                      desc->specParamId, val,
+                                      &selector) == OK) {
+            /* mask out other bits */
+            desc->type = desc->specParamType & (IF_REAL | IF_COMPLEX);
+            return TRUE;
+        }
     }
 
-    if ((vv = if_getstat(run->circuit, &desc->name[1])) != NULL) {
-        /* skip @ sign */
+    if (desc->specStatId != -1) {
+        IFvalue parm;
+
+        if (ft_sim->askAnalysisQuest (run->circuit,
+                                      &(ft_curckt->ci_curTask->taskOptions),
+                                      desc->specStatId, &parm, NULL) == -1)
+        {
+            /* skip @ sign */
+            fprintf(cp_err, "if_getstat: Internal Error: can't get %s\n",
+                    &desc->name[1]);
+            return FALSE;
+        }
+
         desc->type = IF_REAL;
-        if (vv->va_type == CP_REAL)
-            val->rValue = vv->va_real;
-        else if (vv->va_type == CP_NUM)
-            val->rValue = vv->va_num;
-        else if (vv->va_type == CP_BOOL)
-            val->rValue = (vv->va_bool ? 1.0 : 0.0);
-        else
+        switch (desc->specStatType) {
+        case IF_REAL:
+        case IF_COMPLEX:
+            val->rValue = parm.rValue;
+            return TRUE;
+        case IF_INTEGER:
+            val->rValue = parm.iValue;
+            return TRUE;
+        case IF_FLAG:
+            val->rValue = (parm.iValue ? 1.0 : 0.0);
+            return TRUE;
+        default:
             return FALSE; /* not a real */
-        tfree(vv);
-        return TRUE;
+        }
     }
 
     return FALSE;
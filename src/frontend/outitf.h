@@ -20,6 +20,10 @@ typedef struct dataDesc {
     int specIndex;              /* For sensitivity, if special. */
     int specType;
     GENinstance *specFast;
+    int specParamId;            /* The parameter id if special, else -1. */
+    int specParamType;          /* Its data type. */
+    int specStatId;             /* The statistic id if special, else -1. */
+    int specStatType;           /* Its data type. */
     int refIndex;               /* The index of our ref vector. */
     struct dvec *vec;
 } dataDesc;
@@ -36,6 +40,7 @@ struct runDesc {
     bool writeOut;
     bool windowed;
     bool binary;
+    bool columns;               /* binary data in chunks of columns */
     struct plot *runPlot;
     FILE *fp;
     long pointPos;              /* where to write pointCount */
@@ -58,6 +63,8 @@ int OUTwReference(void *plotPtr, IFvalue *valuePtr, void **refPtr);
 int OUTwData(runDesc *plotPtr, int dataIndex, IFvalue *valuePtr, void *refPtr);
 int OUTwEnd(runDesc *plotPtr);
 int OUTendPlot(runDesc *plotPtr);
+void OUTsnapSave(runDesc *plotPtr, CKTsnap *snap);
+int OUTsnapLoad(runDesc *plotPtr, CKTsnap *snap);
 int OUTbeginDomain(runDesc *plotPtr, IFuid refName, int refType, IFvalue *outerRefValue);
 int OUTendDomain(runDesc *plotPtr);
 int OUTattributes(runDesc *plotPtr, IFuid varName, int param, IFvalue *value);
@@ -387,6 +387,7 @@ com_write(wordlist *wl)
     static wordlist all = { "all", NULL, NULL };
     struct pnode *names;
     bool ascii = AsciiRawFile;
+    bool columns = FALSE;
     bool scalefound, appendwrite;
     struct plot *tpl, newplot;
 
@@ -400,7 +401,10 @@ com_write(wordlist *wl)
     if (cp_getvar("filetype", CP_STRING, buf)) {
         if (eq(buf, "binary"))
             ascii = FALSE;
-        else if (eq(buf, "ascii"))
+        else if (eq(buf, "columns")) {
+            ascii = FALSE;
+            columns = TRUE;
+        } else if (eq(buf, "ascii"))
             ascii = TRUE;
         else
             fprintf(cp_err, "Warning: strange file type %s\n", buf);
@@ -499,9 +503,9 @@ com_write(wordlist *wl)
         }
 
         if (ascii)
-            raw_write(file, &newplot, appendwrite, FALSE);
+            raw_write(file, &newplot, appendwrite, FALSE, FALSE);
         else
-            raw_write(file, &newplot, appendwrite, TRUE);
+            raw_write(file, &newplot, appendwrite, TRUE, columns);
 
         for (vv = newplot.pl_dvecs; vv;) {
             struct dvec *next_vv = vv->v_next;
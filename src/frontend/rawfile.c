@@ -5,6 +5,16 @@ Author: 1986 Wayne A. Christopher, U. C. Berkeley CAD Group
 
 /*
  * Read and write the ascii and binary rawfile formats.
+ *
+ * The binary data come either row by row ("Binary:"), or in chunks of
+ * 'chunksize' rows, each chunk holding one column after the other
+ * ("Columns: chunksize").  A column of the columnar format can be
+ * located from the header alone, without scanning the data.
+ *
+ * raw_read_mapped() maps padded binary data into memory instead of
+ * reading them.  The data of a vector are copied from the mapping by
+ * raw_loadvec() only when the vector is looked up.  The scale of a plot
+ * is copied right away, since many commands read pl_scale directly.
  */
 
 #include "ngspice/ngspice.h"
@@ -19,8 +29,32 @@ Author: 1986 Wayne A. Christopher, U. C. Berkeley CAD Group
 #include "variable.h"
 #include "../misc/misc_time.h"
 
+#if defined(HAVE_MMAP) && defined(HAVE_SYS_MMAN_H)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+/* binary data of a plot section mapped into memory */
+struct rawmap {
+    void *base;                 /* the mapping */
+    size_t size;
+    char *data;                 /* start of the data inside */
+    int nvars;
+    int npoints;
+    int chunksize;              /* rows per chunk, 1 for "Binary:" */
+    size_t width;               /* bytes per value */
+    int refs;                   /* vectors not loaded yet */
+};
+
 
 static void fixdims(struct dvec *v, char *s);
+static void raw_write_columns(FILE *fp, struct plot *pl, int length, bool realflag);
+static bool raw_read_columns(FILE *fp, struct plot *pl, int npoints, int flags, int chunksize);
+static bool raw_map_section(FILE *fp, struct plot *pl, int npoints, int flags, int chunksize);
+static struct plot *raw_read_file(char *name, bool mapped);
+static void raw_allocvecs(struct plot *pl);
+static void raw_copyvec(struct dvec *v);
 
 
 int raw_prec = -1;        /* How many sigfigs to use, default 15 (max).  */
@@ -36,7 +70,7 @@ int raw_prec = -1;        /* How many sigfigs to use, default 15 (max).  */
 /* Write a raw file.  We write everything in the plot pointed to. */
 
 void
-raw_write(char *name, struct plot *pl, bool app, bool binary)
+raw_write(char *name, struct plot *pl, bool app, bool binary, bool columns)
 {
     FILE *fp;
     bool realflag = TRUE, writedims;
@@ -50,7 +84,11 @@ raw_write(char *name, struct plot *pl, bool app, bool binary)
     char buf[BSIZE_SP];
     char *branch;
 
-    raw_padding = !cp_getvar("nopadding", CP_BOOL, NULL);
+    for (v = pl->pl_dvecs; v; v = v->v_next)
+        raw_loadvec(v);
+
+    /* columns are always padded */
+    raw_padding = columns || !cp_getvar("nopadding", CP_BOOL, NULL);
 
     /* Why bother printing out an empty plot? */
     if (!pl->pl_dvecs) {
@@ -194,7 +232,10 @@ raw_write(char *name, struct plot *pl, bool app, bool binary)
         (void) putc('\n', fp);
     }
 
-    if (binary) {
+    if (binary && columns) {
+        fprintf(fp, "Columns: %d\n", RAW_CHUNKSIZE);
+        raw_write_columns(fp, pl, length, realflag);
+    } else if (binary) {
         fprintf(fp, "Binary:\n");
         for (i = 0; i < length; i++) {
             for (v = pl->pl_dvecs; v; v = v->v_next) {
@@ -258,6 +299,56 @@ raw_write(char *name, struct plot *pl, bool app, bool binary)
 }
 
 
+/* Write the data of a "Columns:" section: chunks of RAW_CHUNKSIZE rows,
+ * the last one shorter, with the values of one vector after the other.
+ * Short vectors are padded with zeros.
+ */
+
+static void
+raw_write_columns(FILE *fp, struct plot *pl, int length, bool realflag)
+{
+    double *col = TMALLOC(double, 2 * RAW_CHUNKSIZE);
+    struct dvec *v;
+    int start, n, i, j, k;
+
+    for (start = 0; start < length; start += RAW_CHUNKSIZE) {
+        n = MIN(RAW_CHUNKSIZE, length - start);
+        for (v = pl->pl_dvecs; v; v = v->v_next) {
+            /* write directly from the vector if the layout fits */
+            if (start + n <= v->v_length) {
+                if (realflag && isreal(v)) {
+                    (void) fwrite(v->v_realdata + start, sizeof(double), (size_t) n, fp);
+                    continue;
+                } else if (!realflag && iscomplex(v)) {
+                    (void) fwrite(v->v_compdata + start, sizeof(ngcomplex_t), (size_t) n, fp);
+                    continue;
+                }
+            }
+            for (i = 0, k = 0; i < n; i++) {
+                j = start + i;
+                if (j >= v->v_length) {
+                    col[k++] = 0.0;
+                    if (!realflag)
+                        col[k++] = 0.0;
+                } else if (realflag) {
+                    col[k++] = isreal(v) ? v->v_realdata[j] :
+                        realpart(v->v_compdata[j]);
+                } else if (isreal(v)) {
+                    col[k++] = v->v_realdata[j];
+                    col[k++] = 0.0;
+                } else {
+                    col[k++] = realpart(v->v_compdata[j]);
+                    col[k++] = imagpart(v->v_compdata[j]);
+                }
+            }
+            (void) fwrite(col, sizeof(double), (size_t) k, fp);
+        }
+    }
+
+    tfree(col);
+}
+
+
 /* Read a raw file.  Returns a list of plot structures.  This routine should be
  * very flexible about what it expects to see in the rawfile.  Really all we
  * require is that there be one variables and one values section per plot
@@ -287,7 +378,24 @@ raw_write(char *name, struct plot *pl, bool app, bool binary)
 
 
 struct plot *
-raw_read(char *name) {
+raw_read(char *name)
+{
+    return raw_read_file(name, FALSE);
+}
+
+
+/* Read a raw file, mapping the binary data if possible */
+
+struct plot *
+raw_read_mapped(char *name)
+{
+    return raw_read_file(name, TRUE);
+}
+
+
+static struct plot *
+raw_read_file(char *name, bool mapped)
+{
     char *title = NULL;
     char *date = NULL;
     struct plot *plots = NULL, *curpl = NULL;
@@ -460,7 +568,12 @@ raw_read(char *name) {
                  */
                 v = dvec_alloc(NULL,
                                SV_NOTYPE, (short) flags,
-                               npoints, NULL);
+                               mapped ? 0 : npoints, NULL);
+                /* The data of a mapped file are allocated when
+                 * the vector is loaded, or by raw_allocvecs().
+                 */
+                if (mapped)
+                    v->v_length = v->v_alloc_length = npoints;
                 /* Length and dims might be changed by options. */
 
                 v->v_plot = curpl;
@@ -531,7 +644,8 @@ raw_read(char *name) {
                 curpl->pl_dvecs = v;
             }
 
-        } else if (ciprefix("values:", buf) || ciprefix("binary:", buf)) {
+        } else if (ciprefix("values:", buf) || ciprefix("binary:", buf) ||
+                   ciprefix("columns:", buf)) {
 
             if (!curpl) {
                 fprintf(cp_err, "Error: no plot name given\n");
@@ -569,6 +683,22 @@ raw_read(char *name) {
             else
                 is_ascii = FALSE;
 
+            if ((*buf == 'c') || (*buf == 'C')) {
+                s = SKIP(buf);
+                j = scannum(s);
+                if (mapped && raw_map_section(fp, curpl, npoints, flags, j))
+                    continue;
+                raw_allocvecs(curpl);
+                if (!raw_read_columns(fp, curpl, npoints, flags, j))
+                    return (NULL);
+                continue;
+            }
+
+            if (!is_ascii && raw_padded && mapped &&
+                raw_map_section(fp, curpl, npoints, flags, 1))
+                continue;
+            raw_allocvecs(curpl);
+
             for (i = 0; i < npoints; i++) {
                 if (is_ascii) {
                     /* It's an ASCII file. */
@@ -661,6 +791,215 @@ raw_read(char *name) {
 }
 
 
+/* Read the data of a "Columns:" section, see raw_write_columns().
+ * Rows beyond the length of a vector are skipped.
+ */
+
+static bool
+raw_read_columns(FILE *fp, struct plot *pl, int npoints, int flags, int chunksize)
+{
+    size_t width = (flags & VF_REAL) ? 1 : 2;
+    struct dvec *v;
+    int start, n, m;
+
+    if (chunksize < 1) {
+        fprintf(cp_err, "Error: bad rawfile, chunk size %d\n  load aborted\n",
+                chunksize);
+        return FALSE;
+    }
+
+    for (start = 0; start < npoints; start += chunksize) {
+        n = MIN(chunksize, npoints - start);
+        for (v = pl->pl_dvecs; v; v = v->v_next) {
+            m = MAX(0, MIN(n, v->v_length - start));
+            if (m > 0) {
+                double *data = (flags & VF_REAL) ? v->v_realdata + start :
+                    (double *) (v->v_compdata + start);
+                if (fread(data, width * sizeof(double), (size_t) m, fp) != (size_t) m)
+                    m = -1;
+            }
+            if (m >= 0 && m < n &&
+                fseek(fp, (long) ((size_t) (n - m) * width * sizeof(double)), SEEK_CUR))
+                m = -1;
+            if (m < 0) {
+                fprintf(cp_err,
+                        "Error: bad rawfile\n"
+                        "  point %d, var %s\n"
+                        "  load aborted\n",
+                        start, v->v_name);
+                return FALSE;
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+
+/* Map the binary data of a plot section, which start at the current
+ * position of fp, and skip them.  Returns FALSE if the data have to be
+ * read instead.
+ */
+
+static bool
+raw_map_section(FILE *fp, struct plot *pl, int npoints, int flags, int chunksize)
+{
+#if defined(HAVE_MMAP) && defined(HAVE_SYS_MMAN_H)
+    struct rawmap *map;
+    struct dvec *v;
+    size_t width = ((flags & VF_REAL) ? 1 : 2) * sizeof(double);
+    size_t bytes, offset, page;
+    long start, end;
+    void *base;
+    int nvars, i;
+
+    for (nvars = 0, v = pl->pl_dvecs; v; v = v->v_next)
+        nvars++;
+
+    if (nvars == 0 || npoints < 1 || chunksize < 1)
+        return FALSE;
+
+    /* a short file is left to the reading code to complain about */
+    bytes = (size_t) npoints * (size_t) nvars * width;
+    start = ftell(fp);
+    if (start < 0)
+        return FALSE;
+    if (fseek(fp, 0, SEEK_END) || (end = ftell(fp)) < 0 ||
+        (size_t) (end - start) < bytes) {
+        fseek(fp, start, SEEK_SET);
+        return FALSE;
+    }
+
+    /* the mapping has to start at a page boundary */
+    page = (size_t) sysconf(_SC_PAGESIZE);
+    offset = (size_t) start - (size_t) start % page;
+    base = mmap(NULL, (size_t) start - offset + bytes, PROT_READ, MAP_PRIVATE,
+                fileno(fp), (off_t) offset);
+    if (base == MAP_FAILED) {
+        fseek(fp, start, SEEK_SET);
+        return FALSE;
+    }
+
+    map = TMALLOC(struct rawmap, 1);
+    map->base = base;
+    map->size = (size_t) start - offset + bytes;
+    map->data = (char *) base + ((size_t) start - offset);
+    map->nvars = nvars;
+    map->npoints = npoints;
+    map->chunksize = chunksize;
+    map->width = width;
+    map->refs = 0;
+
+    for (i = 0, v = pl->pl_dvecs; v; i++, v = v->v_next) {
+        if (v->v_length < 1)
+            continue;
+        v->v_rawmap = map;
+        v->v_rawcol = i;
+        map->refs++;
+    }
+
+    if (map->refs == 0) {
+        munmap(map->base, map->size);
+        tfree(map);
+    }
+
+    /* fft, spec, linearize and others use the scale without looking it up */
+    if (pl->pl_scale && pl->pl_scale->v_rawmap)
+        raw_copyvec(pl->pl_scale);
+
+    fseek(fp, start + (long) bytes, SEEK_SET);
+    return TRUE;
+#else
+    NG_IGNORE(fp);
+    NG_IGNORE(pl);
+    NG_IGNORE(npoints);
+    NG_IGNORE(flags);
+    NG_IGNORE(chunksize);
+    return FALSE;
+#endif
+}
+
+
+/* allocate the data of vectors read by raw_read_mapped(), if their
+ * section could not be mapped
+ */
+
+static void
+raw_allocvecs(struct plot *pl)
+{
+    struct dvec *v;
+
+    for (v = pl->pl_dvecs; v; v = v->v_next)
+        if (v->v_alloc_length > 0 && !v->v_realdata && !v->v_compdata) {
+            if (isreal(v))
+                v->v_realdata = TMALLOC(double, v->v_alloc_length);
+            else
+                v->v_compdata = TMALLOC(ngcomplex_t, v->v_alloc_length);
+        }
+}
+
+
+/* release a vector's reference to a mapping */
+
+void
+raw_unmap(struct rawmap *map)
+{
+    if (--map->refs > 0)
+        return;
+
+#if defined(HAVE_MMAP) && defined(HAVE_SYS_MMAN_H)
+    munmap(map->base, map->size);
+#endif
+    tfree(map);
+}
+
+
+static void
+raw_copyvec(struct dvec *v)
+{
+    struct rawmap *map = v->v_rawmap;
+    char *data;
+    size_t n, m;
+    int start;
+
+    if (isreal(v)) {
+        v->v_realdata = TMALLOC(double, v->v_alloc_length);
+        data = (char *) v->v_realdata;
+    } else {
+        v->v_compdata = TMALLOC(ngcomplex_t, v->v_alloc_length);
+        data = (char *) v->v_compdata;
+    }
+
+    for (start = 0; start < v->v_length; start += map->chunksize) {
+        n = (size_t) MIN(map->chunksize, map->npoints - start);
+        m = MIN(n, (size_t) (v->v_length - start));
+        memcpy(data + (size_t) start * map->width,
+               map->data + ((size_t) start * (size_t) map->nvars +
+                            (size_t) v->v_rawcol * n) * map->width,
+               m * map->width);
+    }
+
+    v->v_rawmap = NULL;
+    raw_unmap(map);
+}
+
+
+/* Load the data of a vector, and of its scale, if they are still in a
+ * mapped rawfile.
+ */
+
+void
+raw_loadvec(struct dvec *v)
+{
+    if (v->v_rawmap)
+        raw_copyvec(v);
+    if (v->v_scale && v->v_scale->v_rawmap)
+        raw_copyvec(v->v_scale);
+    if (v->v_plot && v->v_plot->pl_scale && v->v_plot->pl_scale->v_rawmap)
+        raw_copyvec(v->v_plot->pl_scale);
+}
+
+
 /* s is a string of the form d1,d2,d3... */
 
 static void
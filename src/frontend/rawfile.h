@@ -6,7 +6,8 @@
 #ifndef ngspice_RAWFILE_H
 #define ngspice_RAWFILE_H
 
-
+/* rows per chunk of the columnar binary format ("Columns:" section) */
+#define RAW_CHUNKSIZE 4096
 
 
 #endif
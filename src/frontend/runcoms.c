@@ -43,6 +43,7 @@ extern struct dbcomm *dbs;
 
 FILE *rawfileFp;
 bool rawfileBinary;
+bool rawfileColumns;
 #define RAWBUF_SIZE 32768
 char rawfileBuf[RAWBUF_SIZE];
 /*To tell resume the rawfile name saj*/
@@ -203,6 +204,7 @@ dosim(
     /* set file type to binary or to what is given by environmental
        variable SPICE_ASCIIRAWFILE in ivars.c */
     bool ascii = AsciiRawFile;
+    bool columns = FALSE;
     if (eq(what, "run") && wl)
         dofile = TRUE;
     /* add "what" to beginning of wordlist wl, except "what" equals "run"
@@ -214,7 +216,10 @@ dosim(
     if (cp_getvar("filetype", CP_STRING, buf)) {
         if (eq(buf, "binary"))
             ascii = FALSE;
-        else if (eq(buf, "ascii"))
+        else if (eq(buf, "columns")) {
+            ascii = FALSE;
+            columns = TRUE;
+        } else if (eq(buf, "ascii"))
             ascii = TRUE;
         else {
             fprintf(cp_err,
@@ -285,6 +290,7 @@ dosim(
         }
 #endif /* __MINGW32__ */
         rawfileBinary = !ascii;
+        rawfileColumns = columns;
     } else {
         rawfileFp = NULL;
     }
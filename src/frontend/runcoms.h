@@ -23,6 +23,7 @@ void com_run(wordlist *wl);
 
 extern FILE *rawfileFp;
 extern bool rawfileBinary;
+extern bool rawfileColumns;
 extern char *last_used_rawfile;
 extern bool resumption;
 
@@ -60,6 +60,7 @@ com_resume(wordlist *wl)
     bool dofile = FALSE;
     char buf[BSIZE_SP];
     bool ascii = AsciiRawFile;
+    bool columns = FALSE;
     /*end saj*/
 
     NG_IGNORE(wl);
@@ -94,7 +95,10 @@ com_resume(wordlist *wl)
     if (cp_getvar("filetype", CP_STRING, buf)) {
         if (eq(buf, "binary"))
             ascii = FALSE;
-        else if (eq(buf, "ascii"))
+        else if (eq(buf, "columns")) {
+            ascii = FALSE;
+            columns = TRUE;
+        } else if (eq(buf, "ascii"))
             ascii = TRUE;
         else
             fprintf(cp_err,
@@ -131,6 +135,7 @@ com_resume(wordlist *wl)
         }
 #endif
         rawfileBinary = !ascii;
+        rawfileColumns = columns;
     } else {
         rawfileFp = NULL;
     } /* if dofile */
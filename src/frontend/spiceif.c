@@ -54,11 +54,26 @@ CDHW*/
 #include "ngspice/inpdefs.h"
 #include "ngspice/iferrmsg.h"
 #include "ngspice/ifsim.h"
+#include "ngspice/trandefs.h"
 
 #include "circuits.h"
+#include "outitf.h"
 #include "spiceif.h"
 #include "variable.h"
 
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+#ifdef HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
 
 #ifdef XSPICE
 #include "ngspice/evt.h"
@@ -1313,395 +1328,431 @@ if_getstat(CKTcircuit *ckt, char *name)
 }
 
 
-/* Some small updates to make it work, h_vogt, Feb. 2012
-   Still very experimental !
-   It is now possible to save a state during transient simulation,
-   reload it later into a new ngspice run and resume simulation.
-   XSPICE code models probably will not do.
-   LTRA transmission line will not do.
-   Many others are not tested.
+/* Snapshots of a transient analysis.
+
+   snsave writes the state of a paused transient analysis to a file.
+   snload sources the same circuit in another run of ngspice, maybe of
+   another build or on another machine, takes the state over, and a
+   'resume' goes on from there.  With 'set snapfile=<file>' and
+   'set snapinterval=<time>' a snapshot is written whenever <time> of
+   simulated time has passed, so that a long run which is killed on the
+   way can be resumed from the last one.
+
+   cktsnap.c writes and reads the file and the state of the circuit,
+   here the analysis and the plot are added.  The event queues of
+   XSPICE code models are not covered, so circuits with 'A' devices are
+   refused.
 */
 
-#include "ngspice/cktdefs.h"
-#include "ngspice/trandefs.h"
+/* the periodic snapshots are written by a child process, the parent
+   goes on with the analysis meanwhile */
+#if defined(HAVE_WORKING_FORK) && defined(HAVE_SYS_WAIT_H) && \
+    defined(HAVE_FCNTL_H) && !defined(SHARED_MODULE) && !defined(_WIN32)
+#define SNAPSHOT_FORK
+#endif
 
-/* arg0: circuit file, arg1: data file */
-void com_snload(wordlist *wl)
+
+/* the transient analysis of 'ckt', NULL if no snapshot of it can be
+   written */
+
+static TRANan *
+snapshot_job(CKTcircuit *ckt)
 {
-    int error = 0;
-    FILE *file;
-    int tmpI, i, size;
-    CKTcircuit *my_ckt, *ckt;
+    JOB *job = ckt->CKTcurJob;
 
-    /*
-      Pseudo code:
+#ifdef XSPICE
+    if (ckt->CKTadevFlag == 1) {
+        fprintf(cp_err, "Error: snapshots do not cover XSPICE 'A' devices\n");
+        return NULL;
+    }
+#endif
 
-      source(file_name);
-      This should setup all the device structs, voltage nodes, etc.
+    if (!job || job->JOBtype != ft_find_analysis("TRAN")) {
+        fprintf(cp_err, "Error: only a transient analysis can be saved\n");
+        return NULL;
+    }
 
-      call cktsetup;
-      This is needed to setup vector mamory allocation for vectors and branch nodes
+    if (CKTsnapCheck(ckt) != OK)
+        return NULL;
 
-      load_binary_data(info);
-      Overwrite the allocated numbers, rhs etc, with saved data
-    */
+    return (TRANan *) job;
+}
 
 
-    if (ft_curckt && !strstr(ft_curckt->ci_name, "script")) {
-        /* Circuit, not a script */
-        fprintf(cp_err, "Error: there is already a circuit loaded.\n");
-        return;
-    }
+/* Build the snapshot of the transient analysis 'job' of 'ckt' in
+   memory, return FALSE if that failed. */
 
-    /* source the circuit */
-    inp_source(wl->wl_word);
-    if (!ft_curckt)
-        return;
+static bool
+snapshot_make(CKTsnap *snap, CKTcircuit *ckt, TRANan *job)
+{
+    double value[5];
 
-    /* allocate all the vectors, with luck!  */
-    if (!error)
-        error = CKTsetup(ft_curckt->ci_ckt);
-    if (!error)
-        error = CKTtemp(ft_curckt->ci_ckt);
+    CKTsnapBegin(snap);
 
-    if (error) {
-        fprintf(cp_err, "Some error in the CKT setup fncts!\n");
-        return;
-    }
+    value[0] = job->TRANfinalTime;
+    value[1] = job->TRANstep;
+    value[2] = job->TRANmaxStep;
+    value[3] = job->TRANinitTime;
+    value[4] = (double) job->TRANmode;
+    CKTsnapPut(snap, "tran", value, 5);
 
-    /* so it resumes ... */
-    ft_curckt->ci_inprogress = TRUE;
+#ifdef XSPICE
+    value[0] = ckt->enh->breakpoint.current;
+    value[1] = ckt->enh->breakpoint.last;
+    CKTsnapPut(snap, "breakpoint", value, 2);
+#endif
 
-    /* now load the binary file */
-    ckt = ft_curckt->ci_ckt;
+    if (job->TRANplot)
+        OUTsnapSave(job->TRANplot, snap);
 
-    file = fopen(wl->wl_next->wl_word, "rb");
+    CKTsnapSave(ckt, snap);
 
-    if (!file) {
-        fprintf(cp_err, "Error: Couldn't open \"%s\" for reading\n", wl->wl_next->wl_word);
-        return;
+    return !CKTsnapEnd(snap);
+}
+
+
+/* Write 'len' bytes of 'buf' to 'tmp' and rename it to 'file' when it is
+   complete, so that 'file' always holds a whole snapshot.  With
+   SNAPSHOT_FORK this runs in the child forked by if_snapshot(), where
+   another thread of the parent may have held the locks of malloc or
+   stdio, so only system calls are used. */
+
+#ifdef SNAPSHOT_FORK
+
+static bool
+snapshot_file(const char *file, const char *tmp, const char *buf, size_t len)
+{
+    ssize_t n;
+    int fd;
+
+    fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd < 0)
+        return FALSE;
+
+    while (len > 0) {
+        n = write(fd, buf, len);
+        if (n < 0) {
+            close(fd);
+            unlink(tmp);
+            return FALSE;
+        }
+        buf += n;
+        len -= (size_t) n;
     }
 
-    fread(&tmpI, sizeof(int), 1, file);
-    if (tmpI != sizeof(CKTcircuit)) {
-        fprintf(cp_err, "loaded num: %d, expected num: %ld\n", tmpI, (long)sizeof(CKTcircuit));
-        fprintf(cp_err, "Error: snapshot saved with different version of spice\n");
-        fclose(file);
-        return;
+    if (close(fd) || rename(tmp, file)) {
+        unlink(tmp);
+        return FALSE;
     }
 
-    my_ckt = TMALLOC(CKTcircuit, 1);
-
-    fread(my_ckt, sizeof(CKTcircuit), 1, file);
-
-#define _t(name) ckt->name = my_ckt->name
-#define _ta(name, size)                                                 \
-    do { int __i; for (__i = 0; __i < size; __i++) _t(name[__i]); } while(0)
-
-    _t(CKTtime);
-    _t(CKTdelta);
-    _ta(CKTdeltaOld, 7);
-    _t(CKTtemp);
-    _t(CKTnomTemp);
-    _t(CKTvt);
-    _ta(CKTag, 7);
-
-    _t(CKTorder);
-    _t(CKTmaxOrder);
-    _t(CKTintegrateMethod);
-    _t(CKTxmu);
-    _t(CKTindverbosity);
-    _t(CKTepsmin);
-
-    _t(CKTniState);
-
-    _t(CKTmaxEqNum);
-    _t(CKTcurrentAnalysis);
-
-    _t(CKTnumStates);
-    _t(CKTmode);
-
-    _t(CKTbypass);
-    _t(CKTdcMaxIter);
-    _t(CKTdcTrcvMaxIter);
-    _t(CKTtranMaxIter);
-    _t(CKTbreakSize);
-    _t(CKTbreak);
-    _t(CKTsaveDelta);
-    _t(CKTminBreak);
-    _t(CKTabstol);
-    _t(CKTpivotAbsTol);
-    _t(CKTpivotRelTol);
-    _t(CKTreltol);
-    _t(CKTchgtol);
-    _t(CKTvoltTol);
-
-    _t(CKTgmin);
-    _t(CKTgshunt);
-    _t(CKTdelmin);
-    _t(CKTtrtol);
-    _t(CKTfinalTime);
-    _t(CKTstep);
-    _t(CKTmaxStep);
-    _t(CKTinitTime);
-    _t(CKTomega);
-    _t(CKTsrcFact);
-    _t(CKTdiagGmin);
-    _t(CKTnumSrcSteps);
-    _t(CKTnumGminSteps);
-    _t(CKTgminFactor);
-    _t(CKTnoncon);
-    _t(CKTdefaultMosM);
-    _t(CKTdefaultMosL);
-    _t(CKTdefaultMosW);
-    _t(CKTdefaultMosAD);
-    _t(CKTdefaultMosAS);
-    _t(CKThadNodeset);
-    _t(CKTfixLimit);
-    _t(CKTnoOpIter);
-    _t(CKTisSetup);
-#ifdef XSPICE
-    _t(CKTadevFlag);
+    return TRUE;
+}
+
+#else
+
+static bool
+snapshot_file(const char *file, const char *tmp, const char *buf, size_t len)
+{
+    FILE *fp;
+    int error;
+
+    fp = fopen(tmp, "wb");
+    if (!fp)
+        return FALSE;
+
+    error = fwrite(buf, 1, len, fp) != len;
+    if (fclose(fp))
+        error = 1;
+
+#ifdef _WIN32
+    /* rename() does not replace a file here */
+    if (!error)
+        remove(file);
 #endif
-    _t(CKTtimeListSize);
-    _t(CKTtimeIndex);
-    _t(CKTsizeIncr);
-
-    _t(CKTtryToCompact);
-    _t(CKTbadMos3);
-    _t(CKTkeepOpInfo);
-    _t(CKTcopyNodesets);
-    _t(CKTnodeDamping);
-    _t(CKTabsDv);
-    _t(CKTrelDv);
-    _t(CKTtroubleNode);
-
-#undef _foo
-#define _foo(name, type, _size)                                         \
-    do {                                                                \
-        int __i;                                                        \
-        fread(&__i, sizeof(int), 1, file);                              \
-        if (__i) {                                                      \
-            if (name)                                                   \
-                tfree(name);                                            \
-            name = (type *)tmalloc((size_t) __i);                       \
-            fread(name, 1, (size_t) __i, file);                         \
-        } else {                                                        \
-            fprintf(cp_err, "size for vector " #name " is 0\n");        \
-        }                                                               \
-        if ((_size) != -1 && __i != (_size) * (int)sizeof(type)) {      \
-            fprintf(cp_err, "expected %ld, but got %d for "#name"\n", (_size)*(long)sizeof(type), __i); \
-        }                                                               \
-    } while(0)
-
-
-    for (i = 0; i <= ckt->CKTmaxOrder+1; i++)
-        _foo(ckt->CKTstates[i], double, ckt->CKTnumStates);
-
-    size = SMPmatSize(ckt->CKTmatrix) + 1;
-    _foo(ckt->CKTrhs, double, size);
-    _foo(ckt->CKTrhsOld, double, size);
-    _foo(ckt->CKTrhsSpare, double, size);
-    _foo(ckt->CKTirhs, double, size);
-    _foo(ckt->CKTirhsOld, double, size);
-    _foo(ckt->CKTirhsSpare, double, size);
-//    _foo(ckt->CKTrhsOp, double, size);
-//    _foo(ckt->CKTsenRhs, double, size);
-//    _foo(ckt->CKTseniRhs, double, size);
-
-//    _foo(ckt->CKTtimePoints, double, -1);
-//    _foo(ckt->CKTdeltaList, double, -1);
-
-    _foo(ckt->CKTbreaks, double, ckt->CKTbreakSize);
-
-    {   /* avoid invalid lvalue assignment errors in the macro _foo() */
-        TSKtask *lname = NULL;
-        _foo(lname, TSKtask, 1);
-        ft_curckt->ci_curTask = lname;
-    }
+    if (!error && rename(tmp, file))
+        error = 1;
+    if (error)
+        remove(tmp);
 
-    /* To stop the Free */
-    ft_curckt->ci_curTask->TSKname = NULL;
-    ft_curckt->ci_curTask->jobs = NULL;
+    return !error;
+}
 
-    _foo(ft_curckt->ci_curTask->TSKname, char, -1);
+#endif
 
-    {
-        TRANan *lname = NULL;
-        _foo(lname, TRANan, -1);
-        ft_curckt->ci_curTask->jobs = (JOB *)lname;
+
+/* write the snapshot of 'job' to 'file' */
+
+static bool
+snapshot_write(char *file, CKTcircuit *ckt, TRANan *job)
+{
+    char *tmp = tprintf("%s.tmp", file);
+    CKTsnap snap;
+    bool ok;
+
+    ok = snapshot_make(&snap, ckt, job) &&
+        snapshot_file(file, tmp, snap.buf, snap.len);
+
+    CKTsnapFree(&snap);
+    tfree(tmp);
+    return ok;
+}
+
+
+/* Write the snapshot asked for by 'snapfile' if 'snapinterval' has
+   passed since the last one.  Called by the transient analysis after
+   each accepted timepoint. */
+
+void
+if_snapshot(CKTcircuit *ckt)
+{
+    static CKTcircuit *last_ckt = NULL;
+    static double last_time, next_time;
+#ifdef SNAPSHOT_FORK
+    static pid_t writer = 0;
+    int status;
+#endif
+    char file[BSIZE_SP];
+    double interval;
+    TRANan *job;
+
+    if (!cp_getvar("snapfile", CP_STRING, file) ||
+        !cp_getvar("snapinterval", CP_REAL, &interval) || interval <= 0.0)
+        return;
+
+    /* a new or restarted analysis starts a new series */
+    if (ckt != last_ckt || ckt->CKTtime < last_time) {
+        last_ckt = ckt;
+        next_time = (floor(ckt->CKTtime / interval) + 1) * interval;
     }
-    ft_curckt->ci_curTask->jobs->JOBname = NULL;
-    _foo(ft_curckt->ci_curTask->jobs->JOBname, char, -1);
-    ft_curckt->ci_curTask->jobs->JOBnextJob = NULL;
-    ckt->CKTcurJob = ft_curckt->ci_curTask->jobs;
-    ((TRANan *)ft_curckt->ci_curTask->jobs)->TRANplot = NULL;
+    last_time = ckt->CKTtime;
 
-    _foo(ckt->CKTstat, STATistics, 1);
-    ckt->CKTstat->STATdevNum = NULL;
-    _foo(ckt->CKTstat->STATdevNum, STATdevList, -1);
+#ifdef SNAPSHOT_FORK
+    if (writer > 0 && waitpid(writer, &status, WNOHANG) == writer) {
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            fprintf(cp_err, "Warning: couldn't write snapshot to \"%s\"\n", file);
+        writer = 0;
+    }
+#endif
 
-#ifdef XSPICE
-    _foo(ckt->evt, Evt_Ckt_Data_t, 1);
-    _foo(ckt->enh, Enh_Ckt_Data_t, 1);
-    g_mif_info.breakpoint.current = ckt->enh->breakpoint.current;
-    g_mif_info.breakpoint.last = ckt->enh->breakpoint.last;
+    if (ckt->CKTtime < next_time)
+        return;
+
+#ifdef SNAPSHOT_FORK
+    /* the last one is still being written, try at the next timepoint */
+    if (writer > 0)
+        return;
 #endif
 
-    tfree(my_ckt);
-    fclose(file);
+    job = snapshot_job(ckt);
+    if (!job) {
+        /* no more tries in this series */
+        next_time = HUGE_VAL;
+        return;
+    }
 
-    /* Finally to resume the plot in some fashion */
+    next_time = (floor(ckt->CKTtime / interval) + 1) * interval;
 
-    /* a worked out version of this should be enough */
+#ifdef SNAPSHOT_FORK
+    /* The parent may run OpenMP threads, so the child must not call
+       malloc or stdio.  It gets the snapshot built already and only
+       writes it out. */
     {
-        IFuid *nameList;
-        int numNames;
-        IFuid timeUid;
-
-        error = CKTnames(ckt, &numNames, &nameList);
-        if (error) {
-            fprintf(cp_err, "error in CKTnames\n");
-            return;
-        }
-        SPfrontEnd->IFnewUid (ckt, &timeUid, NULL, "time", UID_OTHER, NULL);
-        error = SPfrontEnd->OUTpBeginPlot (ckt, ckt->CKTcurJob,
-                                           ckt->CKTcurJob->JOBname,
-                                           timeUid, IF_REAL,
-                                           numNames, nameList, IF_REAL,
-                                           &(((TRANan*)ckt->CKTcurJob)->TRANplot));
-        if (error) {
-            fprintf(cp_err, "error in CKTnames\n");
-            return;
+        char *tmp = tprintf("%s.tmp", file);
+        CKTsnap snap;
+        bool ok = snapshot_make(&snap, ckt, job);
+
+        if (ok) {
+            writer = fork();
+            if (writer == 0)
+                _exit(snapshot_file(file, tmp, snap.buf, snap.len) ? 0 : 1);
+            if (writer < 0) {
+                /* no child, write it here */
+                writer = 0;
+                ok = snapshot_file(file, tmp, snap.buf, snap.len);
+            }
         }
+
+        CKTsnapFree(&snap);
+        tfree(tmp);
+
+        if (!ok)
+            fprintf(cp_err, "Warning: couldn't write snapshot to \"%s\"\n", file);
     }
+#else
+    if (!snapshot_write(file, ckt, job))
+        fprintf(cp_err, "Warning: couldn't write snapshot to \"%s\"\n", file);
+#endif
 }
 
 
-void com_snsave(wordlist *wl)
+void com_snload(wordlist *wl)
 {
-    FILE *file;
-    int i, size;
+    char *name = wl->wl_next->wl_word;
     CKTcircuit *ckt;
-    TSKtask *task;
+    CKTsnap snap;
+    JOB *job;
+    TRANan *tran;
+    IFuid uid, timeUid, *nameList;
+    double *value;
+    int error, numNames;
+    FILE *file;
 
-    if (!ft_curckt) {
-        fprintf(cp_err, "Error: there is no circuit loaded.\n");
+    if (ft_curckt && !strstr(ft_curckt->ci_name, "script")) {
+        /* Circuit, not a script */
+        fprintf(cp_err, "Error: there is already a circuit loaded.\n");
         return;
-    } else if (!ft_curckt->ci_ckt) { /* Set noparse? */
-        fprintf(cp_err, "Error: circuit not parsed.\n");
+    }
+
+    /* read the whole snapshot before the circuit is touched */
+    file = fopen(name, "rb");
+    if (!file) {
+        fprintf(cp_err, "Error: Couldn't open \"%s\" for reading\n", name);
         return;
     }
+    error = CKTsnapRead(&snap, file);
+    fclose(file);
 
-    /* save the data */
+    value = CKTsnapGet(&snap, "tran", 5);
+    if (error == E_BADPARM) {
+        fprintf(cp_err, "Error: \"%s\" is not a snapshot of this format\n", name);
+        CKTsnapFree(&snap);
+        return;
+    } else if (error || !value) {
+        fprintf(cp_err, "Error: snapshot file \"%s\" is truncated or damaged\n", name);
+        CKTsnapFree(&snap);
+        return;
+    }
 
+    /* source the circuit */
+    inp_source(wl->wl_word);
+    if (!ft_curckt) {
+        CKTsnapFree(&snap);
+        return;
+    }
     ckt = ft_curckt->ci_ckt;
 
+    /* allocate all the vectors, with luck!  */
+    error = CKTsetup(ckt);
+    if (!error)
+        error = CKTtemp(ckt);
+    if (error) {
+        fprintf(cp_err, "Some error in the CKT setup fncts!\n");
+        CKTsnapFree(&snap);
+        return;
+    }
+
 #ifdef XSPICE
     if (ckt->CKTadevFlag == 1) {
-        fprintf(cp_err, "Warning: snsave not implemented for XSPICE A devices.\n");
-        fprintf(cp_err, "    Command 'snsave' will be ingnored!\n");
+        fprintf(cp_err, "Error: snapshots do not cover XSPICE 'A' devices\n");
+        CKTsnapFree(&snap);
         return;
     }
 #endif
 
-    task = ft_curckt->ci_curTask;
-
-    if (task->jobs->JOBtype != 4) {
-        fprintf(cp_err, "Only saving of tran analysis is implemented\n");
+    if (CKTsnapCheck(ckt) != OK) {
+        CKTsnapFree(&snap);
         return;
     }
 
-    file = fopen(wl->wl_word, "wb");
-
-    if (!file) {
-        fprintf(cp_err,
-                "Error: Couldn't open \"%s\" for writing\n", wl->wl_word);
+    /* a task of the saved transient analysis alone, which 'resume' runs */
+    error = IFnewUid(ckt, &uid, NULL, "special", UID_TASK, NULL);
+    if (!error)
+        error = ft_sim->newTask (ckt, &(ft_curckt->ci_specTask), uid,
+                                 &(ft_curckt->ci_defTask));
+    if (!error)
+        error = IFnewUid(ckt, &uid, NULL, "Transient Analysis", UID_ANALYSIS, NULL);
+    if (!error)
+        error = ft_sim->newAnalysis (ckt, ft_find_analysis("TRAN"), uid, &job,
+                                     ft_curckt->ci_specTask);
+    if (error) {
+        ft_sperror(error, "snload");
+        CKTsnapFree(&snap);
         return;
     }
 
-#undef _foo
-#define _foo(name, type, num)                                           \
-    do {                                                                \
-        int __i;                                                        \
-        if (name) {                                                     \
-            __i = (num) * (int)sizeof(type); fwrite(&__i, sizeof(int), 1, file); \
-            if ((num))                                                  \
-                fwrite(name, sizeof(type), (size_t)(num), file);        \
-        } else {                                                        \
-            __i = 0;                                                    \
-            fprintf(cp_err, #name " is NULL, zero written\n");          \
-            fwrite(&__i, sizeof(int), 1, file);                         \
-        }                                                               \
-    } while(0)
-
-
-    _foo(ckt, CKTcircuit, 1);
-
-    /* To save list
-
-       double *(CKTstates[8]);
-       double *CKTrhs;
-       double *CKTrhsOld;
-       double *CKTrhsSpare;
-       double *CKTirhs;
-       double *CKTirhsOld;
-       double *CKTirhsSpare;
-       double *CKTrhsOp;
-       double *CKTsenRhs;
-       double *CKTseniRhs;
-       double *CKTtimePoints;       list of all accepted timepoints in
-       the current transient simulation
-       double *CKTdeltaList;        list of all timesteps in the
-       current transient simulation
+    ft_curckt->ci_curTask = ft_curckt->ci_specTask;
+    ft_curckt->ci_curOpt = ft_curckt->ci_defOpt;
 
-    */
+    tran = (TRANan *) job;
+    tran->TRANfinalTime = value[0];
+    tran->TRANstep = value[1];
+    tran->TRANmaxStep = value[2];
+    tran->TRANinitTime = value[3];
+    tran->TRANmode = (long) value[4];
 
+    error = CKTsnapLoad(ckt, &snap);
+    if (error) {
+        fprintf(cp_err,
+                "Error: snapshot \"%s\" does not fit the circuit,\n"
+                "    a run starts from the beginning\n", name);
+        CKTsnapFree(&snap);
+        return;
+    }
 
-    for (i = 0; i <= ckt->CKTmaxOrder+1; i++)
-        _foo(ckt->CKTstates[i], double, ckt->CKTnumStates);
+#ifdef XSPICE
+    value = CKTsnapGet(&snap, "breakpoint", 2);
+    if (value) {
+        g_mif_info.breakpoint.current = ckt->enh->breakpoint.current = value[0];
+        g_mif_info.breakpoint.last = ckt->enh->breakpoint.last = value[1];
+    }
+#endif
 
+    /* the plot goes on from the last point saved */
+    ckt->CKTcurJob = job;
+    error = CKTnames(ckt, &numNames, &nameList);
+    if (!error) {
+        SPfrontEnd->IFnewUid (ckt, &timeUid, NULL, "time", UID_OTHER, NULL);
+        error = SPfrontEnd->OUTpBeginPlot (ckt, job, job->JOBname,
+                                           timeUid, IF_REAL,
+                                           numNames, nameList, IF_REAL,
+                                           &(tran->TRANplot));
+        tfree(nameList);
+    }
+    if (error) {
+        ft_sperror(error, "snload");
+        CKTsnapFree(&snap);
+        return;
+    }
 
-    size = SMPmatSize(ckt->CKTmatrix) + 1;
+    if (OUTsnapLoad(tran->TRANplot, &snap) != OK)
+        fprintf(cp_err,
+                "Warning: the points plotted before %g are not in the snapshot\n",
+                ckt->CKTtime);
 
-    _foo(ckt->CKTrhs, double, size);
-    _foo(ckt->CKTrhsOld, double, size);
-    _foo(ckt->CKTrhsSpare, double, size);
-    _foo(ckt->CKTirhs, double, size);
-    _foo(ckt->CKTirhsOld, double, size);
-    _foo(ckt->CKTirhsSpare, double, size);
-//    _foo(ckt->CKTrhsOp, double, size);
-//    _foo(ckt->CKTsenRhs, double, size);
-//    _foo(ckt->CKTseniRhs, double, size);
+    CKTsnapFree(&snap);
 
-//    _foo(ckt->CKTtimePoints, double, ckt->CKTtimeListSize);
-//    _foo(ckt->CKTdeltaList, double, ckt->CKTtimeListSize);
+    /* so it resumes ... */
+    ft_curckt->ci_inprogress = TRUE;
+    fprintf(stdout, "Snapshot loaded from %s, resume at time %g.\n", name, ckt->CKTtime);
+}
 
-    /* need to save the breakpoints, or something */
-    _foo(ckt->CKTbreaks, double, ckt->CKTbreakSize);
 
-    /* now save the TSK struct, ft_curckt->ci_curTask*/
-    _foo(task, TSKtask, 1);
-    _foo(task->TSKname, char, ((int)strlen(task->TSKname)+1));
+void com_snsave(wordlist *wl)
+{
+    CKTcircuit *ckt;
+    TRANan *job;
 
-    /* now save the JOB struct task->jobs */
-    /* lol, only allow one job, tough! */
-    /* Note that JOB is a base class, need to save actual type!! */
-    _foo(task->jobs, TRANan, 1);
-    _foo(task->jobs->JOBname, char, ((int)strlen(task->jobs->JOBname)+1));
+    if (!ft_curckt) {
+        fprintf(cp_err, "Error: there is no circuit loaded.\n");
+        return;
+    } else if (!ft_curckt->ci_ckt) { /* Set noparse? */
+        fprintf(cp_err, "Error: circuit not parsed.\n");
+        return;
+    } else if (!ft_curckt->ci_inprogress) {
+        fprintf(cp_err, "Error: there is no paused analysis to save.\n");
+        return;
+    }
 
-    /* Finally the stats */
-    _foo(ckt->CKTstat, STATistics, 1);
-    _foo(ckt->CKTstat->STATdevNum, STATdevList, 1);
+    ckt = ft_curckt->ci_ckt;
 
-#ifdef XSPICE
-    /* FIXME struct ckt->evt->data and others are not stored
-       thus snsave, snload not compatible with XSPICE code models*/
-    _foo(ckt->evt, Evt_Ckt_Data_t, 1);
-    _foo(ckt->enh, Enh_Ckt_Data_t, 1);
-#endif
+    job = snapshot_job(ckt);
+    if (!job)
+        return;
 
-    fclose(file);
+    if (!snapshot_write(wl->wl_word, ckt, job)) {
+        fprintf(cp_err, "Error: Couldn't write snapshot to \"%s\"\n", wl->wl_word);
+        return;
+    }
     fprintf(stdout, "Snapshot saved to %s.\n", wl->wl_word);
 }
 
@@ -53,6 +53,12 @@ Modified: 2000 AlansFixes
  * Then we have to systematically change all references to the renamed
  * nodes. On top of that, we have to know how many args BJT's have,
  * so we have to keep track of model names.
+ * The result stays flat: every instance of a .subckt is a full copy with
+ * renamed cards, and memory grows with the flattened instance count.
+ * Only the lookup of the definitions is by hash. Keeping the masters as
+ * shared templates would need the circuit setup, .save, @dev[param],
+ * alter and listing to resolve hierarchical names; they all expect one
+ * flat instance per device.
  *======================================================================*/
 /*#define TRACE*/
 #include "ngspice/ngspice.h"
@@ -60,6 +66,7 @@ Modified: 2000 AlansFixes
 #include "ngspice/ftedefs.h"
 #include "ngspice/fteinp.h"
 #include "ngspice/stringskip.h"
+#include "ngspice/hash.h"
 
 #include <stdarg.h>
 
@@ -87,12 +94,12 @@ extern void line_free_x(struct line * deck, bool recurse);
 struct subs;
 static struct line *doit(struct line *deck, wordlist *modnames);
 static int translate(struct line *deck, char *formal, char *actual, char *scname,
-                     const char *subname, struct subs *subs, wordlist const *modnames);
+                     const char *subname, NGHASHPTR subs_table, wordlist const *modnames);
 struct bxx_buffer;
 static void finishLine(struct bxx_buffer *dst, char *src, char *scname);
 static int settrans(char *formal, char *actual, const char *subname);
 static char *gettrans(const char *name, const char *name_end);
-static int numnodes(const char *line, struct subs *subs, wordlist const *modnames);
+static int numnodes(const char *line, NGHASHPTR subs_table, wordlist const *modnames);
 static int  numdevs(char *s);
 static wordlist *modtranslate(struct line *deck, char *subname, wordlist *new_modnames);
 static void devmodtranslate(struct line *deck, char *subname, wordlist * const orig_modnames);
@@ -432,6 +439,7 @@ doit(struct line *deck, wordlist *modnames) {
 
     /* Save all the old stuff... */
     struct subs *subs = NULL;
+    NGHASHPTR subs_table;
     wordlist *xmodnames = modnames;
 
 #ifdef TRACE
@@ -539,6 +547,11 @@ doit(struct line *deck, wordlist *modnames) {
         if ((sss->su_def = doit(sss->su_def, modnames)) == NULL)
             return (NULL);
 
+    /* index the .subckt definitions by name, the last definition wins */
+    subs_table = nghash_init(NGHASH_MIN_SIZE);
+    for (sss = subs; sss; sss = sss->su_next)
+        nghash_insert(subs_table, sss->su_name, sss);
+
 #ifdef TRACE
     /* SDB debug statement */
     {
@@ -584,10 +597,8 @@ doit(struct line *deck, wordlist *modnames) {
                     s--;
                 s++;
 
-                /* iterate through .subckt list and look for .subckt name invoked */
-                for (sss = subs; sss; sss = sss->su_next)
-                    if (eq(sss->su_name, s))
-                        break;
+                /* look for .subckt name invoked */
+                sss = (struct subs *) nghash_find(subs_table, s);
 
 
                 /* At this point, sss points to the .subckt invoked,
@@ -617,7 +628,7 @@ doit(struct line *deck, wordlist *modnames) {
                     /* now invoke translate, which handles the remainder of the
                      * translation.
                      */
-                    if (!translate(su_deck, sss->su_args, t, scname, sss->su_name, subs, modnames))
+                    if (!translate(su_deck, sss->su_args, t, scname, sss->su_name, subs_table, modnames))
                         error = 1;
 
                     /* Now splice the decks together. */
@@ -670,6 +681,8 @@ doit(struct line *deck, wordlist *modnames) {
 
     wl_delete_slice(modnames, xmodnames);
 
+    nghash_free(subs_table, NULL, NULL);
+
     if (error)
         return NULL;    /* error message already reported; should free() */
 
@@ -909,7 +922,7 @@ translate_inst_name(struct bxx_buffer *buffer, const char *scname, const char *n
 
 
 static int
-translate(struct line *deck, char *formal, char *actual, char *scname, const char *subname, struct subs *subs, wordlist const *modnames)
+translate(struct line *deck, char *formal, char *actual, char *scname, const char *subname, NGHASHPTR subs_table, wordlist const *modnames)
 {
     struct line *c;
     struct bxx_buffer buffer;
@@ -1067,7 +1080,7 @@ translate(struct line *deck, char *formal, char *actual, char *scname, const cha
             bxx_putc(&buffer, ' ');
 
             /* Next iterate over all nodes (netnames) found and translate them. */
-            nnodes = numnodes(c->li_line, subs, modnames);
+            nnodes = numnodes(c->li_line, subs_table, modnames);
 
             while (--nnodes >= 0) {
                 name = gettok_node(&s);
@@ -1154,7 +1167,7 @@ translate(struct line *deck, char *formal, char *actual, char *scname, const cha
             tfree(name);
             bxx_putc(&buffer, ' ');
 
-            nnodes = numnodes(c->li_line, subs, modnames);
+            nnodes = numnodes(c->li_line, subs_table, modnames);
             while (--nnodes >= 0) {
                 name = gettok_node(&s);
                 if (name == NULL) {
@@ -1353,7 +1366,7 @@ gettrans(const char *name, const char *name_end)
 /*-------------------------------------------------------------------*/
 /*-------------------------------------------------------------------*/
 static int
-numnodes(const char *line, struct subs *subs, wordlist const *modnames)
+numnodes(const char *line, NGHASHPTR subs_table, wordlist const *modnames)
 {
     /* gtri - comment - wbk - 10/23/90 - Do not modify this routine for */
     /* 'A' type devices since the callers will not know how to find the */
@@ -1370,9 +1383,11 @@ numnodes(const char *line, struct subs *subs, wordlist const *modnames)
     if (c == 'x') {     /* Handle this ourselves. */
         const char *xname_e = skip_back_ws(strchr(line, '\0'), line);
         const char *xname = skip_back_non_ws(xname_e, line);
-        for (; subs; subs = subs->su_next)
-            if (eq_substr(xname, xname_e, subs->su_name))
-                return subs->su_numargs;
+        char *name = copy_substring(xname, xname_e);
+        struct subs *sss = (struct subs *) nghash_find(subs_table, name);
+        tfree(name);
+        if (sss)
+            return sss->su_numargs;
         /*
          * number of nodes not known so far.
          * lets count the nodes ourselves,
@@ -279,7 +279,10 @@ ft_loadfile(char *file)
     struct plot *pl, *np, *pp;
 
     fprintf(cp_out, "Loading raw data file (\"%s\") . . . ", file);
-    pl = raw_read(file);
+    if (cp_getvar("lazyload", CP_BOOL, NULL))
+        pl = raw_read_mapped(file);
+    else
+        pl = raw_read(file);
     if (pl)
         fprintf(cp_out, "done.\n");
     else
@@ -368,7 +371,7 @@ vec_remove(char *name)
 struct dvec *
 vec_fromplot(char *word, struct plot *plot)
 {
-    struct dvec *d;
+    struct dvec *d, *v;
     char buf[BSIZE_SP], buf2[BSIZE_SP], cc, *s;
 
     d = findvec(word, plot);
@@ -396,6 +399,10 @@ vec_fromplot(char *word, struct plot *plot)
         d = findvec(buf, plot);
     }
 
+    /* get the data of vectors loaded with 'lazyload' */
+    for (v = d; v; v = v->v_link2)
+        raw_loadvec(v);
+
     return (d);
 }
 
@@ -681,6 +688,8 @@ vec_copy(struct dvec *v)
     if (!v)
         return (NULL);
 
+    raw_loadvec(v);
+
     nv = dvec_alloc(copy(v->v_name),
                     v->v_type,
                     v->v_flags & ~VF_PERMANENT,
@@ -201,6 +201,7 @@ struct CKTcircuit {
     double CKTsaveDelta;        /* ??? */
     double CKTminBreak;         /* ??? */
     double *CKTbreaks;          /* List of breakpoints ??? */
+    int CKTbreakAlloc;          /* allocated length of CKTbreaks */
     double CKTabstol;           /* --- */
     double CKTpivotAbsTol;      /* --- */
     double CKTpivotRelTol;      /* --- */
@@ -294,6 +295,13 @@ struct CKTcircuit {
     int CKTsoaMaxWarns; /* specifies the maximum number of SOA warnings */
 
     double CKTepsmin; /* minimum argument value for some log functions, e.g. diode saturation current*/
+    unsigned int CKTsparseCsc:1; /* flag to refactor the matrix in compressed
+                                    column form */
+    int CKTpivotCount;  /* pivot sequence of the last matrix, handed to */
+    int *CKTpivotRows;  /* the next one built for this circuit to save */
+    int *CKTpivotCols;  /* the search for pivots */
+    struct sDEVsizeCache *CKTsizeCache; /* size dependent parameter sets
+                                           of the BSIM temp routines */
 
     NGHASHPTR DEVnameHash;
     NGHASHPTR MODnameHash;
@@ -449,6 +457,54 @@ extern void NInzIter(CKTcircuit *, int, int);
 extern int NIpred(CKTcircuit *ckt);
 #endif
 
+#ifdef USE_OMP
+/* Stamps of a device type whose instances are evaluated in parallel.
+ * Each instance owns a set of slots, assigned in DEVsetup, writes only
+ * to its own slots in DEVload, and CKTstampLoad() then adds all slots
+ * to the matrix and rhs in slot order, so the result does not depend on
+ * the thread schedule.  Slot 0 of either kind is a sink, an index left
+ * at 0 for a stamp an instance does not use is harmless. */
+typedef struct CKTstampBuf {
+    int matCount;       /* number of matrix slots in use */
+    int matSize;        /* allocated matrix slots */
+    double **matPtr;    /* matrix element of each slot */
+    double *matVal;     /* value to be added, sign included */
+    int rhsCount;       /* number of rhs slots in use */
+    int rhsSize;        /* allocated rhs slots */
+    int *rhsNode;       /* equation number of each rhs slot */
+    double *rhsVal;     /* value to be added, sign included */
+    double matSink;     /* matrix element of slot 0 */
+} CKTstampBuf;
+
+extern CKTstampBuf *CKTstampNew(void);
+extern void CKTstampFree(CKTstampBuf **);
+extern int CKTstampMat(CKTstampBuf *, double *);
+extern int CKTstampRhs(CKTstampBuf *, int);
+extern void CKTstampLoad(CKTstampBuf *, CKTcircuit *);
+#endif
+
+/* A snapshot of a transient analysis, see cktsnap.c.  It is a list of
+ * named arrays of doubles, stored in a fixed byte order, so that it can
+ * be read back by another build of ngspice or on another machine. */
+struct CKTsnap {
+    char *buf;          /* the snapshot written so far */
+    size_t len;         /* its length */
+    size_t size;        /* the space allocated for it */
+    NGHASHPTR entries;  /* the arrays read, by name */
+    int error;          /* an array could not be added */
+};
+
+extern void CKTsnapBegin(CKTsnap *);
+extern int CKTsnapEnd(CKTsnap *);
+extern int CKTsnapRead(CKTsnap *, FILE *);
+extern void CKTsnapFree(CKTsnap *);
+extern void CKTsnapPut(CKTsnap *, const char *, const double *, int);
+extern int CKTsnapLength(CKTsnap *, const char *);
+extern double *CKTsnapGet(CKTsnap *, const char *, int);
+extern int CKTsnapCheck(CKTcircuit *);
+extern void CKTsnapSave(CKTcircuit *, CKTsnap *);
+extern int CKTsnapLoad(CKTcircuit *, CKTsnap *);
+
 extern IFfrontEnd *SPfrontEnd;
 
 struct circ;
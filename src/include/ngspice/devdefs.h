@@ -29,6 +29,14 @@ double limitVbe( double, double, int * );
 double limitVce( double, double, int * );
 double limitVgb( double, double, int * );
 
+/* Hashed lookup of size dependent parameter sets (devsize.c) */
+#define DEV_SIZE_MAXKEY 5
+typedef struct sDEVsizeCache DEVsizeCache;
+DEVsizeCache *DEVsizeCacheReset(CKTcircuit *);
+void DEVsizeCacheFree(DEVsizeCache **);
+void *DEVsizeFind(DEVsizeCache *, void *, const double *, int);
+void DEVsizeAdd(DEVsizeCache *, void *, const double *, int, void *);
+
 /* Area Calculation Method (ACM) for MOS models (devsup.c) */
 int
 ACM_SourceDrainResistances(int, double, double, double, double, double,
@@ -104,6 +112,10 @@ typedef struct SPICEdev {
 	/* noise routine */
     int (*DEVsoaCheck)(CKTcircuit*,GENmodel*);
 	/* subroutine to call on soa check */
+    void (*DEVsnapSave)(GENmodel*,CKTcircuit*,CKTsnap*);
+	/* add the history kept outside the states to a snapshot */
+    int (*DEVsnapLoad)(GENmodel*,CKTcircuit*,CKTsnap*,int);
+	/* check that history in a snapshot, and take it over if asked to */
 #ifdef CIDER 	
     void (*DEVdump)(GENmodel *, CKTcircuit *);
     void (*DEVacct)(GENmodel *, CKTcircuit *, FILE *);
@@ -58,6 +58,9 @@ struct dvec {
     struct dvec *v_next;	/* Link for list of plot vectors. */
     struct dvec *v_link2;	/* Extra link for things like print. */
     struct dvec *v_scale;	/* If this has a non-standard scale... */
+    struct rawmap *v_rawmap;	/* Mapped rawfile holding the data, if
+				   they are not loaded yet. */
+    int v_rawcol;		/* The column of this vector there. */
 } ;
 
 #define isreal(v)   ((v)->v_flags & VF_REAL)
@@ -75,4 +78,8 @@ void dvec_extend(struct dvec *v, int length);
 void dvec_trunc(struct dvec *v, int length);
 void dvec_free(struct dvec *);
 
+/* in rawfile.c */
+void raw_loadvec(struct dvec *v);
+void raw_unmap(struct rawmap *map);
+
 #endif
@@ -281,9 +281,10 @@ extern void ft_graf(struct dvec *v, struct dvec *xs, bool nostart);
 
 /* rawfile.c */
 extern int raw_prec;
-extern void raw_write(char *name, struct plot *pl, bool app, bool binary);
+extern void raw_write(char *name, struct plot *pl, bool app, bool binary, bool columns);
 extern void spar_write(char *name, struct plot *pl, double val);
 extern struct plot *raw_read(char *name);
+extern struct plot *raw_read_mapped(char *name);
 
 /* meas.c */
 extern bool do_measure(char *what, bool chk_only);
@@ -319,6 +320,7 @@ extern void if_setndnames(char *line);
 extern void if_setparam_model(CKTcircuit *ckt, char **name, char *val );
 extern void if_setparam(CKTcircuit *ckt, char **name, char *param, struct dvec *val, int do_model);
 extern struct variable *if_getstat(CKTcircuit *ckt, char *name);
+extern void if_snapshot(CKTcircuit *ckt);
 extern int ft_find_analysis(char *name);
 extern IFparm *ft_find_analysis_parm(int which, char *name);
 
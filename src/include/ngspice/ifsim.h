@@ -470,6 +470,8 @@ struct IFfrontEnd {
                             /* end nested domain */
     int (*OUTattributes) (runDesc *, IFuid, int, IFvalue *);
                             /* specify output attributes of node */
+    void (*IFsnapshot) (CKTcircuit *);
+                            /* write a periodic snapshot of a transient */
 };
 
 
@@ -34,6 +34,8 @@ struct INPtables{
     struct INPnTab **INPtermsymtab;
     int INPsize;
     int INPtermsize;
+    int INPnumsyms;             /* entries in INPsymtab */
+    int INPnumterms;            /* entries in INPtermsymtab */
     GENmodel *defAmod;
     GENmodel *defBmod;
     GENmodel *defCmod;
@@ -27,10 +27,13 @@ Author: 1987 Wayne A. Christopher, U. C. Berkeley CAD Group
  * out before returning.
  */
 
+typedef struct PTprogram PTprogram;
+
 typedef struct INPparseTree {
     IFparseTree p;
     struct INPparseNode *tree;  /* The real stuff. */
     struct INPparseNode **derivs;   /* The derivative parse trees. */
+    PTprogram *prog;            /* Both compiled by PTcompile(), or NULL. */
 } INPparseTree;
 
 /* This is what is passed as the actual parameter value.  The fields will all
@@ -169,6 +172,8 @@ typedef struct PTelement {
 /* And in IFeval.c */
 
 extern int IFeval(IFparseTree *tree, double gmin, double *result, double *vals, double *derivs);
+extern PTprogram *PTcompile(INPparseNode *tree, INPparseNode **derivs, int numVars);
+extern void PTfreeProgram(PTprogram *prog);
 
 #endif
 
@@ -308,7 +308,7 @@ extern void SetAnalyse(char *analyse, int percent);
 #define fprintf sh_fprintf
 
 #undef perror
-#define perror(string) fprintf(stderr, "%s: %s\n", string, sys_errlist[errno])
+#define perror(string) fprintf(stderr, "%s: %s\n", string, strerror(errno))
 
 #undef fputs
 #define fputs sh_fputs
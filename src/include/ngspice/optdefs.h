@@ -28,6 +28,9 @@ typedef struct {
 
     int STATtotalDev;   /* PN: number of total devices in the netlist */
 
+    int STATsizeHits;   /* size dependent parameter sets found in the cache */
+    int STATsizeMisses; /* size dependent parameter sets computed anew */
+
     double STATtotAnalTime;     /* total time for all analysis */
     double STATloadTime;        /* total time spent in device loading */
     double STATdecompTime;      /* total time spent in LU decomposition */
@@ -122,6 +125,9 @@ typedef struct {
 #define OPT_XMU          69
 #define OPT_INDVERBOSITY 70
 #define OPT_EPSMIN       71
+#define OPT_SPARSECSC    72
+#define OPT_SIZEHITS     73
+#define OPT_SIZEMISSES   74
 
 
 #ifdef XSPICE
@@ -29,6 +29,20 @@ The void pointer may contain the object address of the calling
 function ('self' or 'this' pointer), so that the answer may be directed
 to a calling object. Callback functions are defined in the global section.
 
+**
+ngSpice_Init_Block(SendDataBlock*, int, double*, int)
+Optional, streaming of simulation output in blocks. Instead of (or in
+addition to) one SendData call per accepted point, the caller receives
+a SendDataBlock call for every 'blocksize' new points, and a last one
+for the remaining points when the plot ends. Each vector is handed over
+as a contiguous column of values. If no ring buffer is given, the
+columns point directly into the ngspice vector storage; they are valid
+only during the callback. If the caller supplies a ring buffer of
+'ringsize' doubles, each block is copied into it (at the next free
+position, wrapping to the start when the block does not fit in the
+rest), and the data stay valid until overwritten by later blocks.
+Output written directly to a rawfile (batch mode) is not streamed.
+
 **
 ngSpice_Command(char*)
 Send a valid command (see the control or interactive commands) from caller
@@ -74,6 +88,25 @@ Memory allocated in the calling program has to be freed only there.
 ngspice.dll should never call exit() directly, but handle either the 'quit'
 request to the caller or an request for exiting upon error,
 done by callback function ngexit().
+
+**
+Several simulators in one process:
+All state of ngspice (circuits, plots, variables, callbacks) is global to
+the loaded library image, so one image runs one simulation at a time.
+ngSpice_New() returns a handle to a simulator of its own, and the
+functions ending in _h work like those above on that simulator. Each
+handle owns its circuits, plots, variables and callbacks, so N handles
+may run N simulations on N threads of the caller at the same time.
+Give each handle a unique ident with ngSpice_Init_Sync_h(); it is
+handed back with every callback, so a caller may share one set of
+callback functions among all handles. ngSpice_Delete() quits the
+simulator of a handle and frees it.
+
+A handle is a further image of this library, loaded with
+dlmopen(LM_ID_NEWLM, ...). Where dlmopen() is not available,
+ngSpice_New() returns NULL; there, load copies of the library under
+different file names (e.g. ngspice1.dll, ngspice2.dll) instead. glibc
+allows for about 15 such images in one process.
 */
 
 #ifndef NGSPICE_DLL_H
@@ -138,6 +171,22 @@ typedef struct vecvaluesall {
     pvecvalues *vecsa; /* values of actual set of vectors, indexed from 0 to veccount - 1 */
 } vecvaluesall, *pvecvaluesall;
 
+/* a block of data points of a specific vector */
+typedef struct vecblock {
+    char *name;            /* name of a specific vector */
+    double *realdata;      /* 'count' real values, or NULL if complex */
+    ngcomplex_t *compdata; /* 'count' complex values, or NULL if real */
+    bool is_scale;         /* if 'name' is the scale vector */
+    bool is_complex;       /* if the data are complex numbers */
+} vecblock, *pvecblock;
+
+typedef struct vecblockall {
+    int veccount;      /* number of vectors in plot */
+    int vecindex;      /* index of the first data point of the block */
+    int count;         /* number of data points in the block */
+    pvecblock *vecsa;  /* data of all vectors, indexed from 0 to veccount - 1 */
+} vecblockall, *pvecblockall;
+
 /* info for a specific vector */
 typedef struct vecinfo
 {
@@ -199,6 +248,15 @@ typedef int (SendData)(pvecvaluesall, int, int, void*);
    void*         return pointer received from caller
 */
 
+/* send back a block of vector data */
+typedef int (SendDataBlock)(pvecblockall, int, int, void*);
+/*
+   vecblockall* pointer to struct containing a block of values from all vectors
+   int          number of vectors
+   int          identification number of calling ngspice shared lib
+   void*        return pointer received from caller
+*/
+
 /* send back initailization vector data */
 typedef int (SendInitData)(pvecinfoall, int, void*);
 /*
@@ -277,6 +335,17 @@ userData: pointer to user-defined data, will not be modified, but
 IMPEXP
 int  ngSpice_Init_Sync(GetVSRCData *vsrcdat, GetISRCData *isrcdat, GetSyncData *syncdat, int *ident, void *userData);
 
+/* initialization of block data streaming
+sblock: pointer to callback function for returning blocks of data values
+        of all current output vectors, NULL to stop streaming
+blocksize: number of data points per block (256 if less than 1)
+ringbuf: pointer to a ring buffer of the caller receiving the blocks,
+         or NULL to send pointers into the ngspice vectors
+ringsize: size of ringbuf, in doubles. A complex value takes two doubles.
+*/
+IMPEXP
+int  ngSpice_Init_Block(SendDataBlock* sblock, int blocksize, double* ringbuf, int ringsize);
+
 /* Caller may send ngspice commands to ngspice.dll.
 Commands are executed immediately */
 IMPEXP
@@ -321,6 +390,56 @@ IMPEXP
 bool ngSpice_SetBkpt(double time);
 
 
+/* a simulator of its own, see 'Several simulators in one process' */
+typedef struct ngspice_handle ngSpiceHandle;
+
+/* load a new simulator, NULL if not possible */
+IMPEXP
+ngSpiceHandle* ngSpice_New(void);
+
+/* quit the simulator of handle and unload it */
+IMPEXP
+void ngSpice_Delete(ngSpiceHandle* handle);
+
+/* the functions above, for the simulator of handle */
+IMPEXP
+int  ngSpice_Init_h(ngSpiceHandle* handle, SendChar* printfcn, SendStat* statfcn,
+                    ControlledExit* ngexit, SendData* sdata, SendInitData* sinitdata,
+                    BGThreadRunning* bgtrun, void* userData);
+
+IMPEXP
+int  ngSpice_Init_Sync_h(ngSpiceHandle* handle, GetVSRCData *vsrcdat, GetISRCData *isrcdat,
+                         GetSyncData *syncdat, int *ident, void *userData);
+
+IMPEXP
+int  ngSpice_Init_Block_h(ngSpiceHandle* handle, SendDataBlock* sblock, int blocksize,
+                          double* ringbuf, int ringsize);
+
+IMPEXP
+int  ngSpice_Command_h(ngSpiceHandle* handle, char* command);
+
+IMPEXP
+pvector_info ngGet_Vec_Info_h(ngSpiceHandle* handle, char* vecname);
+
+IMPEXP
+int ngSpice_Circ_h(ngSpiceHandle* handle, char** circarray);
+
+IMPEXP
+char* ngSpice_CurPlot_h(ngSpiceHandle* handle);
+
+IMPEXP
+char** ngSpice_AllPlots_h(ngSpiceHandle* handle);
+
+IMPEXP
+char** ngSpice_AllVecs_h(ngSpiceHandle* handle, char* plotname);
+
+IMPEXP
+bool ngSpice_running_h(ngSpiceHandle* handle);
+
+IMPEXP
+bool ngSpice_SetBkpt_h(ngSpiceHandle* handle, double time);
+
+
 #ifdef __cplusplus
 }
 #endif
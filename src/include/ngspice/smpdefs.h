@@ -30,6 +30,13 @@ int SMPmatSize( SMPmatrix *);
 int SMPnewMatrix( SMPmatrix **, int );
 void SMPdestroy( SMPmatrix *);
 int SMPpreOrder( SMPmatrix *);
+void SMPsetCompressed( SMPmatrix *, int );
+int SMPcCopySizes( SMPmatrix *, int *, int *);
+void SMPcCopyGather( SMPmatrix *, double []);
+int SMPcCopyLUfac( SMPmatrix *, double [], double []);
+void SMPcCopySolve( SMPmatrix *, double [], double [], double [], double []);
+int SMPgetPivots( SMPmatrix *, int **, int **);
+void SMPsetPivots( SMPmatrix *, int , int *, int *);
 void SMPprint( SMPmatrix * , char *);
 void SMPprintRHS( SMPmatrix * , char *, double*, double*);
 void SMPgetError( SMPmatrix *, int *, int *);
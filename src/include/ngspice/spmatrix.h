@@ -251,6 +251,11 @@ typedef struct MatrixFrame *MatrixPtr;
 
 extern  void     spClear( MatrixPtr );
 extern  spREAL   spCondition( MatrixPtr, spREAL, int* );
+extern  int      spCompressedFactor( MatrixPtr, spREAL*, spREAL* );
+extern  void     spCompressedGather( MatrixPtr, spREAL* );
+extern  int      spCompressedSizes( MatrixPtr, int*, int* );
+extern  void     spCompressedSolve( MatrixPtr, spREAL*, spREAL*, spREAL*, spREAL*,
+                                    spREAL*, spREAL* );
 extern  MatrixPtr spCreate( int, int, int* );
 extern  void     spDeleteRowAndCol( MatrixPtr, int, int );
 extern  void     spDestroy( MatrixPtr);
@@ -265,6 +270,7 @@ extern  spREAL  *spFindElement(MatrixPtr Matrix, int Row, int Col );
 extern  spREAL  *spGetElement(MatrixPtr, int, int );
 extern  void    *spGetInitInfo( spREAL* );
 extern  int      spGetOnes( MatrixPtr, int, int, int, struct spTemplate* );
+extern  int      spGetPivots( MatrixPtr, int*, int* );
 extern  int      spGetQuad( MatrixPtr, int, int, int, int, struct spTemplate* );
 extern  int      spGetSize( MatrixPtr, int );
 extern  int      spInitialize(MatrixPtr, int (*pInit)(spREAL*, void *InitInfo, int, int Col));
@@ -280,6 +286,8 @@ extern  spREAL   spPseudoCondition( MatrixPtr );
 extern  spREAL   spRoundoff( MatrixPtr, spREAL );
 extern  void     spScale( MatrixPtr, spREAL*, spREAL* );
 extern  void     spSetComplex( MatrixPtr );
+extern  void     spSetCompressed( MatrixPtr, int );
+extern  void     spSetPivots( MatrixPtr, int, int*, int* );
 extern  void     spSetReal( MatrixPtr );
 extern  void     spStripFills( MatrixPtr );
 extern  void     spWhereSingular(MatrixPtr, int*, int* );
@@ -69,6 +69,7 @@ struct TSKtask {
     double TSKrelDv;                 /* rel limit for iter-iter voltage change */
     unsigned int TSKnoopac:1; /* flag for no OP calculation before AC */
     double TSKepsmin;         /* minimum value for log */
+    unsigned int TSKsparseCsc:1; /* flag for compressed column refactoring */
 };
 
 #endif
@@ -8,6 +8,7 @@
 
 
 typedef struct CKTcircuit CKTcircuit;
+typedef struct CKTsnap CKTsnap;
 typedef struct CKTnode CKTnode;
 
 
@@ -222,7 +222,8 @@ IFfrontEnd nutmeginfo = {
     OUTendPlot,
     OUTbeginDomain,
     OUTendDomain,
-    OUTattributes
+    OUTattributes,
+    if_snapshot
 };
 
 #else /* SIMULATOR */
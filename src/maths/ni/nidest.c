@@ -16,8 +16,20 @@ Author: 1985 Thomas L. Quarles
 void
 NIdestroy(CKTcircuit *ckt)
 {
-    if (ckt->CKTmatrix)
+    if (ckt->CKTmatrix) {
+        int *rows, *cols;
+        int count = SMPgetPivots(ckt->CKTmatrix, &rows, &cols);
+
+        /* keep the pivot order for the next setup of this circuit */
+        if (count > 0) {
+            tfree(ckt->CKTpivotRows);
+            tfree(ckt->CKTpivotCols);
+            ckt->CKTpivotCount = count;
+            ckt->CKTpivotRows = rows;
+            ckt->CKTpivotCols = cols;
+        }
 	SMPdestroy(ckt->CKTmatrix);
+    }
     ckt->CKTmatrix = NULL;
     if(ckt->CKTrhs)         FREE(ckt->CKTrhs);
     if(ckt->CKTrhsOld)      FREE(ckt->CKTrhsOld);
@@ -24,6 +24,12 @@ NIinit(CKTcircuit *ckt)
 /* a concession to Ken Kundert's sparse matrix package - SMP doesn't need this*/
     int Error;
 #endif /* SPARSE */
+    int error;
+
     ckt->CKTniState = NIUNINITIALIZED;
-    return SMPnewMatrix(&(ckt->CKTmatrix), 0);
+    error = SMPnewMatrix(&(ckt->CKTmatrix), 0);
+    if (!error && ckt->CKTpivotCount > 0)
+        SMPsetPivots(ckt->CKTmatrix, ckt->CKTpivotCount,
+                     ckt->CKTpivotRows, ckt->CKTpivotCols);
+    return error;
 }
@@ -16,6 +16,9 @@
  *  spGetSize
  *  spSetReal
  *  spSetComplex
+ *  spSetCompressed
+ *  spGetPivots
+ *  spSetPivots
  *  spFillinCount
  *  spElementCount
  *  spOriginalCount
@@ -160,6 +163,23 @@ spCreate(int Size, int Complex, int *pError)
     /* Initialize matrix */
     Matrix->ID = SPARSE_ID;
     Matrix->Complex = Complex;
+    Matrix->Compressed = NO;
+    Matrix->CompressedValid = NO;
+    Matrix->CscAllocated = 0;
+    Matrix->CscColStart = NULL;
+    Matrix->CscDiag = NULL;
+    Matrix->CscElement = NULL;
+    Matrix->CscRow = NULL;
+    Matrix->CscValue = NULL;
+    Matrix->CscDense = NULL;
+    Matrix->CscDenseSize = 0;
+    Matrix->CscDenseStart = 0;
+    Matrix->CscUpper = NULL;
+    Matrix->CscUpperCol = NULL;
+    Matrix->CscUpperStart = NULL;
+    Matrix->PreviousPivots = 0;
+    Matrix->PreviousPivotRow = NULL;
+    Matrix->PreviousPivotCol = NULL;
     Matrix->PreviousMatrixWasComplex = Complex;
     Matrix->Factored = NO;
     Matrix->Elements = 0;
@@ -675,6 +695,17 @@ spDestroy(MatrixPtr Matrix)
     SP_FREE( Matrix->DoCmplxDirect );
     SP_FREE( Matrix->DoRealDirect );
     SP_FREE( Matrix->Intermediate );
+    SP_FREE( Matrix->CscColStart );
+    SP_FREE( Matrix->CscDiag );
+    SP_FREE( Matrix->CscElement );
+    SP_FREE( Matrix->CscRow );
+    SP_FREE( Matrix->CscValue );
+    SP_FREE( Matrix->CscDense );
+    SP_FREE( Matrix->CscUpper );
+    SP_FREE( Matrix->CscUpperCol );
+    SP_FREE( Matrix->CscUpperStart );
+    SP_FREE( Matrix->PreviousPivotRow );
+    SP_FREE( Matrix->PreviousPivotCol );
 
     /* Sequentially step through the list of allocated pointers
      * freeing pointers along the way. */
@@ -843,6 +874,124 @@ spSetComplex(MatrixPtr Matrix)
 
 
 
+/*
+ *  SELECT COMPRESSED COLUMN REFACTORIZATION
+ *
+ *  When enabled, spFactor() copies the ordered matrix into compressed
+ *  column arrays the first time it is called after a reordering, and
+ *  then factors on these contiguous arrays instead of following the
+ *  element lists.  The pivot sequence and the fill-ins are those found
+ *  by spOrderAndFactor(), so the results are the same.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (void *)
+ *      Pointer to matrix.
+ *
+ *  Compressed  <input>  (int)
+ *      YES to factor on compressed columns, NO to use the element lists.
+ */
+
+void
+spSetCompressed(MatrixPtr Matrix, int Compressed)
+{
+    /* Begin `spSetCompressed'. */
+
+    assert( IS_SPARSE( Matrix ));
+    Matrix->Compressed = Compressed;
+    Matrix->CompressedValid = NO;
+    return;
+}
+
+
+
+
+
+
+
+
+/*
+ *  GET AND SET PIVOT SEQUENCE
+ *
+ *  spGetPivots() copies the external row and column of the pivot of
+ *  each step of an ordered matrix into Rows[1..Size] and Cols[1..Size].
+ *  The arrays must have room for spGetSize(Matrix, NO) + 1 entries.
+ *  spSetPivots() hands such a sequence, usually taken from an earlier
+ *  matrix with the same structure, to a new matrix.  The first full
+ *  ordering of the new matrix then tries these pivots before searching
+ *  for its own.
+ *
+ *  >>> Returned:
+ *  spGetPivots() returns the number of steps copied, zero if the matrix
+ *  has not been ordered.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (void *)
+ *      Pointer to matrix.
+ *
+ *  Count  <input>  (int)
+ *      Number of steps in the sequence.
+ *
+ *  Rows  <input/output>  (int *)
+ *      External row numbers of the pivots.
+ *
+ *  Cols  <input/output>  (int *)
+ *      External column numbers of the pivots.
+ */
+
+int
+spGetPivots(MatrixPtr Matrix, int *Rows, int *Cols)
+{
+    int  Step;
+
+    /* Begin `spGetPivots'. */
+
+    assert( IS_SPARSE( Matrix ));
+    if (Matrix->NeedsOrdering)
+        return 0;
+
+    for (Step = 1; Step <= Matrix->Size; Step++) {
+        Rows[Step] = Matrix->IntToExtRowMap[Step];
+        Cols[Step] = Matrix->IntToExtColMap[Step];
+    }
+    return Matrix->Size;
+}
+
+
+void
+spSetPivots(MatrixPtr Matrix, int Count, int *Rows, int *Cols)
+{
+    int  Step;
+
+    /* Begin `spSetPivots'. */
+
+    assert( IS_SPARSE( Matrix ));
+    SP_FREE( Matrix->PreviousPivotRow );
+    SP_FREE( Matrix->PreviousPivotCol );
+    Matrix->PreviousPivots = 0;
+
+    Matrix->PreviousPivotRow = SP_MALLOC( int, Count + 1 );
+    Matrix->PreviousPivotCol = SP_MALLOC( int, Count + 1 );
+    if (Matrix->PreviousPivotRow == NULL || Matrix->PreviousPivotCol == NULL) {
+        SP_FREE( Matrix->PreviousPivotRow );
+        SP_FREE( Matrix->PreviousPivotCol );
+        return;
+    }
+
+    for (Step = 1; Step <= Count; Step++) {
+        Matrix->PreviousPivotRow[Step] = Rows[Step];
+        Matrix->PreviousPivotCol[Step] = Cols[Step];
+    }
+    Matrix->PreviousPivots = Count;
+    return;
+}
+
+
+
+
+
+
+
+
 
 /*
  *  ELEMENT, FILL-IN OR ORIGINAL COUNT
@@ -868,6 +868,7 @@ spcCreateElement(MatrixPtr Matrix, int  Row, int  Col,
     }
 
     Matrix->Elements++;
+    Matrix->CompressedValid = NO;
     return pCreatedElement;
 }
 
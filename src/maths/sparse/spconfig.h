@@ -325,6 +325,16 @@
  *              a row-by-row basis, carries a large overhead, but speeds up
  *              both dense and sparse matrices, best if there is a large
  *              number of matrices that can use the same ordering.
+ *  DENSE_TAIL_MIN_SIZE
+ *      The smallest trailing block of the matrix that is factored as a
+ *      dense matrix by the compressed column refactorization. [32]
+ *  DENSE_TAIL_DENSITY
+ *      The fraction of entries that must be present in a trailing block
+ *      before it is factored as a dense matrix. [0.5]
+ *  DENSE_TAIL_MAX_SIZE
+ *      The largest trailing block that is factored as a dense matrix.
+ *      Its packed complex copy takes 16 * DENSE_TAIL_MAX_SIZE^2 bytes,
+ *      a denser tail than that is factored sparse. [2048]
  */
 
 /* Begin constants. */
@@ -338,6 +348,9 @@
 #define  MAX_MARKOWITZ_TIES             100
 #define  TIES_MULTIPLIER                5
 #define  DEFAULT_PARTITION              spAUTO_PARTITION
+#define  DENSE_TAIL_MIN_SIZE            32
+#define  DENSE_TAIL_DENSITY             0.5
+#define  DENSE_TAIL_MAX_SIZE            2048
 
 
 
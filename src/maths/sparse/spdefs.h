@@ -569,6 +569,40 @@ struct ElementListNodeStruct
  *  Complex  (int)
  *      The flag which indicates whether the matrix is complex (true) or
  *      real.
+ *  Compressed  (int)
+ *      Flag that indicates whether spFactor() should refactor the matrix
+ *      on compressed column arrays rather than on the element lists.
+ *  CompressedValid  (int)
+ *      Flag that indicates that the compressed column arrays still match
+ *      the structure of the matrix.  Cleared whenever an element is
+ *      created or rows and columns are exchanged.
+ *  CscAllocated  (int)
+ *      The number of entries allocated in CscElement, CscRow and CscValue.
+ *  CscColStart  (int *)
+ *      Index of the first entry of each column in the compressed arrays.
+ *  CscDense  (RealVector)
+ *      Packed storage for the dense trailing block of the matrix, stored
+ *      by columns.
+ *  CscDenseSize  (int)
+ *      The number of rows and columns in the dense trailing block.
+ *  CscDenseStart  (int)
+ *      The first row and column of the dense trailing block, or Size + 1
+ *      if there is none.
+ *  CscDiag  (int *)
+ *      Index of the diagonal entry of each column in the compressed arrays.
+ *  CscElement  (ElementPtr *)
+ *      The matrix element that each compressed entry was taken from.
+ *  CscRow  (int *)
+ *      Row of each compressed entry.
+ *  CscUpper  (int *)
+ *      Index of each compressed entry above the diagonal, sorted by rows
+ *      and within a row by columns.  Used by spCompressedSolve().
+ *  CscUpperCol  (int *)
+ *      Column of each entry of CscUpper.
+ *  CscUpperStart  (int *)
+ *      Index of the first entry of each row in CscUpper.
+ *  CscValue  (RealVector)
+ *      Values of the compressed entries, real or complex.
  *  CurrentSize  (int)
  *      This number is used during the building of the matrix when the
  *      TRANSLATE option is set true.  It indicates the number of internal
@@ -670,6 +704,14 @@ struct ElementListNodeStruct
  *      in the matrix elements be zero.  Thus, if the previous matrix was
  *      complex, then the current matrix will be cleared as if it were complex
  *      even if it is real.
+ *  PreviousPivotCol  (int *)
+ *      External column of the pivot of each step in a pivot sequence
+ *      given with spSetPivots().
+ *  PreviousPivotRow  (int *)
+ *      External row of the pivot of each step in that sequence.
+ *  PreviousPivots  (int)
+ *      The number of steps in that sequence.  The next full ordering
+ *      tries these pivots first, and clears the sequence.
  *  RelThreshold  (RealNumber)
  *      The magnitude an element must have relative to others in its row
  *      to be considered as a pivot candidate, except as a last resort.
@@ -739,6 +781,23 @@ struct  MatrixFrame
     int                          AllocatedSize;
     int                          AllocatedExtSize;
     int                      Complex;
+    int                      Compressed;
+    int                      CompressedValid;
+    int                          CscAllocated;
+    int                         *CscColStart;
+    int                         *CscDiag;
+    ElementPtr                  *CscElement;
+    int                         *CscRow;
+    RealVector                   CscValue;
+    RealVector                   CscDense;
+    int                          CscDenseSize;
+    int                          CscDenseStart;
+    int                          PreviousPivots;
+    int                         *PreviousPivotRow;
+    int                         *PreviousPivotCol;
+    int                         *CscUpper;
+    int                         *CscUpperCol;
+    int                         *CscUpperStart;
     int                          CurrentSize;
     ArrayOfElementPtrs           Diag;
     int                     *DoCmplxDirect;
@@ -11,11 +11,19 @@
  *  spOrderAndFactor
  *  spFactor
  *  spPartition
+ *  spCompressedSizes
+ *  spCompressedGather
+ *  spCompressedFactor
  *
  *  >>> Other functions contained in this file:
  *  FactorComplexMatrix         spcCreateInternalVectors
+ *  CompressMatrix              FindDenseTail
+ *  FactorCompressedMatrix      FactorCompressedComplexMatrix
+ *  EliminateCompressedComplex  FactorDenseTail
+ *  FactorDenseComplexTail
  *  CountMarkowitz              MarkowitzProducts
- *  SearchForPivot              SearchForSingleton
+ *  SearchForPivot              SearchPreviousPivot
+ *  SearchForSingleton
  *  QuicklySearchDiagonal       SearchDiagonal
  *  SearchEntireMatrix          FindLargestInCol
  *  FindBiggestInColExclude     ExchangeRowsAndCols
@@ -56,6 +64,7 @@
  *    Matrix type and macro definitions for the sparse matrix routines.
  */
 #include <assert.h>
+#include <stdlib.h>
 
 #define spINSIDE_SPARSE
 #include "spconfig.h"
@@ -71,9 +80,18 @@
  */
 
 static int  FactorComplexMatrix( MatrixPtr );
+static int  CompressMatrix( MatrixPtr );
+static void FindDenseTail( MatrixPtr );
+static int  FactorCompressedMatrix( MatrixPtr );
+static int  FactorCompressedComplexMatrix( MatrixPtr );
+static int  EliminateCompressedComplex( MatrixPtr, ComplexVector,
+                                        ComplexVector, ComplexVector );
+static int  FactorDenseTail( RealVector, int );
+static int  FactorDenseComplexTail( ComplexVector, int );
 static void CountMarkowitz( MatrixPtr, RealVector, int );
 static void MarkowitzProducts( MatrixPtr, int );
 static ElementPtr SearchForPivot( MatrixPtr, int, int );
+static ElementPtr SearchPreviousPivot( MatrixPtr, int );
 static ElementPtr SearchForSingleton( MatrixPtr, int );
 static ElementPtr QuicklySearchDiagonal( MatrixPtr, int );
 static ElementPtr SearchDiagonal( MatrixPtr, int );
@@ -193,7 +211,7 @@ spOrderAndFactor(MatrixPtr Matrix, RealNumber RHS[], RealNumber RelThreshold,
                  RealNumber AbsThreshold, int DiagPivoting)
 {
     ElementPtr  pPivot;
-    int  Step, Size, ReorderingRequired;
+    int  Step, Size, ReorderingRequired, FollowPrevious;
     RealNumber LargestInCol;
 
     /* Begin `spOrderAndFactor'. */
@@ -210,6 +228,7 @@ spOrderAndFactor(MatrixPtr Matrix, RealNumber RHS[], RealNumber RelThreshold,
         AbsThreshold = Matrix->AbsThreshold;
     Matrix->AbsThreshold = AbsThreshold;
     ReorderingRequired = NO;
+    FollowPrevious = NO;
 
     if (!Matrix->NeedsOrdering) {
         /* Matrix has been factored before and reordering is not required. */
@@ -243,6 +262,7 @@ spOrderAndFactor(MatrixPtr Matrix, RealNumber RHS[], RealNumber RelThreshold,
          * reodering is required rather than a partial reordering,
          * which occurs during a failure of a fast factorization.  */
         Step = 1;
+        FollowPrevious = (Matrix->PreviousPivots > 0);
         if (!Matrix->RowsLinked)
             spcLinkRows( Matrix );
         if (!Matrix->InternalVectorsAllocated)
@@ -258,7 +278,13 @@ spOrderAndFactor(MatrixPtr Matrix, RealNumber RHS[], RealNumber RelThreshold,
 
     /* Perform reordering and factorization. */
     for (; Step <= Size; Step++) {
-        pPivot = SearchForPivot( Matrix, Step, DiagPivoting );
+        pPivot = NULL;
+        if (FollowPrevious) {
+            pPivot = SearchPreviousPivot( Matrix, Step );
+            FollowPrevious = (pPivot != NULL);
+        }
+        if (pPivot == NULL)
+            pPivot = SearchForPivot( Matrix, Step, DiagPivoting );
         if (pPivot == NULL) return MatrixIsSingular( Matrix, Step );
         ExchangeRowsAndCols( Matrix, pPivot, Step );
 
@@ -276,6 +302,9 @@ spOrderAndFactor(MatrixPtr Matrix, RealNumber RHS[], RealNumber RelThreshold,
     }
 
 Done:
+    Matrix->PreviousPivots = 0;
+    SP_FREE( Matrix->PreviousPivotRow );
+    SP_FREE( Matrix->PreviousPivotCol );
     Matrix->NeedsOrdering = NO;
     Matrix->Reordered = YES;
     Matrix->Factored = YES;
@@ -335,6 +364,12 @@ spFactor(MatrixPtr Matrix)
                                  0.0, 0.0, DIAG_PIVOTING_AS_DEFAULT );
     }
     if (!Matrix->Partitioned) spPartition( Matrix, spDEFAULT_PARTITION );
+    if (Matrix->Compressed && Matrix->Size > 0 &&
+        (Matrix->CompressedValid || CompressMatrix( Matrix ))) {
+        if (Matrix->Complex)
+            return FactorCompressedComplexMatrix( Matrix );
+        return FactorCompressedMatrix( Matrix );
+    }
     if (Matrix->Complex)
         return FactorComplexMatrix( Matrix );
 
@@ -539,6 +574,551 @@ FactorComplexMatrix( MatrixPtr Matrix )
 
 
 
+
+
+/*
+ *  COMPRESS MATRIX
+ *
+ *  Copies the structure of the ordered and factored matrix into
+ *  compressed column arrays.  Column Step occupies the entries
+ *  CscColStart[Step] up to CscColStart[Step+1]-1, sorted by row, with
+ *  the pivot at CscDiag[Step].  CscElement[] links every entry back to
+ *  its element, so values can be gathered from and scattered to the
+ *  element lists in one pass.  The arrays stay valid until the
+ *  structure of the matrix changes.
+ *
+ *  >>> Returned:
+ *  YES if the arrays were built, NO if memory ran out or a pivot is
+ *  missing; spFactor() then falls back to the element lists.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (char *)
+ *      Pointer to matrix.
+ */
+
+static int
+CompressMatrix( MatrixPtr Matrix )
+{
+    ElementPtr  pElement;
+    int  *UpperStart, *Upper, *UpperCol;
+    int  Step, Size, Count, I;
+
+    /* Begin `CompressMatrix'. */
+    Size = Matrix->Size;
+
+    Count = 0;
+    for (Step = 1; Step <= Size; Step++) {
+        if (Matrix->Diag[Step] == NULL)
+            return NO;
+        for (pElement = Matrix->FirstInCol[Step]; pElement != NULL;
+             pElement = pElement->NextInCol)
+            Count++;
+    }
+
+    SP_FREE( Matrix->CscColStart );
+    SP_FREE( Matrix->CscDiag );
+    SP_FREE( Matrix->CscUpperStart );
+    Matrix->CscColStart = SP_MALLOC( int, Size + 2 );
+    Matrix->CscDiag = SP_MALLOC( int, Size + 1 );
+    Matrix->CscUpperStart = SP_MALLOC( int, Size + 2 );
+    if (Count > Matrix->CscAllocated) {
+        SP_FREE( Matrix->CscElement );
+        SP_FREE( Matrix->CscRow );
+        SP_FREE( Matrix->CscValue );
+        SP_FREE( Matrix->CscUpper );
+        SP_FREE( Matrix->CscUpperCol );
+        Matrix->CscElement = SP_MALLOC( ElementPtr, Count );
+        Matrix->CscRow = SP_MALLOC( int, Count );
+        /* room for complex values */
+        Matrix->CscValue = SP_MALLOC( RealNumber, 2 * Count );
+        Matrix->CscUpper = SP_MALLOC( int, Count );
+        Matrix->CscUpperCol = SP_MALLOC( int, Count );
+        Matrix->CscAllocated = Count;
+    }
+    if (!Matrix->CscColStart || !Matrix->CscDiag ||
+        !Matrix->CscUpperStart || !Matrix->CscElement ||
+        !Matrix->CscRow || !Matrix->CscValue || !Matrix->CscUpper ||
+        !Matrix->CscUpperCol) {
+        SP_FREE( Matrix->CscElement );
+        SP_FREE( Matrix->CscRow );
+        SP_FREE( Matrix->CscValue );
+        SP_FREE( Matrix->CscUpper );
+        SP_FREE( Matrix->CscUpperCol );
+        Matrix->CscAllocated = 0;
+        return NO;
+    }
+
+    I = 0;
+    for (Step = 1; Step <= Size; Step++) {
+        Matrix->CscColStart[Step] = I;
+        for (pElement = Matrix->FirstInCol[Step]; pElement != NULL;
+             pElement = pElement->NextInCol) {
+            if (pElement == Matrix->Diag[Step])
+                Matrix->CscDiag[Step] = I;
+            Matrix->CscElement[I] = pElement;
+            Matrix->CscRow[I] = pElement->Row;
+            I++;
+        }
+    }
+    Matrix->CscColStart[Size + 1] = I;
+
+    /* Index the entries above the diagonal by rows, in column order. */
+    UpperStart = Matrix->CscUpperStart;
+    Upper = Matrix->CscUpper;
+    UpperCol = Matrix->CscUpperCol;
+    for (Step = 0; Step <= Size + 1; Step++)
+        UpperStart[Step] = 0;
+    for (Step = 1; Step <= Size; Step++) {
+        for (I = Matrix->CscColStart[Step]; I < Matrix->CscDiag[Step]; I++)
+            UpperStart[Matrix->CscRow[I] + 1]++;
+    }
+    for (Step = 1; Step <= Size + 1; Step++)
+        UpperStart[Step] += UpperStart[Step - 1];
+    for (Step = 1; Step <= Size; Step++) {
+        for (I = Matrix->CscColStart[Step]; I < Matrix->CscDiag[Step]; I++) {
+            UpperCol[UpperStart[Matrix->CscRow[I]]] = Step;
+            Upper[UpperStart[Matrix->CscRow[I]]++] = I;
+        }
+    }
+    for (Step = Size + 1; Step > 0; Step--)
+        UpperStart[Step] = UpperStart[Step - 1];
+    UpperStart[0] = 0;
+
+    FindDenseTail( Matrix );
+
+    Matrix->CompressedValid = YES;
+    return YES;
+}
+
+
+
+
+
+
+/*
+ *  FIND DENSE TRAILING BLOCK
+ *
+ *  Fill-ins often make the last rows and columns of the factored matrix
+ *  nearly full.  This routine looks for the largest trailing block, at
+ *  least DENSE_TAIL_MIN_SIZE and at most DENSE_TAIL_MAX_SIZE on a side,
+ *  that has a fraction of at least DENSE_TAIL_DENSITY of its entries
+ *  present.  That block is then factored as a packed dense matrix by
+ *  FactorDenseTail().  If no such block is found, or there is no memory
+ *  for it, CscDenseStart is set past the end of the matrix and the whole
+ *  matrix is factored sparse.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (MatrixPtr)
+ *      Pointer to matrix.  CompressMatrix() must have filled the column
+ *      arrays.
+ */
+
+static void
+FindDenseTail( MatrixPtr Matrix )
+{
+    int  *ColStart = Matrix->CscColStart;
+    int  *Row = Matrix->CscRow;
+    int  *Count;
+    int  Step, Size, I, Start, M;
+    long  Present;
+
+    /* Begin `FindDenseTail'. */
+    Size = Matrix->Size;
+    Start = Size + 1;
+    SP_FREE( Matrix->CscDense );
+    Matrix->CscDenseStart = Start;
+    Matrix->CscDenseSize = 0;
+    if (Size < DENSE_TAIL_MIN_SIZE)
+        return;
+
+    /* Count[k] is the number of entries whose lower index is k. */
+    Count = SP_MALLOC( int, Size + 1 );
+    if (Count == NULL)
+        return;
+    for (Step = 1; Step <= Size; Step++)
+        Count[Step] = 0;
+    for (Step = 1; Step <= Size; Step++) {
+        for (I = ColStart[Step]; I < ColStart[Step + 1]; I++)
+            Count[MIN( Row[I], Step )]++;
+    }
+
+    Present = 0;
+    for (Step = Size; Step >= 1; Step--) {
+        Present += Count[Step];
+        M = Size - Step + 1;
+        if (M > DENSE_TAIL_MAX_SIZE)
+            break;
+        if (M >= DENSE_TAIL_MIN_SIZE &&
+            Present >= DENSE_TAIL_DENSITY * (double) M * (double) M)
+            Start = Step;
+    }
+    SP_FREE( Count );
+
+    if (Start > Size)
+        return;
+
+    /* Room for complex values.  SP_CALLOC returns NULL instead of
+       exiting when there is no memory, the tail is factored sparse then. */
+    M = Size - Start + 1;
+    SP_CALLOC( Matrix->CscDense, RealNumber, 2 * (size_t) M * (size_t) M );
+    if (Matrix->CscDense == NULL)
+        return;
+    Matrix->CscDenseStart = Start;
+    Matrix->CscDenseSize = M;
+}
+
+
+
+
+
+
+/*
+ *  FACTOR COMPRESSED MATRIX
+ *
+ *  Performs the same "row at a time" factorization as spFactor(), but
+ *  on the compressed column arrays built by CompressMatrix().  The
+ *  values are gathered from the element lists first, and the factors
+ *  are written back afterwards, so spSolve() and the other routines
+ *  see no difference.
+ *
+ *  >>> Returned:
+ *  The error code is returned.  Possible errors are listed below.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (char *)
+ *      Pointer to matrix.
+ *
+ *  >>> Possible errors:
+ *  spZERO_DIAG
+ *  Error is cleared in this function.
+ */
+
+static int
+FactorCompressedMatrix( MatrixPtr Matrix )
+{
+    int  *ColStart = Matrix->CscColStart;
+    int  *Diag = Matrix->CscDiag;
+    int  *Row = Matrix->CscRow;
+    ElementPtr  *Element = Matrix->CscElement;
+    RealVector  Value = Matrix->CscValue;
+    RealVector  Dest = Matrix->Intermediate;
+    RealVector  Column;
+    int  Step, Size, Count, I, J, End, PivotRow, DenseStart, DenseSize;
+    RealNumber  Mult;
+
+    /* Begin `FactorCompressedMatrix'. */
+    Size = Matrix->Size;
+    Count = ColStart[Size + 1];
+    DenseStart = Matrix->CscDenseStart;
+    DenseSize = Matrix->CscDenseSize;
+
+    /* Gather the values loaded into the element lists. */
+    for (I = 0; I < Count; I++)
+        Value[I] = Element[I]->Real;
+
+    for (Step = 1; Step <= Size; Step++) {
+        End = ColStart[Step + 1];
+
+        /* Scatter. */
+        if (Step >= DenseStart) {
+            for (I = DenseStart; I <= Size; I++)
+                Dest[I] = 0.0;
+        }
+        for (I = ColStart[Step]; I < End; I++)
+            Dest[Row[I]] = Value[I];
+
+        /* Update column, leaving the pivots of the dense block alone. */
+        for (I = ColStart[Step]; I < Diag[Step]; I++) {
+            PivotRow = Row[I];
+            if (PivotRow >= DenseStart)
+                break;
+            Mult = Value[I] = Dest[PivotRow] * Value[Diag[PivotRow]];
+            for (J = Diag[PivotRow] + 1; J < ColStart[PivotRow + 1]; J++)
+                Dest[Row[J]] -= Mult * Value[J];
+        }
+
+        if (Step >= DenseStart) {
+            /* Hand the rest of the column to the dense block. */
+            Column = Matrix->CscDense + (Step - DenseStart) * DenseSize;
+            for (I = DenseStart; I <= Size; I++)
+                Column[I - DenseStart] = Dest[I];
+            continue;
+        }
+
+        /* Gather. */
+        for (I = Diag[Step] + 1; I < End; I++)
+            Value[I] = Dest[Row[I]];
+
+        /* Check for singular matrix. */
+        if (Dest[Step] == 0.0) return ZeroPivot( Matrix, Step );
+        Value[Diag[Step]] = 1.0 / Dest[Step];
+    }
+
+    if (DenseStart <= Size) {
+        Step = FactorDenseTail( Matrix->CscDense, DenseSize );
+        if (Step != 0) return ZeroPivot( Matrix, DenseStart + Step - 1 );
+
+        /* Gather the dense block. */
+        for (Step = DenseStart; Step <= Size; Step++) {
+            Column = Matrix->CscDense + (Step - DenseStart) * DenseSize;
+            for (I = ColStart[Step]; I < ColStart[Step + 1]; I++) {
+                if (Row[I] >= DenseStart)
+                    Value[I] = Column[Row[I] - DenseStart];
+            }
+        }
+    }
+
+    /* Store the factors in the element lists. */
+    for (I = 0; I < Count; I++)
+        Element[I]->Real = Value[I];
+
+    Matrix->Factored = YES;
+    return (Matrix->Error = spOKAY);
+}
+
+
+
+
+
+
+/*
+ *  FACTOR COMPRESSED COMPLEX MATRIX
+ *
+ *  This routine is the companion routine to FactorCompressedMatrix(),
+ *  it handles complex matrices.  It is otherwise identical.
+ *
+ *  >>> Returned:
+ *  The error code is returned.  Possible errors are listed below.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (char *)
+ *      Pointer to matrix.
+ *
+ *  >>> Possible errors:
+ *  spSINGULAR
+ *  Error is cleared in this function.
+ */
+
+static int
+FactorCompressedComplexMatrix( MatrixPtr Matrix )
+{
+    ElementPtr  *Element = Matrix->CscElement;
+    ComplexVector  Value = (ComplexVector)Matrix->CscValue;
+    int  Step, Count, I;
+
+    /* Begin `FactorCompressedComplexMatrix'. */
+    Count = Matrix->CscColStart[Matrix->Size + 1];
+
+    /* Gather the values loaded into the element lists. */
+    for (I = 0; I < Count; I++)
+        Value[I] = *(ComplexNumber *)Element[I];
+
+    Step = EliminateCompressedComplex( Matrix, Value,
+                                       (ComplexVector)Matrix->Intermediate,
+                                       (ComplexVector)Matrix->CscDense );
+    if (Step != 0) return ZeroPivot( Matrix, Step );
+
+    /* Store the factors in the element lists. */
+    for (I = 0; I < Count; I++)
+        *(ComplexNumber *)Element[I] = Value[I];
+
+    Matrix->Factored = YES;
+    return (Matrix->Error = spOKAY);
+}
+
+
+
+
+
+
+/*
+ *  ELIMINATE COMPRESSED COMPLEX MATRIX
+ *
+ *  Factors complex values given in the order of the compressed column
+ *  arrays.  The matrix frame is only read, so several sets of values
+ *  can be factored at the same time, each with its own Dest and Dense
+ *  storage.
+ *
+ *  >>> Returned:
+ *  Zero on success, otherwise the step at which a zero pivot was found.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (MatrixPtr)
+ *      Pointer to matrix.
+ *  Value  <input/output>  (ComplexVector)
+ *      The values of the compressed entries, replaced by the factors.
+ *  Dest  <output>  (ComplexVector)
+ *      Work vector of Size + 1 entries.
+ *  Dense  <output>  (ComplexVector)
+ *      Storage for the dense trailing block, CscDenseSize squared entries.
+ */
+
+static int
+EliminateCompressedComplex( MatrixPtr Matrix, ComplexVector Value,
+                            ComplexVector Dest, ComplexVector Dense )
+{
+    int  *ColStart = Matrix->CscColStart;
+    int  *Diag = Matrix->CscDiag;
+    int  *Row = Matrix->CscRow;
+    ComplexVector  Column;
+    int  Step, Size, I, J, End, PivotRow, DenseStart, DenseSize;
+    ComplexNumber  Mult, Pivot;
+
+    /* Begin `EliminateCompressedComplex'. */
+    Size = Matrix->Size;
+    DenseStart = Matrix->CscDenseStart;
+    DenseSize = Matrix->CscDenseSize;
+
+    for (Step = 1; Step <= Size; Step++) {
+        End = ColStart[Step + 1];
+
+        /* Scatter. */
+        if (Step >= DenseStart) {
+            for (I = DenseStart; I <= Size; I++)
+                CMPLX_ASSIGN_VALUE(Dest[I], 0.0, 0.0);
+        }
+        for (I = ColStart[Step]; I < End; I++)
+            Dest[Row[I]] = Value[I];
+
+        /* Update column, leaving the pivots of the dense block alone. */
+        for (I = ColStart[Step]; I < Diag[Step]; I++) {
+            PivotRow = Row[I];
+            if (PivotRow >= DenseStart)
+                break;
+            /* Cmplx expr: Mult = Dest[PivotRow] * (1.0 / *pPivot). */
+            CMPLX_MULT(Mult, Dest[PivotRow], Value[Diag[PivotRow]]);
+            CMPLX_ASSIGN(Value[I], Mult);
+            for (J = Diag[PivotRow] + 1; J < ColStart[PivotRow + 1]; J++) {
+                /* Cmplx expr: Dest[Row[J]] -= Mult * Value[J] */
+                CMPLX_MULT_SUBT_ASSIGN(Dest[Row[J]], Mult, Value[J]);
+            }
+        }
+
+        if (Step >= DenseStart) {
+            /* Hand the rest of the column to the dense block. */
+            Column = Dense + (Step - DenseStart) * DenseSize;
+            for (I = DenseStart; I <= Size; I++)
+                Column[I - DenseStart] = Dest[I];
+            continue;
+        }
+
+        /* Gather. */
+        for (I = Diag[Step] + 1; I < End; I++)
+            Value[I] = Dest[Row[I]];
+
+        /* Check for singular matrix. */
+        Pivot = Dest[Step];
+        if (CMPLX_1_NORM(Pivot) == 0.0) return Step;
+        CMPLX_RECIPROCAL( Value[Diag[Step]], Pivot );
+    }
+
+    if (DenseStart <= Size) {
+        Step = FactorDenseComplexTail( Dense, DenseSize );
+        if (Step != 0) return DenseStart + Step - 1;
+
+        /* Gather the dense block. */
+        for (Step = DenseStart; Step <= Size; Step++) {
+            Column = Dense + (Step - DenseStart) * DenseSize;
+            for (I = ColStart[Step]; I < ColStart[Step + 1]; I++) {
+                if (Row[I] >= DenseStart)
+                    Value[I] = Column[Row[I] - DenseStart];
+            }
+        }
+    }
+    return 0;
+}
+
+
+
+
+
+
+
+/*
+ *  FACTOR DENSE TRAILING BLOCK
+ *
+ *  Factors the packed dense block found by FindDenseTail(), after the
+ *  sparse columns have been eliminated from it.  The block is stored by
+ *  columns and is factored in place in the same "row at a time" order
+ *  as the rest of the matrix, with the reciprocals of the pivots on the
+ *  diagonal.  The inner loops run over contiguous memory so that the
+ *  compiler can vectorize them.
+ *
+ *  >>> Returned:
+ *  Zero on success, otherwise the step within the block, counted from
+ *  one, at which a zero pivot was found.
+ *
+ *  >>> Arguments:
+ *  Dense  <input/output>  (RealVector)
+ *      The block, replaced by its factors.
+ *  M  <input>  (int)
+ *      The number of rows and columns in the block.
+ */
+
+static int
+FactorDenseTail( RealVector Dense, int M )
+{
+    RealVector  Column, Pivot;
+    int  Step, K, I;
+    RealNumber  Mult;
+
+    /* Begin `FactorDenseTail'. */
+    for (Step = 0; Step < M; Step++) {
+        Column = Dense + Step * M;
+
+        for (K = 0; K < Step; K++) {
+            Pivot = Dense + K * M;
+            Mult = Column[K] *= Pivot[K];
+            if (Mult == 0.0)
+                continue;
+            for (I = K + 1; I < M; I++)
+                Column[I] -= Mult * Pivot[I];
+        }
+
+        if (Column[Step] == 0.0)
+            return Step + 1;
+        Column[Step] = 1.0 / Column[Step];
+    }
+    return 0;
+}
+
+
+static int
+FactorDenseComplexTail( ComplexVector Dense, int M )
+{
+    ComplexVector  Column, Pivot;
+    int  Step, K, I;
+    ComplexNumber  Mult, Diagonal;
+
+    /* Begin `FactorDenseComplexTail'. */
+    for (Step = 0; Step < M; Step++) {
+        Column = Dense + Step * M;
+
+        for (K = 0; K < Step; K++) {
+            Pivot = Dense + K * M;
+            /* Cmplx expr: Mult = Column[K] * (1.0 / Pivot[K]). */
+            CMPLX_MULT(Mult, Column[K], Pivot[K]);
+            CMPLX_ASSIGN(Column[K], Mult);
+            if (Mult.Real == 0.0 && Mult.Imag == 0.0)
+                continue;
+            for (I = K + 1; I < M; I++) {
+                /* Cmplx expr: Column[I] -= Mult * Pivot[I] */
+                CMPLX_MULT_SUBT_ASSIGN(Column[I], Mult, Pivot[I]);
+            }
+        }
+
+        Diagonal = Column[Step];
+        if (CMPLX_1_NORM(Diagonal) == 0.0)
+            return Step + 1;
+        CMPLX_RECIPROCAL( Column[Step], Diagonal );
+    }
+    return 0;
+}
+
+
+
+
+
 
 /*
  *  PARTITION MATRIX
@@ -685,6 +1265,94 @@ spPartition(MatrixPtr Matrix, int Mode)
 
 
 
+
+/*
+ *  COMPRESSED COPIES OF A COMPLEX MATRIX
+ *
+ *  These routines let the caller factor and solve several sets of
+ *  values of a complex matrix at once, for example the matrices of
+ *  several frequencies of an AC analysis.  Each set of values lives in
+ *  an array of the caller, in the order of the compressed column
+ *  arrays, and only the structure of the matrix is shared.  The matrix
+ *  must have been ordered before, and the ordering of the matrix is
+ *  used without any pivoting.
+ *
+ *  spCompressedSizes() builds the compressed arrays if necessary and
+ *  returns the number of RealNumbers needed for one set of values and
+ *  for the work area of one caller.  It returns NO if the matrix is not
+ *  complex, not yet ordered, or there is not enough memory.
+ *  spCompressedGather() copies the values currently loaded into the
+ *  matrix into Values.  spCompressedFactor() factors Values in place
+ *  and only reads the matrix, so it may run in several threads at once,
+ *  each with its own Work area.  It returns spZERO_DIAG if a pivot is
+ *  zero, without changing the matrix.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (MatrixPtr)
+ *      Pointer to matrix.
+ *  pValues  <output>  (int *)
+ *      Number of RealNumbers in one set of values.
+ *  pWork  <output>  (int *)
+ *      Number of RealNumbers in one work area.
+ *  Values  <input/output>  (RealVector)
+ *      One set of values.
+ *  Work  <output>  (RealVector)
+ *      A work area.
+ */
+
+int
+spCompressedSizes( MatrixPtr Matrix, int *pValues, int *pWork )
+{
+    int  Size;
+
+    /* Begin `spCompressedSizes'. */
+    assert( IS_SPARSE( Matrix ));
+    Size = Matrix->Size;
+    if (!Matrix->Complex || Matrix->NeedsOrdering || Size == 0)
+        return NO;
+    if (!Matrix->CompressedValid && !CompressMatrix( Matrix ))
+        return NO;
+
+    *pValues = 2 * Matrix->CscColStart[Size + 1];
+    *pWork = 2 * (Size + 1) +
+        2 * Matrix->CscDenseSize * Matrix->CscDenseSize;
+    return YES;
+}
+
+
+void
+spCompressedGather( MatrixPtr Matrix, RealVector Values )
+{
+    ElementPtr  *Element = Matrix->CscElement;
+    ComplexVector  Value = (ComplexVector)Values;
+    int  I, Count;
+
+    /* Begin `spCompressedGather'. */
+    assert( IS_SPARSE( Matrix ) && Matrix->CompressedValid );
+    Count = Matrix->CscColStart[Matrix->Size + 1];
+    for (I = 0; I < Count; I++)
+        Value[I] = *(ComplexNumber *)Element[I];
+}
+
+
+int
+spCompressedFactor( MatrixPtr Matrix, RealVector Values, RealVector Work )
+{
+    /* Begin `spCompressedFactor'. */
+    assert( IS_SPARSE( Matrix ) && Matrix->CompressedValid );
+
+    if (EliminateCompressedComplex( Matrix, (ComplexVector)Values,
+                                    (ComplexVector)Work,
+                                    (ComplexVector)Work + Matrix->Size + 1 ))
+        return spZERO_DIAG;
+    return spOKAY;
+}
+
+
+
+
+
+
 
 /*
  *  CREATE INTERNAL VECTORS
@@ -999,6 +1667,70 @@ SearchForPivot( MatrixPtr Matrix, int Step, int DiagPivoting )
 
 
 
+/*
+ *  FOLLOW PREVIOUS PIVOT SEQUENCE
+ *
+ *  When a pivot sequence was handed over with spSetPivots(), a full
+ *  ordering first tries the pivot that was used at this step before.
+ *  The pivot is taken if it is still in the reduced submatrix and if
+ *  it passes the same threshold tests as any other pivot candidate.
+ *  This avoids the search for pivots when the matrix of the same
+ *  circuit is built again.
+ *
+ *  >>> Returned:
+ *  A pointer to the previous pivot, or NULL if it cannot be used.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (MatrixPtr)
+ *      Pointer to matrix.
+ *  Step  <input>  (int)
+ *      Index of the diagonal currently being eliminated.
+ */
+
+static ElementPtr
+SearchPreviousPivot( MatrixPtr Matrix, int Step )
+{
+    ElementPtr  pPivot;
+    int  ExtRow, ExtCol, Row, Col;
+    RealNumber  Magnitude;
+
+    /* Begin `SearchPreviousPivot'. */
+    if (Step > Matrix->PreviousPivots)
+        return NULL;
+    ExtRow = Matrix->PreviousPivotRow[Step];
+    ExtCol = Matrix->PreviousPivotCol[Step];
+    if (ExtRow > Matrix->ExtSize || ExtCol > Matrix->ExtSize)
+        return NULL;
+
+#if TRANSLATE
+    Row = Matrix->ExtToIntRowMap[ExtRow];
+    Col = Matrix->ExtToIntColMap[ExtCol];
+#else
+    Row = ExtRow;
+    Col = ExtCol;
+#endif
+    if (Row < Step || Col < Step)
+        return NULL;
+
+    pPivot = spcFindElementInCol( Matrix, &Matrix->FirstInCol[Col],
+                                  Row, Col, NO );
+    if (pPivot == NULL)
+        return NULL;
+
+    Magnitude = ELEMENT_MAG( pPivot );
+    if (Magnitude <= Matrix->AbsThreshold ||
+        Magnitude <= Matrix->RelThreshold *
+                     FindBiggestInColExclude( Matrix, pPivot, Step ))
+        return NULL;
+    return pPivot;
+}
+
+
+
+
+
+
+
 
 
 /*
@@ -2114,6 +2846,7 @@ spcRowExchange( MatrixPtr Matrix, int Row1, int Row2 )
     ElementPtr  Element1, Element2;
 
     /* Begin `spcRowExchange'. */
+    Matrix->CompressedValid = NO;
     if (Row1 > Row2)  SWAP(int, Row1, Row2);
 
     Row1Ptr = Matrix->FirstInRow[Row1];
@@ -2208,6 +2941,7 @@ spcColExchange( MatrixPtr Matrix, int Col1, int Col2 )
     ElementPtr  Element1, Element2;
 
     /* Begin `spcColExchange'. */
+    Matrix->CompressedValid = NO;
     if (Col1 > Col2)  SWAP(int, Col1, Col2);
 
     Col1Ptr = Matrix->FirstInCol[Col1];
@@ -26,6 +26,13 @@
  *  SMPnewMatrix
  *  SMPdestroy
  *  SMPpreOrder
+ *  SMPsetCompressed
+ *  SMPcCopySizes
+ *  SMPcCopyGather
+ *  SMPcCopyLUfac
+ *  SMPcCopySolve
+ *  SMPgetPivots
+ *  SMPsetPivots
  *  SMPprint
  *  SMPgetError
  *  SMPcProdDiag
@@ -275,6 +282,85 @@ SMPpreOrder(SMPmatrix *Matrix)
     return spError( Matrix );
 }
 
+/*
+ * SMPsetCompressed()
+ */
+void
+SMPsetCompressed(SMPmatrix *Matrix, int Compressed)
+{
+    spSetCompressed( Matrix, Compressed );
+}
+
+/*
+ * SMPcCopySizes()
+ */
+int
+SMPcCopySizes(SMPmatrix *Matrix, int *NumValues, int *NumWork)
+{
+    return spCompressedSizes( Matrix, NumValues, NumWork );
+}
+
+/*
+ * SMPcCopyGather()
+ */
+void
+SMPcCopyGather(SMPmatrix *Matrix, double Values[])
+{
+    spCompressedGather( Matrix, Values );
+}
+
+/*
+ * SMPcCopyLUfac()
+ */
+int
+SMPcCopyLUfac(SMPmatrix *Matrix, double Values[], double Work[])
+{
+    return spCompressedFactor( Matrix, Values, Work );
+}
+
+/*
+ * SMPcCopySolve()
+ */
+void
+SMPcCopySolve(SMPmatrix *Matrix, double Values[], double Work[],
+	      double RHS[], double iRHS[])
+{
+    spCompressedSolve( Matrix, Values, Work, RHS, RHS, iRHS, iRHS );
+}
+
+/*
+ * SMPgetPivots()
+ * Returns the number of pivots of an ordered matrix and allocates the
+ * arrays with their external rows and columns.
+ */
+int
+SMPgetPivots(SMPmatrix *Matrix, int **Rows, int **Cols)
+{
+    int Size = spGetSize( Matrix, 0 );
+    int Count;
+
+    *Rows = SP_MALLOC( int, Size + 1 );
+    *Cols = SP_MALLOC( int, Size + 1 );
+    if (*Rows == NULL || *Cols == NULL)
+        Count = 0;
+    else
+        Count = spGetPivots( Matrix, *Rows, *Cols );
+    if (Count == 0) {
+        SP_FREE( *Rows );
+        SP_FREE( *Cols );
+    }
+    return Count;
+}
+
+/*
+ * SMPsetPivots()
+ */
+void
+SMPsetPivots(SMPmatrix *Matrix, int Count, int *Rows, int *Cols)
+{
+    spSetPivots( Matrix, Count, Rows, Cols );
+}
+
 /*
  * SMPprint()
  */
@@ -11,6 +11,7 @@
  *  >>> User accessible functions contained in this file:
  *  spSolve
  *  spSolveTransposed
+ *  spCompressedSolve
  *
  *  >>> Other functions contained in this file:
  *  SolveComplexMatrix
@@ -602,3 +603,105 @@ SolveComplexTransposedMatrix(MatrixPtr Matrix, RealVector RHS, RealVector Soluti
     return;
 }
 #endif /* TRANSPOSE */
+
+
+
+
+
+
+
+
+/*
+ *  SOLVE WITH A COMPRESSED COPY
+ *
+ *  Solves a complex system with a set of values factored by
+ *  spCompressedFactor().  The substitutions run in the same order as
+ *  in SolveComplexMatrix(), so the result is the same as factoring and
+ *  solving the matrix itself.  The matrix is only read, so several
+ *  solves may run at once, each with its own Work area.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (MatrixPtr)
+ *      Pointer to matrix.
+ *  Values  <input>  (RealVector)
+ *      The factored values.
+ *  Work  <output>  (RealVector)
+ *      A work area of the size given by spCompressedSizes().
+ *  RHS  <input>  (RealVector)
+ *      Real part of the right-hand side.
+ *  Solution  <output>  (RealVector)
+ *      Real part of the solution, may be the same as RHS.
+ *  iRHS  <input>  (RealVector)
+ *      Imaginary part of the right-hand side.
+ *  iSolution  <output>  (RealVector)
+ *      Imaginary part of the solution, may be the same as iRHS.
+ */
+
+void
+spCompressedSolve( MatrixPtr Matrix, RealVector Values, RealVector Work,
+                   RealVector RHS, RealVector Solution,
+                   RealVector iRHS, RealVector iSolution )
+{
+    int  *ColStart = Matrix->CscColStart;
+    int  *Diag = Matrix->CscDiag;
+    int  *Row = Matrix->CscRow;
+    int  *UpperStart = Matrix->CscUpperStart;
+    int  *Upper = Matrix->CscUpper;
+    int  *UpperCol = Matrix->CscUpperCol;
+    ComplexVector  Value = (ComplexVector)Values;
+    ComplexVector  Intermediate = (ComplexVector)Work;
+    int  I, J, *pExtOrder, Size;
+    ComplexNumber  Temp;
+
+    /* Begin `spCompressedSolve'. */
+    assert( IS_SPARSE( Matrix ) && Matrix->CompressedValid );
+    Size = Matrix->Size;
+
+    /* Initialize Intermediate vector. */
+    pExtOrder = &Matrix->IntToExtRowMap[Size];
+    for (I = Size; I > 0; I--)
+    {
+        Intermediate[I].Real = RHS[*(pExtOrder)];
+        Intermediate[I].Imag = iRHS[*(pExtOrder--)];
+    }
+
+    /* Forward substitution. Solves Lc = b.*/
+    for (I = 1; I <= Size; I++)
+    {
+        Temp = Intermediate[I];
+
+        /* This step of the substitution is skipped if Temp equals zero. */
+        if ((Temp.Real != 0.0) || (Temp.Imag != 0.0))
+        {
+            /* Cmplx expr: Temp *= (1.0 / Pivot). */
+            CMPLX_MULT_ASSIGN(Temp, Value[Diag[I]]);
+            Intermediate[I] = Temp;
+            for (J = Diag[I] + 1; J < ColStart[I + 1]; J++)
+            {
+                /* Cmplx expr: Intermediate[Row] -= Temp * Value. */
+                CMPLX_MULT_SUBT_ASSIGN(Intermediate[Row[J]], Temp, Value[J]);
+            }
+        }
+    }
+
+    /* Backward Substitution. Solves Ux = c.*/
+    for (I = Size; I > 0; I--)
+    {
+        Temp = Intermediate[I];
+        for (J = UpperStart[I]; J < UpperStart[I + 1]; J++)
+        {
+            /* Cmplx expr: Temp -= Value * Intermediate[Col]. */
+            CMPLX_MULT_SUBT_ASSIGN(Temp, Value[Upper[J]],
+                                   Intermediate[UpperCol[J]]);
+        }
+        Intermediate[I] = Temp;
+    }
+
+    /* Unscramble Intermediate vector while placing data in to Solution vector. */
+    pExtOrder = &Matrix->IntToExtColMap[Size];
+    for (I = Size; I > 0; I--)
+    {
+        Solution[*(pExtOrder)] = Intermediate[I].Real;
+        iSolution[*(pExtOrder--)] = Intermediate[I].Imag;
+    }
+}
@@ -1040,6 +1040,7 @@ spStripFills(MatrixPtr Matrix)
     assert( IS_SPARSE( Matrix ) );
     if (Matrix->Fillins == 0) return;
     Matrix->NeedsOrdering = YES;
+    Matrix->CompressedValid = NO;
     Matrix->Elements -= Matrix->Fillins;
     Matrix->Fillins = 0;
 
@@ -1110,6 +1111,7 @@ spStripMatrix(MatrixPtr Matrix)
     if (Matrix->Elements == 0) return;
     Matrix->RowsLinked = NO;
     Matrix->NeedsOrdering = YES;
+    Matrix->CompressedValid = NO;
     Matrix->Elements = 0;
     Matrix->Originals = 0;
     Matrix->Fillins = 0;
@@ -1262,6 +1264,7 @@ spDeleteRowAndCol(MatrixPtr Matrix, int Row, int Col)
     Matrix->ExtToIntRowMap[ExtRow] = -1;
     Matrix->ExtToIntColMap[ExtCol] = -1;
     Matrix->NeedsOrdering = YES;
+    Matrix->CompressedValid = NO;
 
     return;
 }
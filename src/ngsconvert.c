@@ -371,7 +371,7 @@ main(int ac, char **av)
             fprintf(cp_err, 
                 "Usage: %s fromtype fromfile totype tofile,\n",
                 cp_program);
-            fprintf(cp_err, "\twhere types are o, b, or a\n");
+            fprintf(cp_err, "\twhere types are o, b, c, or a\n");
             fprintf(cp_err, 
                 "\tor, %s fromtype totype, used as a filter.\n",
                 cp_program);
@@ -384,11 +384,12 @@ main(int ac, char **av)
 
         case 'b' :
         case 'a' :
+        case 'c' :
         pl = raw_read(sf);
         break;
 
         default:
-        fprintf(cp_err, "Types are o, a, or b\n");
+        fprintf(cp_err, "Types are o, a, b, or c\n");
         exit(EXIT_BAD);
     }
     if (!pl)
@@ -400,15 +401,19 @@ main(int ac, char **av)
         break;
 
         case 'b' :
-        raw_write(af, pl, FALSE, TRUE);
+        raw_write(af, pl, FALSE, TRUE, FALSE);
+        break;
+
+        case 'c' :
+        raw_write(af, pl, FALSE, TRUE, TRUE);
         break;
 
         case 'a' :
-        raw_write(af, pl, FALSE, FALSE);
+        raw_write(af, pl, FALSE, FALSE, FALSE);
         break;
 
         default:
-        fprintf(cp_err, "Types are o, a, or b\n");
+        fprintf(cp_err, "Types are o, a, b, or c\n");
         exit(EXIT_BAD);
     }
     if (ac == 3) {
@@ -16,6 +16,11 @@
 #define STDERR_FILENO   2
 #endif
 
+/* dlmopen() and dladdr() for ngSpice_New(), before any system header */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 /* If a calling function has high latency times during printing,
    causing memory access errors, you may undef the following line.
    Printing messages are assembled in a wordlist, and sent to the caller
@@ -160,6 +165,10 @@ typedef void (*sighandler)(int);
 #include <fcntl.h>
 #include <sys/stat.h>
 
+#ifdef HAVE_DLMOPEN
+#include <dlfcn.h>
+#endif
+
 #ifdef _MSC_VER
 #define S_IRWXU _S_IWRITE
 #endif
@@ -184,6 +193,7 @@ int sh_fputsll(const char *input, FILE* outf);
 int sh_ExecutePerLoop(void);
 double getvsrcval(double, char*);
 int sh_vecinit(runDesc *run);
+void sh_vecend(runDesc *run);
 
 ATTRIBUTE_NORETURN void shared_exit(int status);
 
@@ -211,6 +221,10 @@ static BGThreadRunning* bgtr;
 static GetVSRCData* getvdat;
 static GetISRCData* getidat;
 static GetSyncData* getsync;
+static SendDataBlock* blockfcn;
+static int blocksize;
+static double* ringbuf;
+static int ringsize;
 static pvector_info myvec = NULL;
 char **allvecs = NULL;
 char **allplots = NULL;
@@ -564,6 +578,26 @@ ngSpice_Init_Sync(GetVSRCData *vsrcdat, GetISRCData *isrcdat, GetSyncData *syncd
 }
 
 
+/* Initialise streaming of output data in blocks */
+IMPEXP
+int
+ngSpice_Init_Block(SendDataBlock* sblock, int bsize, double* rbuf, int rsize)
+{
+    blockfcn = sblock;
+    blocksize = (bsize < 1) ? 256 : bsize;
+    /* if caller sends NULL, send pointers into the vectors */
+    if (rbuf && rsize > 0) {
+        ringbuf = rbuf;
+        ringsize = rsize;
+    }
+    else {
+        ringbuf = NULL;
+        ringsize = 0;
+    }
+    return 0;
+}
+
+
 /* Initialise ngspice and setup native methods */
 IMPEXP
 int
@@ -974,6 +1008,217 @@ add_bkpt(void)
 }
 
 
+/* Simulators of their own: each handle is a further image of this
+   library in a new link map, with all of the globals of ngspice anew.
+   The functions ending in _h call the exported functions of that
+   image. */
+
+struct ngspice_handle {
+    void *image;
+    bool initialized;
+    int (*init)(SendChar*, SendStat*, ControlledExit*, SendData*,
+                SendInitData*, BGThreadRunning*, void*);
+    int (*init_sync)(GetVSRCData*, GetISRCData*, GetSyncData*, int*, void*);
+    int (*init_block)(SendDataBlock*, int, double*, int);
+    int (*command)(char*);
+    pvector_info (*vec_info)(char*);
+    int (*circ)(char**);
+    char* (*curplot)(void);
+    char** (*allplots)(void);
+    char** (*allvecs)(char*);
+    bool (*running)(void);
+    bool (*setbkpt)(double);
+    void (*ctype_init)(void);
+};
+
+
+/* The threads of the caller are started by the C library of the first
+   image. With glibc, the new image has a C library of its own, whose
+   per thread locale pointers are then still unset; set them here. */
+static void
+handle_enter(ngSpiceHandle* h)
+{
+    if (h->ctype_init)
+        h->ctype_init();
+}
+
+/* load a new image of this library, NULL if not possible */
+IMPEXP
+ngSpiceHandle* ngSpice_New(void)
+{
+#ifdef HAVE_DLMOPEN
+    Dl_info info;
+    ngSpiceHandle *h;
+    void *image;
+
+    if (!dladdr((void *) ngSpice_New, &info) || !info.dli_fname) {
+        fprintf(stderr, "Error: cannot find the ngspice library\n");
+        return NULL;
+    }
+    image = dlmopen(LM_ID_NEWLM, info.dli_fname, RTLD_NOW | RTLD_LOCAL);
+    if (!image) {
+        fprintf(stderr, "Error: cannot load a new ngspice: %s\n", dlerror());
+        return NULL;
+    }
+
+    h = TMALLOC(ngSpiceHandle, 1);
+    h->image = image;
+    h->initialized = FALSE;
+    *(void **) &h->init = dlsym(image, "ngSpice_Init");
+    *(void **) &h->init_sync = dlsym(image, "ngSpice_Init_Sync");
+    *(void **) &h->init_block = dlsym(image, "ngSpice_Init_Block");
+    *(void **) &h->command = dlsym(image, "ngSpice_Command");
+    *(void **) &h->vec_info = dlsym(image, "ngGet_Vec_Info");
+    *(void **) &h->circ = dlsym(image, "ngSpice_Circ");
+    *(void **) &h->curplot = dlsym(image, "ngSpice_CurPlot");
+    *(void **) &h->allplots = dlsym(image, "ngSpice_AllPlots");
+    *(void **) &h->allvecs = dlsym(image, "ngSpice_AllVecs");
+    *(void **) &h->running = dlsym(image, "ngSpice_running");
+    *(void **) &h->setbkpt = dlsym(image, "ngSpice_SetBkpt");
+    /* optional, glibc only */
+    *(void **) &h->ctype_init = dlsym(image, "__ctype_init");
+
+    if (!h->init || !h->init_sync || !h->init_block || !h->command ||
+        !h->vec_info || !h->circ || !h->curplot || !h->allplots ||
+        !h->allvecs || !h->running || !h->setbkpt) {
+        fprintf(stderr, "Error: the new ngspice lacks its interface\n");
+        dlclose(image);
+        tfree(h);
+        return NULL;
+    }
+    return h;
+#else
+    fprintf(stderr, "Error: a new ngspice needs dlmopen(), not available here\n");
+    return NULL;
+#endif
+}
+
+
+/* quit the simulator of handle, wait for its background thread, and
+   unload it */
+IMPEXP
+void ngSpice_Delete(ngSpiceHandle* h)
+{
+    if (!h)
+        return;
+#ifdef HAVE_DLMOPEN
+    if (h->initialized) {
+        handle_enter(h);
+        if (h->running()) {
+            h->command("bg_halt");
+            while (h->running())
+                usleep(10000);
+        }
+        h->command("quit");
+    }
+    dlclose(h->image);
+#endif
+    tfree(h);
+}
+
+
+IMPEXP
+int ngSpice_Init_h(ngSpiceHandle* h, SendChar* printfcn, SendStat* statusfcn,
+                   ControlledExit* ngspiceexit, SendData* sdata,
+                   SendInitData* sinitdata, BGThreadRunning* bgtrun, void* userData)
+{
+    sighandler old_sigint;
+    int ret;
+
+    /* SIGINT stays with this image: a handler in the new one would be
+       left dangling when it is unloaded */
+    old_sigint = signal(SIGINT, SIG_IGN);
+    handle_enter(h);
+    ret = h->init(printfcn, statusfcn, ngspiceexit, sdata, sinitdata,
+                  bgtrun, userData);
+    signal(SIGINT, old_sigint);
+    h->initialized = TRUE;
+    return ret;
+}
+
+
+IMPEXP
+int ngSpice_Init_Sync_h(ngSpiceHandle* h, GetVSRCData *vsrcdat, GetISRCData *isrcdat,
+                        GetSyncData *syncdat, int *ident, void *userData)
+{
+    handle_enter(h);
+    return h->init_sync(vsrcdat, isrcdat, syncdat, ident, userData);
+}
+
+
+IMPEXP
+int ngSpice_Init_Block_h(ngSpiceHandle* h, SendDataBlock* sblock, int bsize,
+                         double* rbuf, int rsize)
+{
+    handle_enter(h);
+    return h->init_block(sblock, bsize, rbuf, rsize);
+}
+
+
+IMPEXP
+int ngSpice_Command_h(ngSpiceHandle* h, char* comexec)
+{
+    handle_enter(h);
+    return h->command(comexec);
+}
+
+
+IMPEXP
+pvector_info ngGet_Vec_Info_h(ngSpiceHandle* h, char* vecname)
+{
+    handle_enter(h);
+    return h->vec_info(vecname);
+}
+
+
+IMPEXP
+int ngSpice_Circ_h(ngSpiceHandle* h, char** circa)
+{
+    handle_enter(h);
+    return h->circ(circa);
+}
+
+
+IMPEXP
+char* ngSpice_CurPlot_h(ngSpiceHandle* h)
+{
+    handle_enter(h);
+    return h->curplot();
+}
+
+
+IMPEXP
+char** ngSpice_AllPlots_h(ngSpiceHandle* h)
+{
+    handle_enter(h);
+    return h->allplots();
+}
+
+
+IMPEXP
+char** ngSpice_AllVecs_h(ngSpiceHandle* h, char* plotname)
+{
+    handle_enter(h);
+    return h->allvecs(plotname);
+}
+
+
+IMPEXP
+bool ngSpice_running_h(ngSpiceHandle* h)
+{
+    handle_enter(h);
+    return h->running();
+}
+
+
+IMPEXP
+bool ngSpice_SetBkpt_h(ngSpiceHandle* h, double time)
+{
+    handle_enter(h);
+    return h->setbkpt(time);
+}
+
+
 /* use the original vprintf() in the rest of this file
  *   instead of the redirected variant
  */
@@ -1667,6 +1912,146 @@ int sh_ExecutePerLoop_old(void)
 }
 #endif
 
+/* block streaming state of the current plot:
+   points [blockstart, v_length) of the plot vectors are not sent yet */
+static struct plot *blockplot = NULL;
+static int blockstart = 0;
+static int ringpos = 0;
+static bool blockring = FALSE;
+static pvecblockall curvecblockall = NULL;
+
+
+/* send points [blockstart, end) of the plot vectors via blockfcn() */
+static void
+sh_blocksend(int end)
+{
+    struct dvec *d;
+    int i, count = end - blockstart;
+
+    curvecblockall->vecindex = blockstart;
+    curvecblockall->count = count;
+
+    if (blockring) {
+        /* doubles needed for this block */
+        int need = 0;
+        for (d = blockplot->pl_dvecs; d; d = d->v_next)
+            need += isreal(d) ? count : 2 * count;
+        if (ringpos + need > ringsize)
+            ringpos = 0;
+        for (d = blockplot->pl_dvecs, i = 0; d; d = d->v_next, i++) {
+            pvecblock vb = curvecblockall->vecsa[i];
+            if (isreal(d)) {
+                vb->realdata = ringbuf + ringpos;
+                memcpy(vb->realdata, d->v_realdata + blockstart,
+                       (size_t) count * sizeof(double));
+                ringpos += count;
+            }
+            else {
+                vb->compdata = (ngcomplex_t *) (ringbuf + ringpos);
+                memcpy(vb->compdata, d->v_compdata + blockstart,
+                       (size_t) count * sizeof(ngcomplex_t));
+                ringpos += 2 * count;
+            }
+        }
+    }
+    else {
+        for (d = blockplot->pl_dvecs, i = 0; d; d = d->v_next, i++) {
+            pvecblock vb = curvecblockall->vecsa[i];
+            if (isreal(d))
+                vb->realdata = d->v_realdata + blockstart;
+            else
+                vb->compdata = d->v_compdata + blockstart;
+        }
+    }
+
+    blockfcn(curvecblockall, curvecblockall->veccount, ng_ident, userptr);
+
+    blockstart = end;
+}
+
+
+/* set up the block transfer structure for a new plot */
+static void
+sh_blockinit(runDesc *run)
+{
+    struct dvec *d;
+    int veccount, i, need;
+
+    blockplot = NULL;
+
+    /* nothing to point into if the data go to a rawfile */
+    if (!blockfcn || run->writeOut || !run->runPlot || !run->runPlot->pl_dvecs)
+        return;
+
+    if (curvecblockall) {
+        for (i = 0; i < curvecblockall->veccount; i++)
+            tfree(curvecblockall->vecsa[i]);
+        tfree(curvecblockall->vecsa);
+    }
+    else {
+        curvecblockall = TMALLOC(vecblockall, 1);
+    }
+
+    veccount = 0;
+    need = 0;
+    for (d = run->runPlot->pl_dvecs; d; d = d->v_next) {
+        veccount++;
+        need += isreal(d) ? blocksize : 2 * blocksize;
+    }
+
+    curvecblockall->veccount = veccount;
+    curvecblockall->vecsa = TMALLOC(pvecblock, veccount);
+
+    for (i = 0, d = run->runPlot->pl_dvecs; d; i++, d = d->v_next) {
+        pvecblock vb = curvecblockall->vecsa[i] = TMALLOC(vecblock, 1);
+        vb->name = d->v_name;
+        vb->is_scale = (d == run->runPlot->pl_scale);
+        vb->is_complex = !isreal(d);
+    }
+
+    blockring = (ringbuf != NULL);
+    if (blockring && need > ringsize) {
+        fprintf(cp_err,
+                "Warning: ring buffer too small for %d vectors, need %d doubles,\n"
+                "    sending pointers into the vectors instead\n",
+                veccount, need);
+        blockring = FALSE;
+    }
+
+    ringpos = 0;
+    blockstart = 0;
+    blockplot = run->runPlot;
+}
+
+
+/* called from sh_ExecutePerLoop() for every new point */
+static void
+sh_blockadd(void)
+{
+    int end = blockplot->pl_dvecs->v_length;
+
+    /* vectors have been emptied */
+    if (end < blockstart)
+        blockstart = 0;
+
+    if (end - blockstart >= blocksize)
+        sh_blocksend(end);
+}
+
+
+/* called once at the end of a plot from OUTendPlot() in outitf.c,
+   sends the points not yet sent */
+void sh_vecend(runDesc *run)
+{
+    if (blockplot && blockfcn && run->runPlot == blockplot) {
+        int end = blockplot->pl_dvecs->v_length;
+        if (end > blockstart)
+            sh_blocksend(end);
+    }
+    blockplot = NULL;
+}
+
+
 /* called each time a new data set is written to the output vectors */
 int sh_ExecutePerLoop(void)
 {
@@ -1674,6 +2059,10 @@ int sh_ExecutePerLoop(void)
     int i, veclen;
 //  double testval;
     struct plot *pl = plot_cur;
+
+    if (blockplot)
+        sh_blockadd();
+
     /* return immediately if callback not wanted */
     if (nodatawanted)
         return 2;
@@ -1713,6 +2102,8 @@ int sh_vecinit(runDesc *run)
     static pvecinfoall pvca = NULL;
     pvecinfo *pvc;
 
+    sh_blockinit(run);
+
     /* return immediately if callback not wanted */
     if (nodatainitwanted)
         return 2;
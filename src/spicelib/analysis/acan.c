@@ -20,6 +20,16 @@ Modified 2001: AlansFixes
 /* gtri - end - wbk */
 #endif
 
+#ifdef USE_OMP
+#include <omp.h>
+
+static int ACbatch(CKTcircuit *ckt, ACAN *job, double *freq, double freqTol,
+                   runDesc *acPlot, int *numDone);
+
+/* bytes the matrix copies of a batch may take at most */
+#define AC_BATCH_MEMORY (256.0 * 1024 * 1024)
+#endif
+
 
 #define INIT_STATS() \
 do { \
@@ -250,6 +260,29 @@ ACan(CKTcircuit *ckt, int restart)
             job->ACsaveFreq = freq;
             return(E_PAUSE);
         }
+
+#ifdef USE_OMP
+        /* Once the ordering is known, solve several frequencies at once */
+        if (!ckt->CKTvarHertz && !(ckt->CKTniState & NIACSHOULDREORDER)
+#ifdef WANT_SENSE2
+            && !(ckt->CKTsenInfo && (ckt->CKTsenInfo->SENmode & ACSEN))
+#endif
+#ifdef XSPICE
+            && !g_ipc.enabled
+#endif
+            ) {
+            int numDone;
+
+            error = ACbatch(ckt, job, &freq, freqTol, acPlot, &numDone);
+            if (error) {
+                UPDATE_STATS(DOING_AC);
+                return(error);
+            }
+            if (numDone > 0)
+                continue;
+        }
+#endif
+
         ckt->CKTomega = 2.0 * M_PI *freq;
 
         /* Update opertating point, if variable 'hertz' is given */
@@ -385,6 +418,149 @@ endsweep:
 }
 
 
+#ifdef USE_OMP
+/* ACbatch(ckt, job, freq, freqTol, acPlot, numDone)
+ * Load the matrices of up to four frequencies per thread one after the
+ * other, then factor and solve copies of them in parallel, reusing the
+ * current pivot ordering, and dump the results in order.  *freq is
+ * advanced past the frequencies done, their number is returned in
+ * *numDone.  If a pivot fails, the frequencies from there on are left
+ * to NIacIter(), which may reorder the matrix.  A pause requested
+ * during the loads ends the batch after the frequencies loaded so far,
+ * and returns E_PAUSE.
+ * The threads and their copies are limited to AC_BATCH_MEMORY; if that
+ * does not suffice for two threads, no batch is done.
+ */
+
+static int
+ACbatch(CKTcircuit *ckt, ACAN *job, double *freq, double freqTol,
+        runDesc *acPlot, int *numDone)
+{
+    SMPmatrix *matrix = ckt->CKTmatrix;
+    int nthreads = omp_get_max_threads();
+    int numValues, numWork, size, count, n, i, error;
+    double perThread, *freqs, *values, *rhs, *work;
+    double startTime;
+    int *errors;
+    bool paused = FALSE;
+
+    *numDone = 0;
+
+    /* nothing to gain for a single frequency or a single thread */
+    if (job->ACfreqDelta == ((job->ACstepType == LINEAR) ? 0.0 : 1.0))
+        return(OK);
+    if (nthreads < 2 || !SMPcCopySizes(matrix, &numValues, &numWork))
+        return(OK);
+
+    /* a thread needs its work space and four matrix and rhs copies */
+    size = SMPmatSize(matrix) + 1;
+    perThread = sizeof(double) *
+        ((double) numWork + 4.0 * ((double) numValues + 2.0 * size));
+    if (nthreads > AC_BATCH_MEMORY / perThread)
+        nthreads = (int) (AC_BATCH_MEMORY / perThread);
+    if (nthreads < 2)
+        return(OK);
+
+    count = 4 * nthreads;
+    freqs = TMALLOC(double, count);
+    errors = TMALLOC(int, count);
+    values = TMALLOC(double, (size_t) count * (size_t) numValues);
+    rhs = TMALLOC(double, (size_t) count * 2 * (size_t) size);
+    work = TMALLOC(double, (size_t) nthreads * (size_t) numWork);
+
+    error = OK;
+    for (n = 0; n < count && *freq <= job->ACstopFreq + freqTol; n++) {
+        ckt->CKTomega = 2.0 * M_PI * *freq;
+        ckt->CKTmode = (ckt->CKTmode & MODEUIC) | MODEAC;
+        error = CKTacLoad(ckt);
+        if (error)
+            goto done;
+        SMPcCopyGather(matrix, values + (size_t) n * (size_t) numValues);
+        memcpy(rhs + (size_t) (2 * n) * (size_t) size, ckt->CKTrhs,
+               (size_t) size * sizeof(double));
+        memcpy(rhs + (size_t) (2 * n + 1) * (size_t) size, ckt->CKTirhs,
+               (size_t) size * sizeof(double));
+        freqs[n] = *freq;
+        if (job->ACstepType == LINEAR)
+            *freq += job->ACfreqDelta;
+        else
+            *freq *= job->ACfreqDelta;
+        if (SPfrontEnd->IFpauseTest()) {
+            /* user asked us to pause via an interrupt */
+            paused = TRUE;
+            n++;
+            break;
+        }
+    }
+
+    startTime = SPfrontEnd->IFseconds();
+#pragma omp parallel for num_threads(nthreads)
+    for (i = 0; i < n; i++) {
+        double *w = work + (size_t) omp_get_thread_num() * (size_t) numWork;
+        double *v = values + (size_t) i * (size_t) numValues;
+
+        errors[i] = SMPcCopyLUfac(matrix, v, w);
+        if (!errors[i])
+            SMPcCopySolve(matrix, v, w, rhs + (size_t) (2 * i) * (size_t) size,
+                          rhs + (size_t) (2 * i + 1) * (size_t) size);
+    }
+    ckt->CKTstat->STATdecompTime += SPfrontEnd->IFseconds() - startTime;
+
+    for (i = 0; i < n; i++) {
+        if (errors[i]) {
+            /* continue here one frequency at a time */
+            *freq = freqs[i];
+            break;
+        }
+        memcpy(ckt->CKTrhsOld, rhs + (size_t) (2 * i) * (size_t) size,
+               (size_t) size * sizeof(double));
+        memcpy(ckt->CKTirhsOld, rhs + (size_t) (2 * i + 1) * (size_t) size,
+               (size_t) size * sizeof(double));
+        *ckt->CKTrhsOld = 0;
+        *ckt->CKTirhsOld = 0;
+
+        /* device currents are evaluated at this frequency */
+        ckt->CKTomega = 2.0 * M_PI * freqs[i];
+        error = CKTacDump(ckt, freqs[i], acPlot);
+        if (error)
+            goto done;
+        (*numDone)++;
+    }
+
+#ifdef HAS_PROGREP
+    if (*numDone > 0) {
+        double last = freqs[*numDone - 1];
+
+        if (job->ACstepType == LINEAR)
+            SetAnalyse("ac", (int)((last - job->ACstartFreq) * 1000.0 /
+                                   (job->ACstopFreq - job->ACstartFreq)));
+        else if (last > 0.0) {
+            double startfreq = job->ACstartFreq;
+
+            if (startfreq == 0.0)
+                startfreq = 1e-12;
+            SetAnalyse("ac", (int)((log(last) - log(startfreq)) * 1000.0 /
+                                   (log(job->ACstopFreq) - log(startfreq))));
+        }
+    }
+#endif
+
+    if (paused) {
+        job->ACsaveFreq = *freq;
+        error = E_PAUSE;
+    }
+
+done:
+    tfree(freqs);
+    tfree(errors);
+    tfree(values);
+    tfree(rhs);
+    tfree(work);
+    return(error);
+}
+#endif
+
+
     /* CKTacLoad(ckt)
      * this is a driver program to iterate through all the various
      * ac load functions provided for the circuit elements in the
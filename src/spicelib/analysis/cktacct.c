@@ -70,6 +70,12 @@ CKTacct(CKTcircuit *ckt, JOB *anal, int which, IFvalue *val)
     case OPT_TRANRJCT:
         val->iValue = ckt->CKTstat->STATrejected;
         break;
+    case OPT_SIZEHITS:
+        val->iValue = ckt->CKTstat->STATsizeHits;
+        break;
+    case OPT_SIZEMISSES:
+        val->iValue = ckt->CKTstat->STATsizeMisses;
+        break;
     case OPT_TOTANALTIME:
         val->rValue = ckt->CKTstat->STATtotAnalTime;
         break;
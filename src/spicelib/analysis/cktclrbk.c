@@ -18,18 +18,11 @@ Author: 1985 Thomas L. Quarles
 int
 CKTclrBreak(CKTcircuit *ckt)
 {
-    double *tmp;
-    int j;
-
     if(ckt->CKTbreakSize >2) {
-        tmp = TMALLOC(double, ckt->CKTbreakSize - 1);
-        if(tmp == NULL) return(E_NOMEM);
-        for(j=1;j<ckt->CKTbreakSize;j++) {
-            tmp[j-1] = ckt->CKTbreaks[j];
-        }
-        FREE(ckt->CKTbreaks);
+        /* shift down in place, the space is reused by CKTsetBreak() */
+        memmove(&ckt->CKTbreaks[0], &ckt->CKTbreaks[1],
+                (size_t) (ckt->CKTbreakSize - 1) * sizeof(double));
         ckt->CKTbreakSize--;
-        ckt->CKTbreaks=tmp;
     } else {
         ckt->CKTbreaks[0] = ckt->CKTbreaks[1];
         ckt->CKTbreaks[1] = ckt->CKTfinalTime;
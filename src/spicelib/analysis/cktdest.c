@@ -49,6 +49,9 @@ CKTdestroy(CKTcircuit *ckt)
         SMPdestroy(ckt->CKTmatrix);
         ckt->CKTmatrix = NULL;
     }
+    FREE(ckt->CKTpivotRows);
+    FREE(ckt->CKTpivotCols);
+    DEVsizeCacheFree(&ckt->CKTsizeCache);
     FREE(ckt->CKTbreaks);
     for(node = ckt->CKTnodes; node; ) {
         nnode = node->next;
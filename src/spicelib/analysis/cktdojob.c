@@ -107,6 +107,7 @@ CKTdoJob(CKTcircuit *ckt, int reset, TSKtask *task)
     ckt->CKTtroubleElt  = NULL;
     ckt->CKTnoopac = task->TSKnoopac && ckt->CKTisLinear;
     ckt->CKTepsmin = task->TSKepsmin;
+    ckt->CKTsparseCsc = task->TSKsparseCsc;
 #ifdef NEWTRUNC
     ckt->CKTlteReltol = task->TSKlteReltol;
     ckt->CKTlteAbstol = task->TSKlteAbstol;
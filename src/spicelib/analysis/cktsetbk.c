@@ -17,11 +17,31 @@ Author: 1985 Thomas L. Quarles
 /* define to enable breakpoint trace code */
 /* #define TRACE_BREAKPOINT */
 
+/* make room for one more breakpoint, the table grows geometrically */
+
+static int
+CKTgrowBreaks(CKTcircuit *ckt)
+{
+    double *tmp;
+    int size;
+
+    if (ckt->CKTbreakSize < ckt->CKTbreakAlloc)
+        return(OK);
+
+    size = MAX(2 * ckt->CKTbreakSize, 16);
+    tmp = TREALLOC(double, ckt->CKTbreaks, size);
+    if(tmp == NULL) return(E_NOMEM);
+    ckt->CKTbreaks = tmp;
+    ckt->CKTbreakAlloc = size;
+
+    return(OK);
+}
+
+
 int
 CKTsetBreak(CKTcircuit *ckt, double time)
 {
-    double *tmp;
-    int i,j;
+    int i, lo, hi, error;
 
 #ifdef TRACE_BREAKPOINT
     printf("[t:%e] \t want breakpoint for t = %e\n", ckt->CKTtime, time);
@@ -31,46 +51,50 @@ CKTsetBreak(CKTcircuit *ckt, double time)
         SPfrontEnd->IFerrorf (ERR_PANIC, "breakpoint in the past - HELP!");
         return(E_INTERN);
     }
-    for(i=0;i<ckt->CKTbreakSize;i++) {
-        if(ckt->CKTbreaks[i]>time) { /* passed */
-            if((ckt->CKTbreaks[i]-time) <= ckt->CKTminBreak) {
-                /* very close together - take earlier point */
-#ifdef TRACE_BREAKPOINT
-                printf("[t:%e] \t %e replaces %e\n", ckt->CKTtime, time,
-		ckt->CKTbreaks[i]);
-		CKTbreakDump(ckt);
-#endif		
-                ckt->CKTbreaks[i] = time;
-                return(OK);
-            }
-            if(i>0 && time-ckt->CKTbreaks[i-1] <= ckt->CKTminBreak) {
-                /* very close together, but after, so skip */
+
+    /* the table is sorted, find the first breakpoint after time */
+    lo = 0;
+    hi = ckt->CKTbreakSize;
+    while(lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if(ckt->CKTbreaks[mid] > time)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    i = lo;
+
+    if(i < ckt->CKTbreakSize) { /* passed */
+        if((ckt->CKTbreaks[i]-time) <= ckt->CKTminBreak) {
+            /* very close together - take earlier point */
 #ifdef TRACE_BREAKPOINT
-                printf("[t:%e] \t %e skipped\n", ckt->CKTtime, time);
-		CKTbreakDump(ckt);
-#endif			
-                return(OK);
-            }
-            /* fits in middle - new array & insert */
-            tmp = TMALLOC(double, ckt->CKTbreakSize + 1);
-            if(tmp == NULL) return(E_NOMEM);
-            for(j=0;j<i;j++) {
-                tmp[j] = ckt->CKTbreaks[j];
-            }
-            tmp[i]=time;
+            printf("[t:%e] \t %e replaces %e\n", ckt->CKTtime, time,
+                   ckt->CKTbreaks[i]);
+            CKTbreakDump(ckt);
+#endif
+            ckt->CKTbreaks[i] = time;
+            return(OK);
+        }
+        if(i>0 && time-ckt->CKTbreaks[i-1] <= ckt->CKTminBreak) {
+            /* very close together, but after, so skip */
 #ifdef TRACE_BREAKPOINT
-                printf("[t:%e] \t %e added\n", ckt->CKTtime, time);
-		CKTbreakDump(ckt);
-#endif	    
-            for(j=i;j<ckt->CKTbreakSize;j++) {
-                tmp[j+1] = ckt->CKTbreaks[j];
-            }
-            FREE(ckt->CKTbreaks);
-            ckt->CKTbreakSize++;
-            ckt->CKTbreaks=tmp;
-
+            printf("[t:%e] \t %e skipped\n", ckt->CKTtime, time);
+            CKTbreakDump(ckt);
+#endif
             return(OK);
         }
+        /* fits in middle - insert */
+        error = CKTgrowBreaks(ckt);
+        if(error) return(error);
+        memmove(&ckt->CKTbreaks[i+1], &ckt->CKTbreaks[i],
+                (size_t) (ckt->CKTbreakSize - i) * sizeof(double));
+        ckt->CKTbreaks[i] = time;
+        ckt->CKTbreakSize++;
+#ifdef TRACE_BREAKPOINT
+        printf("[t:%e] \t %e added\n", ckt->CKTtime, time);
+        CKTbreakDump(ckt);
+#endif
+        return(OK);
     }
     /* never found it - beyond end of time - extend out idea of time */
     if(time-ckt->CKTbreaks[ckt->CKTbreakSize-1]<=ckt->CKTminBreak) {
@@ -81,8 +105,9 @@ CKTsetBreak(CKTcircuit *ckt, double time)
 #endif	
         return(OK);
     }
-    /* fits at end - grow array & add on */
-    ckt->CKTbreaks = TREALLOC(double, ckt->CKTbreaks, ckt->CKTbreakSize + 1);
+    /* fits at end - add on */
+    error = CKTgrowBreaks(ckt);
+    if(error) return(error);
     ckt->CKTbreakSize++;
     ckt->CKTbreaks[ckt->CKTbreakSize-1]=time;
 #ifdef TRACE_BREAKPOINT
@@ -61,6 +61,7 @@ CKTsetup(CKTcircuit *ckt)
     ckt->CKTisSetup = 1;
 
     matrix = ckt->CKTmatrix;
+    SMPsetCompressed(matrix, ckt->CKTsparseCsc);
 
 #ifdef USE_OMP
     if (!cp_getvar("num_threads", CP_NUM, &nthreads))
@@ -0,0 +1,593 @@
+/* Snapshots of a transient analysis, to resume it in another run.
+ *
+ * A snapshot is a list of named arrays of doubles.  The file starts with
+ * SNAP_MAGIC and the format version, then each array follows as
+ *
+ *     name length (2 bytes), name, count (4 bytes), count doubles
+ *
+ * closed by a name of length 0.  All numbers are little endian, the
+ * doubles in IEEE 754 format, whatever the machine writing them.  The
+ * reader looks the arrays up by name, arrays it does not know are
+ * skipped, so items can be added without a new format version.  Integers
+ * are stored as doubles, which hold them exactly.
+ *
+ * CKTsnapSave() adds the state of the circuit: the scalars of the time
+ * step control and integration history, the state vectors, the solution,
+ * the breakpoints, the accepted timepoints, the pivot order and the
+ * statistics, and the history which transmission lines keep outside of
+ * the state vectors.  The frontend adds the analysis and the output.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
+#include "ngspice/sperror.h"
+#include "ngspice/suffix.h"
+
+#define SNAP_MAGIC "ngspice snapshot"
+#define SNAP_VERSION 3
+
+/* an array read from a snapshot */
+struct snap_entry {
+    char *name;
+    int count;
+    double *data;
+};
+
+
+/* Scalars of the circuit.  The options are not among them, they come
+   from the task when the analysis is resumed. */
+
+struct snap_scalar {
+    char *name;
+    size_t offset;
+    char type;                  /* 'd' double, 'i' int */
+    int count;
+};
+
+#define SNAP_D(s, f, n) { #f, offsetof(s, f), 'd', n }
+#define SNAP_I(s, f)    { #f, offsetof(s, f), 'i', 1 }
+
+static struct snap_scalar ckt_scalars[] = {
+    SNAP_D(CKTcircuit, CKTtime, 1),
+    SNAP_D(CKTcircuit, CKTdelta, 1),
+    SNAP_D(CKTcircuit, CKTdeltaOld, 7),
+    SNAP_D(CKTcircuit, CKTag, 7),
+    SNAP_I(CKTcircuit, CKTorder),
+    SNAP_I(CKTcircuit, CKTmaxOrder),
+    SNAP_I(CKTcircuit, CKTcurrentAnalysis),
+    SNAP_I(CKTcircuit, CKTbreak),
+    SNAP_D(CKTcircuit, CKTsaveDelta, 1),
+    SNAP_D(CKTcircuit, CKTsrcFact, 1),
+    SNAP_D(CKTcircuit, CKTdiagGmin, 1),
+    SNAP_I(CKTcircuit, CKTtimeListSize),
+    SNAP_I(CKTcircuit, CKTtimeIndex),
+    SNAP_I(CKTcircuit, CKTsizeIncr),
+};
+
+static struct snap_scalar stat_scalars[] = {
+    SNAP_I(STATistics, STATnumIter),
+    SNAP_I(STATistics, STATtranIter),
+    SNAP_I(STATistics, STAToldIter),
+    SNAP_I(STATistics, STATtimePts),
+    SNAP_I(STATistics, STATaccepted),
+    SNAP_I(STATistics, STATrejected),
+    SNAP_D(STATistics, STATtotAnalTime, 1),
+    SNAP_D(STATistics, STATloadTime, 1),
+    SNAP_D(STATistics, STATdecompTime, 1),
+    SNAP_D(STATistics, STATsolveTime, 1),
+    SNAP_D(STATistics, STATreorderTime, 1),
+    SNAP_D(STATistics, STATsyncTime, 1),
+    SNAP_D(STATistics, STATtranTime, 1),
+    SNAP_D(STATistics, STATtranDecompTime, 1),
+    SNAP_D(STATistics, STATtranSolveTime, 1),
+    SNAP_D(STATistics, STATtranLoadTime, 1),
+    SNAP_D(STATistics, STATtranTruncTime, 1),
+    SNAP_D(STATistics, STATtranSyncTime, 1),
+};
+
+/* the rhs vectors, all of them have SMPmatSize() + 1 elements */
+#define SNAP_RHS(f) { #f, offsetof(CKTcircuit, f) }
+
+static struct {
+    char *name;
+    size_t offset;
+} ckt_rhs[] = {
+    SNAP_RHS(CKTrhs),
+    SNAP_RHS(CKTrhsOld),
+    SNAP_RHS(CKTrhsSpare),
+    SNAP_RHS(CKTirhs),
+    SNAP_RHS(CKTirhsOld),
+    SNAP_RHS(CKTirhsSpare),
+};
+
+/* devices with a history which snapshots do not cover */
+static char *snap_unsupported[] = {
+    "TransLine", "CplLines",
+    "NDEV", "NUMD", "NUMD2", "NBJT", "NBJT2", "NUMOS",
+};
+
+
+/* byte order of the file */
+
+static int
+snap_host_little(void)
+{
+    const int one = 1;
+    return *(const char *) &one == 1;
+}
+
+
+static void
+snap_encode(unsigned char *buf, const void *value, size_t size)
+{
+    size_t i;
+
+    memcpy(buf, value, size);
+    if (!snap_host_little())
+        for (i = 0; i < size / 2; i++) {
+            unsigned char c = buf[i];
+            buf[i] = buf[size - 1 - i];
+            buf[size - 1 - i] = c;
+        }
+}
+
+
+static void
+snap_decode(void *value, const unsigned char *buf, size_t size)
+{
+    unsigned char tmp[8];
+    size_t i;
+
+    for (i = 0; i < size; i++)
+        tmp[i] = buf[snap_host_little() ? i : size - 1 - i];
+    memcpy(value, tmp, size);
+}
+
+
+static void
+snap_write(CKTsnap *snap, const void *buf, size_t size)
+{
+    if (snap->len + size > snap->size) {
+        snap->size = MAX(2 * snap->size, snap->len + size);
+        snap->buf = TREALLOC(char, snap->buf, snap->size);
+    }
+    memcpy(snap->buf + snap->len, buf, size);
+    snap->len += size;
+}
+
+
+static void
+snap_write_uint(CKTsnap *snap, unsigned int value, size_t size)
+{
+    unsigned char buf[4];
+    size_t i;
+
+    for (i = 0; i < size; i++)
+        buf[i] = (unsigned char) (value >> (8 * i));
+    snap_write(snap, buf, size);
+}
+
+
+static int
+snap_read_uint(FILE *fp, unsigned int *value, size_t size)
+{
+    unsigned char buf[4];
+    size_t i;
+
+    if (fread(buf, 1, size, fp) != size)
+        return 0;
+    *value = 0;
+    for (i = 0; i < size; i++)
+        *value |= (unsigned int) buf[i] << (8 * i);
+    return 1;
+}
+
+
+/* Start a snapshot.  It is built in memory, the caller writes the
+   buffer to a file when CKTsnapEnd() has closed it. */
+
+void
+CKTsnapBegin(CKTsnap *snap)
+{
+    snap->buf = NULL;
+    snap->len = snap->size = 0;
+    snap->entries = NULL;
+    snap->error = 0;
+
+    snap_write(snap, SNAP_MAGIC, strlen(SNAP_MAGIC));
+    snap_write_uint(snap, SNAP_VERSION, 4);
+}
+
+
+/* close the list of arrays, return 1 if something could not be added */
+
+int
+CKTsnapEnd(CKTsnap *snap)
+{
+    snap_write_uint(snap, 0, 2);
+
+    return snap->error;
+}
+
+
+/* add the array 'data' of 'count' doubles under 'name' */
+
+void
+CKTsnapPut(CKTsnap *snap, const char *name, const double *data, int count)
+{
+    unsigned char buf[8 * 256];
+    size_t len = strlen(name);
+    int i, n;
+
+    if (len == 0 || len > 0xffff || count < 0) {
+        snap->error = 1;
+        return;
+    }
+
+    snap_write_uint(snap, (unsigned int) len, 2);
+    snap_write(snap, name, len);
+    snap_write_uint(snap, (unsigned int) count, 4);
+
+    for (i = 0; i < count; i += n) {
+        int k;
+        n = MIN(count - i, 256);
+        for (k = 0; k < n; k++)
+            snap_encode(buf + 8 * k, data + i + k, 8);
+        snap_write(snap, buf, 8 * (size_t) n);
+    }
+}
+
+
+static void
+snap_entry_free(void *data)
+{
+    struct snap_entry *entry = (struct snap_entry *) data;
+
+    tfree(entry->name);
+    tfree(entry->data);
+    tfree(entry);
+}
+
+
+/* Read all arrays of a snapshot from 'fp'.  Return OK, E_BADPARM if
+   the file is not a snapshot of this format, or E_NOTFOUND if it
+   is truncated.  The arrays are kept until CKTsnapFree(). */
+
+int
+CKTsnapRead(CKTsnap *snap, FILE *fp)
+{
+    char magic[sizeof(SNAP_MAGIC)];
+    unsigned char buf[8 * 256];
+    unsigned int version, len, count;
+
+    snap->buf = NULL;
+    snap->len = snap->size = 0;
+    snap->error = 0;
+    snap->entries = nghash_init(NGHASH_MIN_SIZE);
+
+    if (fread(magic, 1, strlen(SNAP_MAGIC), fp) != strlen(SNAP_MAGIC) ||
+        memcmp(magic, SNAP_MAGIC, strlen(SNAP_MAGIC)) != 0 ||
+        !snap_read_uint(fp, &version, 4) || version != SNAP_VERSION)
+        return E_BADPARM;
+
+    for (;;) {
+        struct snap_entry *entry;
+        unsigned int i, n;
+
+        if (!snap_read_uint(fp, &len, 2))
+            return E_NOTFOUND;
+        if (len == 0)
+            return OK;
+
+        entry = TMALLOC(struct snap_entry, 1);
+        entry->name = TMALLOC(char, len + 1);
+        if (fread(entry->name, 1, len, fp) != len ||
+            !snap_read_uint(fp, &count, 4) || count > INT_MAX / 8) {
+            snap_entry_free(entry);
+            return E_NOTFOUND;
+        }
+        entry->name[len] = '\0';
+        entry->count = (int) count;
+        entry->data = TMALLOC(double, count);
+
+        for (i = 0; i < count; i += n) {
+            unsigned int k;
+            n = MIN(count - i, 256);
+            if (fread(buf, 8, n, fp) != n) {
+                snap_entry_free(entry);
+                return E_NOTFOUND;
+            }
+            for (k = 0; k < n; k++)
+                snap_decode(entry->data + i + k, buf + 8 * k, 8);
+        }
+
+        /* of two arrays with the same name the first one counts */
+        if (nghash_insert(snap->entries, entry->name, entry))
+            snap_entry_free(entry);
+    }
+}
+
+
+void
+CKTsnapFree(CKTsnap *snap)
+{
+    if (snap->entries)
+        nghash_free(snap->entries, snap_entry_free, NULL);
+    snap->entries = NULL;
+    tfree(snap->buf);
+    snap->len = snap->size = 0;
+}
+
+
+/* the number of elements of the array 'name', -1 if there is none */
+
+int
+CKTsnapLength(CKTsnap *snap, const char *name)
+{
+    struct snap_entry *entry = nghash_find(snap->entries, (void *) name);
+
+    return entry ? entry->count : -1;
+}
+
+
+/* the array 'name', NULL unless it has 'count' elements */
+
+double *
+CKTsnapGet(CKTsnap *snap, const char *name, int count)
+{
+    struct snap_entry *entry = nghash_find(snap->entries, (void *) name);
+
+    if (!entry || entry->count != count)
+        return NULL;
+
+    return entry->data;
+}
+
+
+static void
+snap_put_scalars(CKTsnap *snap, void *base, struct snap_scalar *table, int n)
+{
+    double value[7];
+    int i, k;
+
+    for (i = 0; i < n; i++) {
+        char *p = (char *) base + table[i].offset;
+        for (k = 0; k < table[i].count; k++)
+            if (table[i].type == 'd')
+                value[k] = ((double *) p)[k];
+            else
+                value[k] = ((int *) p)[k];
+        CKTsnapPut(snap, table[i].name, value, table[i].count);
+    }
+}
+
+
+static int
+snap_has_scalars(CKTsnap *snap, struct snap_scalar *table, int n)
+{
+    int i;
+
+    for (i = 0; i < n; i++)
+        if (!CKTsnapGet(snap, table[i].name, table[i].count))
+            return 0;
+
+    return 1;
+}
+
+
+static void
+snap_get_scalars(CKTsnap *snap, void *base, struct snap_scalar *table, int n)
+{
+    int i, k;
+
+    for (i = 0; i < n; i++) {
+        char *p = (char *) base + table[i].offset;
+        double *value = CKTsnapGet(snap, table[i].name, table[i].count);
+        for (k = 0; k < table[i].count; k++)
+            if (table[i].type == 'd')
+                ((double *) p)[k] = value[k];
+            else
+                ((int *) p)[k] = (int) value[k];
+    }
+}
+
+
+/* Return OK if the state of 'ckt' can be saved completely, else tell
+   which device is in the way. */
+
+int
+CKTsnapCheck(CKTcircuit *ckt)
+{
+    int i, type;
+
+    for (i = 0; i < (int) NUMELEMS(snap_unsupported); i++) {
+        type = CKTtypelook(snap_unsupported[i]);
+        if (type >= 0 && ckt->CKThead[type]) {
+            SPfrontEnd->IFerrorf (ERR_WARNING,
+                "snapshots do not cover the history of %s devices",
+                snap_unsupported[i]);
+            return E_UNSUPP;
+        }
+    }
+
+    return OK;
+}
+
+
+/* add the state of the transient analysis of 'ckt' to 'snap' */
+
+void
+CKTsnapSave(CKTcircuit *ckt, CKTsnap *snap)
+{
+    char name[32];
+    double value;
+    int i, size = SMPmatSize(ckt->CKTmatrix);
+    int *rows, *cols;
+
+    value = ckt->CKTnumStates;
+    CKTsnapPut(snap, "CKTnumStates", &value, 1);
+    value = size;
+    CKTsnapPut(snap, "SMPmatSize", &value, 1);
+
+    snap_put_scalars(snap, ckt, ckt_scalars, (int) NUMELEMS(ckt_scalars));
+    snap_put_scalars(snap, ckt->CKTstat, stat_scalars, (int) NUMELEMS(stat_scalars));
+
+    for (i = 0; i < (int) NUMELEMS(ckt->CKTstates); i++)
+        if (ckt->CKTstates[i]) {
+            sprintf(name, "CKTstates[%d]", i);
+            CKTsnapPut(snap, name, ckt->CKTstates[i], ckt->CKTnumStates);
+        }
+
+    for (i = 0; i < (int) NUMELEMS(ckt_rhs); i++) {
+        double *rhs = *(double **) ((char *) ckt + ckt_rhs[i].offset);
+        if (rhs)
+            CKTsnapPut(snap, ckt_rhs[i].name, rhs, size + 1);
+    }
+
+    CKTsnapPut(snap, "CKTbreaks", ckt->CKTbreaks, ckt->CKTbreakSize);
+
+    if (ckt->CKTtimePoints)
+        CKTsnapPut(snap, "CKTtimePoints", ckt->CKTtimePoints,
+                   ckt->CKTtimeIndex + 1);
+
+    /* the pivot order, a resumed run takes the same pivots */
+    if (ckt->CKTmatrix) {
+        int count = SMPgetPivots(ckt->CKTmatrix, &rows, &cols);
+        if (count > 0) {
+            double *pivots = TMALLOC(double, 2 * count);
+            for (i = 0; i < count; i++) {
+                pivots[i] = rows[i + 1];
+                pivots[count + i] = cols[i + 1];
+            }
+            CKTsnapPut(snap, "pivots", pivots, 2 * count);
+            tfree(pivots);
+            tfree(rows);
+            tfree(cols);
+        }
+    }
+
+    /* devices with a history of their own */
+    for (i = 0; i < DEVmaxnum; i++)
+        if (DEVices[i] && DEVices[i]->DEVsnapSave && ckt->CKThead[i])
+            DEVices[i]->DEVsnapSave (ckt->CKThead[i], ckt, snap);
+}
+
+
+/* Take over the state saved in 'snap' into 'ckt', which has been set
+   up for the same circuit.  Return E_BADPARM if the snapshot does not
+   fit the circuit or misses a part, the circuit is left as it was then. */
+
+int
+CKTsnapLoad(CKTcircuit *ckt, CKTsnap *snap)
+{
+    char name[32];
+    double *value, *data;
+    int i, error, maxOrder, size = SMPmatSize(ckt->CKTmatrix);
+
+    value = CKTsnapGet(snap, "CKTnumStates", 1);
+    if (!value || (int) *value != ckt->CKTnumStates)
+        return E_BADPARM;
+    value = CKTsnapGet(snap, "SMPmatSize", 1);
+    if (!value || (int) *value != size)
+        return E_BADPARM;
+
+    if (!snap_has_scalars(snap, ckt_scalars, (int) NUMELEMS(ckt_scalars)) ||
+        !CKTsnapGet(snap, "CKTbreaks", CKTsnapLength(snap, "CKTbreaks")) ||
+        CKTsnapLength(snap, "CKTbreaks") < 2)
+        return E_BADPARM;
+
+    value = CKTsnapGet(snap, "CKTmaxOrder", 1);
+    maxOrder = (int) *value;
+    if (maxOrder < 1 || maxOrder + 2 > (int) NUMELEMS(ckt->CKTstates))
+        return E_BADPARM;
+
+    for (i = 0; i <= maxOrder + 1; i++) {
+        sprintf(name, "CKTstates[%d]", i);
+        if (!CKTsnapGet(snap, name, ckt->CKTnumStates))
+            return E_BADPARM;
+    }
+
+    for (i = 0; i < (int) NUMELEMS(ckt_rhs); i++)
+        if (*(double **) ((char *) ckt + ckt_rhs[i].offset) &&
+            !CKTsnapGet(snap, ckt_rhs[i].name, size + 1))
+            return E_BADPARM;
+
+    value = CKTsnapGet(snap, "CKTtimeIndex", 1);
+    if (CKTsnapLength(snap, "CKTtimePoints") >= 0 &&
+        CKTsnapLength(snap, "CKTtimePoints") != (int) *value + 1)
+        return E_BADPARM;
+
+    /* the history of the devices, checked before anything is changed */
+    for (i = 0; i < DEVmaxnum; i++)
+        if (DEVices[i] && DEVices[i]->DEVsnapLoad && ckt->CKThead[i]) {
+            error = DEVices[i]->DEVsnapLoad (ckt->CKThead[i], ckt, snap, 0);
+            if (error)
+                return error;
+        }
+
+    /* the snapshot fits, take it over */
+
+    for (i = 0; i < (int) NUMELEMS(ckt->CKTstates); i++)
+        tfree(ckt->CKTstates[i]);
+
+    snap_get_scalars(snap, ckt, ckt_scalars, (int) NUMELEMS(ckt_scalars));
+    if (snap_has_scalars(snap, stat_scalars, (int) NUMELEMS(stat_scalars)))
+        snap_get_scalars(snap, ckt->CKTstat, stat_scalars, (int) NUMELEMS(stat_scalars));
+
+    for (i = 0; i < (int) NUMELEMS(ckt->CKTstates); i++) {
+        sprintf(name, "CKTstates[%d]", i);
+        data = CKTsnapGet(snap, name, ckt->CKTnumStates);
+        if (data) {
+            ckt->CKTstates[i] = TMALLOC(double, ckt->CKTnumStates);
+            memcpy(ckt->CKTstates[i], data, (size_t) ckt->CKTnumStates * sizeof(double));
+        }
+    }
+
+    for (i = 0; i < (int) NUMELEMS(ckt_rhs); i++) {
+        double *rhs = *(double **) ((char *) ckt + ckt_rhs[i].offset);
+        if (rhs)
+            memcpy(rhs, CKTsnapGet(snap, ckt_rhs[i].name, size + 1),
+                   (size_t) (size + 1) * sizeof(double));
+    }
+
+    ckt->CKTbreakSize = CKTsnapLength(snap, "CKTbreaks");
+    ckt->CKTbreakAlloc = ckt->CKTbreakSize;
+    tfree(ckt->CKTbreaks);
+    ckt->CKTbreaks = TMALLOC(double, ckt->CKTbreakSize);
+    memcpy(ckt->CKTbreaks, CKTsnapGet(snap, "CKTbreaks", ckt->CKTbreakSize),
+           (size_t) ckt->CKTbreakSize * sizeof(double));
+
+    tfree(ckt->CKTtimePoints);
+    data = CKTsnapGet(snap, "CKTtimePoints", ckt->CKTtimeIndex + 1);
+    if (data) {
+        ckt->CKTtimeListSize = MAX(ckt->CKTtimeListSize, ckt->CKTtimeIndex + 1);
+        ckt->CKTtimePoints = TMALLOC(double, ckt->CKTtimeListSize);
+        memcpy(ckt->CKTtimePoints, data,
+               (size_t) (ckt->CKTtimeIndex + 1) * sizeof(double));
+    }
+
+    data = CKTsnapGet(snap, "pivots", CKTsnapLength(snap, "pivots"));
+    if (data && ckt->CKTmatrix) {
+        int count = CKTsnapLength(snap, "pivots") / 2;
+        tfree(ckt->CKTpivotRows);
+        tfree(ckt->CKTpivotCols);
+        ckt->CKTpivotCount = count;
+        ckt->CKTpivotRows = TMALLOC(int, count + 1);
+        ckt->CKTpivotCols = TMALLOC(int, count + 1);
+        for (i = 0; i < count; i++) {
+            ckt->CKTpivotRows[i + 1] = (int) data[i];
+            ckt->CKTpivotCols[i + 1] = (int) data[count + i];
+        }
+        SMPsetPivots(ckt->CKTmatrix, count, ckt->CKTpivotRows, ckt->CKTpivotCols);
+    }
+
+    for (i = 0; i < DEVmaxnum; i++)
+        if (DEVices[i] && DEVices[i]->DEVsnapLoad && ckt->CKThead[i]) {
+            error = DEVices[i]->DEVsnapLoad (ckt->CKThead[i], ckt, snap, 1);
+            if (error)
+                return error;
+        }
+
+    return OK;
+}
@@ -172,6 +172,9 @@ CKTsetOpt(CKTcircuit *ckt, JOB *anal, int opt, IFvalue *val)
     case OPT_EPSMIN:
         task->TSKepsmin = val->rValue;
         break;
+    case OPT_SPARSECSC:
+        task->TSKsparseCsc = (val->iValue != 0);
+        break;
 /* gtri - begin - wbk - add new options */
 #ifdef XSPICE
     case OPT_EVT_MAX_OP_ALTER:
@@ -306,6 +309,10 @@ static IFparm OPTtbl[] = {
  { "trantrunctime", OPT_TRANTRUNC, IF_ASK|IF_REAL,"Transient trunc time" },
  { "trancuriters", OPT_TRANCURITER, IF_ASK|IF_INTEGER,
         "Transient iters per point" },
+ { "sizehits", OPT_SIZEHITS, IF_ASK|IF_INTEGER,
+        "Size dependent parameter sets reused" },
+ { "sizemisses", OPT_SIZEMISSES, IF_ASK|IF_INTEGER,
+        "Size dependent parameter sets computed" },
  { "actime", OPT_ACTIME, IF_ASK|IF_REAL,"AC analysis time" },
  { "acloadtime", OPT_ACLOAD, IF_ASK|IF_REAL,"AC load time" },
  { "acsynctime", OPT_ACSYNC, IF_ASK|IF_REAL,"AC sync time" },
@@ -328,7 +335,9 @@ static IFparm OPTtbl[] = {
  { "noopac", OPT_NOOPAC, IF_SET|IF_FLAG,
         "No op calculation in ac if circuit is linear" },
  { "epsmin", OPT_EPSMIN, IF_SET|IF_REAL,
-        "Minimum value for log" }
+        "Minimum value for log" },
+ { "sparsecsc", OPT_SPARSECSC, IF_SET|IF_FLAG,
+        "Refactor the matrix in compressed column form" }
 };
 
 int OPTcount = NUMELEMS(OPTtbl);
@@ -0,0 +1,100 @@
+/* Deferred matrix and rhs stamps for device loads running in parallel.
+ *
+ * An OpenMP device load cannot add into the matrix directly, because
+ * instances of different threads share matrix elements.  Instead every
+ * instance reserves slots in a CKTstampBuf during setup and writes its
+ * contributions into them.  CKTstampLoad() then sweeps the two compact
+ * slot arrays once, instead of revisiting every instance structure.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/suffix.h"
+
+#ifdef USE_OMP
+
+CKTstampBuf *
+CKTstampNew(void)
+{
+    CKTstampBuf *buf = TMALLOC(CKTstampBuf, 1);
+
+    /* the sink slots, the rhs one goes to the ground equation */
+    CKTstampMat(buf, &buf->matSink);
+    CKTstampRhs(buf, 0);
+
+    return buf;
+}
+
+
+void
+CKTstampFree(CKTstampBuf **pbuf)
+{
+    CKTstampBuf *buf = *pbuf;
+
+    if (!buf)
+        return;
+
+    tfree(buf->matPtr);
+    tfree(buf->matVal);
+    tfree(buf->rhsNode);
+    tfree(buf->rhsVal);
+    tfree(*pbuf);
+}
+
+
+/* reserve a slot for the matrix element 'ptr', return its index */
+
+int
+CKTstampMat(CKTstampBuf *buf, double *ptr)
+{
+    if (buf->matCount >= buf->matSize) {
+        buf->matSize = buf->matSize ? 2 * buf->matSize : 64;
+        buf->matPtr = TREALLOC(double *, buf->matPtr, buf->matSize);
+        buf->matVal = TREALLOC(double, buf->matVal, buf->matSize);
+    }
+
+    buf->matPtr[buf->matCount] = ptr;
+    buf->matVal[buf->matCount] = 0.0;
+
+    return buf->matCount++;
+}
+
+
+/* reserve a slot for the rhs entry of equation 'node', return its index */
+
+int
+CKTstampRhs(CKTstampBuf *buf, int node)
+{
+    if (buf->rhsCount >= buf->rhsSize) {
+        buf->rhsSize = buf->rhsSize ? 2 * buf->rhsSize : 64;
+        buf->rhsNode = TREALLOC(int, buf->rhsNode, buf->rhsSize);
+        buf->rhsVal = TREALLOC(double, buf->rhsVal, buf->rhsSize);
+    }
+
+    buf->rhsNode[buf->rhsCount] = node;
+    buf->rhsVal[buf->rhsCount] = 0.0;
+
+    return buf->rhsCount++;
+}
+
+
+/* add all slots to the matrix and rhs, always in the same order */
+
+void
+CKTstampLoad(CKTstampBuf *buf, CKTcircuit *ckt)
+{
+    double **matPtr = buf->matPtr;
+    double *matVal = buf->matVal;
+    int *rhsNode = buf->rhsNode;
+    double *rhsVal = buf->rhsVal;
+    double *rhs = ckt->CKTrhs;
+    int i;
+
+    for (i = 0; i < buf->matCount; i++)
+        *(matPtr[i]) += matVal[i];
+
+    for (i = 0; i < buf->rhsCount; i++)
+        rhs[rhsNode[i]] += rhsVal[i];
+}
+
+#endif
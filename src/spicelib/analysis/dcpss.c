@@ -209,6 +209,7 @@ DCpss(CKTcircuit *ckt,
         ckt->CKTbreaks[0] = 0;
         ckt->CKTbreaks[1] = ckt->CKTfinalTime;
         ckt->CKTbreakSize = 2;
+        ckt->CKTbreakAlloc = 2;
 
 #ifdef XSPICE
 /* gtri - begin - wbk - 12/19/90 - Modify setting of CKTminBreak */
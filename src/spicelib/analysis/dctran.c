@@ -137,6 +137,7 @@ DCtran(CKTcircuit *ckt,
         ckt->CKTbreaks[0] = 0;
         ckt->CKTbreaks[1] = ckt->CKTfinalTime;
         ckt->CKTbreakSize = 2;
+        ckt->CKTbreakAlloc = 2;
 
 #ifdef SHARED_MODULE
         add_bkpt();
@@ -359,6 +360,8 @@ DCtran(CKTcircuit *ckt,
         /* saj As traninit resets CKTmode */
         ckt->CKTmode = (ckt->CKTmode&MODEUIC) | MODETRAN | MODEINITPRED;
         /* saj */
+        /* the timepoint list keeps growing by this */
+        maxstepsize = MAX(ckt->CKTstep, ckt->CKTmaxStep);
         INIT_STATS();
         if(ckt->CKTminBreak==0) ckt->CKTminBreak=ckt->CKTmaxStep*5e-5;
         firsttime=0;
@@ -502,6 +505,7 @@ DCtran(CKTcircuit *ckt,
 #endif
         return(OK);
     }
+    SPfrontEnd->IFsnapshot (ckt);
     if(SPfrontEnd->IFpauseTest()) {
         /* user requested pause... */
         UPDATE_STATS(DOING_TRAN);
@@ -69,6 +69,8 @@ SPICEdev ASRCinfo = {
     /* DEVdisto      */ NULL,      /* DISTO */
     /* DEVnoise      */ NULL,      /* NOISE */
     /* DEVsoaCheck   */ NULL,
+    /* DEVsnapSave   */ NULL,
+    /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
     /* DEVdump       */ NULL,
     /* DEVacct       */ NULL,
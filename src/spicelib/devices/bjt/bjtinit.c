@@ -68,6 +68,8 @@ SPICEdev BJTinfo = {                  /* description from struct IFdevice  */
  /* DEVdisto      */ BJTdisto,
  /* DEVnoise      */ BJTnoise,
  /* DEVsoaCheck   */ BJTsoaCheck,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump	  */ NULL,
  /* DEVacct       */ NULL,
@@ -68,6 +68,8 @@ SPICEdev B1info = {
  /* DEVdisto      */ B1disto,
  /* DEVnoise      */ B1noise,	/* NOISE */
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
@@ -6,6 +6,7 @@ Author: 1985 Hong J. Park, Thomas L. Quarles
 #include "ngspice/ngspice.h"
 #include "ngspice/smpdefs.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
 #include "bsim2def.h"
 #include "ngspice/const.h"
 #include "ngspice/sperror.h"
@@ -26,8 +27,10 @@ B2temp(GENmodel *inModel, CKTcircuit *ckt)
     double EffectiveWidth;
     double CoxWoverL, Inv_L, Inv_W, tmp;
     int Size_Not_Found;
+    DEVsizeCache *sizeCache;
+    double sizeKey[2];
 
-    NG_IGNORE(ckt);
+    sizeCache = DEVsizeCacheReset(ckt);
 
     /*  loop through all the B2 device models */
     for( ; model != NULL; model = model->B2nextModel ) {
@@ -53,20 +56,13 @@ B2temp(GENmodel *inModel, CKTcircuit *ckt)
         for (here = model->B2instances; here != NULL ;
                 here=here->B2nextInstance) {
 
-	    pSizeDependParamKnot = model->pSizeDependParamKnot;
-	    Size_Not_Found = 1;
-
-	    while ((pSizeDependParamKnot != NULL) && Size_Not_Found)
-	    {   if ((here->B2l == pSizeDependParamKnot->Length)
-		    && (here->B2w == pSizeDependParamKnot->Width))
-                {   Size_Not_Found = 0;
-		    here->pParam = pSizeDependParamKnot;
-		}
-		else
-		{   pLastKnot = pSizeDependParamKnot;
-		    pSizeDependParamKnot = pSizeDependParamKnot->pNext;
-		}
-            }
+	    sizeKey[0] = here->B2l;
+	    sizeKey[1] = here->B2w;
+	    pSizeDependParamKnot = DEVsizeFind(sizeCache, model, sizeKey, 2);
+	    Size_Not_Found = (pSizeDependParamKnot == NULL);
+	    if (!Size_Not_Found)
+	    {   here->pParam = pSizeDependParamKnot;
+	    }
 
 	    if (Size_Not_Found)
 	    {   here->pParam = TMALLOC(struct bsim2SizeDependParam, 1);
@@ -75,6 +71,8 @@ B2temp(GENmodel *inModel, CKTcircuit *ckt)
                 else
 		    pLastKnot->pNext = here->pParam;
                 here->pParam->pNext = NULL;
+                pLastKnot = here->pParam;
+                DEVsizeAdd(sizeCache, model, sizeKey, 2, pLastKnot);
 
 		EffectiveLength = here->B2l - model->B2deltaL * 1.0e-6;
 		EffectiveWidth = here->B2w - model->B2deltaW * 1.0e-6;
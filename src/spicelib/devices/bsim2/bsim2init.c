@@ -68,6 +68,8 @@ SPICEdev B2info = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ B2noise,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
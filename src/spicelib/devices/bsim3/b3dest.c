@@ -21,6 +21,7 @@ BSIM3destroy(GENmodel **inModel)
     #ifdef USE_OMP
         /* free just once for all models */
         FREE(mod->BSIM3InstanceArray);
+        CKTstampFree(&mod->BSIM3stamps);
     #endif
 
     while (mod) {
@@ -34,7 +34,6 @@
 
 #ifdef USE_OMP
 int BSIM3LoadOMP(BSIM3instance *here, CKTcircuit *ckt);
-void BSIM3LoadRhsMat(GENmodel *inModel, CKTcircuit *ckt);
 #endif
 
 
@@ -58,7 +57,7 @@ CKTcircuit *ckt)
             error = local_error;
     }
 
-    BSIM3LoadRhsMat(inModel, ckt);
+    CKTstampLoad(model->BSIM3stamps, ckt);
 
     return error;
 }
@@ -66,6 +65,8 @@ CKTcircuit *ckt)
 
 int BSIM3LoadOMP(BSIM3instance *here, CKTcircuit *ckt) {
 BSIM3model *model = here->BSIM3modPtr;
+double *rhsStamp = model->BSIM3stamps->rhsVal + here->BSIM3rhsSlot;
+double *matStamp = model->BSIM3stamps->matVal + here->BSIM3matSlot;
 #else
 BSIM3model *model = (BSIM3model*)inModel;
 BSIM3instance *here;
@@ -2991,13 +2992,13 @@ line900:
 
            m = here->BSIM3m;
 #ifdef USE_OMP
-           here->BSIM3rhsG = m * ceqqg;
-           here->BSIM3rhsB = m * (ceqbs + ceqbd + ceqqb);
-           here->BSIM3rhsD = m * (ceqbd - cdreq - ceqqd);
-           here->BSIM3rhsS = m * (cdreq + ceqbs + ceqqg
+           rhsStamp[0] = -m * ceqqg;
+           rhsStamp[1] = -m * (ceqbs + ceqbd + ceqqb);
+           rhsStamp[2] = m * (ceqbd - cdreq - ceqqd);
+           rhsStamp[3] = m * (cdreq + ceqbs + ceqqg
                                                     + ceqqb + ceqqd);
            if (here->BSIM3nqsMod)
-           here->BSIM3rhsQ = m * (cqcheq - cqdef);
+           rhsStamp[4] = m * (cqcheq - cqdef);
 #else
            (*(ckt->CKTrhs + here->BSIM3gNode) -= m * ceqqg);
            (*(ckt->CKTrhs + here->BSIM3bNode) -= m * (ceqbs + ceqbd + ceqqb));
@@ -3013,55 +3014,55 @@ line900:
 
            T1 = qdef * here->BSIM3gtau;
 #ifdef USE_OMP
-           here->BSIM3DdPt = m * here->BSIM3drainConductance;
-           here->BSIM3GgPt = m * (gcggb - ggtg);
-           here->BSIM3SsPt = m * here->BSIM3sourceConductance;
-           here->BSIM3BbPt = m * (here->BSIM3gbd + here->BSIM3gbs
+           matStamp[0] = m * here->BSIM3drainConductance;
+           matStamp[1] = m * (gcggb - ggtg);
+           matStamp[2] = m * here->BSIM3sourceConductance;
+           matStamp[3] = m * (here->BSIM3gbd + here->BSIM3gbs
                                 - gcbgb - gcbdb - gcbsb - here->BSIM3gbbs);
-           here->BSIM3DPdpPt = m * (here->BSIM3drainConductance
+           matStamp[4] = m * (here->BSIM3drainConductance
                                   + here->BSIM3gds + here->BSIM3gbd
                                   + RevSum + gcddb + dxpart * ggtd
                                   + T1 * ddxpart_dVd + gbdpdp);
-           here->BSIM3SPspPt = m * (here->BSIM3sourceConductance
+           matStamp[5] = m * (here->BSIM3sourceConductance
                                   + here->BSIM3gds + here->BSIM3gbs
                                   + FwdSum + gcssb + sxpart * ggts
                                   + T1 * dsxpart_dVs + gbspsp);
-           here->BSIM3DdpPt = m * here->BSIM3drainConductance;
-           here->BSIM3GbPt = m * (gcggb + gcgdb + gcgsb + ggtb);
-           here->BSIM3GdpPt = m * (gcgdb - ggtd);
-           here->BSIM3GspPt = m * (gcgsb - ggts);
-           here->BSIM3SspPt = m * here->BSIM3sourceConductance;
-           here->BSIM3BgPt = m * (gcbgb - here->BSIM3gbgs);
-           here->BSIM3BdpPt = m * (gcbdb - here->BSIM3gbd + gbbdp);
-           here->BSIM3BspPt = m * (gcbsb - here->BSIM3gbs + gbbsp);
-           here->BSIM3DPdPt = m * here->BSIM3drainConductance;
-           here->BSIM3DPgPt = m * (Gm + gcdgb + dxpart * ggtg
+           matStamp[6] = -m * here->BSIM3drainConductance;
+           matStamp[7] = -m * (gcggb + gcgdb + gcgsb + ggtb);
+           matStamp[8] = m * (gcgdb - ggtd);
+           matStamp[9] = m * (gcgsb - ggts);
+           matStamp[10] = -m * here->BSIM3sourceConductance;
+           matStamp[11] = m * (gcbgb - here->BSIM3gbgs);
+           matStamp[12] = m * (gcbdb - here->BSIM3gbd + gbbdp);
+           matStamp[13] = m * (gcbsb - here->BSIM3gbs + gbbsp);
+           matStamp[14] = -m * here->BSIM3drainConductance;
+           matStamp[15] = m * (Gm + gcdgb + dxpart * ggtg
                                  + T1 * ddxpart_dVg + gbdpg);
-           here->BSIM3DPbPt = m * (here->BSIM3gbd - Gmbs + gcdgb + gcddb
+           matStamp[16] = -m * (here->BSIM3gbd - Gmbs + gcdgb + gcddb
                                  + gcdsb - dxpart * ggtb
                                  - T1 * ddxpart_dVb - gbdpb);
-           here->BSIM3DPspPt = m * (here->BSIM3gds + FwdSum - gcdsb
+           matStamp[17] = -m * (here->BSIM3gds + FwdSum - gcdsb
                                   - dxpart * ggts - T1 * ddxpart_dVs - gbdpsp);
-           here->BSIM3SPgPt = m * (gcsgb - Gm + sxpart * ggtg
+           matStamp[18] = m * (gcsgb - Gm + sxpart * ggtg
                                  + T1 * dsxpart_dVg + gbspg);
-           here->BSIM3SPsPt = m * here->BSIM3sourceConductance;
-           here->BSIM3SPbPt = m * (here->BSIM3gbs + Gmbs + gcsgb + gcsdb
+           matStamp[19] = -m * here->BSIM3sourceConductance;
+           matStamp[20] = -m * (here->BSIM3gbs + Gmbs + gcsgb + gcsdb
                                  + gcssb - sxpart * ggtb
                                  - T1 * dsxpart_dVb - gbspb);
-           here->BSIM3SPdpPt = m * (here->BSIM3gds + RevSum - gcsdb
+           matStamp[21] = -m * (here->BSIM3gds + RevSum - gcsdb
                                   - sxpart * ggtd - T1 * dsxpart_dVd - gbspdp);
 
            if (here->BSIM3nqsMod)
-           {   here->BSIM3QqPt = m * (gqdef + here->BSIM3gtau);
+           {   matStamp[22] = m * (gqdef + here->BSIM3gtau);
 
-               here->BSIM3DPqPt = m * (dxpart * here->BSIM3gtau);
-               here->BSIM3SPqPt = m * (sxpart * here->BSIM3gtau);
-               here->BSIM3GqPt = m * here->BSIM3gtau;
+               matStamp[23] = m * (dxpart * here->BSIM3gtau);
+               matStamp[24] = m * (sxpart * here->BSIM3gtau);
+               matStamp[25] = -m * here->BSIM3gtau;
 
-               here->BSIM3QgPt = m * (ggtg - gcqgb);
-               here->BSIM3QdpPt = m * (ggtd - gcqdb);
-               here->BSIM3QspPt = m * (ggts - gcqsb);
-               here->BSIM3QbPt = m * (ggtb - gcqbb);
+               matStamp[26] = m * (ggtg - gcqgb);
+               matStamp[27] = m * (ggtd - gcqdb);
+               matStamp[28] = m * (ggts - gcqsb);
+               matStamp[29] = m * (ggtb - gcqbb);
            }
 #else
            (*(here->BSIM3DdPtr) += m * here->BSIM3drainConductance);
@@ -3122,66 +3123,3 @@ line1000:  ;
 #endif
 return(OK);
 }
-
-#ifdef USE_OMP
-void BSIM3LoadRhsMat(GENmodel *inModel, CKTcircuit *ckt)
-{
-    int InstCount, idx;
-    BSIM3instance **InstArray;
-    BSIM3instance *here;
-    BSIM3model *model = (BSIM3model*)inModel;
-
-    InstArray = model->BSIM3InstanceArray;
-    InstCount = model->BSIM3InstCount;
-
-    for(idx = 0; idx < InstCount; idx++) {
-       here = InstArray[idx];
-       model = here->BSIM3modPtr;
-        /* Update b for Ax = b */
-       (*(ckt->CKTrhs + here->BSIM3gNode) -= here->BSIM3rhsG);
-       (*(ckt->CKTrhs + here->BSIM3bNode) -= here->BSIM3rhsB);
-       (*(ckt->CKTrhs + here->BSIM3dNodePrime) += here->BSIM3rhsD);
-       (*(ckt->CKTrhs + here->BSIM3sNodePrime) += here->BSIM3rhsS);
-       if (here->BSIM3nqsMod)
-           (*(ckt->CKTrhs + here->BSIM3qNode) += here->BSIM3rhsQ);
-
-        /* Update A for Ax = b */
-           (*(here->BSIM3DdPtr) += here->BSIM3DdPt);
-           (*(here->BSIM3GgPtr) += here->BSIM3GgPt);
-           (*(here->BSIM3SsPtr) += here->BSIM3SsPt);
-           (*(here->BSIM3BbPtr) += here->BSIM3BbPt);
-           (*(here->BSIM3DPdpPtr) += here->BSIM3DPdpPt);
-           (*(here->BSIM3SPspPtr) += here->BSIM3SPspPt);
-           (*(here->BSIM3DdpPtr) -= here->BSIM3DdpPt);
-           (*(here->BSIM3GbPtr) -= here->BSIM3GbPt);
-           (*(here->BSIM3GdpPtr) += here->BSIM3GdpPt);
-           (*(here->BSIM3GspPtr) += here->BSIM3GspPt);
-           (*(here->BSIM3SspPtr) -= here->BSIM3SspPt);
-           (*(here->BSIM3BgPtr) += here->BSIM3BgPt);
-           (*(here->BSIM3BdpPtr) += here->BSIM3BdpPt);
-           (*(here->BSIM3BspPtr) += here->BSIM3BspPt);
-           (*(here->BSIM3DPdPtr) -= here->BSIM3DPdPt);
-           (*(here->BSIM3DPgPtr) += here->BSIM3DPgPt);
-           (*(here->BSIM3DPbPtr) -= here->BSIM3DPbPt);
-           (*(here->BSIM3DPspPtr) -= here->BSIM3DPspPt);
-           (*(here->BSIM3SPgPtr) += here->BSIM3SPgPt);
-           (*(here->BSIM3SPsPtr) -= here->BSIM3SPsPt);
-           (*(here->BSIM3SPbPtr) -= here->BSIM3SPbPt);
-           (*(here->BSIM3SPdpPtr) -= here->BSIM3SPdpPt);
-
-           if (here->BSIM3nqsMod)
-           {   *(here->BSIM3QqPtr) += here->BSIM3QqPt;
-
-               *(here->BSIM3DPqPtr) += here->BSIM3DPqPt;
-               *(here->BSIM3SPqPtr) += here->BSIM3SPqPt;
-               *(here->BSIM3GqPtr) -= here->BSIM3GqPt;
-
-               *(here->BSIM3QgPtr) += here->BSIM3QgPt;
-               *(here->BSIM3QdpPtr) += here->BSIM3QdpPt;
-               *(here->BSIM3QspPtr) += here->BSIM3QspPt;
-               *(here->BSIM3QbPtr) += here->BSIM3QbPt;
-           }
-
-    }
-}
-#endif
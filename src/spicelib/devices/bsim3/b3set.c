@@ -45,6 +45,7 @@ IFuid tmpName;
 #ifdef USE_OMP
 int idx, InstCount;
 BSIM3instance **InstArray;
+CKTstampBuf *stamps;
 #endif
 
 
@@ -1138,8 +1139,14 @@ do { if((here->ptr = SMPmakeElt(matrix, here->first, here->second)) == NULL){\
             InstCount++;
         }
     }
-    InstArray = TMALLOC(BSIM3instance*, InstCount);
     model = (BSIM3model*)inModel;
+    /* a repeated setup replaces the arrays shared by all models */
+    if (model) {
+        FREE(model->BSIM3InstanceArray);
+        CKTstampFree(&model->BSIM3stamps);
+    }
+    InstArray = TMALLOC(BSIM3instance*, InstCount);
+    stamps = CKTstampNew();
     idx = 0;
     for( ; model != NULL; model = model->BSIM3nextModel )
     {
@@ -1149,10 +1156,52 @@ do { if((here->ptr = SMPmakeElt(matrix, here->first, here->second)) == NULL){\
         {
             InstArray[idx] = here;
             idx++;
+
+            /* reserve the stamp slots, in the order used by BSIM3LoadOMP */
+            here->BSIM3rhsSlot = CKTstampRhs(stamps, here->BSIM3gNode);
+            CKTstampRhs(stamps, here->BSIM3bNode);
+            CKTstampRhs(stamps, here->BSIM3dNodePrime);
+            CKTstampRhs(stamps, here->BSIM3sNodePrime);
+            if (here->BSIM3nqsMod)
+                CKTstampRhs(stamps, here->BSIM3qNode);
+
+            here->BSIM3matSlot = CKTstampMat(stamps, here->BSIM3DdPtr);
+            CKTstampMat(stamps, here->BSIM3GgPtr);
+            CKTstampMat(stamps, here->BSIM3SsPtr);
+            CKTstampMat(stamps, here->BSIM3BbPtr);
+            CKTstampMat(stamps, here->BSIM3DPdpPtr);
+            CKTstampMat(stamps, here->BSIM3SPspPtr);
+            CKTstampMat(stamps, here->BSIM3DdpPtr);
+            CKTstampMat(stamps, here->BSIM3GbPtr);
+            CKTstampMat(stamps, here->BSIM3GdpPtr);
+            CKTstampMat(stamps, here->BSIM3GspPtr);
+            CKTstampMat(stamps, here->BSIM3SspPtr);
+            CKTstampMat(stamps, here->BSIM3BgPtr);
+            CKTstampMat(stamps, here->BSIM3BdpPtr);
+            CKTstampMat(stamps, here->BSIM3BspPtr);
+            CKTstampMat(stamps, here->BSIM3DPdPtr);
+            CKTstampMat(stamps, here->BSIM3DPgPtr);
+            CKTstampMat(stamps, here->BSIM3DPbPtr);
+            CKTstampMat(stamps, here->BSIM3DPspPtr);
+            CKTstampMat(stamps, here->BSIM3SPgPtr);
+            CKTstampMat(stamps, here->BSIM3SPsPtr);
+            CKTstampMat(stamps, here->BSIM3SPbPtr);
+            CKTstampMat(stamps, here->BSIM3SPdpPtr);
+            if (here->BSIM3nqsMod)
+            {   CKTstampMat(stamps, here->BSIM3QqPtr);
+                CKTstampMat(stamps, here->BSIM3DPqPtr);
+                CKTstampMat(stamps, here->BSIM3SPqPtr);
+                CKTstampMat(stamps, here->BSIM3GqPtr);
+                CKTstampMat(stamps, here->BSIM3QgPtr);
+                CKTstampMat(stamps, here->BSIM3QdpPtr);
+                CKTstampMat(stamps, here->BSIM3QspPtr);
+                CKTstampMat(stamps, here->BSIM3QbPtr);
+            }
         }
-        /* set the array pointer and instance count into each model */
+        /* set the array pointers and instance count into each model */
         model->BSIM3InstCount = InstCount;
         model->BSIM3InstanceArray = InstArray;
+        model->BSIM3stamps = stamps;
     }
 
 #endif
@@ -42,6 +42,10 @@ double tmp, tmp1, tmp2, tmp3, Eg, Eg0, ni, T0, T1, T2, T3, T4, T5, Ldrn, Wdrn;
 double delTemp, Temp, TRatio, Inv_L, Inv_W, Inv_LW, Vtm0, Tnom;
 double Nvtm, SourceSatCurrent, DrainSatCurrent;
 int Size_Not_Found, error;
+DEVsizeCache *sizeCache;
+double sizeKey[2];
+
+    sizeCache = DEVsizeCacheReset(ckt);
 
 /*  loop through all the BSIM3 device models */
     for (; model != NULL; model = model->BSIM3nextModel)
@@ -146,19 +150,13 @@ int Size_Not_Found, error;
          for (here = model->BSIM3instances; here != NULL;
               here = here->BSIM3nextInstance)
          {
-              pSizeDependParamKnot = model->pSizeDependParamKnot;
-              Size_Not_Found = 1;
-              while ((pSizeDependParamKnot != NULL) && Size_Not_Found)
-              {   if ((here->BSIM3l == pSizeDependParamKnot->Length)
-                      && (here->BSIM3w == pSizeDependParamKnot->Width))
-                  {   Size_Not_Found = 0;
-                      here->pParam = pSizeDependParamKnot;
-                      pParam = here->pParam; /*bug-fix  */
-                  }
-                  else
-                  {   pLastKnot = pSizeDependParamKnot;
-                      pSizeDependParamKnot = pSizeDependParamKnot->pNext;
-                  }
+              sizeKey[0] = here->BSIM3l;
+              sizeKey[1] = here->BSIM3w;
+              pSizeDependParamKnot = DEVsizeFind(sizeCache, model, sizeKey, 2);
+              Size_Not_Found = (pSizeDependParamKnot == NULL);
+              if (!Size_Not_Found)
+              {   here->pParam = pSizeDependParamKnot;
+                  pParam = here->pParam; /*bug-fix  */
               }
 
               if (Size_Not_Found)
@@ -169,6 +167,8 @@ int Size_Not_Found, error;
                       pLastKnot->pNext = pParam;
                   pParam->pNext = NULL;
                   here->pParam = pParam;
+                  pLastKnot = pParam;
+                  DEVsizeAdd(sizeCache, model, sizeKey, 2, pLastKnot);
 
                   Ldrn = here->BSIM3l;
                   Wdrn = here->BSIM3w;
@@ -175,45 +175,10 @@ typedef struct sBSIM3instance
     double *BSIM3BqPtr;
 
 #ifdef USE_OMP
-    /* per instance storage of results, to update matrix at a later stge */
-    double BSIM3rhsG;
-    double BSIM3rhsB;
-    double BSIM3rhsD;
-    double BSIM3rhsS;
-    double BSIM3rhsQ;
-
-    double BSIM3DdPt;
-    double BSIM3GgPt;
-    double BSIM3SsPt;
-    double BSIM3BbPt;
-    double BSIM3DPdpPt;
-    double BSIM3SPspPt;
-    double BSIM3DdpPt;
-    double BSIM3GbPt;
-    double BSIM3GdpPt;
-    double BSIM3GspPt;
-    double BSIM3SspPt;
-    double BSIM3BdpPt;
-    double BSIM3BspPt;
-    double BSIM3DPspPt;
-    double BSIM3DPdPt;
-    double BSIM3BgPt;
-    double BSIM3DPgPt;
-    double BSIM3SPgPt;
-    double BSIM3SPsPt;
-    double BSIM3DPbPt;
-    double BSIM3SPbPt;
-    double BSIM3SPdpPt;
-
-    double BSIM3QqPt;
-    double BSIM3QdpPt;
-    double BSIM3QgPt;
-    double BSIM3QspPt;
-    double BSIM3QbPt;
-    double BSIM3DPqPt;
-    double BSIM3GqPt;
-    double BSIM3SPqPt;
-    double BSIM3BqPt;
+    /* first matrix and rhs slot in the model stamp buffer, 22 and 4
+       slots, plus 8 and 1 when nqsMod is set */
+    int BSIM3matSlot;
+    int BSIM3rhsSlot;
 #endif
 
 #define BSIM3vbd BSIM3states+ 0
@@ -882,6 +847,7 @@ typedef struct sBSIM3model
 #ifdef USE_OMP
     int BSIM3InstCount;
     struct sBSIM3instance **BSIM3InstanceArray;
+    CKTstampBuf *BSIM3stamps;
 #endif
 
     /* Flags */
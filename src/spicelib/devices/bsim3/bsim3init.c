@@ -67,6 +67,8 @@ SPICEdev BSIM3info = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ BSIM3noise,
  /* DEVsoaCheck   */ BSIM3soaCheck,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
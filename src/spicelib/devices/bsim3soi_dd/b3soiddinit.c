@@ -65,6 +65,8 @@ SPICEdev B3SOIDDinfo = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ B3SOIDDnoise,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
@@ -17,6 +17,7 @@ Modified by Paolo Nenzi 2002
 #include "ngspice/ngspice.h"
 #include "ngspice/smpdefs.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
 #include "b3soidddef.h"
 #include "ngspice/const.h"
 #include "ngspice/sperror.h"
@@ -44,6 +45,10 @@ double tmp, tmp1, tmp2, Eg, Eg0, ni, T0, T1, T2, T3, T4, T5, T6, Ldrn, Wdrn;
 double Temp, TRatio, Inv_L, Inv_W, Inv_LW, Vtm0, Tnom;
 double SDphi, SDgamma;
 int Size_Not_Found;
+DEVsizeCache *sizeCache;
+double sizeKey[4];
+
+    sizeCache = DEVsizeCacheReset(ckt);
 
     /*  loop through all the B3SOIDD device models */
     for (; model != NULL; model = model->B3SOIDDnextModel)
@@ -77,21 +82,15 @@ int Size_Not_Found;
 	 {	      
 	      here->B3SOIDDrbodyext = here->B3SOIDDbodySquares *
                                     model->B3SOIDDrbsh;
-	      pSizeDependParamKnot = model->pSizeDependParamKnot;
-              Size_Not_Found = 1;
-	      while ((pSizeDependParamKnot != NULL) && Size_Not_Found)
-	      {   if ((here->B3SOIDDl == pSizeDependParamKnot->Length)
-		      && (here->B3SOIDDw == pSizeDependParamKnot->Width)
-                      && (here->B3SOIDDrth0 == pSizeDependParamKnot->Rth0)
-                      && (here->B3SOIDDcth0 == pSizeDependParamKnot->Cth0))
-                  {   Size_Not_Found = 0;
-		      here->pParam = pSizeDependParamKnot;
-		  }
-		  else
-		  {   pLastKnot = pSizeDependParamKnot;
-		      pSizeDependParamKnot = pSizeDependParamKnot->pNext;
-		  }
-              }
+	      sizeKey[0] = here->B3SOIDDl;
+	      sizeKey[1] = here->B3SOIDDw;
+	      sizeKey[2] = here->B3SOIDDrth0;
+	      sizeKey[3] = here->B3SOIDDcth0;
+	      pSizeDependParamKnot = DEVsizeFind(sizeCache, model, sizeKey, 4);
+	      Size_Not_Found = (pSizeDependParamKnot == NULL);
+	      if (!Size_Not_Found)
+	      {   here->pParam = pSizeDependParamKnot;
+	      }
 
 	      if (Size_Not_Found)
 	      {   pParam = TMALLOC(struct b3soiddSizeDependParam, 1);
@@ -101,6 +100,8 @@ int Size_Not_Found;
 		      pLastKnot->pNext = pParam;
                   pParam->pNext = NULL;
                   here->pParam = pParam;
+                  pLastKnot = pParam;
+                  DEVsizeAdd(sizeCache, model, sizeKey, 4, pLastKnot);
 
 		  Ldrn = here->B3SOIDDl;
 		  Wdrn = here->B3SOIDDw;
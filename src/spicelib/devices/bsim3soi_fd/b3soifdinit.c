@@ -66,6 +66,8 @@ SPICEdev B3SOIFDinfo = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ B3SOIFDnoise,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
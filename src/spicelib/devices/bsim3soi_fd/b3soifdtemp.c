@@ -16,6 +16,7 @@ Modified by Paolo Nenzi 2002
 #include "ngspice/ngspice.h"
 #include "ngspice/smpdefs.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
 #include "b3soifddef.h"
 #include "ngspice/const.h"
 #include "ngspice/sperror.h"
@@ -43,6 +44,10 @@ double tmp, tmp1, tmp2, Eg, Eg0, ni, T0, T1, T2, T3, T4, T5, T6, Ldrn, Wdrn;
 double Temp, TRatio, Inv_L, Inv_W, Inv_LW, Vtm0, Tnom;
 double SDphi, SDgamma;
 int Size_Not_Found;
+DEVsizeCache *sizeCache;
+double sizeKey[4];
+
+    sizeCache = DEVsizeCacheReset(ckt);
 
     /*  loop through all the B3SOIFD device models */
     for (; model != NULL; model = model->B3SOIFDnextModel)
@@ -76,21 +81,15 @@ int Size_Not_Found;
 	 {	      
 	      here->B3SOIFDrbodyext = here->B3SOIFDbodySquares *
                                     model->B3SOIFDrbsh;
-	      pSizeDependParamKnot = model->pSizeDependParamKnot;
-              Size_Not_Found = 1;
-	      while ((pSizeDependParamKnot != NULL) && Size_Not_Found)
-	      {   if ((here->B3SOIFDl == pSizeDependParamKnot->Length)
-		      && (here->B3SOIFDw == pSizeDependParamKnot->Width)
-                      && (here->B3SOIFDrth0 == pSizeDependParamKnot->Rth0)
-                      && (here->B3SOIFDcth0 == pSizeDependParamKnot->Cth0))
-                  {   Size_Not_Found = 0;
-		      here->pParam = pSizeDependParamKnot;
-		  }
-		  else
-		  {   pLastKnot = pSizeDependParamKnot;
-		      pSizeDependParamKnot = pSizeDependParamKnot->pNext;
-		  }
-              }
+	      sizeKey[0] = here->B3SOIFDl;
+	      sizeKey[1] = here->B3SOIFDw;
+	      sizeKey[2] = here->B3SOIFDrth0;
+	      sizeKey[3] = here->B3SOIFDcth0;
+	      pSizeDependParamKnot = DEVsizeFind(sizeCache, model, sizeKey, 4);
+	      Size_Not_Found = (pSizeDependParamKnot == NULL);
+	      if (!Size_Not_Found)
+	      {   here->pParam = pSizeDependParamKnot;
+	      }
 
 	      if (Size_Not_Found)
 	      {   pParam = TMALLOC(struct b3soifdSizeDependParam, 1);
@@ -100,6 +99,8 @@ int Size_Not_Found;
 		      pLastKnot->pNext = pParam;
                   pParam->pNext = NULL;
                   here->pParam = pParam;
+                  pLastKnot = pParam;
+                  DEVsizeAdd(sizeCache, model, sizeKey, 4, pLastKnot);
 
 		  Ldrn = here->B3SOIFDl;
 		  Wdrn = here->B3SOIFDw;
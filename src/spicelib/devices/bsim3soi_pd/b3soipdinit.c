@@ -67,6 +67,8 @@ SPICEdev B3SOIPDinfo = {
  /* DEVdisto*/       NULL,
  /* DEVnoise*/       B3SOIPDnoise,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump*/        NULL,
  /* DEVacct*/        NULL,
@@ -21,6 +21,7 @@ Modified by Paolo Nenzi 2002
 #include "ngspice/ngspice.h"
 #include "ngspice/smpdefs.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
 #include "b3soipddef.h"
 #include "ngspice/const.h"
 #include "ngspice/sperror.h"
@@ -58,11 +59,15 @@ double tmp, tmp1, tmp2, Eg, Eg0, ni, T0, T1, T2, T3, T4, T5, Ldrn, Wdrn;
 double Temp, TempRatio, Inv_L, Inv_W, Inv_LW, Vtm0, Tnom;
 double SDphi, SDgamma;
 int Size_Not_Found;
+DEVsizeCache *sizeCache;
+double sizeKey[4];
 
 /* v2.0 release */
 double tmp3, T7;
 
 
+    sizeCache = DEVsizeCacheReset(ckt);
+
     /*  loop through all the B3SOIPD device models */
     for (; model != NULL; model = model->B3SOIPDnextModel)
     {    Temp = ckt->CKTtemp;
@@ -95,22 +100,16 @@ double tmp3, T7;
 	 {
               here->B3SOIPDrbodyext = here->B3SOIPDbodySquares *
                                     model->B3SOIPDrbsh;
-	      pSizeDependParamKnot = model->pSizeDependParamKnot;
-              Size_Not_Found = 1;
-	      while ((pSizeDependParamKnot != NULL) && Size_Not_Found)
-	      {   if ((here->B3SOIPDl == pSizeDependParamKnot->Length)
-		      && (here->B3SOIPDw == pSizeDependParamKnot->Width)
-                      && (here->B3SOIPDrth0 == pSizeDependParamKnot->Rth0)
-                      && (here->B3SOIPDcth0 == pSizeDependParamKnot->Cth0))
-                  {   Size_Not_Found = 0;
-		      here->pParam = pSizeDependParamKnot;
-		      pParam = here->pParam; /* v2.2.3 bug fix */
-		  }
-		  else
-		  {   pLastKnot = pSizeDependParamKnot;
-		      pSizeDependParamKnot = pSizeDependParamKnot->pNext;
-		  }
-              }
+	      sizeKey[0] = here->B3SOIPDl;
+	      sizeKey[1] = here->B3SOIPDw;
+	      sizeKey[2] = here->B3SOIPDrth0;
+	      sizeKey[3] = here->B3SOIPDcth0;
+	      pSizeDependParamKnot = DEVsizeFind(sizeCache, model, sizeKey, 4);
+	      Size_Not_Found = (pSizeDependParamKnot == NULL);
+	      if (!Size_Not_Found)
+	      {   here->pParam = pSizeDependParamKnot;
+	          pParam = here->pParam; /* v2.2.3 bug fix */
+	      }
 
 	      if (Size_Not_Found)
 	      {   pParam = TMALLOC(struct b3soipdSizeDependParam, 1);
@@ -120,6 +119,8 @@ double tmp3, T7;
 		      pLastKnot->pNext = pParam;
                   pParam->pNext = NULL;
                   here->pParam = pParam;
+                  pLastKnot = pParam;
+                  DEVsizeAdd(sizeCache, model, sizeKey, 4, pLastKnot);
 
 		  Ldrn = here->B3SOIPDl;
 		  Wdrn = here->B3SOIPDw;
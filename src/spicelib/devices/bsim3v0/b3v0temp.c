@@ -8,6 +8,7 @@ File: b3temp.c
 #include "ngspice/ngspice.h"
 #include "ngspice/smpdefs.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
 #include "bsim3v0def.h"
 #include "ngspice/const.h"
 #include "ngspice/sperror.h"
@@ -34,6 +35,10 @@ struct bsim3v0SizeDependParam *pSizeDependParamKnot, *pLastKnot, *pParam = NULL;
 double tmp1, tmp2, Eg, ni, T0, T1, T2, T3, Ldrn, Wdrn;
 double Temp, TRatio, Inv_L, Inv_W, Inv_LW, Vtm0, Tnom;
 int Size_Not_Found;
+DEVsizeCache *sizeCache;
+double sizeKey[2];
+
+    sizeCache = DEVsizeCacheReset(ckt);
 
     /*  loop through all the BSIM3v0 device models */
     for (; model != NULL; model = model->BSIM3v0nextModel)
@@ -52,19 +57,13 @@ int Size_Not_Found;
          for (here = model->BSIM3v0instances; here != NULL;
               here=here->BSIM3v0nextInstance) 
  	 {
-	      pSizeDependParamKnot = model->pSizeDependParamKnot;
-	      Size_Not_Found = 1;
-	      while ((pSizeDependParamKnot != NULL) && Size_Not_Found)
-	      {   if ((here->BSIM3v0l == pSizeDependParamKnot->Length)
-		      && (here->BSIM3v0w == pSizeDependParamKnot->Width))
-                  {   Size_Not_Found = 0;
-		      here->pParam = pSizeDependParamKnot;
-		  }
-		  else
-		  {   pLastKnot = pSizeDependParamKnot;
-		      pSizeDependParamKnot = pSizeDependParamKnot->pNext;
-		  }
-              }
+	      sizeKey[0] = here->BSIM3v0l;
+	      sizeKey[1] = here->BSIM3v0w;
+	      pSizeDependParamKnot = DEVsizeFind(sizeCache, model, sizeKey, 2);
+	      Size_Not_Found = (pSizeDependParamKnot == NULL);
+	      if (!Size_Not_Found)
+	      {   here->pParam = pSizeDependParamKnot;
+	      }
 
 	      if (Size_Not_Found)
 	      {   pParam = TMALLOC(struct bsim3v0SizeDependParam, 1);
@@ -74,6 +73,8 @@ int Size_Not_Found;
 		      pLastKnot->pNext = pParam;
                   pParam->pNext = NULL;
                   here->pParam = pParam;
+                  pLastKnot = pParam;
+                  DEVsizeAdd(sizeCache, model, sizeKey, 2, pLastKnot);
 
 		     Ldrn = here->BSIM3v0l;
 		     Wdrn = here->BSIM3v0w;
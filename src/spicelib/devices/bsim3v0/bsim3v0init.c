@@ -66,6 +66,8 @@ SPICEdev B3v0info = {
  /* DEVdisto      */ NULL,        
  /* DEVnoise      */ BSIM3v0noise,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
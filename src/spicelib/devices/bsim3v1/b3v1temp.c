@@ -15,6 +15,7 @@
 #include "ngspice/ngspice.h"
 #include "ngspice/smpdefs.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
 #include "bsim3v1def.h"
 #include "ngspice/const.h"
 #include "ngspice/sperror.h"
@@ -41,6 +42,10 @@ struct bsim3v1SizeDependParam *pSizeDependParamKnot, *pLastKnot, *pParam = NULL;
 double tmp1, tmp2, Eg, Eg0, ni, T0, T1, T2, T3, Ldrn, Wdrn;
 double Temp, TRatio, Inv_L, Inv_W, Inv_LW, Vtm0, Tnom;
 int Size_Not_Found;
+DEVsizeCache *sizeCache;
+double sizeKey[2];
+
+    sizeCache = DEVsizeCacheReset(ckt);
 
     /*  loop through all the BSIM3v1 device models */
     for (; model != NULL; model = model->BSIM3v1nextModel)
@@ -92,19 +97,13 @@ int Size_Not_Found;
          for (here = model->BSIM3v1instances; here != NULL;
               here = here->BSIM3v1nextInstance) 
 	 {
-	      pSizeDependParamKnot = model->pSizeDependParamKnot;
-	      Size_Not_Found = 1;
-	      while ((pSizeDependParamKnot != NULL) && Size_Not_Found)
-	      {   if ((here->BSIM3v1l == pSizeDependParamKnot->Length)
-		      && (here->BSIM3v1w == pSizeDependParamKnot->Width))
-                  {   Size_Not_Found = 0;
-		      here->pParam = pSizeDependParamKnot;
-		  }
-		  else
-		  {   pLastKnot = pSizeDependParamKnot;
-		      pSizeDependParamKnot = pSizeDependParamKnot->pNext;
-		  }
-              }
+	      sizeKey[0] = here->BSIM3v1l;
+	      sizeKey[1] = here->BSIM3v1w;
+	      pSizeDependParamKnot = DEVsizeFind(sizeCache, model, sizeKey, 2);
+	      Size_Not_Found = (pSizeDependParamKnot == NULL);
+	      if (!Size_Not_Found)
+	      {   here->pParam = pSizeDependParamKnot;
+	      }
 
 	      if (Size_Not_Found)
 	      {   pParam = TMALLOC(struct bsim3v1SizeDependParam, 1);
@@ -114,6 +113,8 @@ int Size_Not_Found;
 		      pLastKnot->pNext = pParam;
                   pParam->pNext = NULL;
                   here->pParam = pParam;
+                  pLastKnot = pParam;
+                  DEVsizeAdd(sizeCache, model, sizeKey, 2, pLastKnot);
 
 		  Ldrn = here->BSIM3v1l;
 		  Wdrn = here->BSIM3v1w;
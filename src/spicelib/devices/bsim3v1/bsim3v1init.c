@@ -66,6 +66,8 @@ SPICEdev BSIM3v1info = {
  /* DEVdisto      */ NULL,        
  /* DEVnoise      */ BSIM3v1noise,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER    
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
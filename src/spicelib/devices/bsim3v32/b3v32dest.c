@@ -22,6 +22,7 @@ BSIM3v32destroy (GENmodel **inModel)
 #ifdef USE_OMP
     /* free just once for all models */
     FREE(mod->BSIM3v32InstanceArray);
+    CKTstampFree(&mod->BSIM3v32stamps);
 #endif
 
     while (mod) {
@@ -42,6 +42,7 @@ IFuid tmpName;
 #ifdef USE_OMP
 int idx, InstCount;
 BSIM3v32instance **InstArray;
+CKTstampBuf *stamps;
 #endif
 
     /*  loop through all the BSIM3v32 device models */
@@ -1150,8 +1151,14 @@ do { if((here->ptr = SMPmakeElt(matrix, here->first, here->second)) == NULL){\
             InstCount++;
         }
     }
-    InstArray = TMALLOC(BSIM3v32instance*, InstCount);
     model = (BSIM3v32model*)inModel;
+    /* a repeated setup replaces the arrays shared by all models */
+    if (model) {
+        FREE(model->BSIM3v32InstanceArray);
+        CKTstampFree(&model->BSIM3v32stamps);
+    }
+    InstArray = TMALLOC(BSIM3v32instance*, InstCount);
+    stamps = CKTstampNew();
     idx = 0;
     for (; model != NULL; model = model->BSIM3v32nextModel)
     {
@@ -1161,10 +1168,58 @@ do { if((here->ptr = SMPmakeElt(matrix, here->first, here->second)) == NULL){\
         {
             InstArray[idx] = here;
             idx++;
+
+            /* reserve the stamp slots written by BSIM3v32LoadOMP */
+            /* Update b for Ax = b */
+            here->BSIM3v32rhsG = CKTstampRhs(stamps, here->BSIM3v32gNode);
+            here->BSIM3v32rhsB = CKTstampRhs(stamps, here->BSIM3v32bNode);
+            here->BSIM3v32rhsD = CKTstampRhs(stamps, here->BSIM3v32dNodePrime);
+            here->BSIM3v32rhsS = CKTstampRhs(stamps, here->BSIM3v32sNodePrime);
+            if (here->BSIM3v32nqsMod)
+                here->BSIM3v32rhsQ = CKTstampRhs(stamps, here->BSIM3v32qNode);
+
+            /* Update A for Ax = b */
+            here->BSIM3v32DdPt = CKTstampMat(stamps, here->BSIM3v32DdPtr);
+            here->BSIM3v32GgPt = CKTstampMat(stamps, here->BSIM3v32GgPtr);
+            here->BSIM3v32SsPt = CKTstampMat(stamps, here->BSIM3v32SsPtr);
+            here->BSIM3v32BbPt = CKTstampMat(stamps, here->BSIM3v32BbPtr);
+            here->BSIM3v32DPdpPt = CKTstampMat(stamps, here->BSIM3v32DPdpPtr);
+            here->BSIM3v32SPspPt = CKTstampMat(stamps, here->BSIM3v32SPspPtr);
+            here->BSIM3v32DdpPt = CKTstampMat(stamps, here->BSIM3v32DdpPtr);
+            here->BSIM3v32GbPt = CKTstampMat(stamps, here->BSIM3v32GbPtr);
+            here->BSIM3v32GdpPt = CKTstampMat(stamps, here->BSIM3v32GdpPtr);
+            here->BSIM3v32GspPt = CKTstampMat(stamps, here->BSIM3v32GspPtr);
+            here->BSIM3v32SspPt = CKTstampMat(stamps, here->BSIM3v32SspPtr);
+            here->BSIM3v32BgPt = CKTstampMat(stamps, here->BSIM3v32BgPtr);
+            here->BSIM3v32BdpPt = CKTstampMat(stamps, here->BSIM3v32BdpPtr);
+            here->BSIM3v32BspPt = CKTstampMat(stamps, here->BSIM3v32BspPtr);
+            here->BSIM3v32DPdPt = CKTstampMat(stamps, here->BSIM3v32DPdPtr);
+            here->BSIM3v32DPgPt = CKTstampMat(stamps, here->BSIM3v32DPgPtr);
+            here->BSIM3v32DPbPt = CKTstampMat(stamps, here->BSIM3v32DPbPtr);
+            here->BSIM3v32DPspPt = CKTstampMat(stamps, here->BSIM3v32DPspPtr);
+            here->BSIM3v32SPgPt = CKTstampMat(stamps, here->BSIM3v32SPgPtr);
+            here->BSIM3v32SPsPt = CKTstampMat(stamps, here->BSIM3v32SPsPtr);
+            here->BSIM3v32SPbPt = CKTstampMat(stamps, here->BSIM3v32SPbPtr);
+            here->BSIM3v32SPdpPt = CKTstampMat(stamps, here->BSIM3v32SPdpPtr);
+
+            if (here->BSIM3v32nqsMod)
+            {
+                here->BSIM3v32QqPt = CKTstampMat(stamps, here->BSIM3v32QqPtr);
+
+                here->BSIM3v32DPqPt = CKTstampMat(stamps, here->BSIM3v32DPqPtr);
+                here->BSIM3v32SPqPt = CKTstampMat(stamps, here->BSIM3v32SPqPtr);
+                here->BSIM3v32GqPt = CKTstampMat(stamps, here->BSIM3v32GqPtr);
+
+                here->BSIM3v32QgPt = CKTstampMat(stamps, here->BSIM3v32QgPtr);
+                here->BSIM3v32QdpPt = CKTstampMat(stamps, here->BSIM3v32QdpPtr);
+                here->BSIM3v32QspPt = CKTstampMat(stamps, here->BSIM3v32QspPtr);
+                here->BSIM3v32QbPt = CKTstampMat(stamps, here->BSIM3v32QbPtr);
+            }
         }
-        /* set the array pointer and instance count into each model */
+        /* set the array pointers and instance count into each model */
         model->BSIM3v32InstCount = InstCount;
         model->BSIM3v32InstanceArray = InstArray;
+        model->BSIM3v32stamps = stamps;
     }
 
 #endif
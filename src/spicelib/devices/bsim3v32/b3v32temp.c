@@ -39,6 +39,10 @@ double tmp, tmp1, tmp2, tmp3, Eg, Eg0, ni, T0, T1, T2, T3, T4, T5, Ldrn, Wdrn;
 double delTemp, Temp, TRatio, Inv_L, Inv_W, Inv_LW, Vtm0, Tnom;
 double Nvtm, SourceSatCurrent, DrainSatCurrent;
 int Size_Not_Found, error;
+DEVsizeCache *sizeCache;
+double sizeKey[2];
+
+    sizeCache = DEVsizeCacheReset(ckt);
 
     /*  loop through all the BSIM3v32 device models */
     for (; model != NULL; model = model->BSIM3v32nextModel)
@@ -212,21 +216,15 @@ int Size_Not_Found, error;
          for (here = model->BSIM3v32instances; here != NULL;
               here = here->BSIM3v32nextInstance)
          {
-              pSizeDependParamKnot = model->pSizeDependParamKnot;
-              Size_Not_Found = 1;
-              while ((pSizeDependParamKnot != NULL) && Size_Not_Found)
-              {   if ((here->BSIM3v32l == pSizeDependParamKnot->Length)
-                      && (here->BSIM3v32w == pSizeDependParamKnot->Width))
-                  {   Size_Not_Found = 0;
-                      here->pParam = pSizeDependParamKnot;
-                      if (model->BSIM3v32intVersion > BSIM3v32V322)
-                      {
-                        pParam = here->pParam; /*bug-fix  */
-                      }
-                  }
-                  else
-                  {   pLastKnot = pSizeDependParamKnot;
-                      pSizeDependParamKnot = pSizeDependParamKnot->pNext;
+              sizeKey[0] = here->BSIM3v32l;
+              sizeKey[1] = here->BSIM3v32w;
+              pSizeDependParamKnot = DEVsizeFind(sizeCache, model, sizeKey, 2);
+              Size_Not_Found = (pSizeDependParamKnot == NULL);
+              if (!Size_Not_Found)
+              {   here->pParam = pSizeDependParamKnot;
+                  if (model->BSIM3v32intVersion > BSIM3v32V322)
+                  {
+                  pParam = here->pParam; /*bug-fix  */
                   }
               }
 
@@ -238,6 +236,8 @@ int Size_Not_Found, error;
                     pLastKnot->pNext = pParam;
                   pParam->pNext = NULL;
                   here->pParam = pParam;
+                  pLastKnot = pParam;
+                  DEVsizeAdd(sizeCache, model, sizeKey, 2, pLastKnot);
 
                   Ldrn = here->BSIM3v32l;
                   Wdrn = here->BSIM3v32w;
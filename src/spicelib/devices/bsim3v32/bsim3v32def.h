@@ -172,44 +172,44 @@ typedef struct sBSIM3v32instance
     double *BSIM3v32BqPtr;
 
 #ifdef USE_OMP
-    /* per instance storage of results, to update matrix at a later stge */
-    double BSIM3v32rhsG;
-    double BSIM3v32rhsB;
-    double BSIM3v32rhsD;
-    double BSIM3v32rhsS;
-    double BSIM3v32rhsQ;
-
-    double BSIM3v32DdPt;
-    double BSIM3v32GgPt;
-    double BSIM3v32SsPt;
-    double BSIM3v32BbPt;
-    double BSIM3v32DPdpPt;
-    double BSIM3v32SPspPt;
-    double BSIM3v32DdpPt;
-    double BSIM3v32GbPt;
-    double BSIM3v32GdpPt;
-    double BSIM3v32GspPt;
-    double BSIM3v32SspPt;
-    double BSIM3v32BdpPt;
-    double BSIM3v32BspPt;
-    double BSIM3v32DPspPt;
-    double BSIM3v32DPdPt;
-    double BSIM3v32BgPt;
-    double BSIM3v32DPgPt;
-    double BSIM3v32SPgPt;
-    double BSIM3v32SPsPt;
-    double BSIM3v32DPbPt;
-    double BSIM3v32SPbPt;
-    double BSIM3v32SPdpPt;
-
-    double BSIM3v32QqPt;
-    double BSIM3v32QdpPt;
-    double BSIM3v32QgPt;
-    double BSIM3v32QspPt;
-    double BSIM3v32QbPt;
-    double BSIM3v32DPqPt;
-    double BSIM3v32GqPt;
-    double BSIM3v32SPqPt;
+    /* slots of the results in the model stamp buffer */
+    int BSIM3v32rhsG;
+    int BSIM3v32rhsB;
+    int BSIM3v32rhsD;
+    int BSIM3v32rhsS;
+    int BSIM3v32rhsQ;
+
+    int BSIM3v32DdPt;
+    int BSIM3v32GgPt;
+    int BSIM3v32SsPt;
+    int BSIM3v32BbPt;
+    int BSIM3v32DPdpPt;
+    int BSIM3v32SPspPt;
+    int BSIM3v32DdpPt;
+    int BSIM3v32GbPt;
+    int BSIM3v32GdpPt;
+    int BSIM3v32GspPt;
+    int BSIM3v32SspPt;
+    int BSIM3v32BdpPt;
+    int BSIM3v32BspPt;
+    int BSIM3v32DPspPt;
+    int BSIM3v32DPdPt;
+    int BSIM3v32BgPt;
+    int BSIM3v32DPgPt;
+    int BSIM3v32SPgPt;
+    int BSIM3v32SPsPt;
+    int BSIM3v32DPbPt;
+    int BSIM3v32SPbPt;
+    int BSIM3v32SPdpPt;
+
+    int BSIM3v32QqPt;
+    int BSIM3v32QdpPt;
+    int BSIM3v32QgPt;
+    int BSIM3v32QspPt;
+    int BSIM3v32QbPt;
+    int BSIM3v32DPqPt;
+    int BSIM3v32GqPt;
+    int BSIM3v32SPqPt;
     double BSIM3v32BqPt;
 #endif
 
@@ -886,6 +886,7 @@ typedef struct sBSIM3v32model
 #ifdef USE_OMP
     int BSIM3v32InstCount;
     struct sBSIM3v32instance **BSIM3v32InstanceArray;
+    CKTstampBuf *BSIM3v32stamps;
 #endif
 
     /* Flags */
@@ -67,6 +67,8 @@ SPICEdev BSIM3v32info = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ BSIM3v32noise,
  /* DEVsoaCheck   */ BSIM3v32soaCheck,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
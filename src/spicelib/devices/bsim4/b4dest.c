@@ -71,6 +71,8 @@ BSIM4destroy(GENmodel **inModel)
 #ifdef USE_OMP
     /* free just once for all models */
     FREE(mod->BSIM4InstanceArray);
+    CKTstampFree(&mod->BSIM4stamps);
+    FREE(mod->BSIM4EvalArray);
 #endif
 
     while (mod) {
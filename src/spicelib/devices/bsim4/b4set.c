@@ -98,6 +98,7 @@ JOB   *job;
 #ifdef USE_OMP
 int idx, InstCount;
 BSIM4instance **InstArray;
+CKTstampBuf *stamps;
 #endif
 
     /* Search for a noise analysis request */
@@ -2729,8 +2730,16 @@ do { if((here->ptr = SMPmakeElt(matrix,here->first,here->second))==(double *)NUL
             InstCount++;
         }
     }
-    InstArray = TMALLOC(BSIM4instance*, InstCount);
     model = (BSIM4model*)inModel;
+    /* a repeated setup replaces the arrays shared by all models,
+       BSIM4temp builds the evaluation array again */
+    if (model) {
+        FREE(model->BSIM4InstanceArray);
+        FREE(model->BSIM4EvalArray);
+        CKTstampFree(&model->BSIM4stamps);
+    }
+    InstArray = TMALLOC(BSIM4instance*, InstCount);
+    stamps = CKTstampNew();
     idx = 0;
     for( ; model != NULL; model = model->BSIM4nextModel )
     {
@@ -2740,10 +2749,181 @@ do { if((here->ptr = SMPmakeElt(matrix,here->first,here->second))==(double *)NUL
         { 
             InstArray[idx] = here;
             idx++;
+
+            /* reserve the stamp slots written by BSIM4LoadOMP */
+            /* Update b for Ax = b */
+            here->BSIM4rhsdPrime = CKTstampRhs(stamps, here->BSIM4dNodePrime);
+            here->BSIM4rhsgPrime = CKTstampRhs(stamps, here->BSIM4gNodePrime);
+
+            if (here->BSIM4rgateMod == 2)
+                here->BSIM4rhsgExt = CKTstampRhs(stamps, here->BSIM4gNodeExt);
+            else if (here->BSIM4rgateMod == 3)
+                here->BSIM4grhsMid = CKTstampRhs(stamps, here->BSIM4gNodeMid);
+
+            if (!here->BSIM4rbodyMod)
+            {   here->BSIM4rhsbPrime = CKTstampRhs(stamps, here->BSIM4bNodePrime);
+                here->BSIM4rhssPrime = CKTstampRhs(stamps, here->BSIM4sNodePrime);
+            }
+            else
+            {   here->BSIM4rhsdb = CKTstampRhs(stamps, here->BSIM4dbNode);
+                here->BSIM4rhsbPrime = CKTstampRhs(stamps, here->BSIM4bNodePrime);
+                here->BSIM4rhssb = CKTstampRhs(stamps, here->BSIM4sbNode);
+                here->BSIM4rhssPrime = CKTstampRhs(stamps, here->BSIM4sNodePrime);
+            }
+
+            if (model->BSIM4rdsMod)
+            {   here->BSIM4rhsd = CKTstampRhs(stamps, here->BSIM4dNode);
+                here->BSIM4rhss = CKTstampRhs(stamps, here->BSIM4sNode);
+            }
+
+            if (here->BSIM4trnqsMod)
+                here->BSIM4rhsq = CKTstampRhs(stamps, here->BSIM4qNode);
+
+            /* Update A for Ax = b */
+            if (here->BSIM4rgateMod == 1)
+            {   here->BSIM4_1 = CKTstampMat(stamps, here->BSIM4GEgePtr);
+                here->BSIM4_2 = CKTstampMat(stamps, here->BSIM4GPgePtr);
+                here->BSIM4_3 = CKTstampMat(stamps, here->BSIM4GEgpPtr);
+                here->BSIM4_4 = CKTstampMat(stamps, here->BSIM4GPgpPtr);
+                here->BSIM4_5 = CKTstampMat(stamps, here->BSIM4GPdpPtr);
+                here->BSIM4_6 = CKTstampMat(stamps, here->BSIM4GPspPtr);
+                here->BSIM4_7 = CKTstampMat(stamps, here->BSIM4GPbpPtr);
+            }
+            else if (here->BSIM4rgateMod == 2)
+            {   here->BSIM4_8 = CKTstampMat(stamps, here->BSIM4GEgePtr);
+                here->BSIM4_9 = CKTstampMat(stamps, here->BSIM4GEgpPtr);
+                here->BSIM4_10 = CKTstampMat(stamps, here->BSIM4GEdpPtr);
+                here->BSIM4_11 = CKTstampMat(stamps, here->BSIM4GEspPtr);
+                here->BSIM4_12 = CKTstampMat(stamps, here->BSIM4GEbpPtr);
+
+                here->BSIM4_13 = CKTstampMat(stamps, here->BSIM4GPgePtr);
+                here->BSIM4_14 = CKTstampMat(stamps, here->BSIM4GPgpPtr);
+                here->BSIM4_15 = CKTstampMat(stamps, here->BSIM4GPdpPtr);
+                here->BSIM4_16 = CKTstampMat(stamps, here->BSIM4GPspPtr);
+                here->BSIM4_17 = CKTstampMat(stamps, here->BSIM4GPbpPtr);
+            }
+            else if (here->BSIM4rgateMod == 3)
+            {   here->BSIM4_18 = CKTstampMat(stamps, here->BSIM4GEgePtr);
+                here->BSIM4_19 = CKTstampMat(stamps, here->BSIM4GEgmPtr);
+                here->BSIM4_20 = CKTstampMat(stamps, here->BSIM4GMgePtr);
+                here->BSIM4_21 = CKTstampMat(stamps, here->BSIM4GMgmPtr);
+
+                here->BSIM4_22 = CKTstampMat(stamps, here->BSIM4GMdpPtr);
+                here->BSIM4_23 = CKTstampMat(stamps, here->BSIM4GMgpPtr);
+                here->BSIM4_24 = CKTstampMat(stamps, here->BSIM4GMspPtr);
+                here->BSIM4_25 = CKTstampMat(stamps, here->BSIM4GMbpPtr);
+
+                here->BSIM4_26 = CKTstampMat(stamps, here->BSIM4DPgmPtr);
+                here->BSIM4_27 = CKTstampMat(stamps, here->BSIM4GPgmPtr);
+                here->BSIM4_28 = CKTstampMat(stamps, here->BSIM4SPgmPtr);
+                here->BSIM4_29 = CKTstampMat(stamps, here->BSIM4BPgmPtr);
+
+                here->BSIM4_30 = CKTstampMat(stamps, here->BSIM4GPgpPtr);
+                here->BSIM4_31 = CKTstampMat(stamps, here->BSIM4GPdpPtr);
+                here->BSIM4_32 = CKTstampMat(stamps, here->BSIM4GPspPtr);
+                here->BSIM4_33 = CKTstampMat(stamps, here->BSIM4GPbpPtr);
+            }
+
+             else
+            {   here->BSIM4_34 = CKTstampMat(stamps, here->BSIM4GPgpPtr);
+                here->BSIM4_35 = CKTstampMat(stamps, here->BSIM4GPdpPtr);
+                here->BSIM4_36 = CKTstampMat(stamps, here->BSIM4GPspPtr);
+                here->BSIM4_37 = CKTstampMat(stamps, here->BSIM4GPbpPtr);
+            }
+
+            if (model->BSIM4rdsMod)
+            {   here->BSIM4_38 = CKTstampMat(stamps, here->BSIM4DgpPtr);
+                here->BSIM4_39 = CKTstampMat(stamps, here->BSIM4DspPtr);
+                here->BSIM4_40 = CKTstampMat(stamps, here->BSIM4DbpPtr);
+                here->BSIM4_41 = CKTstampMat(stamps, here->BSIM4SdpPtr);
+                here->BSIM4_42 = CKTstampMat(stamps, here->BSIM4SgpPtr);
+                here->BSIM4_43 = CKTstampMat(stamps, here->BSIM4SbpPtr);
+            }
+
+            here->BSIM4_44 = CKTstampMat(stamps, here->BSIM4DPdpPtr);
+            here->BSIM4_45 = CKTstampMat(stamps, here->BSIM4DPdPtr);
+            here->BSIM4_46 = CKTstampMat(stamps, here->BSIM4DPgpPtr);
+            here->BSIM4_47 = CKTstampMat(stamps, here->BSIM4DPspPtr);
+            here->BSIM4_48 = CKTstampMat(stamps, here->BSIM4DPbpPtr);
+
+            here->BSIM4_49 = CKTstampMat(stamps, here->BSIM4DdpPtr);
+            here->BSIM4_50 = CKTstampMat(stamps, here->BSIM4DdPtr);
+
+            here->BSIM4_51 = CKTstampMat(stamps, here->BSIM4SPdpPtr);
+            here->BSIM4_52 = CKTstampMat(stamps, here->BSIM4SPgpPtr);
+            here->BSIM4_53 = CKTstampMat(stamps, here->BSIM4SPspPtr);
+            here->BSIM4_54 = CKTstampMat(stamps, here->BSIM4SPsPtr);
+            here->BSIM4_55 = CKTstampMat(stamps, here->BSIM4SPbpPtr);
+
+            here->BSIM4_56 = CKTstampMat(stamps, here->BSIM4SspPtr);
+            here->BSIM4_57 = CKTstampMat(stamps, here->BSIM4SsPtr);
+
+            here->BSIM4_58 = CKTstampMat(stamps, here->BSIM4BPdpPtr);
+            here->BSIM4_59 = CKTstampMat(stamps, here->BSIM4BPgpPtr);
+            here->BSIM4_60 = CKTstampMat(stamps, here->BSIM4BPspPtr);
+            here->BSIM4_61 = CKTstampMat(stamps, here->BSIM4BPbpPtr);
+
+            /* stamp gidl */
+            here->BSIM4_62 = CKTstampMat(stamps, here->BSIM4DPdpPtr);
+            here->BSIM4_63 = CKTstampMat(stamps, here->BSIM4DPgpPtr);
+            here->BSIM4_64 = CKTstampMat(stamps, here->BSIM4DPspPtr);
+            here->BSIM4_65 = CKTstampMat(stamps, here->BSIM4DPbpPtr);
+            here->BSIM4_66 = CKTstampMat(stamps, here->BSIM4BPdpPtr);
+            here->BSIM4_67 = CKTstampMat(stamps, here->BSIM4BPgpPtr);
+            here->BSIM4_68 = CKTstampMat(stamps, here->BSIM4BPspPtr);
+            here->BSIM4_69 = CKTstampMat(stamps, here->BSIM4BPbpPtr);
+             /* stamp gisl */
+            here->BSIM4_70 = CKTstampMat(stamps, here->BSIM4SPdpPtr);
+            here->BSIM4_71 = CKTstampMat(stamps, here->BSIM4SPgpPtr);
+            here->BSIM4_72 = CKTstampMat(stamps, here->BSIM4SPspPtr);
+            here->BSIM4_73 = CKTstampMat(stamps, here->BSIM4SPbpPtr);
+            here->BSIM4_74 = CKTstampMat(stamps, here->BSIM4BPdpPtr);
+            here->BSIM4_75 = CKTstampMat(stamps, here->BSIM4BPgpPtr);
+            here->BSIM4_76 = CKTstampMat(stamps, here->BSIM4BPspPtr);
+            here->BSIM4_77 = CKTstampMat(stamps, here->BSIM4BPbpPtr);
+
+            if (here->BSIM4rbodyMod)
+            {   here->BSIM4_78 = CKTstampMat(stamps, here->BSIM4DPdbPtr);
+                here->BSIM4_79 = CKTstampMat(stamps, here->BSIM4SPsbPtr);
+
+                here->BSIM4_80 = CKTstampMat(stamps, here->BSIM4DBdpPtr);
+                here->BSIM4_81 = CKTstampMat(stamps, here->BSIM4DBdbPtr);
+                here->BSIM4_82 = CKTstampMat(stamps, here->BSIM4DBbpPtr);
+                here->BSIM4_83 = CKTstampMat(stamps, here->BSIM4DBbPtr);
+
+                here->BSIM4_84 = CKTstampMat(stamps, here->BSIM4BPdbPtr);
+                here->BSIM4_85 = CKTstampMat(stamps, here->BSIM4BPbPtr);
+                here->BSIM4_86 = CKTstampMat(stamps, here->BSIM4BPsbPtr);
+                here->BSIM4_87 = CKTstampMat(stamps, here->BSIM4BPbpPtr);
+
+                here->BSIM4_88 = CKTstampMat(stamps, here->BSIM4SBspPtr);
+                here->BSIM4_89 = CKTstampMat(stamps, here->BSIM4SBbpPtr);
+                here->BSIM4_90 = CKTstampMat(stamps, here->BSIM4SBbPtr);
+                here->BSIM4_91 = CKTstampMat(stamps, here->BSIM4SBsbPtr);
+
+                here->BSIM4_92 = CKTstampMat(stamps, here->BSIM4BdbPtr);
+                here->BSIM4_93 = CKTstampMat(stamps, here->BSIM4BbpPtr);
+                here->BSIM4_94 = CKTstampMat(stamps, here->BSIM4BsbPtr);
+                here->BSIM4_95 = CKTstampMat(stamps, here->BSIM4BbPtr);
+            }
+
+            if (here->BSIM4trnqsMod)
+            {   here->BSIM4_96 = CKTstampMat(stamps, here->BSIM4QqPtr);
+                here->BSIM4_97 = CKTstampMat(stamps, here->BSIM4QgpPtr);
+                here->BSIM4_98 = CKTstampMat(stamps, here->BSIM4QdpPtr);
+                here->BSIM4_99 = CKTstampMat(stamps, here->BSIM4QspPtr);
+                here->BSIM4_100 = CKTstampMat(stamps, here->BSIM4QbpPtr);
+
+                here->BSIM4_101 = CKTstampMat(stamps, here->BSIM4DPqPtr);
+                here->BSIM4_102 = CKTstampMat(stamps, here->BSIM4SPqPtr);
+                here->BSIM4_103 = CKTstampMat(stamps, here->BSIM4GPqPtr);
+            }
         }
-        /* set the array pointer and instance count into each model */
+        /* set the array pointers and instance count into each model */
         model->BSIM4InstCount = InstCount;
         model->BSIM4InstanceArray = InstArray;		
+        model->BSIM4stamps = stamps;
+        model->BSIM4EvalArray = NULL;
     }
 #endif
 
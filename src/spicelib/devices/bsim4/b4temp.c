@@ -61,6 +61,7 @@
 #include "ngspice/ngspice.h"
 #include "ngspice/smpdefs.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
 #include "bsim4def.h"
 #include "ngspice/const.h"
 #include "ngspice/sperror.h"
@@ -102,6 +103,55 @@ return 0;
 }
 
 
+#ifdef USE_OMP
+/* Build the evaluation array of the OpenMP load, the instances ordered
+ * by model and size bin, so the instances evaluated one after the other
+ * by a thread mostly share their model and size dependent parameters in
+ * the cache.  Instances keep their netlist order within a bin.
+ * The stamp slots stay in the netlist order of the instance array, so
+ * the matrix and rhs sums are rounded as before.
+ */
+
+static void
+BSIM4orderInstances(BSIM4model *model)
+{
+    BSIM4instance **InstArray = model->BSIM4InstanceArray;
+    BSIM4instance **sorted;
+    int InstCount = model->BSIM4InstCount;
+    struct bsim4SizeDependParam *pParam;
+    BSIM4model *mod;
+    int nbatch, *start, idx;
+
+    /* shared by all models, like the instance array */
+    FREE(model->BSIM4EvalArray);
+    for (mod = model; mod != NULL; mod = mod->BSIM4nextModel)
+        mod->BSIM4EvalArray = NULL;
+
+    if (!InstArray)
+        return;
+
+    nbatch = 0;
+    for (mod = model; mod != NULL; mod = mod->BSIM4nextModel)
+        for (pParam = mod->pSizeDependParamKnot; pParam; pParam = pParam->pNext)
+            pParam->Batch = nbatch++;
+
+    start = TMALLOC(int, nbatch + 1);
+    for (idx = 0; idx < InstCount; idx++)
+        start[InstArray[idx]->pParam->Batch + 1]++;
+    for (idx = 0; idx < nbatch; idx++)
+        start[idx + 1] += start[idx];
+
+    sorted = TMALLOC(BSIM4instance *, InstCount);
+    for (idx = 0; idx < InstCount; idx++)
+        sorted[start[InstArray[idx]->pParam->Batch]++] = InstArray[idx];
+    for (mod = model; mod != NULL; mod = mod->BSIM4nextModel)
+        mod->BSIM4EvalArray = sorted;
+
+    tfree(start);
+}
+#endif
+
+
 int
 BSIM4temp(
 GENmodel *inModel,
@@ -126,6 +176,10 @@ double n,n0, Vgsteff, Vgs_eff, niter, toxpf, toxpi, Tcen, toxe, epsrox, vddeot;
 double vtfbphi2eot, phieot, TempRatioeot, Vtm0eot, Vtmeot,vbieot;
 
 int Size_Not_Found, i;
+DEVsizeCache *sizeCache;
+double sizeKey[3];
+
+    sizeCache = DEVsizeCacheReset(ckt);
 
     /*  loop through all the BSIM4 device models */
     for (; model != NULL; model = model->BSIM4nextModel)
@@ -445,20 +499,14 @@ int Size_Not_Found, i;
          for (here = model->BSIM4instances; here != NULL;
               here = here->BSIM4nextInstance)
          {
-              pSizeDependParamKnot = model->pSizeDependParamKnot;
-              Size_Not_Found = 1;
-              while ((pSizeDependParamKnot != NULL) && Size_Not_Found)
-              {   if ((here->BSIM4l == pSizeDependParamKnot->Length)
-                      && (here->BSIM4w == pSizeDependParamKnot->Width)
-                      && (here->BSIM4nf == pSizeDependParamKnot->NFinger))
-                  {   Size_Not_Found = 0;
-                      here->pParam = pSizeDependParamKnot;
-                      pParam = here->pParam; /*bug-fix  */
-                  }
-                  else
-                  {   pLastKnot = pSizeDependParamKnot;
-                      pSizeDependParamKnot = pSizeDependParamKnot->pNext;
-                  }
+              sizeKey[0] = here->BSIM4l;
+              sizeKey[1] = here->BSIM4w;
+              sizeKey[2] = here->BSIM4nf;
+              pSizeDependParamKnot = DEVsizeFind(sizeCache, model, sizeKey, 3);
+              Size_Not_Found = (pSizeDependParamKnot == NULL);
+              if (!Size_Not_Found)
+              {   here->pParam = pSizeDependParamKnot;
+                  pParam = here->pParam; /*bug-fix  */
               }
 
               /* stress effect */
@@ -473,6 +521,8 @@ int Size_Not_Found, i;
                       pLastKnot->pNext = pParam;
                   pParam->pNext = NULL;
                   here->pParam = pParam;
+                  pLastKnot = pParam;
+                  DEVsizeAdd(sizeCache, model, sizeKey, 3, pLastKnot);
 
                   pParam->Length = here->BSIM4l;
                   pParam->Width = here->BSIM4w;
@@ -2405,5 +2455,10 @@ int Size_Not_Found, i;
               }
          } /* End instance */
     }
+
+#ifdef USE_OMP
+    BSIM4orderInstances((BSIM4model*) inModel);
+#endif
+
     return(OK);
 }
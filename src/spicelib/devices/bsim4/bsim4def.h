@@ -432,122 +432,122 @@ typedef struct sBSIM4instance
     double *BSIM4SPqPtr;
 
 #ifdef USE_OMP
-    /* per instance storage of results, to update matrix at a later stge */
-    double BSIM4rhsdPrime;
-    double BSIM4rhsgPrime;
-    double BSIM4rhsgExt;
-    double BSIM4grhsMid;
-    double BSIM4rhsbPrime;
-    double BSIM4rhssPrime;
-    double BSIM4rhsdb;
-    double BSIM4rhssb;
-    double BSIM4rhsd;
-    double BSIM4rhss;
-    double BSIM4rhsq;
-
-    double BSIM4_1;
-    double BSIM4_2;
-    double BSIM4_3;
-    double BSIM4_4;
-    double BSIM4_5;
-    double BSIM4_6;
-    double BSIM4_7;
-    double BSIM4_8;
-    double BSIM4_9;
-    double BSIM4_10;
-    double BSIM4_11;
-    double BSIM4_12;
-    double BSIM4_13;
-    double BSIM4_14;
-    double BSIM4_15;
-    double BSIM4_16;
-    double BSIM4_17;
-    double BSIM4_18;
-    double BSIM4_19;
-    double BSIM4_20;
-    double BSIM4_21;
-    double BSIM4_22;
-    double BSIM4_23;
-    double BSIM4_24;
-    double BSIM4_25;
-    double BSIM4_26;
-    double BSIM4_27;
-    double BSIM4_28;
-    double BSIM4_29;
-    double BSIM4_30;
-    double BSIM4_31;
-    double BSIM4_32;
-    double BSIM4_33;
-    double BSIM4_34;
-    double BSIM4_35;
-    double BSIM4_36;
-    double BSIM4_37;
-    double BSIM4_38;
-    double BSIM4_39;
-    double BSIM4_40;
-    double BSIM4_41;
-    double BSIM4_42;
-    double BSIM4_43;
-    double BSIM4_44;
-    double BSIM4_45;
-    double BSIM4_46;
-    double BSIM4_47;
-    double BSIM4_48;
-    double BSIM4_49;
-    double BSIM4_50;
-    double BSIM4_51;
-    double BSIM4_52;
-    double BSIM4_53;
-    double BSIM4_54;
-    double BSIM4_55;
-    double BSIM4_56;
-    double BSIM4_57;
-    double BSIM4_58;
-    double BSIM4_59;
-    double BSIM4_60;
-    double BSIM4_61;
-    double BSIM4_62;
-    double BSIM4_63;
-    double BSIM4_64;
-    double BSIM4_65;
-    double BSIM4_66;
-    double BSIM4_67;
-    double BSIM4_68;
-    double BSIM4_69;
-    double BSIM4_70;
-    double BSIM4_71;
-    double BSIM4_72;
-    double BSIM4_73;
-    double BSIM4_74;
-    double BSIM4_75;
-    double BSIM4_76;
-    double BSIM4_77;
-    double BSIM4_78;
-    double BSIM4_79;
-    double BSIM4_80;
-    double BSIM4_81;
-    double BSIM4_82;
-    double BSIM4_83;
-    double BSIM4_84;
-    double BSIM4_85;
-    double BSIM4_86;
-    double BSIM4_87;
-    double BSIM4_88;
-    double BSIM4_89;
-    double BSIM4_90;
-    double BSIM4_91;
-    double BSIM4_92;
-    double BSIM4_93;
-    double BSIM4_94;
-    double BSIM4_95;
-    double BSIM4_96;
-    double BSIM4_97;
-    double BSIM4_98;
-    double BSIM4_99;
-    double BSIM4_100;
-    double BSIM4_101;
-    double BSIM4_102;
-    double BSIM4_103;
+    /* slots of the results in the model stamp buffer */
+    int BSIM4rhsdPrime;
+    int BSIM4rhsgPrime;
+    int BSIM4rhsgExt;
+    int BSIM4grhsMid;
+    int BSIM4rhsbPrime;
+    int BSIM4rhssPrime;
+    int BSIM4rhsdb;
+    int BSIM4rhssb;
+    int BSIM4rhsd;
+    int BSIM4rhss;
+    int BSIM4rhsq;
+
+    int BSIM4_1;
+    int BSIM4_2;
+    int BSIM4_3;
+    int BSIM4_4;
+    int BSIM4_5;
+    int BSIM4_6;
+    int BSIM4_7;
+    int BSIM4_8;
+    int BSIM4_9;
+    int BSIM4_10;
+    int BSIM4_11;
+    int BSIM4_12;
+    int BSIM4_13;
+    int BSIM4_14;
+    int BSIM4_15;
+    int BSIM4_16;
+    int BSIM4_17;
+    int BSIM4_18;
+    int BSIM4_19;
+    int BSIM4_20;
+    int BSIM4_21;
+    int BSIM4_22;
+    int BSIM4_23;
+    int BSIM4_24;
+    int BSIM4_25;
+    int BSIM4_26;
+    int BSIM4_27;
+    int BSIM4_28;
+    int BSIM4_29;
+    int BSIM4_30;
+    int BSIM4_31;
+    int BSIM4_32;
+    int BSIM4_33;
+    int BSIM4_34;
+    int BSIM4_35;
+    int BSIM4_36;
+    int BSIM4_37;
+    int BSIM4_38;
+    int BSIM4_39;
+    int BSIM4_40;
+    int BSIM4_41;
+    int BSIM4_42;
+    int BSIM4_43;
+    int BSIM4_44;
+    int BSIM4_45;
+    int BSIM4_46;
+    int BSIM4_47;
+    int BSIM4_48;
+    int BSIM4_49;
+    int BSIM4_50;
+    int BSIM4_51;
+    int BSIM4_52;
+    int BSIM4_53;
+    int BSIM4_54;
+    int BSIM4_55;
+    int BSIM4_56;
+    int BSIM4_57;
+    int BSIM4_58;
+    int BSIM4_59;
+    int BSIM4_60;
+    int BSIM4_61;
+    int BSIM4_62;
+    int BSIM4_63;
+    int BSIM4_64;
+    int BSIM4_65;
+    int BSIM4_66;
+    int BSIM4_67;
+    int BSIM4_68;
+    int BSIM4_69;
+    int BSIM4_70;
+    int BSIM4_71;
+    int BSIM4_72;
+    int BSIM4_73;
+    int BSIM4_74;
+    int BSIM4_75;
+    int BSIM4_76;
+    int BSIM4_77;
+    int BSIM4_78;
+    int BSIM4_79;
+    int BSIM4_80;
+    int BSIM4_81;
+    int BSIM4_82;
+    int BSIM4_83;
+    int BSIM4_84;
+    int BSIM4_85;
+    int BSIM4_86;
+    int BSIM4_87;
+    int BSIM4_88;
+    int BSIM4_89;
+    int BSIM4_90;
+    int BSIM4_91;
+    int BSIM4_92;
+    int BSIM4_93;
+    int BSIM4_94;
+    int BSIM4_95;
+    int BSIM4_96;
+    int BSIM4_97;
+    int BSIM4_98;
+    int BSIM4_99;
+    int BSIM4_100;
+    int BSIM4_101;
+    int BSIM4_102;
+    int BSIM4_103;
 #endif
 
 #define BSIM4vbd BSIM4states+ 0
@@ -851,6 +851,9 @@ struct bsim4SizeDependParam
     double BSIM4k2ox;
     double BSIM4vfbzbfactor;
     double BSIM4dvtp2factor; /* v4.7 */
+#ifdef USE_OMP
+    int Batch;  /* position of this size bin in the instance array */
+#endif
     struct bsim4SizeDependParam  *pNext;
 };
 
@@ -1829,7 +1832,9 @@ typedef struct sBSIM4model
 
 #ifdef USE_OMP
     int BSIM4InstCount;
-    struct sBSIM4instance **BSIM4InstanceArray;
+    struct sBSIM4instance **BSIM4InstanceArray;  /* netlist order, for stamping */
+    CKTstampBuf *BSIM4stamps;
+    struct sBSIM4instance **BSIM4EvalArray;      /* size bin order, for evaluation */
 #endif
 
     /* Flags */
@@ -68,6 +68,8 @@ SPICEdev BSIM4info = {
     NULL,          /* DEVdisto       */
     BSIM4noise,    /* DEVnoise       */
     BSIM4soaCheck, /* DEVsoaCheck    */
+    NULL, /* DEVsnapSave    */
+    NULL, /* DEVsnapLoad    */
 #ifdef CIDER
     NULL,          /* DEVdump        */
     NULL,          /* DEVacct        */
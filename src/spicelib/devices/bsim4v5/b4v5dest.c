@@ -21,6 +21,7 @@ BSIM4v5destroy(GENmodel **inModel)
 #ifdef USE_OMP
     /* free just once for all models */
     FREE(mod->BSIM4v5InstanceArray);
+    CKTstampFree(&mod->BSIM4v5stamps);
 #endif
 
     while (mod) {
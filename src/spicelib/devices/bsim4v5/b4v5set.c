@@ -55,6 +55,7 @@ JOB   *job;
 #ifdef USE_OMP
 int idx, InstCount;
 BSIM4v5instance **InstArray;
+CKTstampBuf *stamps;
 #endif
 
     /* Search for a noise analysis request */
@@ -2107,8 +2108,14 @@ do { if((here->ptr = SMPmakeElt(matrix, here->first, here->second)) == NULL){\
             InstCount++;
         }
     }
-    InstArray = TMALLOC(BSIM4v5instance*, InstCount);
     model = (BSIM4v5model*)inModel;
+    /* a repeated setup replaces the arrays shared by all models */
+    if (model) {
+        FREE(model->BSIM4v5InstanceArray);
+        CKTstampFree(&model->BSIM4v5stamps);
+    }
+    InstArray = TMALLOC(BSIM4v5instance*, InstCount);
+    stamps = CKTstampNew();
     idx = 0;
     for (; model != NULL; model = model->BSIM4v5nextModel)
     {
@@ -2118,10 +2125,180 @@ do { if((here->ptr = SMPmakeElt(matrix, here->first, here->second)) == NULL){\
         {
             InstArray[idx] = here;
             idx++;
+
+            /* reserve the stamp slots written by BSIM4v5LoadOMP */
+            /* Update b for Ax = b */
+            here->BSIM4v5rhsdPrime = CKTstampRhs(stamps, here->BSIM4v5dNodePrime);
+            here->BSIM4v5rhsgPrime = CKTstampRhs(stamps, here->BSIM4v5gNodePrime);
+
+            if (here->BSIM4v5rgateMod == 2)
+                here->BSIM4v5rhsgExt = CKTstampRhs(stamps, here->BSIM4v5gNodeExt);
+            else if (here->BSIM4v5rgateMod == 3)
+                here->BSIM4v5grhsMid = CKTstampRhs(stamps, here->BSIM4v5gNodeMid);
+
+            if (!here->BSIM4v5rbodyMod)
+            {   here->BSIM4v5rhsbPrime = CKTstampRhs(stamps, here->BSIM4v5bNodePrime);
+                here->BSIM4v5rhssPrime = CKTstampRhs(stamps, here->BSIM4v5sNodePrime);
+            }
+            else
+            {   here->BSIM4v5rhsdb = CKTstampRhs(stamps, here->BSIM4v5dbNode);
+                here->BSIM4v5rhsbPrime = CKTstampRhs(stamps, here->BSIM4v5bNodePrime);
+                here->BSIM4v5rhssb = CKTstampRhs(stamps, here->BSIM4v5sbNode);
+                here->BSIM4v5rhssPrime = CKTstampRhs(stamps, here->BSIM4v5sNodePrime);
+            }
+
+            if (model->BSIM4v5rdsMod)
+            {   here->BSIM4v5rhsd = CKTstampRhs(stamps, here->BSIM4v5dNode);
+                here->BSIM4v5rhss = CKTstampRhs(stamps, here->BSIM4v5sNode);
+            }
+
+            if (here->BSIM4v5trnqsMod)
+                here->BSIM4v5rhsq = CKTstampRhs(stamps, here->BSIM4v5qNode);
+
+            /* Update A for Ax = b */
+            if (here->BSIM4v5rgateMod == 1)
+            {   here->BSIM4v5_1 = CKTstampMat(stamps, here->BSIM4v5GEgePtr);
+                here->BSIM4v5_2 = CKTstampMat(stamps, here->BSIM4v5GPgePtr);
+                here->BSIM4v5_3 = CKTstampMat(stamps, here->BSIM4v5GEgpPtr);
+                here->BSIM4v5_4 = CKTstampMat(stamps, here->BSIM4v5GPgpPtr);
+                here->BSIM4v5_5 = CKTstampMat(stamps, here->BSIM4v5GPdpPtr);
+                here->BSIM4v5_6 = CKTstampMat(stamps, here->BSIM4v5GPspPtr);
+                here->BSIM4v5_7 = CKTstampMat(stamps, here->BSIM4v5GPbpPtr);
+            }
+            else if (here->BSIM4v5rgateMod == 2)
+            {   here->BSIM4v5_8 = CKTstampMat(stamps, here->BSIM4v5GEgePtr);
+                here->BSIM4v5_9 = CKTstampMat(stamps, here->BSIM4v5GEgpPtr);
+                here->BSIM4v5_10 = CKTstampMat(stamps, here->BSIM4v5GEdpPtr);
+                here->BSIM4v5_11 = CKTstampMat(stamps, here->BSIM4v5GEspPtr);
+                here->BSIM4v5_12 = CKTstampMat(stamps, here->BSIM4v5GEbpPtr);
+
+                here->BSIM4v5_13 = CKTstampMat(stamps, here->BSIM4v5GPgePtr);
+                here->BSIM4v5_14 = CKTstampMat(stamps, here->BSIM4v5GPgpPtr);
+                here->BSIM4v5_15 = CKTstampMat(stamps, here->BSIM4v5GPdpPtr);
+                here->BSIM4v5_16 = CKTstampMat(stamps, here->BSIM4v5GPspPtr);
+                here->BSIM4v5_17 = CKTstampMat(stamps, here->BSIM4v5GPbpPtr);
+            }
+            else if (here->BSIM4v5rgateMod == 3)
+            {   here->BSIM4v5_18 = CKTstampMat(stamps, here->BSIM4v5GEgePtr);
+                here->BSIM4v5_19 = CKTstampMat(stamps, here->BSIM4v5GEgmPtr);
+                here->BSIM4v5_20 = CKTstampMat(stamps, here->BSIM4v5GMgePtr);
+                here->BSIM4v5_21 = CKTstampMat(stamps, here->BSIM4v5GMgmPtr);
+
+                here->BSIM4v5_22 = CKTstampMat(stamps, here->BSIM4v5GMdpPtr);
+                here->BSIM4v5_23 = CKTstampMat(stamps, here->BSIM4v5GMgpPtr);
+                here->BSIM4v5_24 = CKTstampMat(stamps, here->BSIM4v5GMspPtr);
+                here->BSIM4v5_25 = CKTstampMat(stamps, here->BSIM4v5GMbpPtr);
+
+                here->BSIM4v5_26 = CKTstampMat(stamps, here->BSIM4v5DPgmPtr);
+                here->BSIM4v5_27 = CKTstampMat(stamps, here->BSIM4v5GPgmPtr);
+                here->BSIM4v5_28 = CKTstampMat(stamps, here->BSIM4v5SPgmPtr);
+                here->BSIM4v5_29 = CKTstampMat(stamps, here->BSIM4v5BPgmPtr);
+
+                here->BSIM4v5_30 = CKTstampMat(stamps, here->BSIM4v5GPgpPtr);
+                here->BSIM4v5_31 = CKTstampMat(stamps, here->BSIM4v5GPdpPtr);
+                here->BSIM4v5_32 = CKTstampMat(stamps, here->BSIM4v5GPspPtr);
+                here->BSIM4v5_33 = CKTstampMat(stamps, here->BSIM4v5GPbpPtr);
+            }
+
+             else
+            {   here->BSIM4v5_34 = CKTstampMat(stamps, here->BSIM4v5GPgpPtr);
+                here->BSIM4v5_35 = CKTstampMat(stamps, here->BSIM4v5GPdpPtr);
+                here->BSIM4v5_36 = CKTstampMat(stamps, here->BSIM4v5GPspPtr);
+                here->BSIM4v5_37 = CKTstampMat(stamps, here->BSIM4v5GPbpPtr);
+            }
+
+            if (model->BSIM4v5rdsMod)
+            {   here->BSIM4v5_38 = CKTstampMat(stamps, here->BSIM4v5DgpPtr);
+                here->BSIM4v5_39 = CKTstampMat(stamps, here->BSIM4v5DspPtr);
+                here->BSIM4v5_40 = CKTstampMat(stamps, here->BSIM4v5DbpPtr);
+                here->BSIM4v5_41 = CKTstampMat(stamps, here->BSIM4v5SdpPtr);
+                here->BSIM4v5_42 = CKTstampMat(stamps, here->BSIM4v5SgpPtr);
+                here->BSIM4v5_43 = CKTstampMat(stamps, here->BSIM4v5SbpPtr);
+            }
+
+            here->BSIM4v5_44 = CKTstampMat(stamps, here->BSIM4v5DPdpPtr);
+            here->BSIM4v5_45 = CKTstampMat(stamps, here->BSIM4v5DPdPtr);
+            here->BSIM4v5_46 = CKTstampMat(stamps, here->BSIM4v5DPgpPtr);
+            here->BSIM4v5_47 = CKTstampMat(stamps, here->BSIM4v5DPspPtr);
+            here->BSIM4v5_48 = CKTstampMat(stamps, here->BSIM4v5DPbpPtr);
+
+            here->BSIM4v5_49 = CKTstampMat(stamps, here->BSIM4v5DdpPtr);
+            here->BSIM4v5_50 = CKTstampMat(stamps, here->BSIM4v5DdPtr);
+
+            here->BSIM4v5_51 = CKTstampMat(stamps, here->BSIM4v5SPdpPtr);
+            here->BSIM4v5_52 = CKTstampMat(stamps, here->BSIM4v5SPgpPtr);
+            here->BSIM4v5_53 = CKTstampMat(stamps, here->BSIM4v5SPspPtr);
+            here->BSIM4v5_54 = CKTstampMat(stamps, here->BSIM4v5SPsPtr);
+            here->BSIM4v5_55 = CKTstampMat(stamps, here->BSIM4v5SPbpPtr);
+
+            here->BSIM4v5_56 = CKTstampMat(stamps, here->BSIM4v5SspPtr);
+            here->BSIM4v5_57 = CKTstampMat(stamps, here->BSIM4v5SsPtr);
+
+            here->BSIM4v5_58 = CKTstampMat(stamps, here->BSIM4v5BPdpPtr);
+            here->BSIM4v5_59 = CKTstampMat(stamps, here->BSIM4v5BPgpPtr);
+            here->BSIM4v5_60 = CKTstampMat(stamps, here->BSIM4v5BPspPtr);
+            here->BSIM4v5_61 = CKTstampMat(stamps, here->BSIM4v5BPbpPtr);
+
+            /* stamp gidl */
+            here->BSIM4v5_62 = CKTstampMat(stamps, here->BSIM4v5DPdpPtr);
+            here->BSIM4v5_63 = CKTstampMat(stamps, here->BSIM4v5DPgpPtr);
+            here->BSIM4v5_64 = CKTstampMat(stamps, here->BSIM4v5DPspPtr);
+            here->BSIM4v5_65 = CKTstampMat(stamps, here->BSIM4v5DPbpPtr);
+            here->BSIM4v5_66 = CKTstampMat(stamps, here->BSIM4v5BPdpPtr);
+            here->BSIM4v5_67 = CKTstampMat(stamps, here->BSIM4v5BPgpPtr);
+            here->BSIM4v5_68 = CKTstampMat(stamps, here->BSIM4v5BPspPtr);
+            here->BSIM4v5_69 = CKTstampMat(stamps, here->BSIM4v5BPbpPtr);
+             /* stamp gisl */
+            here->BSIM4v5_70 = CKTstampMat(stamps, here->BSIM4v5SPdpPtr);
+            here->BSIM4v5_71 = CKTstampMat(stamps, here->BSIM4v5SPgpPtr);
+            here->BSIM4v5_72 = CKTstampMat(stamps, here->BSIM4v5SPspPtr);
+            here->BSIM4v5_73 = CKTstampMat(stamps, here->BSIM4v5SPbpPtr);
+            here->BSIM4v5_74 = CKTstampMat(stamps, here->BSIM4v5BPdpPtr);
+            here->BSIM4v5_75 = CKTstampMat(stamps, here->BSIM4v5BPgpPtr);
+            here->BSIM4v5_76 = CKTstampMat(stamps, here->BSIM4v5BPspPtr);
+            here->BSIM4v5_77 = CKTstampMat(stamps, here->BSIM4v5BPbpPtr);
+
+            if (here->BSIM4v5rbodyMod)
+            {   here->BSIM4v5_78 = CKTstampMat(stamps, here->BSIM4v5DPdbPtr);
+                here->BSIM4v5_79 = CKTstampMat(stamps, here->BSIM4v5SPsbPtr);
+
+                here->BSIM4v5_80 = CKTstampMat(stamps, here->BSIM4v5DBdpPtr);
+                here->BSIM4v5_81 = CKTstampMat(stamps, here->BSIM4v5DBdbPtr);
+                here->BSIM4v5_82 = CKTstampMat(stamps, here->BSIM4v5DBbpPtr);
+                here->BSIM4v5_83 = CKTstampMat(stamps, here->BSIM4v5DBbPtr);
+
+                here->BSIM4v5_84 = CKTstampMat(stamps, here->BSIM4v5BPdbPtr);
+                here->BSIM4v5_85 = CKTstampMat(stamps, here->BSIM4v5BPbPtr);
+                here->BSIM4v5_86 = CKTstampMat(stamps, here->BSIM4v5BPsbPtr);
+                here->BSIM4v5_87 = CKTstampMat(stamps, here->BSIM4v5BPbpPtr);
+
+                here->BSIM4v5_88 = CKTstampMat(stamps, here->BSIM4v5SBspPtr);
+                here->BSIM4v5_89 = CKTstampMat(stamps, here->BSIM4v5SBbpPtr);
+                here->BSIM4v5_90 = CKTstampMat(stamps, here->BSIM4v5SBbPtr);
+                here->BSIM4v5_91 = CKTstampMat(stamps, here->BSIM4v5SBsbPtr);
+
+                here->BSIM4v5_92 = CKTstampMat(stamps, here->BSIM4v5BdbPtr);
+                here->BSIM4v5_93 = CKTstampMat(stamps, here->BSIM4v5BbpPtr);
+                here->BSIM4v5_94 = CKTstampMat(stamps, here->BSIM4v5BsbPtr);
+                here->BSIM4v5_95 = CKTstampMat(stamps, here->BSIM4v5BbPtr);
+            }
+
+            if (here->BSIM4v5trnqsMod)
+            {   here->BSIM4v5_96 = CKTstampMat(stamps, here->BSIM4v5QqPtr);
+                here->BSIM4v5_97 = CKTstampMat(stamps, here->BSIM4v5QgpPtr);
+                here->BSIM4v5_98 = CKTstampMat(stamps, here->BSIM4v5QdpPtr);
+                here->BSIM4v5_99 = CKTstampMat(stamps, here->BSIM4v5QspPtr);
+                here->BSIM4v5_100 = CKTstampMat(stamps, here->BSIM4v5QbpPtr);
+
+                here->BSIM4v5_101 = CKTstampMat(stamps, here->BSIM4v5DPqPtr);
+                here->BSIM4v5_102 = CKTstampMat(stamps, here->BSIM4v5SPqPtr);
+                here->BSIM4v5_103 = CKTstampMat(stamps, here->BSIM4v5GPqPtr);
+            }
         }
-        /* set the array pointer and instance count into each model */
+        /* set the array pointers and instance count into each model */
         model->BSIM4v5InstCount = InstCount;
         model->BSIM4v5InstanceArray = InstArray;
+        model->BSIM4v5stamps = stamps;
     }
 #endif
 
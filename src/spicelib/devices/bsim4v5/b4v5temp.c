@@ -17,6 +17,7 @@
 #include "ngspice/ngspice.h"
 #include "ngspice/smpdefs.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
 #include "bsim4v5def.h"
 #include "ngspice/const.h"
 #include "ngspice/sperror.h"
@@ -81,6 +82,10 @@ double lnl, lnw, lnnf, rbpbx, rbpby, rbsbx, rbsby, rbdbx, rbdby,bodymode;
 double kvsat, wlod, sceff, Wdrn;
 
 int Size_Not_Found, i;
+DEVsizeCache *sizeCache;
+double sizeKey[3];
+
+    sizeCache = DEVsizeCacheReset(ckt);
 
     /*  loop through all the BSIM4v5 device models */
     for (; model != NULL; model = model->BSIM4v5nextModel)
@@ -340,20 +345,14 @@ int Size_Not_Found, i;
          for (here = model->BSIM4v5instances; here != NULL;
               here = here->BSIM4v5nextInstance) 
             {
-              pSizeDependParamKnot = model->pSizeDependParamKnot;
-              Size_Not_Found = 1;
-              while ((pSizeDependParamKnot != NULL) && Size_Not_Found)
-              {   if ((here->BSIM4v5l == pSizeDependParamKnot->Length)
-                      && (here->BSIM4v5w == pSizeDependParamKnot->Width)
-                      && (here->BSIM4v5nf == pSizeDependParamKnot->NFinger))
-                  {   Size_Not_Found = 0;
-                      here->pParam = pSizeDependParamKnot;
-                      pParam = here->pParam; /*bug-fix  */
-                  }
-                  else
-                  {   pLastKnot = pSizeDependParamKnot;
-                      pSizeDependParamKnot = pSizeDependParamKnot->pNext;
-                  }
+              sizeKey[0] = here->BSIM4v5l;
+              sizeKey[1] = here->BSIM4v5w;
+              sizeKey[2] = here->BSIM4v5nf;
+              pSizeDependParamKnot = DEVsizeFind(sizeCache, model, sizeKey, 3);
+              Size_Not_Found = (pSizeDependParamKnot == NULL);
+              if (!Size_Not_Found)
+              {   here->pParam = pSizeDependParamKnot;
+                  pParam = here->pParam; /*bug-fix  */
               }
 
               /* stress effect */
@@ -368,6 +367,8 @@ int Size_Not_Found, i;
 		      pLastKnot->pNext = pParam;
                   pParam->pNext = NULL;
                   here->pParam = pParam;
+                  pLastKnot = pParam;
+                  DEVsizeAdd(sizeCache, model, sizeKey, 3, pLastKnot);
 
                   pParam->Length = here->BSIM4v5l;
                   pParam->Width = here->BSIM4v5w;
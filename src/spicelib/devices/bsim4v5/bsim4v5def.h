@@ -377,122 +377,122 @@ typedef struct sBSIM4v5instance
     double *BSIM4v5SPqPtr;
 
 #ifdef USE_OMP
-    /* per instance storage of results, to update matrix at a later stge */
-    double BSIM4v5rhsdPrime;
-    double BSIM4v5rhsgPrime;
-    double BSIM4v5rhsgExt;
-    double BSIM4v5grhsMid;
-    double BSIM4v5rhsbPrime;
-    double BSIM4v5rhssPrime;
-    double BSIM4v5rhsdb;
-    double BSIM4v5rhssb;
-    double BSIM4v5rhsd;
-    double BSIM4v5rhss;
-    double BSIM4v5rhsq;
-
-    double BSIM4v5_1;
-    double BSIM4v5_2;
-    double BSIM4v5_3;
-    double BSIM4v5_4;
-    double BSIM4v5_5;
-    double BSIM4v5_6;
-    double BSIM4v5_7;
-    double BSIM4v5_8;
-    double BSIM4v5_9;
-    double BSIM4v5_10;
-    double BSIM4v5_11;
-    double BSIM4v5_12;
-    double BSIM4v5_13;
-    double BSIM4v5_14;
-    double BSIM4v5_15;
-    double BSIM4v5_16;
-    double BSIM4v5_17;
-    double BSIM4v5_18;
-    double BSIM4v5_19;
-    double BSIM4v5_20;
-    double BSIM4v5_21;
-    double BSIM4v5_22;
-    double BSIM4v5_23;
-    double BSIM4v5_24;
-    double BSIM4v5_25;
-    double BSIM4v5_26;
-    double BSIM4v5_27;
-    double BSIM4v5_28;
-    double BSIM4v5_29;
-    double BSIM4v5_30;
-    double BSIM4v5_31;
-    double BSIM4v5_32;
-    double BSIM4v5_33;
-    double BSIM4v5_34;
-    double BSIM4v5_35;
-    double BSIM4v5_36;
-    double BSIM4v5_37;
-    double BSIM4v5_38;
-    double BSIM4v5_39;
-    double BSIM4v5_40;
-    double BSIM4v5_41;
-    double BSIM4v5_42;
-    double BSIM4v5_43;
-    double BSIM4v5_44;
-    double BSIM4v5_45;
-    double BSIM4v5_46;
-    double BSIM4v5_47;
-    double BSIM4v5_48;
-    double BSIM4v5_49;
-    double BSIM4v5_50;
-    double BSIM4v5_51;
-    double BSIM4v5_52;
-    double BSIM4v5_53;
-    double BSIM4v5_54;
-    double BSIM4v5_55;
-    double BSIM4v5_56;
-    double BSIM4v5_57;
-    double BSIM4v5_58;
-    double BSIM4v5_59;
-    double BSIM4v5_60;
-    double BSIM4v5_61;
-    double BSIM4v5_62;
-    double BSIM4v5_63;
-    double BSIM4v5_64;
-    double BSIM4v5_65;
-    double BSIM4v5_66;
-    double BSIM4v5_67;
-    double BSIM4v5_68;
-    double BSIM4v5_69;
-    double BSIM4v5_70;
-    double BSIM4v5_71;
-    double BSIM4v5_72;
-    double BSIM4v5_73;
-    double BSIM4v5_74;
-    double BSIM4v5_75;
-    double BSIM4v5_76;
-    double BSIM4v5_77;
-    double BSIM4v5_78;
-    double BSIM4v5_79;
-    double BSIM4v5_80;
-    double BSIM4v5_81;
-    double BSIM4v5_82;
-    double BSIM4v5_83;
-    double BSIM4v5_84;
-    double BSIM4v5_85;
-    double BSIM4v5_86;
-    double BSIM4v5_87;
-    double BSIM4v5_88;
-    double BSIM4v5_89;
-    double BSIM4v5_90;
-    double BSIM4v5_91;
-    double BSIM4v5_92;
-    double BSIM4v5_93;
-    double BSIM4v5_94;
-    double BSIM4v5_95;
-    double BSIM4v5_96;
-    double BSIM4v5_97;
-    double BSIM4v5_98;
-    double BSIM4v5_99;
-    double BSIM4v5_100;
-    double BSIM4v5_101;
-    double BSIM4v5_102;
-    double BSIM4v5_103;
+    /* slots of the results in the model stamp buffer */
+    int BSIM4v5rhsdPrime;
+    int BSIM4v5rhsgPrime;
+    int BSIM4v5rhsgExt;
+    int BSIM4v5grhsMid;
+    int BSIM4v5rhsbPrime;
+    int BSIM4v5rhssPrime;
+    int BSIM4v5rhsdb;
+    int BSIM4v5rhssb;
+    int BSIM4v5rhsd;
+    int BSIM4v5rhss;
+    int BSIM4v5rhsq;
+
+    int BSIM4v5_1;
+    int BSIM4v5_2;
+    int BSIM4v5_3;
+    int BSIM4v5_4;
+    int BSIM4v5_5;
+    int BSIM4v5_6;
+    int BSIM4v5_7;
+    int BSIM4v5_8;
+    int BSIM4v5_9;
+    int BSIM4v5_10;
+    int BSIM4v5_11;
+    int BSIM4v5_12;
+    int BSIM4v5_13;
+    int BSIM4v5_14;
+    int BSIM4v5_15;
+    int BSIM4v5_16;
+    int BSIM4v5_17;
+    int BSIM4v5_18;
+    int BSIM4v5_19;
+    int BSIM4v5_20;
+    int BSIM4v5_21;
+    int BSIM4v5_22;
+    int BSIM4v5_23;
+    int BSIM4v5_24;
+    int BSIM4v5_25;
+    int BSIM4v5_26;
+    int BSIM4v5_27;
+    int BSIM4v5_28;
+    int BSIM4v5_29;
+    int BSIM4v5_30;
+    int BSIM4v5_31;
+    int BSIM4v5_32;
+    int BSIM4v5_33;
+    int BSIM4v5_34;
+    int BSIM4v5_35;
+    int BSIM4v5_36;
+    int BSIM4v5_37;
+    int BSIM4v5_38;
+    int BSIM4v5_39;
+    int BSIM4v5_40;
+    int BSIM4v5_41;
+    int BSIM4v5_42;
+    int BSIM4v5_43;
+    int BSIM4v5_44;
+    int BSIM4v5_45;
+    int BSIM4v5_46;
+    int BSIM4v5_47;
+    int BSIM4v5_48;
+    int BSIM4v5_49;
+    int BSIM4v5_50;
+    int BSIM4v5_51;
+    int BSIM4v5_52;
+    int BSIM4v5_53;
+    int BSIM4v5_54;
+    int BSIM4v5_55;
+    int BSIM4v5_56;
+    int BSIM4v5_57;
+    int BSIM4v5_58;
+    int BSIM4v5_59;
+    int BSIM4v5_60;
+    int BSIM4v5_61;
+    int BSIM4v5_62;
+    int BSIM4v5_63;
+    int BSIM4v5_64;
+    int BSIM4v5_65;
+    int BSIM4v5_66;
+    int BSIM4v5_67;
+    int BSIM4v5_68;
+    int BSIM4v5_69;
+    int BSIM4v5_70;
+    int BSIM4v5_71;
+    int BSIM4v5_72;
+    int BSIM4v5_73;
+    int BSIM4v5_74;
+    int BSIM4v5_75;
+    int BSIM4v5_76;
+    int BSIM4v5_77;
+    int BSIM4v5_78;
+    int BSIM4v5_79;
+    int BSIM4v5_80;
+    int BSIM4v5_81;
+    int BSIM4v5_82;
+    int BSIM4v5_83;
+    int BSIM4v5_84;
+    int BSIM4v5_85;
+    int BSIM4v5_86;
+    int BSIM4v5_87;
+    int BSIM4v5_88;
+    int BSIM4v5_89;
+    int BSIM4v5_90;
+    int BSIM4v5_91;
+    int BSIM4v5_92;
+    int BSIM4v5_93;
+    int BSIM4v5_94;
+    int BSIM4v5_95;
+    int BSIM4v5_96;
+    int BSIM4v5_97;
+    int BSIM4v5_98;
+    int BSIM4v5_99;
+    int BSIM4v5_100;
+    int BSIM4v5_101;
+    int BSIM4v5_102;
+    int BSIM4v5_103;
 
 #endif
 
@@ -1609,6 +1609,7 @@ typedef struct sBSIM4v5model
 #ifdef USE_OMP
     int BSIM4v5InstCount;
     struct sBSIM4v5instance **BSIM4v5InstanceArray;
+    CKTstampBuf *BSIM4v5stamps;
 #endif
 
     /* Flags */
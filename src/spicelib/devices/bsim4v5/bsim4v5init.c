@@ -68,6 +68,8 @@ SPICEdev BSIM4v5info = {
     NULL,          /* DEVdisto       */
     BSIM4v5noise,    /* DEVnoise       */
     BSIM4v5soaCheck, /* DEVsoaCheck    */
+    NULL, /* DEVsnapSave    */
+    NULL, /* DEVsnapLoad    */
 #ifdef CIDER
     NULL,          /* DEVdump        */
     NULL,          /* DEVacct        */
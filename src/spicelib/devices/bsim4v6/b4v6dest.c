@@ -23,6 +23,7 @@ BSIM4v6destroy(GENmodel **inModel)
 #ifdef USE_OMP
     /* free just once for all models */
     FREE(mod->BSIM4v6InstanceArray);
+    CKTstampFree(&mod->BSIM4v6stamps);
 #endif
 
     while (mod) {
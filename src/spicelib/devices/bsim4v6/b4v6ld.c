@@ -63,7 +63,6 @@
 
 #ifdef USE_OMP
 int BSIM4v6LoadOMP(BSIM4v6instance *here, CKTcircuit *ckt);
-void BSIM4v6LoadRhsMat(GENmodel *inModel, CKTcircuit *ckt);
 #endif
 
 int BSIM4v6polyDepletion(double phi, double ngate,double epsgate, double coxe, double Vgs, double *Vgs_eff, double *dVgs_eff_dVg);
@@ -88,7 +87,7 @@ CKTcircuit *ckt)
             error = local_error;
     }
 
-    BSIM4v6LoadRhsMat(inModel, ckt);
+    CKTstampLoad(model->BSIM4v6stamps, ckt);
     
     return error;
 }
@@ -96,6 +95,8 @@ CKTcircuit *ckt)
 
 int BSIM4v6LoadOMP(BSIM4v6instance *here, CKTcircuit *ckt) {
 BSIM4v6model *model = here->BSIM4v6modPtr;
+double *rhsVal = model->BSIM4v6stamps->rhsVal;
+double *matVal = model->BSIM4v6stamps->matVal;
 #else
 BSIM4v6model *model = (BSIM4v6model*)inModel;
 BSIM4v6instance *here;
@@ -4748,36 +4749,36 @@ line900:
               m = here->BSIM4v6m;
 
 #ifdef USE_OMP
-       here->BSIM4v6rhsdPrime = m * (ceqjd - ceqbd + ceqgdtot
+       rhsVal[here->BSIM4v6rhsdPrime] = m * (ceqjd - ceqbd + ceqgdtot
                                                     - ceqdrn - ceqqd + Idtoteq);
-       here->BSIM4v6rhsgPrime = m * (ceqqg - ceqgcrg + Igtoteq);
+       rhsVal[here->BSIM4v6rhsgPrime] = -m * (ceqqg - ceqgcrg + Igtoteq);
 
        if (here->BSIM4v6rgateMod == 2)
-           here->BSIM4v6rhsgExt = m * ceqgcrg;
+           rhsVal[here->BSIM4v6rhsgExt] = -m * ceqgcrg;
        else if (here->BSIM4v6rgateMod == 3)
-               here->BSIM4v6grhsMid = m * (ceqqgmid + ceqgcrg);
+               rhsVal[here->BSIM4v6grhsMid] = -m * (ceqqgmid + ceqgcrg);
 
        if (!here->BSIM4v6rbodyMod)
-       {   here->BSIM4v6rhsbPrime = m * (ceqbd + ceqbs - ceqjd
+       {   rhsVal[here->BSIM4v6rhsbPrime] = m * (ceqbd + ceqbs - ceqjd
                                                         - ceqjs - ceqqb + Ibtoteq);
-           here->BSIM4v6rhssPrime = m * (ceqdrn - ceqbs + ceqjs 
+           rhsVal[here->BSIM4v6rhssPrime] = m * (ceqdrn - ceqbs + ceqjs 
                               + ceqqg + ceqqb + ceqqd + ceqqgmid - ceqgstot + Istoteq);
         }
         else
-        {   here->BSIM4v6rhsdb = m * (ceqjd + ceqqjd);
-            here->BSIM4v6rhsbPrime = m * (ceqbd + ceqbs - ceqqb + Ibtoteq);
-            here->BSIM4v6rhssb = m * (ceqjs + ceqqjs);
-            here->BSIM4v6rhssPrime = m * (ceqdrn - ceqbs + ceqjs + ceqqd 
+        {   rhsVal[here->BSIM4v6rhsdb] = -m * (ceqjd + ceqqjd);
+            rhsVal[here->BSIM4v6rhsbPrime] = m * (ceqbd + ceqbs - ceqqb + Ibtoteq);
+            rhsVal[here->BSIM4v6rhssb] = -m * (ceqjs + ceqqjs);
+            rhsVal[here->BSIM4v6rhssPrime] = m * (ceqdrn - ceqbs + ceqjs + ceqqd 
                 + ceqqg + ceqqb + ceqqjd + ceqqjs + ceqqgmid - ceqgstot + Istoteq);
         }
 
         if (model->BSIM4v6rdsMod)
-        {   here->BSIM4v6rhsd = m * ceqgdtot; 
-            here->BSIM4v6rhss = m * ceqgstot;
+        {   rhsVal[here->BSIM4v6rhsd] = -m * ceqgdtot; 
+            rhsVal[here->BSIM4v6rhss] = m * ceqgstot;
         }
 
         if (here->BSIM4v6trnqsMod)
-           here->BSIM4v6rhsq = m * (cqcheq - cqdef);
+           rhsVal[here->BSIM4v6rhsq] = m * (cqcheq - cqdef);
 #else
         (*(ckt->CKTrhs + here->BSIM4v6dNodePrime) += m * (ceqjd - ceqbd + ceqgdtot
                                                     - ceqdrn - ceqqd + Idtoteq));
@@ -4835,94 +4836,94 @@ line900:
        T1 = qdef * here->BSIM4v6gtau;
 #ifdef USE_OMP
        if (here->BSIM4v6rgateMod == 1)
-       {   here->BSIM4v6_1 = m * geltd;
-           here->BSIM4v6_2 = m * geltd;
-           here->BSIM4v6_3 = m * geltd;
-           here->BSIM4v6_4 = m * (gcggb + geltd - ggtg + gIgtotg);
-           here->BSIM4v6_5 = m * (gcgdb - ggtd + gIgtotd);
-           here->BSIM4v6_6 = m * (gcgsb - ggts + gIgtots);
-           here->BSIM4v6_7 = m * (gcgbb - ggtb + gIgtotb);
+       {   matVal[here->BSIM4v6_1] = m * geltd;
+           matVal[here->BSIM4v6_2] = -m * geltd;
+           matVal[here->BSIM4v6_3] = -m * geltd;
+           matVal[here->BSIM4v6_4] = m * (gcggb + geltd - ggtg + gIgtotg);
+           matVal[here->BSIM4v6_5] = m * (gcgdb - ggtd + gIgtotd);
+           matVal[here->BSIM4v6_6] = m * (gcgsb - ggts + gIgtots);
+           matVal[here->BSIM4v6_7] = m * (gcgbb - ggtb + gIgtotb);
        } /* WDLiu: gcrg already subtracted from all gcrgg below */
        else if (here->BSIM4v6rgateMod == 2)        
-       {   here->BSIM4v6_8 = m * gcrg;
-           here->BSIM4v6_9 = m * gcrgg;
-           here->BSIM4v6_10 = m * gcrgd;
-           here->BSIM4v6_11 = m * gcrgs;
-           here->BSIM4v6_12 = m * gcrgb;        
-
-           here->BSIM4v6_13 = m * gcrg;
-           here->BSIM4v6_14 = m * (gcggb  - gcrgg - ggtg + gIgtotg);
-           here->BSIM4v6_15 = m * (gcgdb - gcrgd - ggtd + gIgtotd);
-           here->BSIM4v6_16 = m * (gcgsb - gcrgs - ggts + gIgtots);
-           here->BSIM4v6_17 = m * (gcgbb - gcrgb - ggtb + gIgtotb);
+       {   matVal[here->BSIM4v6_8] = m * gcrg;
+           matVal[here->BSIM4v6_9] = m * gcrgg;
+           matVal[here->BSIM4v6_10] = m * gcrgd;
+           matVal[here->BSIM4v6_11] = m * gcrgs;
+           matVal[here->BSIM4v6_12] = m * gcrgb;        
+
+           matVal[here->BSIM4v6_13] = -m * gcrg;
+           matVal[here->BSIM4v6_14] = m * (gcggb  - gcrgg - ggtg + gIgtotg);
+           matVal[here->BSIM4v6_15] = m * (gcgdb - gcrgd - ggtd + gIgtotd);
+           matVal[here->BSIM4v6_16] = m * (gcgsb - gcrgs - ggts + gIgtots);
+           matVal[here->BSIM4v6_17] = m * (gcgbb - gcrgb - ggtb + gIgtotb);
        }
        else if (here->BSIM4v6rgateMod == 3)
-       {   here->BSIM4v6_18 = m * geltd;
-           here->BSIM4v6_19 = m * geltd;
-           here->BSIM4v6_20 = m * geltd;
-           here->BSIM4v6_21 = m * (geltd + gcrg + gcgmgmb);
-
-           here->BSIM4v6_22 = m * (gcrgd + gcgmdb);
-           here->BSIM4v6_23 = m * gcrgg;
-           here->BSIM4v6_24 = m * (gcrgs + gcgmsb);
-           here->BSIM4v6_25 = m * (gcrgb + gcgmbb);
-
-           here->BSIM4v6_26 = m * gcdgmb;
-           here->BSIM4v6_27 = m * gcrg;
-           here->BSIM4v6_28 = m * gcsgmb;
-           here->BSIM4v6_29 = m * gcbgmb;
-
-           here->BSIM4v6_30 = m * (gcggb - gcrgg - ggtg + gIgtotg);
-           here->BSIM4v6_31 = m * (gcgdb - gcrgd - ggtd + gIgtotd);
-           here->BSIM4v6_32 = m * (gcgsb - gcrgs - ggts + gIgtots);
-           here->BSIM4v6_33 = m * (gcgbb - gcrgb - ggtb + gIgtotb);
+       {   matVal[here->BSIM4v6_18] = m * geltd;
+           matVal[here->BSIM4v6_19] = -m * geltd;
+           matVal[here->BSIM4v6_20] = -m * geltd;
+           matVal[here->BSIM4v6_21] = m * (geltd + gcrg + gcgmgmb);
+
+           matVal[here->BSIM4v6_22] = m * (gcrgd + gcgmdb);
+           matVal[here->BSIM4v6_23] = m * gcrgg;
+           matVal[here->BSIM4v6_24] = m * (gcrgs + gcgmsb);
+           matVal[here->BSIM4v6_25] = m * (gcrgb + gcgmbb);
+
+           matVal[here->BSIM4v6_26] = m * gcdgmb;
+           matVal[here->BSIM4v6_27] = -m * gcrg;
+           matVal[here->BSIM4v6_28] = m * gcsgmb;
+           matVal[here->BSIM4v6_29] = m * gcbgmb;
+
+           matVal[here->BSIM4v6_30] = m * (gcggb - gcrgg - ggtg + gIgtotg);
+           matVal[here->BSIM4v6_31] = m * (gcgdb - gcrgd - ggtd + gIgtotd);
+           matVal[here->BSIM4v6_32] = m * (gcgsb - gcrgs - ggts + gIgtots);
+           matVal[here->BSIM4v6_33] = m * (gcgbb - gcrgb - ggtb + gIgtotb);
        }
        else
-       {   here->BSIM4v6_34 = m * (gcggb - ggtg + gIgtotg);
-           here->BSIM4v6_35 = m * (gcgdb - ggtd + gIgtotd);
-           here->BSIM4v6_36 = m * (gcgsb - ggts + gIgtots);
-           here->BSIM4v6_37 = m * (gcgbb - ggtb + gIgtotb);
+       {   matVal[here->BSIM4v6_34] = m * (gcggb - ggtg + gIgtotg);
+           matVal[here->BSIM4v6_35] = m * (gcgdb - ggtd + gIgtotd);
+           matVal[here->BSIM4v6_36] = m * (gcgsb - ggts + gIgtots);
+           matVal[here->BSIM4v6_37] = m * (gcgbb - ggtb + gIgtotb);
        }
 
        if (model->BSIM4v6rdsMod)
-       {   here->BSIM4v6_38 = m * gdtotg;
-           here->BSIM4v6_39 = m * gdtots;
-           here->BSIM4v6_40 = m * gdtotb;
-           here->BSIM4v6_41 = m * gstotd;
-           here->BSIM4v6_42 = m * gstotg;
-           here->BSIM4v6_43 = m * gstotb;
+       {   matVal[here->BSIM4v6_38] = m * gdtotg;
+           matVal[here->BSIM4v6_39] = m * gdtots;
+           matVal[here->BSIM4v6_40] = m * gdtotb;
+           matVal[here->BSIM4v6_41] = m * gstotd;
+           matVal[here->BSIM4v6_42] = m * gstotg;
+           matVal[here->BSIM4v6_43] = m * gstotb;
        }
 
-       here->BSIM4v6_44 = m * (gdpr + here->BSIM4v6gds + here->BSIM4v6gbd + T1 * ddxpart_dVd
+       matVal[here->BSIM4v6_44] = m * (gdpr + here->BSIM4v6gds + here->BSIM4v6gbd + T1 * ddxpart_dVd
                                    - gdtotd + RevSum + gcddb + gbdpdp + dxpart * ggtd - gIdtotd);
-       here->BSIM4v6_45 = m * (gdpr + gdtot);
-       here->BSIM4v6_46 = m * (Gm + gcdgb - gdtotg + gbdpg - gIdtotg
+       matVal[here->BSIM4v6_45] = -m * (gdpr + gdtot);
+       matVal[here->BSIM4v6_46] = m * (Gm + gcdgb - gdtotg + gbdpg - gIdtotg
                                    + dxpart * ggtg + T1 * ddxpart_dVg);
-       here->BSIM4v6_47 = m * (here->BSIM4v6gds + gdtots - dxpart * ggts + gIdtots
+       matVal[here->BSIM4v6_47] = -m * (here->BSIM4v6gds + gdtots - dxpart * ggts + gIdtots
                                    - T1 * ddxpart_dVs + FwdSum - gcdsb - gbdpsp);
-       here->BSIM4v6_48 = m * (gjbd + gdtotb - Gmbs - gcdbb - gbdpb + gIdtotb
+       matVal[here->BSIM4v6_48] = -m * (gjbd + gdtotb - Gmbs - gcdbb - gbdpb + gIdtotb
                                    - T1 * ddxpart_dVb - dxpart * ggtb);
 
-       here->BSIM4v6_49 = m * (gdpr - gdtotd);
-       here->BSIM4v6_50 = m * (gdpr + gdtot);
+       matVal[here->BSIM4v6_49] = -m * (gdpr - gdtotd);
+       matVal[here->BSIM4v6_50] = m * (gdpr + gdtot);
 
-       here->BSIM4v6_51 = m * (here->BSIM4v6gds + gstotd + RevSum - gcsdb - gbspdp
+       matVal[here->BSIM4v6_51] = -m * (here->BSIM4v6gds + gstotd + RevSum - gcsdb - gbspdp
                                    - T1 * dsxpart_dVd - sxpart * ggtd + gIstotd);
-       here->BSIM4v6_52 = m * (gcsgb - Gm - gstotg + gbspg + sxpart * ggtg
+       matVal[here->BSIM4v6_52] = m * (gcsgb - Gm - gstotg + gbspg + sxpart * ggtg
                                    + T1 * dsxpart_dVg - gIstotg);
-       here->BSIM4v6_53 = m * (gspr + here->BSIM4v6gds + here->BSIM4v6gbs + T1 * dsxpart_dVs
+       matVal[here->BSIM4v6_53] = m * (gspr + here->BSIM4v6gds + here->BSIM4v6gbs + T1 * dsxpart_dVs
                                    - gstots + FwdSum + gcssb + gbspsp + sxpart * ggts - gIstots);
-       here->BSIM4v6_54 = m * (gspr + gstot);
-       here->BSIM4v6_55 = m * (gjbs + gstotb + Gmbs - gcsbb - gbspb - sxpart * ggtb
+       matVal[here->BSIM4v6_54] = -m * (gspr + gstot);
+       matVal[here->BSIM4v6_55] = -m * (gjbs + gstotb + Gmbs - gcsbb - gbspb - sxpart * ggtb
                                    - T1 * dsxpart_dVb + gIstotb);
 
-       here->BSIM4v6_56 = m * (gspr - gstots);
-       here->BSIM4v6_57 = m * (gspr + gstot);
+       matVal[here->BSIM4v6_56] = -m * (gspr - gstots);
+       matVal[here->BSIM4v6_57] = m * (gspr + gstot);
 
-       here->BSIM4v6_58 = m * (gcbdb - gjbd + gbbdp - gIbtotd);
-       here->BSIM4v6_59 = m * (gcbgb - here->BSIM4v6gbgs - gIbtotg);
-       here->BSIM4v6_60 = m * (gcbsb - gjbs + gbbsp - gIbtots);
-       here->BSIM4v6_61 = m * (gjbd + gjbs + gcbbb - here->BSIM4v6gbbs - gIbtotb);
+       matVal[here->BSIM4v6_58] = m * (gcbdb - gjbd + gbbdp - gIbtotd);
+       matVal[here->BSIM4v6_59] = m * (gcbgb - here->BSIM4v6gbgs - gIbtotg);
+       matVal[here->BSIM4v6_60] = m * (gcbsb - gjbs + gbbsp - gIbtots);
+       matVal[here->BSIM4v6_61] = m * (gjbd + gjbs + gcbbb - here->BSIM4v6gbbs - gIbtotb);
 
        ggidld = here->BSIM4v6ggidld;
        ggidlg = here->BSIM4v6ggidlg;
@@ -4932,64 +4933,64 @@ line900:
        ggislb = here->BSIM4v6ggislb;
 
        /* stamp gidl */
-       here->BSIM4v6_62 = m * ggidld;
-       here->BSIM4v6_63 = m * ggidlg;
-       here->BSIM4v6_64 = m * (ggidlg + ggidld + ggidlb);
-       here->BSIM4v6_65 = m * ggidlb;
-       here->BSIM4v6_66 = m * ggidld;
-       here->BSIM4v6_67 = m * ggidlg;
-       here->BSIM4v6_68 = m * (ggidlg + ggidld + ggidlb);
-       here->BSIM4v6_69 = m * ggidlb;
+       matVal[here->BSIM4v6_62] = m * ggidld;
+       matVal[here->BSIM4v6_63] = m * ggidlg;
+       matVal[here->BSIM4v6_64] = -m * (ggidlg + ggidld + ggidlb);
+       matVal[here->BSIM4v6_65] = m * ggidlb;
+       matVal[here->BSIM4v6_66] = -m * ggidld;
+       matVal[here->BSIM4v6_67] = -m * ggidlg;
+       matVal[here->BSIM4v6_68] = m * (ggidlg + ggidld + ggidlb);
+       matVal[here->BSIM4v6_69] = -m * ggidlb;
        /* stamp gisl */
-       here->BSIM4v6_70 = m * (ggisls + ggislg + ggislb);
-       here->BSIM4v6_71 = m * ggislg;
-       here->BSIM4v6_72 = m * ggisls;
-       here->BSIM4v6_73 = m * ggislb;
-       here->BSIM4v6_74 = m * (ggislg + ggisls + ggislb);
-       here->BSIM4v6_75 = m * ggislg;
-       here->BSIM4v6_76 = m * ggisls;
-       here->BSIM4v6_77 = m * ggislb;
+       matVal[here->BSIM4v6_70] = -m * (ggisls + ggislg + ggislb);
+       matVal[here->BSIM4v6_71] = m * ggislg;
+       matVal[here->BSIM4v6_72] = m * ggisls;
+       matVal[here->BSIM4v6_73] = m * ggislb;
+       matVal[here->BSIM4v6_74] = m * (ggislg + ggisls + ggislb);
+       matVal[here->BSIM4v6_75] = -m * ggislg;
+       matVal[here->BSIM4v6_76] = -m * ggisls;
+       matVal[here->BSIM4v6_77] = -m * ggislb;
 
        if (here->BSIM4v6rbodyMod)
-       {   here->BSIM4v6_78 = m * (gcdbdb - here->BSIM4v6gbd);
-           here->BSIM4v6_79 = m * (here->BSIM4v6gbs - gcsbsb);
+       {   matVal[here->BSIM4v6_78] = m * (gcdbdb - here->BSIM4v6gbd);
+           matVal[here->BSIM4v6_79] = -m * (here->BSIM4v6gbs - gcsbsb);
 
-           here->BSIM4v6_80 = m * (gcdbdb - here->BSIM4v6gbd);
-           here->BSIM4v6_81 = m * (here->BSIM4v6gbd - gcdbdb 
+           matVal[here->BSIM4v6_80] = m * (gcdbdb - here->BSIM4v6gbd);
+           matVal[here->BSIM4v6_81] = m * (here->BSIM4v6gbd - gcdbdb 
                           + here->BSIM4v6grbpd + here->BSIM4v6grbdb);
-           here->BSIM4v6_82 = m * here->BSIM4v6grbpd;
-           here->BSIM4v6_83 = m * here->BSIM4v6grbdb;
+           matVal[here->BSIM4v6_82] = -m * here->BSIM4v6grbpd;
+           matVal[here->BSIM4v6_83] = -m * here->BSIM4v6grbdb;
 
-           here->BSIM4v6_84 = m * here->BSIM4v6grbpd;
-           here->BSIM4v6_85 = m * here->BSIM4v6grbpb;
-           here->BSIM4v6_86 = m * here->BSIM4v6grbps;
-           here->BSIM4v6_87 = m * (here->BSIM4v6grbpd + here->BSIM4v6grbps 
+           matVal[here->BSIM4v6_84] = -m * here->BSIM4v6grbpd;
+           matVal[here->BSIM4v6_85] = -m * here->BSIM4v6grbpb;
+           matVal[here->BSIM4v6_86] = -m * here->BSIM4v6grbps;
+           matVal[here->BSIM4v6_87] = m * (here->BSIM4v6grbpd + here->BSIM4v6grbps 
                           + here->BSIM4v6grbpb);
            /* WDLiu: (gcbbb - here->BSIM4v6gbbs) already added to BPbpPtr */        
 
-           here->BSIM4v6_88 = m * (gcsbsb - here->BSIM4v6gbs);
-           here->BSIM4v6_89 = m * here->BSIM4v6grbps;
-           here->BSIM4v6_90 = m * here->BSIM4v6grbsb;
-           here->BSIM4v6_91 = m * (here->BSIM4v6gbs - gcsbsb 
+           matVal[here->BSIM4v6_88] = m * (gcsbsb - here->BSIM4v6gbs);
+           matVal[here->BSIM4v6_89] = -m * here->BSIM4v6grbps;
+           matVal[here->BSIM4v6_90] = -m * here->BSIM4v6grbsb;
+           matVal[here->BSIM4v6_91] = m * (here->BSIM4v6gbs - gcsbsb 
                           + here->BSIM4v6grbps + here->BSIM4v6grbsb);
 
-           here->BSIM4v6_92 = m * here->BSIM4v6grbdb;
-           here->BSIM4v6_93 = m * here->BSIM4v6grbpb;
-           here->BSIM4v6_94 = m * here->BSIM4v6grbsb;
-           here->BSIM4v6_95 = m * (here->BSIM4v6grbsb + here->BSIM4v6grbdb
+           matVal[here->BSIM4v6_92] = -m * here->BSIM4v6grbdb;
+           matVal[here->BSIM4v6_93] = -m * here->BSIM4v6grbpb;
+           matVal[here->BSIM4v6_94] = -m * here->BSIM4v6grbsb;
+           matVal[here->BSIM4v6_95] = m * (here->BSIM4v6grbsb + here->BSIM4v6grbdb
                            + here->BSIM4v6grbpb);
        }
 
            if (here->BSIM4v6trnqsMod)
-           {   here->BSIM4v6_96 = m * (gqdef + here->BSIM4v6gtau);
-               here->BSIM4v6_97 = m * (ggtg - gcqgb);
-               here->BSIM4v6_98 = m * (ggtd - gcqdb);
-               here->BSIM4v6_99 = m * (ggts - gcqsb);
-               here->BSIM4v6_100 = m * (ggtb - gcqbb);
-
-               here->BSIM4v6_101 = m * dxpart * here->BSIM4v6gtau;
-               here->BSIM4v6_102 = m * sxpart * here->BSIM4v6gtau;
-               here->BSIM4v6_103 = m * here->BSIM4v6gtau;
+           {   matVal[here->BSIM4v6_96] = m * (gqdef + here->BSIM4v6gtau);
+               matVal[here->BSIM4v6_97] = m * (ggtg - gcqgb);
+               matVal[here->BSIM4v6_98] = m * (ggtd - gcqdb);
+               matVal[here->BSIM4v6_99] = m * (ggts - gcqsb);
+               matVal[here->BSIM4v6_100] = m * (ggtb - gcqbb);
+
+               matVal[here->BSIM4v6_101] = m * dxpart * here->BSIM4v6gtau;
+               matVal[here->BSIM4v6_102] = m * sxpart * here->BSIM4v6gtau;
+               matVal[here->BSIM4v6_103] = -m * here->BSIM4v6gtau;
            }
 #else
            if (here->BSIM4v6rgateMod == 1)
@@ -5196,193 +5197,3 @@ int BSIM4v6polyDepletion(
     }
     return(0);
 }
-
-#ifdef USE_OMP
-void BSIM4v6LoadRhsMat(GENmodel *inModel, CKTcircuit *ckt)
-{
-    int InstCount, idx;
-    BSIM4v6instance **InstArray;
-    BSIM4v6instance *here;
-    BSIM4v6model *model = (BSIM4v6model*)inModel;
-
-    InstArray = model->BSIM4v6InstanceArray;
-    InstCount = model->BSIM4v6InstCount;
-
-    for(idx = 0; idx < InstCount; idx++) {
-       here = InstArray[idx];
-       model = here->BSIM4v6modPtr;
-        /* Update b for Ax = b */
-           (*(ckt->CKTrhs + here->BSIM4v6dNodePrime) += here->BSIM4v6rhsdPrime);
-           (*(ckt->CKTrhs + here->BSIM4v6gNodePrime) -= here->BSIM4v6rhsgPrime);
-
-           if (here->BSIM4v6rgateMod == 2)
-               (*(ckt->CKTrhs + here->BSIM4v6gNodeExt) -= here->BSIM4v6rhsgExt);
-           else if (here->BSIM4v6rgateMod == 3)
-               (*(ckt->CKTrhs + here->BSIM4v6gNodeMid) -= here->BSIM4v6grhsMid);
-
-           if (!here->BSIM4v6rbodyMod)
-           {   (*(ckt->CKTrhs + here->BSIM4v6bNodePrime) += here->BSIM4v6rhsbPrime);
-               (*(ckt->CKTrhs + here->BSIM4v6sNodePrime) += here->BSIM4v6rhssPrime);
-           }
-           else
-           {   (*(ckt->CKTrhs + here->BSIM4v6dbNode) -= here->BSIM4v6rhsdb);
-               (*(ckt->CKTrhs + here->BSIM4v6bNodePrime) += here->BSIM4v6rhsbPrime);
-               (*(ckt->CKTrhs + here->BSIM4v6sbNode) -= here->BSIM4v6rhssb);
-               (*(ckt->CKTrhs + here->BSIM4v6sNodePrime) += here->BSIM4v6rhssPrime);
-           }
-
-           if (model->BSIM4v6rdsMod)
-           {   (*(ckt->CKTrhs + here->BSIM4v6dNode) -= here->BSIM4v6rhsd); 
-               (*(ckt->CKTrhs + here->BSIM4v6sNode) += here->BSIM4v6rhss);
-           }
-
-           if (here->BSIM4v6trnqsMod)
-               *(ckt->CKTrhs + here->BSIM4v6qNode) += here->BSIM4v6rhsq;
-
-
-        /* Update A for Ax = b */
-           if (here->BSIM4v6rgateMod == 1)
-           {   (*(here->BSIM4v6GEgePtr) += here->BSIM4v6_1);
-               (*(here->BSIM4v6GPgePtr) -= here->BSIM4v6_2);
-               (*(here->BSIM4v6GEgpPtr) -= here->BSIM4v6_3);
-               (*(here->BSIM4v6GPgpPtr) += here->BSIM4v6_4);
-               (*(here->BSIM4v6GPdpPtr) += here->BSIM4v6_5);
-               (*(here->BSIM4v6GPspPtr) += here->BSIM4v6_6);
-               (*(here->BSIM4v6GPbpPtr) += here->BSIM4v6_7);
-           }
-           else if (here->BSIM4v6rgateMod == 2)        
-           {   (*(here->BSIM4v6GEgePtr) += here->BSIM4v6_8);
-               (*(here->BSIM4v6GEgpPtr) += here->BSIM4v6_9);
-               (*(here->BSIM4v6GEdpPtr) += here->BSIM4v6_10);
-               (*(here->BSIM4v6GEspPtr) += here->BSIM4v6_11);
-               (*(here->BSIM4v6GEbpPtr) += here->BSIM4v6_12);        
-
-               (*(here->BSIM4v6GPgePtr) -= here->BSIM4v6_13);
-               (*(here->BSIM4v6GPgpPtr) += here->BSIM4v6_14);
-               (*(here->BSIM4v6GPdpPtr) += here->BSIM4v6_15);
-               (*(here->BSIM4v6GPspPtr) += here->BSIM4v6_16);
-               (*(here->BSIM4v6GPbpPtr) += here->BSIM4v6_17);
-           }
-           else if (here->BSIM4v6rgateMod == 3)
-           {   (*(here->BSIM4v6GEgePtr) += here->BSIM4v6_18);
-               (*(here->BSIM4v6GEgmPtr) -= here->BSIM4v6_19);
-               (*(here->BSIM4v6GMgePtr) -= here->BSIM4v6_20);
-               (*(here->BSIM4v6GMgmPtr) += here->BSIM4v6_21);
-
-               (*(here->BSIM4v6GMdpPtr) += here->BSIM4v6_22);
-               (*(here->BSIM4v6GMgpPtr) += here->BSIM4v6_23);
-               (*(here->BSIM4v6GMspPtr) += here->BSIM4v6_24);
-               (*(here->BSIM4v6GMbpPtr) += here->BSIM4v6_25);
-
-               (*(here->BSIM4v6DPgmPtr) += here->BSIM4v6_26);
-               (*(here->BSIM4v6GPgmPtr) -= here->BSIM4v6_27);
-               (*(here->BSIM4v6SPgmPtr) += here->BSIM4v6_28);
-               (*(here->BSIM4v6BPgmPtr) += here->BSIM4v6_29);
-
-               (*(here->BSIM4v6GPgpPtr) += here->BSIM4v6_30);
-               (*(here->BSIM4v6GPdpPtr) += here->BSIM4v6_31);
-               (*(here->BSIM4v6GPspPtr) += here->BSIM4v6_32);
-               (*(here->BSIM4v6GPbpPtr) += here->BSIM4v6_33);
-           }
-
-
-            else
-           {   (*(here->BSIM4v6GPgpPtr) += here->BSIM4v6_34);
-               (*(here->BSIM4v6GPdpPtr) += here->BSIM4v6_35);
-               (*(here->BSIM4v6GPspPtr) += here->BSIM4v6_36);
-               (*(here->BSIM4v6GPbpPtr) += here->BSIM4v6_37);
-           }
-
-
-           if (model->BSIM4v6rdsMod)
-           {   (*(here->BSIM4v6DgpPtr) += here->BSIM4v6_38);
-               (*(here->BSIM4v6DspPtr) += here->BSIM4v6_39);
-               (*(here->BSIM4v6DbpPtr) += here->BSIM4v6_40);
-               (*(here->BSIM4v6SdpPtr) += here->BSIM4v6_41);
-               (*(here->BSIM4v6SgpPtr) += here->BSIM4v6_42);
-               (*(here->BSIM4v6SbpPtr) += here->BSIM4v6_43);
-           }
-
-           (*(here->BSIM4v6DPdpPtr) += here->BSIM4v6_44);
-           (*(here->BSIM4v6DPdPtr) -= here->BSIM4v6_45);
-           (*(here->BSIM4v6DPgpPtr) += here->BSIM4v6_46);
-           (*(here->BSIM4v6DPspPtr) -= here->BSIM4v6_47);
-           (*(here->BSIM4v6DPbpPtr) -= here->BSIM4v6_48);
-
-           (*(here->BSIM4v6DdpPtr) -= here->BSIM4v6_49);
-           (*(here->BSIM4v6DdPtr) += here->BSIM4v6_50);
-
-           (*(here->BSIM4v6SPdpPtr) -= here->BSIM4v6_51);
-           (*(here->BSIM4v6SPgpPtr) += here->BSIM4v6_52);
-           (*(here->BSIM4v6SPspPtr) += here->BSIM4v6_53);
-           (*(here->BSIM4v6SPsPtr) -= here->BSIM4v6_54);
-           (*(here->BSIM4v6SPbpPtr) -= here->BSIM4v6_55);
-
-           (*(here->BSIM4v6SspPtr) -= here->BSIM4v6_56);
-           (*(here->BSIM4v6SsPtr) += here->BSIM4v6_57);
-
-           (*(here->BSIM4v6BPdpPtr) += here->BSIM4v6_58);
-           (*(here->BSIM4v6BPgpPtr) += here->BSIM4v6_59);
-           (*(here->BSIM4v6BPspPtr) += here->BSIM4v6_60);
-           (*(here->BSIM4v6BPbpPtr) += here->BSIM4v6_61);
-
-           /* stamp gidl */
-           (*(here->BSIM4v6DPdpPtr) += here->BSIM4v6_62);
-           (*(here->BSIM4v6DPgpPtr) += here->BSIM4v6_63);
-           (*(here->BSIM4v6DPspPtr) -= here->BSIM4v6_64);
-           (*(here->BSIM4v6DPbpPtr) += here->BSIM4v6_65);
-           (*(here->BSIM4v6BPdpPtr) -= here->BSIM4v6_66);
-           (*(here->BSIM4v6BPgpPtr) -= here->BSIM4v6_67);
-           (*(here->BSIM4v6BPspPtr) += here->BSIM4v6_68);
-           (*(here->BSIM4v6BPbpPtr) -= here->BSIM4v6_69);
-            /* stamp gisl */
-           (*(here->BSIM4v6SPdpPtr) -= here->BSIM4v6_70);
-           (*(here->BSIM4v6SPgpPtr) += here->BSIM4v6_71);
-           (*(here->BSIM4v6SPspPtr) += here->BSIM4v6_72);
-           (*(here->BSIM4v6SPbpPtr) += here->BSIM4v6_73);
-           (*(here->BSIM4v6BPdpPtr) += here->BSIM4v6_74);
-           (*(here->BSIM4v6BPgpPtr) -= here->BSIM4v6_75);
-           (*(here->BSIM4v6BPspPtr) -= here->BSIM4v6_76);
-           (*(here->BSIM4v6BPbpPtr) -= here->BSIM4v6_77);
-
-
-           if (here->BSIM4v6rbodyMod)
-           {   (*(here->BSIM4v6DPdbPtr) += here->BSIM4v6_78);
-               (*(here->BSIM4v6SPsbPtr) -= here->BSIM4v6_79);
-
-               (*(here->BSIM4v6DBdpPtr) += here->BSIM4v6_80);
-               (*(here->BSIM4v6DBdbPtr) += here->BSIM4v6_81);
-               (*(here->BSIM4v6DBbpPtr) -= here->BSIM4v6_82);
-               (*(here->BSIM4v6DBbPtr) -= here->BSIM4v6_83);
-
-               (*(here->BSIM4v6BPdbPtr) -= here->BSIM4v6_84);
-               (*(here->BSIM4v6BPbPtr) -= here->BSIM4v6_85);
-               (*(here->BSIM4v6BPsbPtr) -= here->BSIM4v6_86);
-               (*(here->BSIM4v6BPbpPtr) += here->BSIM4v6_87);
-
-               (*(here->BSIM4v6SBspPtr) += here->BSIM4v6_88);
-               (*(here->BSIM4v6SBbpPtr) -= here->BSIM4v6_89);
-               (*(here->BSIM4v6SBbPtr) -= here->BSIM4v6_90);
-               (*(here->BSIM4v6SBsbPtr) += here->BSIM4v6_91);
-
-               (*(here->BSIM4v6BdbPtr) -= here->BSIM4v6_92);
-               (*(here->BSIM4v6BbpPtr) -= here->BSIM4v6_93);
-               (*(here->BSIM4v6BsbPtr) -= here->BSIM4v6_94);
-               (*(here->BSIM4v6BbPtr) += here->BSIM4v6_95);
-           }
-
-           if (here->BSIM4v6trnqsMod)
-           {   (*(here->BSIM4v6QqPtr) += here->BSIM4v6_96);
-               (*(here->BSIM4v6QgpPtr) += here->BSIM4v6_97);
-               (*(here->BSIM4v6QdpPtr) += here->BSIM4v6_98);
-               (*(here->BSIM4v6QspPtr) += here->BSIM4v6_99);
-               (*(here->BSIM4v6QbpPtr) += here->BSIM4v6_100);
-
-               (*(here->BSIM4v6DPqPtr) += here->BSIM4v6_101);
-               (*(here->BSIM4v6SPqPtr) += here->BSIM4v6_102);
-               (*(here->BSIM4v6GPqPtr) -= here->BSIM4v6_103);
-           }
-    }
-}
-
-#endif
@@ -62,6 +62,7 @@ JOB   *job;
 #ifdef USE_OMP
 int idx, InstCount;
 BSIM4v6instance **InstArray;
+CKTstampBuf *stamps;
 #endif
 
     /* Search for a noise analysis request */
@@ -2442,8 +2443,14 @@ do { if((here->ptr = SMPmakeElt(matrix, here->first, here->second)) == NULL){\
             InstCount++;
         }
     }
-    InstArray = TMALLOC(BSIM4v6instance*, InstCount);
     model = (BSIM4v6model*)inModel;
+    /* a repeated setup replaces the arrays shared by all models */
+    if (model) {
+        FREE(model->BSIM4v6InstanceArray);
+        CKTstampFree(&model->BSIM4v6stamps);
+    }
+    InstArray = TMALLOC(BSIM4v6instance*, InstCount);
+    stamps = CKTstampNew();
     idx = 0;
     for( ; model != NULL; model = model->BSIM4v6nextModel )
     {
@@ -2453,10 +2460,180 @@ do { if((here->ptr = SMPmakeElt(matrix, here->first, here->second)) == NULL){\
         { 
             InstArray[idx] = here;
             idx++;
+
+            /* reserve the stamp slots written by BSIM4v6LoadOMP */
+            /* Update b for Ax = b */
+            here->BSIM4v6rhsdPrime = CKTstampRhs(stamps, here->BSIM4v6dNodePrime);
+            here->BSIM4v6rhsgPrime = CKTstampRhs(stamps, here->BSIM4v6gNodePrime);
+
+            if (here->BSIM4v6rgateMod == 2)
+                here->BSIM4v6rhsgExt = CKTstampRhs(stamps, here->BSIM4v6gNodeExt);
+            else if (here->BSIM4v6rgateMod == 3)
+                here->BSIM4v6grhsMid = CKTstampRhs(stamps, here->BSIM4v6gNodeMid);
+
+            if (!here->BSIM4v6rbodyMod)
+            {   here->BSIM4v6rhsbPrime = CKTstampRhs(stamps, here->BSIM4v6bNodePrime);
+                here->BSIM4v6rhssPrime = CKTstampRhs(stamps, here->BSIM4v6sNodePrime);
+            }
+            else
+            {   here->BSIM4v6rhsdb = CKTstampRhs(stamps, here->BSIM4v6dbNode);
+                here->BSIM4v6rhsbPrime = CKTstampRhs(stamps, here->BSIM4v6bNodePrime);
+                here->BSIM4v6rhssb = CKTstampRhs(stamps, here->BSIM4v6sbNode);
+                here->BSIM4v6rhssPrime = CKTstampRhs(stamps, here->BSIM4v6sNodePrime);
+            }
+
+            if (model->BSIM4v6rdsMod)
+            {   here->BSIM4v6rhsd = CKTstampRhs(stamps, here->BSIM4v6dNode);
+                here->BSIM4v6rhss = CKTstampRhs(stamps, here->BSIM4v6sNode);
+            }
+
+            if (here->BSIM4v6trnqsMod)
+                here->BSIM4v6rhsq = CKTstampRhs(stamps, here->BSIM4v6qNode);
+
+            /* Update A for Ax = b */
+            if (here->BSIM4v6rgateMod == 1)
+            {   here->BSIM4v6_1 = CKTstampMat(stamps, here->BSIM4v6GEgePtr);
+                here->BSIM4v6_2 = CKTstampMat(stamps, here->BSIM4v6GPgePtr);
+                here->BSIM4v6_3 = CKTstampMat(stamps, here->BSIM4v6GEgpPtr);
+                here->BSIM4v6_4 = CKTstampMat(stamps, here->BSIM4v6GPgpPtr);
+                here->BSIM4v6_5 = CKTstampMat(stamps, here->BSIM4v6GPdpPtr);
+                here->BSIM4v6_6 = CKTstampMat(stamps, here->BSIM4v6GPspPtr);
+                here->BSIM4v6_7 = CKTstampMat(stamps, here->BSIM4v6GPbpPtr);
+            }
+            else if (here->BSIM4v6rgateMod == 2)
+            {   here->BSIM4v6_8 = CKTstampMat(stamps, here->BSIM4v6GEgePtr);
+                here->BSIM4v6_9 = CKTstampMat(stamps, here->BSIM4v6GEgpPtr);
+                here->BSIM4v6_10 = CKTstampMat(stamps, here->BSIM4v6GEdpPtr);
+                here->BSIM4v6_11 = CKTstampMat(stamps, here->BSIM4v6GEspPtr);
+                here->BSIM4v6_12 = CKTstampMat(stamps, here->BSIM4v6GEbpPtr);
+
+                here->BSIM4v6_13 = CKTstampMat(stamps, here->BSIM4v6GPgePtr);
+                here->BSIM4v6_14 = CKTstampMat(stamps, here->BSIM4v6GPgpPtr);
+                here->BSIM4v6_15 = CKTstampMat(stamps, here->BSIM4v6GPdpPtr);
+                here->BSIM4v6_16 = CKTstampMat(stamps, here->BSIM4v6GPspPtr);
+                here->BSIM4v6_17 = CKTstampMat(stamps, here->BSIM4v6GPbpPtr);
+            }
+            else if (here->BSIM4v6rgateMod == 3)
+            {   here->BSIM4v6_18 = CKTstampMat(stamps, here->BSIM4v6GEgePtr);
+                here->BSIM4v6_19 = CKTstampMat(stamps, here->BSIM4v6GEgmPtr);
+                here->BSIM4v6_20 = CKTstampMat(stamps, here->BSIM4v6GMgePtr);
+                here->BSIM4v6_21 = CKTstampMat(stamps, here->BSIM4v6GMgmPtr);
+
+                here->BSIM4v6_22 = CKTstampMat(stamps, here->BSIM4v6GMdpPtr);
+                here->BSIM4v6_23 = CKTstampMat(stamps, here->BSIM4v6GMgpPtr);
+                here->BSIM4v6_24 = CKTstampMat(stamps, here->BSIM4v6GMspPtr);
+                here->BSIM4v6_25 = CKTstampMat(stamps, here->BSIM4v6GMbpPtr);
+
+                here->BSIM4v6_26 = CKTstampMat(stamps, here->BSIM4v6DPgmPtr);
+                here->BSIM4v6_27 = CKTstampMat(stamps, here->BSIM4v6GPgmPtr);
+                here->BSIM4v6_28 = CKTstampMat(stamps, here->BSIM4v6SPgmPtr);
+                here->BSIM4v6_29 = CKTstampMat(stamps, here->BSIM4v6BPgmPtr);
+
+                here->BSIM4v6_30 = CKTstampMat(stamps, here->BSIM4v6GPgpPtr);
+                here->BSIM4v6_31 = CKTstampMat(stamps, here->BSIM4v6GPdpPtr);
+                here->BSIM4v6_32 = CKTstampMat(stamps, here->BSIM4v6GPspPtr);
+                here->BSIM4v6_33 = CKTstampMat(stamps, here->BSIM4v6GPbpPtr);
+            }
+
+             else
+            {   here->BSIM4v6_34 = CKTstampMat(stamps, here->BSIM4v6GPgpPtr);
+                here->BSIM4v6_35 = CKTstampMat(stamps, here->BSIM4v6GPdpPtr);
+                here->BSIM4v6_36 = CKTstampMat(stamps, here->BSIM4v6GPspPtr);
+                here->BSIM4v6_37 = CKTstampMat(stamps, here->BSIM4v6GPbpPtr);
+            }
+
+            if (model->BSIM4v6rdsMod)
+            {   here->BSIM4v6_38 = CKTstampMat(stamps, here->BSIM4v6DgpPtr);
+                here->BSIM4v6_39 = CKTstampMat(stamps, here->BSIM4v6DspPtr);
+                here->BSIM4v6_40 = CKTstampMat(stamps, here->BSIM4v6DbpPtr);
+                here->BSIM4v6_41 = CKTstampMat(stamps, here->BSIM4v6SdpPtr);
+                here->BSIM4v6_42 = CKTstampMat(stamps, here->BSIM4v6SgpPtr);
+                here->BSIM4v6_43 = CKTstampMat(stamps, here->BSIM4v6SbpPtr);
+            }
+
+            here->BSIM4v6_44 = CKTstampMat(stamps, here->BSIM4v6DPdpPtr);
+            here->BSIM4v6_45 = CKTstampMat(stamps, here->BSIM4v6DPdPtr);
+            here->BSIM4v6_46 = CKTstampMat(stamps, here->BSIM4v6DPgpPtr);
+            here->BSIM4v6_47 = CKTstampMat(stamps, here->BSIM4v6DPspPtr);
+            here->BSIM4v6_48 = CKTstampMat(stamps, here->BSIM4v6DPbpPtr);
+
+            here->BSIM4v6_49 = CKTstampMat(stamps, here->BSIM4v6DdpPtr);
+            here->BSIM4v6_50 = CKTstampMat(stamps, here->BSIM4v6DdPtr);
+
+            here->BSIM4v6_51 = CKTstampMat(stamps, here->BSIM4v6SPdpPtr);
+            here->BSIM4v6_52 = CKTstampMat(stamps, here->BSIM4v6SPgpPtr);
+            here->BSIM4v6_53 = CKTstampMat(stamps, here->BSIM4v6SPspPtr);
+            here->BSIM4v6_54 = CKTstampMat(stamps, here->BSIM4v6SPsPtr);
+            here->BSIM4v6_55 = CKTstampMat(stamps, here->BSIM4v6SPbpPtr);
+
+            here->BSIM4v6_56 = CKTstampMat(stamps, here->BSIM4v6SspPtr);
+            here->BSIM4v6_57 = CKTstampMat(stamps, here->BSIM4v6SsPtr);
+
+            here->BSIM4v6_58 = CKTstampMat(stamps, here->BSIM4v6BPdpPtr);
+            here->BSIM4v6_59 = CKTstampMat(stamps, here->BSIM4v6BPgpPtr);
+            here->BSIM4v6_60 = CKTstampMat(stamps, here->BSIM4v6BPspPtr);
+            here->BSIM4v6_61 = CKTstampMat(stamps, here->BSIM4v6BPbpPtr);
+
+            /* stamp gidl */
+            here->BSIM4v6_62 = CKTstampMat(stamps, here->BSIM4v6DPdpPtr);
+            here->BSIM4v6_63 = CKTstampMat(stamps, here->BSIM4v6DPgpPtr);
+            here->BSIM4v6_64 = CKTstampMat(stamps, here->BSIM4v6DPspPtr);
+            here->BSIM4v6_65 = CKTstampMat(stamps, here->BSIM4v6DPbpPtr);
+            here->BSIM4v6_66 = CKTstampMat(stamps, here->BSIM4v6BPdpPtr);
+            here->BSIM4v6_67 = CKTstampMat(stamps, here->BSIM4v6BPgpPtr);
+            here->BSIM4v6_68 = CKTstampMat(stamps, here->BSIM4v6BPspPtr);
+            here->BSIM4v6_69 = CKTstampMat(stamps, here->BSIM4v6BPbpPtr);
+             /* stamp gisl */
+            here->BSIM4v6_70 = CKTstampMat(stamps, here->BSIM4v6SPdpPtr);
+            here->BSIM4v6_71 = CKTstampMat(stamps, here->BSIM4v6SPgpPtr);
+            here->BSIM4v6_72 = CKTstampMat(stamps, here->BSIM4v6SPspPtr);
+            here->BSIM4v6_73 = CKTstampMat(stamps, here->BSIM4v6SPbpPtr);
+            here->BSIM4v6_74 = CKTstampMat(stamps, here->BSIM4v6BPdpPtr);
+            here->BSIM4v6_75 = CKTstampMat(stamps, here->BSIM4v6BPgpPtr);
+            here->BSIM4v6_76 = CKTstampMat(stamps, here->BSIM4v6BPspPtr);
+            here->BSIM4v6_77 = CKTstampMat(stamps, here->BSIM4v6BPbpPtr);
+
+            if (here->BSIM4v6rbodyMod)
+            {   here->BSIM4v6_78 = CKTstampMat(stamps, here->BSIM4v6DPdbPtr);
+                here->BSIM4v6_79 = CKTstampMat(stamps, here->BSIM4v6SPsbPtr);
+
+                here->BSIM4v6_80 = CKTstampMat(stamps, here->BSIM4v6DBdpPtr);
+                here->BSIM4v6_81 = CKTstampMat(stamps, here->BSIM4v6DBdbPtr);
+                here->BSIM4v6_82 = CKTstampMat(stamps, here->BSIM4v6DBbpPtr);
+                here->BSIM4v6_83 = CKTstampMat(stamps, here->BSIM4v6DBbPtr);
+
+                here->BSIM4v6_84 = CKTstampMat(stamps, here->BSIM4v6BPdbPtr);
+                here->BSIM4v6_85 = CKTstampMat(stamps, here->BSIM4v6BPbPtr);
+                here->BSIM4v6_86 = CKTstampMat(stamps, here->BSIM4v6BPsbPtr);
+                here->BSIM4v6_87 = CKTstampMat(stamps, here->BSIM4v6BPbpPtr);
+
+                here->BSIM4v6_88 = CKTstampMat(stamps, here->BSIM4v6SBspPtr);
+                here->BSIM4v6_89 = CKTstampMat(stamps, here->BSIM4v6SBbpPtr);
+                here->BSIM4v6_90 = CKTstampMat(stamps, here->BSIM4v6SBbPtr);
+                here->BSIM4v6_91 = CKTstampMat(stamps, here->BSIM4v6SBsbPtr);
+
+                here->BSIM4v6_92 = CKTstampMat(stamps, here->BSIM4v6BdbPtr);
+                here->BSIM4v6_93 = CKTstampMat(stamps, here->BSIM4v6BbpPtr);
+                here->BSIM4v6_94 = CKTstampMat(stamps, here->BSIM4v6BsbPtr);
+                here->BSIM4v6_95 = CKTstampMat(stamps, here->BSIM4v6BbPtr);
+            }
+
+            if (here->BSIM4v6trnqsMod)
+            {   here->BSIM4v6_96 = CKTstampMat(stamps, here->BSIM4v6QqPtr);
+                here->BSIM4v6_97 = CKTstampMat(stamps, here->BSIM4v6QgpPtr);
+                here->BSIM4v6_98 = CKTstampMat(stamps, here->BSIM4v6QdpPtr);
+                here->BSIM4v6_99 = CKTstampMat(stamps, here->BSIM4v6QspPtr);
+                here->BSIM4v6_100 = CKTstampMat(stamps, here->BSIM4v6QbpPtr);
+
+                here->BSIM4v6_101 = CKTstampMat(stamps, here->BSIM4v6DPqPtr);
+                here->BSIM4v6_102 = CKTstampMat(stamps, here->BSIM4v6SPqPtr);
+                here->BSIM4v6_103 = CKTstampMat(stamps, here->BSIM4v6GPqPtr);
+            }
         }
-        /* set the array pointer and instance count into each model */
+        /* set the array pointers and instance count into each model */
         model->BSIM4v6InstCount = InstCount;
         model->BSIM4v6InstanceArray = InstArray;		
+        model->BSIM4v6stamps = stamps;
     }
 #endif
 
@@ -24,6 +24,7 @@
 #include "ngspice/ngspice.h"
 #include "ngspice/smpdefs.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
 #include "bsim4v6def.h"
 #include "ngspice/const.h"
 #include "ngspice/sperror.h"
@@ -88,6 +89,10 @@ double n, n0, Vgsteff, Vgs_eff, niter, toxpf, toxpi, Tcen, toxe, epsrox, vddeot;
 double vtfbphi2eot, phieot, TempRatioeot, Vtm0eot, Vtmeot,vbieot;
 
 int Size_Not_Found, i;
+DEVsizeCache *sizeCache;
+double sizeKey[3];
+
+    sizeCache = DEVsizeCacheReset(ckt);
 
     /*  loop through all the BSIM4v6 device models */
     for (; model != NULL; model = model->BSIM4v6nextModel)
@@ -388,21 +393,15 @@ int Size_Not_Found, i;
          for (here = model->BSIM4v6instances; here != NULL;
               here = here->BSIM4v6nextInstance) 
 	 {
-	      pSizeDependParamKnot = model->pSizeDependParamKnot;
-	      Size_Not_Found = 1;
-	      while ((pSizeDependParamKnot != NULL) && Size_Not_Found)
-	      {   if ((here->BSIM4v6l == pSizeDependParamKnot->Length)
-		      && (here->BSIM4v6w == pSizeDependParamKnot->Width)
-		      && (here->BSIM4v6nf == pSizeDependParamKnot->NFinger))
-                  {   Size_Not_Found = 0;
-		      here->pParam = pSizeDependParamKnot;
-		      pParam = here->pParam; /*bug-fix  */
-		  }
-		  else
-		  {   pLastKnot = pSizeDependParamKnot;
-		      pSizeDependParamKnot = pSizeDependParamKnot->pNext;
-		  }
-              }
+	      sizeKey[0] = here->BSIM4v6l;
+	      sizeKey[1] = here->BSIM4v6w;
+	      sizeKey[2] = here->BSIM4v6nf;
+	      pSizeDependParamKnot = DEVsizeFind(sizeCache, model, sizeKey, 3);
+	      Size_Not_Found = (pSizeDependParamKnot == NULL);
+	      if (!Size_Not_Found)
+	      {   here->pParam = pSizeDependParamKnot;
+	          pParam = here->pParam; /*bug-fix  */
+	      }
 
 	      /* stress effect */
 	      Ldrn = here->BSIM4v6l;
@@ -416,6 +415,8 @@ int Size_Not_Found, i;
 		      pLastKnot->pNext = pParam;
                   pParam->pNext = NULL;
                   here->pParam = pParam;
+                  pLastKnot = pParam;
+                  DEVsizeAdd(sizeCache, model, sizeKey, 3, pLastKnot);
 
                   pParam->Length = here->BSIM4v6l;
                   pParam->Width = here->BSIM4v6w;
@@ -386,122 +386,122 @@ typedef struct sBSIM4v6instance
     double *BSIM4v6SPqPtr;
 
 #ifdef USE_OMP
-    /* per instance storage of results, to update matrix at a later stge */
-    double BSIM4v6rhsdPrime;
-    double BSIM4v6rhsgPrime;
-    double BSIM4v6rhsgExt;
-    double BSIM4v6grhsMid;
-    double BSIM4v6rhsbPrime;
-    double BSIM4v6rhssPrime;
-    double BSIM4v6rhsdb;
-    double BSIM4v6rhssb;
-    double BSIM4v6rhsd;
-    double BSIM4v6rhss;
-    double BSIM4v6rhsq;
-
-    double BSIM4v6_1;
-    double BSIM4v6_2;
-    double BSIM4v6_3;
-    double BSIM4v6_4;
-    double BSIM4v6_5;
-    double BSIM4v6_6;
-    double BSIM4v6_7;
-    double BSIM4v6_8;
-    double BSIM4v6_9;
-    double BSIM4v6_10;
-    double BSIM4v6_11;
-    double BSIM4v6_12;
-    double BSIM4v6_13;
-    double BSIM4v6_14;
-    double BSIM4v6_15;
-    double BSIM4v6_16;
-    double BSIM4v6_17;
-    double BSIM4v6_18;
-    double BSIM4v6_19;
-    double BSIM4v6_20;
-    double BSIM4v6_21;
-    double BSIM4v6_22;
-    double BSIM4v6_23;
-    double BSIM4v6_24;
-    double BSIM4v6_25;
-    double BSIM4v6_26;
-    double BSIM4v6_27;
-    double BSIM4v6_28;
-    double BSIM4v6_29;
-    double BSIM4v6_30;
-    double BSIM4v6_31;
-    double BSIM4v6_32;
-    double BSIM4v6_33;
-    double BSIM4v6_34;
-    double BSIM4v6_35;
-    double BSIM4v6_36;
-    double BSIM4v6_37;
-    double BSIM4v6_38;
-    double BSIM4v6_39;
-    double BSIM4v6_40;
-    double BSIM4v6_41;
-    double BSIM4v6_42;
-    double BSIM4v6_43;
-    double BSIM4v6_44;
-    double BSIM4v6_45;
-    double BSIM4v6_46;
-    double BSIM4v6_47;
-    double BSIM4v6_48;
-    double BSIM4v6_49;
-    double BSIM4v6_50;
-    double BSIM4v6_51;
-    double BSIM4v6_52;
-    double BSIM4v6_53;
-    double BSIM4v6_54;
-    double BSIM4v6_55;
-    double BSIM4v6_56;
-    double BSIM4v6_57;
-    double BSIM4v6_58;
-    double BSIM4v6_59;
-    double BSIM4v6_60;
-    double BSIM4v6_61;
-    double BSIM4v6_62;
-    double BSIM4v6_63;
-    double BSIM4v6_64;
-    double BSIM4v6_65;
-    double BSIM4v6_66;
-    double BSIM4v6_67;
-    double BSIM4v6_68;
-    double BSIM4v6_69;
-    double BSIM4v6_70;
-    double BSIM4v6_71;
-    double BSIM4v6_72;
-    double BSIM4v6_73;
-    double BSIM4v6_74;
-    double BSIM4v6_75;
-    double BSIM4v6_76;
-    double BSIM4v6_77;
-    double BSIM4v6_78;
-    double BSIM4v6_79;
-    double BSIM4v6_80;
-    double BSIM4v6_81;
-    double BSIM4v6_82;
-    double BSIM4v6_83;
-    double BSIM4v6_84;
-    double BSIM4v6_85;
-    double BSIM4v6_86;
-    double BSIM4v6_87;
-    double BSIM4v6_88;
-    double BSIM4v6_89;
-    double BSIM4v6_90;
-    double BSIM4v6_91;
-    double BSIM4v6_92;
-    double BSIM4v6_93;
-    double BSIM4v6_94;
-    double BSIM4v6_95;
-    double BSIM4v6_96;
-    double BSIM4v6_97;
-    double BSIM4v6_98;
-    double BSIM4v6_99;
-    double BSIM4v6_100;
-    double BSIM4v6_101;
-    double BSIM4v6_102;
-    double BSIM4v6_103;
+    /* slots of the results in the model stamp buffer */
+    int BSIM4v6rhsdPrime;
+    int BSIM4v6rhsgPrime;
+    int BSIM4v6rhsgExt;
+    int BSIM4v6grhsMid;
+    int BSIM4v6rhsbPrime;
+    int BSIM4v6rhssPrime;
+    int BSIM4v6rhsdb;
+    int BSIM4v6rhssb;
+    int BSIM4v6rhsd;
+    int BSIM4v6rhss;
+    int BSIM4v6rhsq;
+
+    int BSIM4v6_1;
+    int BSIM4v6_2;
+    int BSIM4v6_3;
+    int BSIM4v6_4;
+    int BSIM4v6_5;
+    int BSIM4v6_6;
+    int BSIM4v6_7;
+    int BSIM4v6_8;
+    int BSIM4v6_9;
+    int BSIM4v6_10;
+    int BSIM4v6_11;
+    int BSIM4v6_12;
+    int BSIM4v6_13;
+    int BSIM4v6_14;
+    int BSIM4v6_15;
+    int BSIM4v6_16;
+    int BSIM4v6_17;
+    int BSIM4v6_18;
+    int BSIM4v6_19;
+    int BSIM4v6_20;
+    int BSIM4v6_21;
+    int BSIM4v6_22;
+    int BSIM4v6_23;
+    int BSIM4v6_24;
+    int BSIM4v6_25;
+    int BSIM4v6_26;
+    int BSIM4v6_27;
+    int BSIM4v6_28;
+    int BSIM4v6_29;
+    int BSIM4v6_30;
+    int BSIM4v6_31;
+    int BSIM4v6_32;
+    int BSIM4v6_33;
+    int BSIM4v6_34;
+    int BSIM4v6_35;
+    int BSIM4v6_36;
+    int BSIM4v6_37;
+    int BSIM4v6_38;
+    int BSIM4v6_39;
+    int BSIM4v6_40;
+    int BSIM4v6_41;
+    int BSIM4v6_42;
+    int BSIM4v6_43;
+    int BSIM4v6_44;
+    int BSIM4v6_45;
+    int BSIM4v6_46;
+    int BSIM4v6_47;
+    int BSIM4v6_48;
+    int BSIM4v6_49;
+    int BSIM4v6_50;
+    int BSIM4v6_51;
+    int BSIM4v6_52;
+    int BSIM4v6_53;
+    int BSIM4v6_54;
+    int BSIM4v6_55;
+    int BSIM4v6_56;
+    int BSIM4v6_57;
+    int BSIM4v6_58;
+    int BSIM4v6_59;
+    int BSIM4v6_60;
+    int BSIM4v6_61;
+    int BSIM4v6_62;
+    int BSIM4v6_63;
+    int BSIM4v6_64;
+    int BSIM4v6_65;
+    int BSIM4v6_66;
+    int BSIM4v6_67;
+    int BSIM4v6_68;
+    int BSIM4v6_69;
+    int BSIM4v6_70;
+    int BSIM4v6_71;
+    int BSIM4v6_72;
+    int BSIM4v6_73;
+    int BSIM4v6_74;
+    int BSIM4v6_75;
+    int BSIM4v6_76;
+    int BSIM4v6_77;
+    int BSIM4v6_78;
+    int BSIM4v6_79;
+    int BSIM4v6_80;
+    int BSIM4v6_81;
+    int BSIM4v6_82;
+    int BSIM4v6_83;
+    int BSIM4v6_84;
+    int BSIM4v6_85;
+    int BSIM4v6_86;
+    int BSIM4v6_87;
+    int BSIM4v6_88;
+    int BSIM4v6_89;
+    int BSIM4v6_90;
+    int BSIM4v6_91;
+    int BSIM4v6_92;
+    int BSIM4v6_93;
+    int BSIM4v6_94;
+    int BSIM4v6_95;
+    int BSIM4v6_96;
+    int BSIM4v6_97;
+    int BSIM4v6_98;
+    int BSIM4v6_99;
+    int BSIM4v6_100;
+    int BSIM4v6_101;
+    int BSIM4v6_102;
+    int BSIM4v6_103;
 
 #endif
 
@@ -1713,6 +1713,7 @@ typedef struct sBSIM4v6model
 #ifdef USE_OMP
     int BSIM4v6InstCount;
     struct sBSIM4v6instance **BSIM4v6InstanceArray;
+    CKTstampBuf *BSIM4v6stamps;
 #endif
 
     /* Flags */
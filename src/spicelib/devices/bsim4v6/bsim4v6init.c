@@ -68,6 +68,8 @@ SPICEdev BSIM4v6info = {
     NULL,          /* DEVdisto       */
     BSIM4v6noise,    /* DEVnoise       */
     BSIM4v6soaCheck,/* DEVsoaCheck    */
+    NULL,/* DEVsnapSave    */
+    NULL,/* DEVsnapLoad    */
 #ifdef CIDER
     NULL,          /* DEVdump        */
     NULL,          /* DEVacct        */
@@ -23,6 +23,7 @@ BSIM4v7destroy(GENmodel **inModel)
 #ifdef USE_OMP
     /* free just once for all models */
     FREE(mod->BSIM4v7InstanceArray);
+    CKTstampFree(&mod->BSIM4v7stamps);
 #endif
 
     while (mod) {
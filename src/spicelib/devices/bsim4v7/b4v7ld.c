@@ -61,7 +61,6 @@
 
 #ifdef USE_OMP
 int BSIM4v7LoadOMP(BSIM4v7instance *here, CKTcircuit *ckt);
-void BSIM4v7LoadRhsMat(GENmodel *inModel, CKTcircuit *ckt);
 #endif
 
 int BSIM4v7polyDepletion(double phi, double ngate,double epsgate, double coxe, double Vgs, double *Vgs_eff, double *dVgs_eff_dVg);
@@ -86,7 +85,7 @@ CKTcircuit *ckt)
             error = local_error;
     }
 
-    BSIM4v7LoadRhsMat(inModel, ckt);
+    CKTstampLoad(model->BSIM4v7stamps, ckt);
     
     return error;
 }
@@ -94,6 +93,8 @@ CKTcircuit *ckt)
 
 int BSIM4v7LoadOMP(BSIM4v7instance *here, CKTcircuit *ckt) {
 BSIM4v7model *model = here->BSIM4v7modPtr;
+double *rhsVal = model->BSIM4v7stamps->rhsVal;
+double *matVal = model->BSIM4v7stamps->matVal;
 #else
 BSIM4v7model *model = (BSIM4v7model*)inModel;
 BSIM4v7instance *here;
@@ -4903,36 +4904,36 @@ line900:
               m = here->BSIM4v7m;
 
 #ifdef USE_OMP
-       here->BSIM4v7rhsdPrime = m * (ceqjd - ceqbd + ceqgdtot
+       rhsVal[here->BSIM4v7rhsdPrime] = m * (ceqjd - ceqbd + ceqgdtot
                                                     - ceqdrn - ceqqd + Idtoteq);
-       here->BSIM4v7rhsgPrime = m * (ceqqg - ceqgcrg + Igtoteq);
+       rhsVal[here->BSIM4v7rhsgPrime] = -m * (ceqqg - ceqgcrg + Igtoteq);
 
        if (here->BSIM4v7rgateMod == 2)
-           here->BSIM4v7rhsgExt = m * ceqgcrg;
+           rhsVal[here->BSIM4v7rhsgExt] = -m * ceqgcrg;
        else if (here->BSIM4v7rgateMod == 3)
-               here->BSIM4v7grhsMid = m * (ceqqgmid + ceqgcrg);
+               rhsVal[here->BSIM4v7grhsMid] = -m * (ceqqgmid + ceqgcrg);
 
        if (!here->BSIM4v7rbodyMod)
-       {   here->BSIM4v7rhsbPrime = m * (ceqbd + ceqbs - ceqjd
+       {   rhsVal[here->BSIM4v7rhsbPrime] = m * (ceqbd + ceqbs - ceqjd
                                                         - ceqjs - ceqqb + Ibtoteq);
-           here->BSIM4v7rhssPrime = m * (ceqdrn - ceqbs + ceqjs 
+           rhsVal[here->BSIM4v7rhssPrime] = m * (ceqdrn - ceqbs + ceqjs 
                               + ceqqg + ceqqb + ceqqd + ceqqgmid - ceqgstot + Istoteq);
         }
         else
-        {   here->BSIM4v7rhsdb = m * (ceqjd + ceqqjd);
-            here->BSIM4v7rhsbPrime = m * (ceqbd + ceqbs - ceqqb + Ibtoteq);
-            here->BSIM4v7rhssb = m * (ceqjs + ceqqjs);
-            here->BSIM4v7rhssPrime = m * (ceqdrn - ceqbs + ceqjs + ceqqd 
+        {   rhsVal[here->BSIM4v7rhsdb] = -m * (ceqjd + ceqqjd);
+            rhsVal[here->BSIM4v7rhsbPrime] = m * (ceqbd + ceqbs - ceqqb + Ibtoteq);
+            rhsVal[here->BSIM4v7rhssb] = -m * (ceqjs + ceqqjs);
+            rhsVal[here->BSIM4v7rhssPrime] = m * (ceqdrn - ceqbs + ceqjs + ceqqd 
                 + ceqqg + ceqqb + ceqqjd + ceqqjs + ceqqgmid - ceqgstot + Istoteq);
         }
 
         if (model->BSIM4v7rdsMod)
-        {   here->BSIM4v7rhsd = m * ceqgdtot; 
-            here->BSIM4v7rhss = m * ceqgstot;
+        {   rhsVal[here->BSIM4v7rhsd] = -m * ceqgdtot; 
+            rhsVal[here->BSIM4v7rhss] = m * ceqgstot;
         }
 
         if (here->BSIM4v7trnqsMod)
-           here->BSIM4v7rhsq = m * (cqcheq - cqdef);
+           rhsVal[here->BSIM4v7rhsq] = m * (cqcheq - cqdef);
 #else
         (*(ckt->CKTrhs + here->BSIM4v7dNodePrime) += m * (ceqjd - ceqbd + ceqgdtot
                                                     - ceqdrn - ceqqd + Idtoteq));
@@ -4990,94 +4991,94 @@ line900:
        T1 = qdef * here->BSIM4v7gtau;
 #ifdef USE_OMP
        if (here->BSIM4v7rgateMod == 1)
-       {   here->BSIM4v7_1 = m * geltd;
-           here->BSIM4v7_2 = m * geltd;
-           here->BSIM4v7_3 = m * geltd;
-           here->BSIM4v7_4 = m * (gcggb + geltd - ggtg + gIgtotg);
-           here->BSIM4v7_5 = m * (gcgdb - ggtd + gIgtotd);
-           here->BSIM4v7_6 = m * (gcgsb - ggts + gIgtots);
-           here->BSIM4v7_7 = m * (gcgbb - ggtb + gIgtotb);
+       {   matVal[here->BSIM4v7_1] = m * geltd;
+           matVal[here->BSIM4v7_2] = -m * geltd;
+           matVal[here->BSIM4v7_3] = -m * geltd;
+           matVal[here->BSIM4v7_4] = m * (gcggb + geltd - ggtg + gIgtotg);
+           matVal[here->BSIM4v7_5] = m * (gcgdb - ggtd + gIgtotd);
+           matVal[here->BSIM4v7_6] = m * (gcgsb - ggts + gIgtots);
+           matVal[here->BSIM4v7_7] = m * (gcgbb - ggtb + gIgtotb);
        } /* WDLiu: gcrg already subtracted from all gcrgg below */
        else if (here->BSIM4v7rgateMod == 2)        
-       {   here->BSIM4v7_8 = m * gcrg;
-           here->BSIM4v7_9 = m * gcrgg;
-           here->BSIM4v7_10 = m * gcrgd;
-           here->BSIM4v7_11 = m * gcrgs;
-           here->BSIM4v7_12 = m * gcrgb;        
-
-           here->BSIM4v7_13 = m * gcrg;
-           here->BSIM4v7_14 = m * (gcggb  - gcrgg - ggtg + gIgtotg);
-           here->BSIM4v7_15 = m * (gcgdb - gcrgd - ggtd + gIgtotd);
-           here->BSIM4v7_16 = m * (gcgsb - gcrgs - ggts + gIgtots);
-           here->BSIM4v7_17 = m * (gcgbb - gcrgb - ggtb + gIgtotb);
+       {   matVal[here->BSIM4v7_8] = m * gcrg;
+           matVal[here->BSIM4v7_9] = m * gcrgg;
+           matVal[here->BSIM4v7_10] = m * gcrgd;
+           matVal[here->BSIM4v7_11] = m * gcrgs;
+           matVal[here->BSIM4v7_12] = m * gcrgb;        
+
+           matVal[here->BSIM4v7_13] = -m * gcrg;
+           matVal[here->BSIM4v7_14] = m * (gcggb  - gcrgg - ggtg + gIgtotg);
+           matVal[here->BSIM4v7_15] = m * (gcgdb - gcrgd - ggtd + gIgtotd);
+           matVal[here->BSIM4v7_16] = m * (gcgsb - gcrgs - ggts + gIgtots);
+           matVal[here->BSIM4v7_17] = m * (gcgbb - gcrgb - ggtb + gIgtotb);
        }
        else if (here->BSIM4v7rgateMod == 3)
-       {   here->BSIM4v7_18 = m * geltd;
-           here->BSIM4v7_19 = m * geltd;
-           here->BSIM4v7_20 = m * geltd;
-           here->BSIM4v7_21 = m * (geltd + gcrg + gcgmgmb);
-
-           here->BSIM4v7_22 = m * (gcrgd + gcgmdb);
-           here->BSIM4v7_23 = m * gcrgg;
-           here->BSIM4v7_24 = m * (gcrgs + gcgmsb);
-           here->BSIM4v7_25 = m * (gcrgb + gcgmbb);
-
-           here->BSIM4v7_26 = m * gcdgmb;
-           here->BSIM4v7_27 = m * gcrg;
-           here->BSIM4v7_28 = m * gcsgmb;
-           here->BSIM4v7_29 = m * gcbgmb;
-
-           here->BSIM4v7_30 = m * (gcggb - gcrgg - ggtg + gIgtotg);
-           here->BSIM4v7_31 = m * (gcgdb - gcrgd - ggtd + gIgtotd);
-           here->BSIM4v7_32 = m * (gcgsb - gcrgs - ggts + gIgtots);
-           here->BSIM4v7_33 = m * (gcgbb - gcrgb - ggtb + gIgtotb);
+       {   matVal[here->BSIM4v7_18] = m * geltd;
+           matVal[here->BSIM4v7_19] = -m * geltd;
+           matVal[here->BSIM4v7_20] = -m * geltd;
+           matVal[here->BSIM4v7_21] = m * (geltd + gcrg + gcgmgmb);
+
+           matVal[here->BSIM4v7_22] = m * (gcrgd + gcgmdb);
+           matVal[here->BSIM4v7_23] = m * gcrgg;
+           matVal[here->BSIM4v7_24] = m * (gcrgs + gcgmsb);
+           matVal[here->BSIM4v7_25] = m * (gcrgb + gcgmbb);
+
+           matVal[here->BSIM4v7_26] = m * gcdgmb;
+           matVal[here->BSIM4v7_27] = -m * gcrg;
+           matVal[here->BSIM4v7_28] = m * gcsgmb;
+           matVal[here->BSIM4v7_29] = m * gcbgmb;
+
+           matVal[here->BSIM4v7_30] = m * (gcggb - gcrgg - ggtg + gIgtotg);
+           matVal[here->BSIM4v7_31] = m * (gcgdb - gcrgd - ggtd + gIgtotd);
+           matVal[here->BSIM4v7_32] = m * (gcgsb - gcrgs - ggts + gIgtots);
+           matVal[here->BSIM4v7_33] = m * (gcgbb - gcrgb - ggtb + gIgtotb);
        }
        else
-       {   here->BSIM4v7_34 = m * (gcggb - ggtg + gIgtotg);
-           here->BSIM4v7_35 = m * (gcgdb - ggtd + gIgtotd);
-           here->BSIM4v7_36 = m * (gcgsb - ggts + gIgtots);
-           here->BSIM4v7_37 = m * (gcgbb - ggtb + gIgtotb);
+       {   matVal[here->BSIM4v7_34] = m * (gcggb - ggtg + gIgtotg);
+           matVal[here->BSIM4v7_35] = m * (gcgdb - ggtd + gIgtotd);
+           matVal[here->BSIM4v7_36] = m * (gcgsb - ggts + gIgtots);
+           matVal[here->BSIM4v7_37] = m * (gcgbb - ggtb + gIgtotb);
        }
 
        if (model->BSIM4v7rdsMod)
-       {   here->BSIM4v7_38 = m * gdtotg;
-           here->BSIM4v7_39 = m * gdtots;
-           here->BSIM4v7_40 = m * gdtotb;
-           here->BSIM4v7_41 = m * gstotd;
-           here->BSIM4v7_42 = m * gstotg;
-           here->BSIM4v7_43 = m * gstotb;
+       {   matVal[here->BSIM4v7_38] = m * gdtotg;
+           matVal[here->BSIM4v7_39] = m * gdtots;
+           matVal[here->BSIM4v7_40] = m * gdtotb;
+           matVal[here->BSIM4v7_41] = m * gstotd;
+           matVal[here->BSIM4v7_42] = m * gstotg;
+           matVal[here->BSIM4v7_43] = m * gstotb;
        }
 
-       here->BSIM4v7_44 = m * (gdpr + here->BSIM4v7gds + here->BSIM4v7gbd + T1 * ddxpart_dVd
+       matVal[here->BSIM4v7_44] = m * (gdpr + here->BSIM4v7gds + here->BSIM4v7gbd + T1 * ddxpart_dVd
                                    - gdtotd + RevSum + gcddb + gbdpdp + dxpart * ggtd - gIdtotd);
-       here->BSIM4v7_45 = m * (gdpr + gdtot);
-       here->BSIM4v7_46 = m * (Gm + gcdgb - gdtotg + gbdpg - gIdtotg
+       matVal[here->BSIM4v7_45] = -m * (gdpr + gdtot);
+       matVal[here->BSIM4v7_46] = m * (Gm + gcdgb - gdtotg + gbdpg - gIdtotg
                                    + dxpart * ggtg + T1 * ddxpart_dVg);
-       here->BSIM4v7_47 = m * (here->BSIM4v7gds + gdtots - dxpart * ggts + gIdtots
+       matVal[here->BSIM4v7_47] = -m * (here->BSIM4v7gds + gdtots - dxpart * ggts + gIdtots
                                    - T1 * ddxpart_dVs + FwdSum - gcdsb - gbdpsp);
-       here->BSIM4v7_48 = m * (gjbd + gdtotb - Gmbs - gcdbb - gbdpb + gIdtotb
+       matVal[here->BSIM4v7_48] = -m * (gjbd + gdtotb - Gmbs - gcdbb - gbdpb + gIdtotb
                                    - T1 * ddxpart_dVb - dxpart * ggtb);
 
-       here->BSIM4v7_49 = m * (gdpr - gdtotd);
-       here->BSIM4v7_50 = m * (gdpr + gdtot);
+       matVal[here->BSIM4v7_49] = -m * (gdpr - gdtotd);
+       matVal[here->BSIM4v7_50] = m * (gdpr + gdtot);
 
-       here->BSIM4v7_51 = m * (here->BSIM4v7gds + gstotd + RevSum - gcsdb - gbspdp
+       matVal[here->BSIM4v7_51] = -m * (here->BSIM4v7gds + gstotd + RevSum - gcsdb - gbspdp
                                    - T1 * dsxpart_dVd - sxpart * ggtd + gIstotd);
-       here->BSIM4v7_52 = m * (gcsgb - Gm - gstotg + gbspg + sxpart * ggtg
+       matVal[here->BSIM4v7_52] = m * (gcsgb - Gm - gstotg + gbspg + sxpart * ggtg
                                    + T1 * dsxpart_dVg - gIstotg);
-       here->BSIM4v7_53 = m * (gspr + here->BSIM4v7gds + here->BSIM4v7gbs + T1 * dsxpart_dVs
+       matVal[here->BSIM4v7_53] = m * (gspr + here->BSIM4v7gds + here->BSIM4v7gbs + T1 * dsxpart_dVs
                                    - gstots + FwdSum + gcssb + gbspsp + sxpart * ggts - gIstots);
-       here->BSIM4v7_54 = m * (gspr + gstot);
-       here->BSIM4v7_55 = m * (gjbs + gstotb + Gmbs - gcsbb - gbspb - sxpart * ggtb
+       matVal[here->BSIM4v7_54] = -m * (gspr + gstot);
+       matVal[here->BSIM4v7_55] = -m * (gjbs + gstotb + Gmbs - gcsbb - gbspb - sxpart * ggtb
                                    - T1 * dsxpart_dVb + gIstotb);
 
-       here->BSIM4v7_56 = m * (gspr - gstots);
-       here->BSIM4v7_57 = m * (gspr + gstot);
+       matVal[here->BSIM4v7_56] = -m * (gspr - gstots);
+       matVal[here->BSIM4v7_57] = m * (gspr + gstot);
 
-       here->BSIM4v7_58 = m * (gcbdb - gjbd + gbbdp - gIbtotd);
-       here->BSIM4v7_59 = m * (gcbgb - here->BSIM4v7gbgs - gIbtotg);
-       here->BSIM4v7_60 = m * (gcbsb - gjbs + gbbsp - gIbtots);
-       here->BSIM4v7_61 = m * (gjbd + gjbs + gcbbb - here->BSIM4v7gbbs - gIbtotb);
+       matVal[here->BSIM4v7_58] = m * (gcbdb - gjbd + gbbdp - gIbtotd);
+       matVal[here->BSIM4v7_59] = m * (gcbgb - here->BSIM4v7gbgs - gIbtotg);
+       matVal[here->BSIM4v7_60] = m * (gcbsb - gjbs + gbbsp - gIbtots);
+       matVal[here->BSIM4v7_61] = m * (gjbd + gjbs + gcbbb - here->BSIM4v7gbbs - gIbtotb);
 
        ggidld = here->BSIM4v7ggidld;
        ggidlg = here->BSIM4v7ggidlg;
@@ -5087,64 +5088,64 @@ line900:
        ggislb = here->BSIM4v7ggislb;
 
        /* stamp gidl */
-       here->BSIM4v7_62 = m * ggidld;
-       here->BSIM4v7_63 = m * ggidlg;
-       here->BSIM4v7_64 = m * (ggidlg + ggidld + ggidlb);
-       here->BSIM4v7_65 = m * ggidlb;
-       here->BSIM4v7_66 = m * ggidld;
-       here->BSIM4v7_67 = m * ggidlg;
-       here->BSIM4v7_68 = m * (ggidlg + ggidld + ggidlb);
-       here->BSIM4v7_69 = m * ggidlb;
+       matVal[here->BSIM4v7_62] = m * ggidld;
+       matVal[here->BSIM4v7_63] = m * ggidlg;
+       matVal[here->BSIM4v7_64] = -m * (ggidlg + ggidld + ggidlb);
+       matVal[here->BSIM4v7_65] = m * ggidlb;
+       matVal[here->BSIM4v7_66] = -m * ggidld;
+       matVal[here->BSIM4v7_67] = -m * ggidlg;
+       matVal[here->BSIM4v7_68] = m * (ggidlg + ggidld + ggidlb);
+       matVal[here->BSIM4v7_69] = -m * ggidlb;
        /* stamp gisl */
-       here->BSIM4v7_70 = m * (ggisls + ggislg + ggislb);
-       here->BSIM4v7_71 = m * ggislg;
-       here->BSIM4v7_72 = m * ggisls;
-       here->BSIM4v7_73 = m * ggislb;
-       here->BSIM4v7_74 = m * (ggislg + ggisls + ggislb);
-       here->BSIM4v7_75 = m * ggislg;
-       here->BSIM4v7_76 = m * ggisls;
-       here->BSIM4v7_77 = m * ggislb;
+       matVal[here->BSIM4v7_70] = -m * (ggisls + ggislg + ggislb);
+       matVal[here->BSIM4v7_71] = m * ggislg;
+       matVal[here->BSIM4v7_72] = m * ggisls;
+       matVal[here->BSIM4v7_73] = m * ggislb;
+       matVal[here->BSIM4v7_74] = m * (ggislg + ggisls + ggislb);
+       matVal[here->BSIM4v7_75] = -m * ggislg;
+       matVal[here->BSIM4v7_76] = -m * ggisls;
+       matVal[here->BSIM4v7_77] = -m * ggislb;
 
        if (here->BSIM4v7rbodyMod)
-       {   here->BSIM4v7_78 = m * (gcdbdb - here->BSIM4v7gbd);
-           here->BSIM4v7_79 = m * (here->BSIM4v7gbs - gcsbsb);
+       {   matVal[here->BSIM4v7_78] = m * (gcdbdb - here->BSIM4v7gbd);
+           matVal[here->BSIM4v7_79] = -m * (here->BSIM4v7gbs - gcsbsb);
 
-           here->BSIM4v7_80 = m * (gcdbdb - here->BSIM4v7gbd);
-           here->BSIM4v7_81 = m * (here->BSIM4v7gbd - gcdbdb 
+           matVal[here->BSIM4v7_80] = m * (gcdbdb - here->BSIM4v7gbd);
+           matVal[here->BSIM4v7_81] = m * (here->BSIM4v7gbd - gcdbdb 
                           + here->BSIM4v7grbpd + here->BSIM4v7grbdb);
-           here->BSIM4v7_82 = m * here->BSIM4v7grbpd;
-           here->BSIM4v7_83 = m * here->BSIM4v7grbdb;
+           matVal[here->BSIM4v7_82] = -m * here->BSIM4v7grbpd;
+           matVal[here->BSIM4v7_83] = -m * here->BSIM4v7grbdb;
 
-           here->BSIM4v7_84 = m * here->BSIM4v7grbpd;
-           here->BSIM4v7_85 = m * here->BSIM4v7grbpb;
-           here->BSIM4v7_86 = m * here->BSIM4v7grbps;
-           here->BSIM4v7_87 = m * (here->BSIM4v7grbpd + here->BSIM4v7grbps 
+           matVal[here->BSIM4v7_84] = -m * here->BSIM4v7grbpd;
+           matVal[here->BSIM4v7_85] = -m * here->BSIM4v7grbpb;
+           matVal[here->BSIM4v7_86] = -m * here->BSIM4v7grbps;
+           matVal[here->BSIM4v7_87] = m * (here->BSIM4v7grbpd + here->BSIM4v7grbps 
                           + here->BSIM4v7grbpb);
            /* WDLiu: (gcbbb - here->BSIM4v7gbbs) already added to BPbpPtr */        
 
-           here->BSIM4v7_88 = m * (gcsbsb - here->BSIM4v7gbs);
-           here->BSIM4v7_89 = m * here->BSIM4v7grbps;
-           here->BSIM4v7_90 = m * here->BSIM4v7grbsb;
-           here->BSIM4v7_91 = m * (here->BSIM4v7gbs - gcsbsb 
+           matVal[here->BSIM4v7_88] = m * (gcsbsb - here->BSIM4v7gbs);
+           matVal[here->BSIM4v7_89] = -m * here->BSIM4v7grbps;
+           matVal[here->BSIM4v7_90] = -m * here->BSIM4v7grbsb;
+           matVal[here->BSIM4v7_91] = m * (here->BSIM4v7gbs - gcsbsb 
                           + here->BSIM4v7grbps + here->BSIM4v7grbsb);
 
-           here->BSIM4v7_92 = m * here->BSIM4v7grbdb;
-           here->BSIM4v7_93 = m * here->BSIM4v7grbpb;
-           here->BSIM4v7_94 = m * here->BSIM4v7grbsb;
-           here->BSIM4v7_95 = m * (here->BSIM4v7grbsb + here->BSIM4v7grbdb
+           matVal[here->BSIM4v7_92] = -m * here->BSIM4v7grbdb;
+           matVal[here->BSIM4v7_93] = -m * here->BSIM4v7grbpb;
+           matVal[here->BSIM4v7_94] = -m * here->BSIM4v7grbsb;
+           matVal[here->BSIM4v7_95] = m * (here->BSIM4v7grbsb + here->BSIM4v7grbdb
                            + here->BSIM4v7grbpb);
        }
 
            if (here->BSIM4v7trnqsMod)
-           {   here->BSIM4v7_96 = m * (gqdef + here->BSIM4v7gtau);
-               here->BSIM4v7_97 = m * (ggtg - gcqgb);
-               here->BSIM4v7_98 = m * (ggtd - gcqdb);
-               here->BSIM4v7_99 = m * (ggts - gcqsb);
-               here->BSIM4v7_100 = m * (ggtb - gcqbb);
-
-               here->BSIM4v7_101 = m * dxpart * here->BSIM4v7gtau;
-               here->BSIM4v7_102 = m * sxpart * here->BSIM4v7gtau;
-               here->BSIM4v7_103 = m * here->BSIM4v7gtau;
+           {   matVal[here->BSIM4v7_96] = m * (gqdef + here->BSIM4v7gtau);
+               matVal[here->BSIM4v7_97] = m * (ggtg - gcqgb);
+               matVal[here->BSIM4v7_98] = m * (ggtd - gcqdb);
+               matVal[here->BSIM4v7_99] = m * (ggts - gcqsb);
+               matVal[here->BSIM4v7_100] = m * (ggtb - gcqbb);
+
+               matVal[here->BSIM4v7_101] = m * dxpart * here->BSIM4v7gtau;
+               matVal[here->BSIM4v7_102] = m * sxpart * here->BSIM4v7gtau;
+               matVal[here->BSIM4v7_103] = -m * here->BSIM4v7gtau;
            }
 #else
            if (here->BSIM4v7rgateMod == 1)
@@ -5351,193 +5352,3 @@ int BSIM4v7polyDepletion(
     }
     return(0);
 }
-
-#ifdef USE_OMP
-void BSIM4v7LoadRhsMat(GENmodel *inModel, CKTcircuit *ckt)
-{
-    int InstCount, idx;
-    BSIM4v7instance **InstArray;
-    BSIM4v7instance *here;
-    BSIM4v7model *model = (BSIM4v7model*)inModel;
-
-    InstArray = model->BSIM4v7InstanceArray;
-    InstCount = model->BSIM4v7InstCount;
-
-    for(idx = 0; idx < InstCount; idx++) {
-       here = InstArray[idx];
-       model = here->BSIM4v7modPtr;
-        /* Update b for Ax = b */
-           (*(ckt->CKTrhs + here->BSIM4v7dNodePrime) += here->BSIM4v7rhsdPrime);
-           (*(ckt->CKTrhs + here->BSIM4v7gNodePrime) -= here->BSIM4v7rhsgPrime);
-
-           if (here->BSIM4v7rgateMod == 2)
-               (*(ckt->CKTrhs + here->BSIM4v7gNodeExt) -= here->BSIM4v7rhsgExt);
-           else if (here->BSIM4v7rgateMod == 3)
-               (*(ckt->CKTrhs + here->BSIM4v7gNodeMid) -= here->BSIM4v7grhsMid);
-
-           if (!here->BSIM4v7rbodyMod)
-           {   (*(ckt->CKTrhs + here->BSIM4v7bNodePrime) += here->BSIM4v7rhsbPrime);
-               (*(ckt->CKTrhs + here->BSIM4v7sNodePrime) += here->BSIM4v7rhssPrime);
-           }
-           else
-           {   (*(ckt->CKTrhs + here->BSIM4v7dbNode) -= here->BSIM4v7rhsdb);
-               (*(ckt->CKTrhs + here->BSIM4v7bNodePrime) += here->BSIM4v7rhsbPrime);
-               (*(ckt->CKTrhs + here->BSIM4v7sbNode) -= here->BSIM4v7rhssb);
-               (*(ckt->CKTrhs + here->BSIM4v7sNodePrime) += here->BSIM4v7rhssPrime);
-           }
-
-           if (model->BSIM4v7rdsMod)
-           {   (*(ckt->CKTrhs + here->BSIM4v7dNode) -= here->BSIM4v7rhsd); 
-               (*(ckt->CKTrhs + here->BSIM4v7sNode) += here->BSIM4v7rhss);
-           }
-
-           if (here->BSIM4v7trnqsMod)
-               *(ckt->CKTrhs + here->BSIM4v7qNode) += here->BSIM4v7rhsq;
-
-
-        /* Update A for Ax = b */
-           if (here->BSIM4v7rgateMod == 1)
-           {   (*(here->BSIM4v7GEgePtr) += here->BSIM4v7_1);
-               (*(here->BSIM4v7GPgePtr) -= here->BSIM4v7_2);
-               (*(here->BSIM4v7GEgpPtr) -= here->BSIM4v7_3);
-               (*(here->BSIM4v7GPgpPtr) += here->BSIM4v7_4);
-               (*(here->BSIM4v7GPdpPtr) += here->BSIM4v7_5);
-               (*(here->BSIM4v7GPspPtr) += here->BSIM4v7_6);
-               (*(here->BSIM4v7GPbpPtr) += here->BSIM4v7_7);
-           }
-           else if (here->BSIM4v7rgateMod == 2)        
-           {   (*(here->BSIM4v7GEgePtr) += here->BSIM4v7_8);
-               (*(here->BSIM4v7GEgpPtr) += here->BSIM4v7_9);
-               (*(here->BSIM4v7GEdpPtr) += here->BSIM4v7_10);
-               (*(here->BSIM4v7GEspPtr) += here->BSIM4v7_11);
-               (*(here->BSIM4v7GEbpPtr) += here->BSIM4v7_12);        
-
-               (*(here->BSIM4v7GPgePtr) -= here->BSIM4v7_13);
-               (*(here->BSIM4v7GPgpPtr) += here->BSIM4v7_14);
-               (*(here->BSIM4v7GPdpPtr) += here->BSIM4v7_15);
-               (*(here->BSIM4v7GPspPtr) += here->BSIM4v7_16);
-               (*(here->BSIM4v7GPbpPtr) += here->BSIM4v7_17);
-           }
-           else if (here->BSIM4v7rgateMod == 3)
-           {   (*(here->BSIM4v7GEgePtr) += here->BSIM4v7_18);
-               (*(here->BSIM4v7GEgmPtr) -= here->BSIM4v7_19);
-               (*(here->BSIM4v7GMgePtr) -= here->BSIM4v7_20);
-               (*(here->BSIM4v7GMgmPtr) += here->BSIM4v7_21);
-
-               (*(here->BSIM4v7GMdpPtr) += here->BSIM4v7_22);
-               (*(here->BSIM4v7GMgpPtr) += here->BSIM4v7_23);
-               (*(here->BSIM4v7GMspPtr) += here->BSIM4v7_24);
-               (*(here->BSIM4v7GMbpPtr) += here->BSIM4v7_25);
-
-               (*(here->BSIM4v7DPgmPtr) += here->BSIM4v7_26);
-               (*(here->BSIM4v7GPgmPtr) -= here->BSIM4v7_27);
-               (*(here->BSIM4v7SPgmPtr) += here->BSIM4v7_28);
-               (*(here->BSIM4v7BPgmPtr) += here->BSIM4v7_29);
-
-               (*(here->BSIM4v7GPgpPtr) += here->BSIM4v7_30);
-               (*(here->BSIM4v7GPdpPtr) += here->BSIM4v7_31);
-               (*(here->BSIM4v7GPspPtr) += here->BSIM4v7_32);
-               (*(here->BSIM4v7GPbpPtr) += here->BSIM4v7_33);
-           }
-
-
-            else
-           {   (*(here->BSIM4v7GPgpPtr) += here->BSIM4v7_34);
-               (*(here->BSIM4v7GPdpPtr) += here->BSIM4v7_35);
-               (*(here->BSIM4v7GPspPtr) += here->BSIM4v7_36);
-               (*(here->BSIM4v7GPbpPtr) += here->BSIM4v7_37);
-           }
-
-
-           if (model->BSIM4v7rdsMod)
-           {   (*(here->BSIM4v7DgpPtr) += here->BSIM4v7_38);
-               (*(here->BSIM4v7DspPtr) += here->BSIM4v7_39);
-               (*(here->BSIM4v7DbpPtr) += here->BSIM4v7_40);
-               (*(here->BSIM4v7SdpPtr) += here->BSIM4v7_41);
-               (*(here->BSIM4v7SgpPtr) += here->BSIM4v7_42);
-               (*(here->BSIM4v7SbpPtr) += here->BSIM4v7_43);
-           }
-
-           (*(here->BSIM4v7DPdpPtr) += here->BSIM4v7_44);
-           (*(here->BSIM4v7DPdPtr) -= here->BSIM4v7_45);
-           (*(here->BSIM4v7DPgpPtr) += here->BSIM4v7_46);
-           (*(here->BSIM4v7DPspPtr) -= here->BSIM4v7_47);
-           (*(here->BSIM4v7DPbpPtr) -= here->BSIM4v7_48);
-
-           (*(here->BSIM4v7DdpPtr) -= here->BSIM4v7_49);
-           (*(here->BSIM4v7DdPtr) += here->BSIM4v7_50);
-
-           (*(here->BSIM4v7SPdpPtr) -= here->BSIM4v7_51);
-           (*(here->BSIM4v7SPgpPtr) += here->BSIM4v7_52);
-           (*(here->BSIM4v7SPspPtr) += here->BSIM4v7_53);
-           (*(here->BSIM4v7SPsPtr) -= here->BSIM4v7_54);
-           (*(here->BSIM4v7SPbpPtr) -= here->BSIM4v7_55);
-
-           (*(here->BSIM4v7SspPtr) -= here->BSIM4v7_56);
-           (*(here->BSIM4v7SsPtr) += here->BSIM4v7_57);
-
-           (*(here->BSIM4v7BPdpPtr) += here->BSIM4v7_58);
-           (*(here->BSIM4v7BPgpPtr) += here->BSIM4v7_59);
-           (*(here->BSIM4v7BPspPtr) += here->BSIM4v7_60);
-           (*(here->BSIM4v7BPbpPtr) += here->BSIM4v7_61);
-
-           /* stamp gidl */
-           (*(here->BSIM4v7DPdpPtr) += here->BSIM4v7_62);
-           (*(here->BSIM4v7DPgpPtr) += here->BSIM4v7_63);
-           (*(here->BSIM4v7DPspPtr) -= here->BSIM4v7_64);
-           (*(here->BSIM4v7DPbpPtr) += here->BSIM4v7_65);
-           (*(here->BSIM4v7BPdpPtr) -= here->BSIM4v7_66);
-           (*(here->BSIM4v7BPgpPtr) -= here->BSIM4v7_67);
-           (*(here->BSIM4v7BPspPtr) += here->BSIM4v7_68);
-           (*(here->BSIM4v7BPbpPtr) -= here->BSIM4v7_69);
-            /* stamp gisl */
-           (*(here->BSIM4v7SPdpPtr) -= here->BSIM4v7_70);
-           (*(here->BSIM4v7SPgpPtr) += here->BSIM4v7_71);
-           (*(here->BSIM4v7SPspPtr) += here->BSIM4v7_72);
-           (*(here->BSIM4v7SPbpPtr) += here->BSIM4v7_73);
-           (*(here->BSIM4v7BPdpPtr) += here->BSIM4v7_74);
-           (*(here->BSIM4v7BPgpPtr) -= here->BSIM4v7_75);
-           (*(here->BSIM4v7BPspPtr) -= here->BSIM4v7_76);
-           (*(here->BSIM4v7BPbpPtr) -= here->BSIM4v7_77);
-
-
-           if (here->BSIM4v7rbodyMod)
-           {   (*(here->BSIM4v7DPdbPtr) += here->BSIM4v7_78);
-               (*(here->BSIM4v7SPsbPtr) -= here->BSIM4v7_79);
-
-               (*(here->BSIM4v7DBdpPtr) += here->BSIM4v7_80);
-               (*(here->BSIM4v7DBdbPtr) += here->BSIM4v7_81);
-               (*(here->BSIM4v7DBbpPtr) -= here->BSIM4v7_82);
-               (*(here->BSIM4v7DBbPtr) -= here->BSIM4v7_83);
-
-               (*(here->BSIM4v7BPdbPtr) -= here->BSIM4v7_84);
-               (*(here->BSIM4v7BPbPtr) -= here->BSIM4v7_85);
-               (*(here->BSIM4v7BPsbPtr) -= here->BSIM4v7_86);
-               (*(here->BSIM4v7BPbpPtr) += here->BSIM4v7_87);
-
-               (*(here->BSIM4v7SBspPtr) += here->BSIM4v7_88);
-               (*(here->BSIM4v7SBbpPtr) -= here->BSIM4v7_89);
-               (*(here->BSIM4v7SBbPtr) -= here->BSIM4v7_90);
-               (*(here->BSIM4v7SBsbPtr) += here->BSIM4v7_91);
-
-               (*(here->BSIM4v7BdbPtr) -= here->BSIM4v7_92);
-               (*(here->BSIM4v7BbpPtr) -= here->BSIM4v7_93);
-               (*(here->BSIM4v7BsbPtr) -= here->BSIM4v7_94);
-               (*(here->BSIM4v7BbPtr) += here->BSIM4v7_95);
-           }
-
-           if (here->BSIM4v7trnqsMod)
-           {   (*(here->BSIM4v7QqPtr) += here->BSIM4v7_96);
-               (*(here->BSIM4v7QgpPtr) += here->BSIM4v7_97);
-               (*(here->BSIM4v7QdpPtr) += here->BSIM4v7_98);
-               (*(here->BSIM4v7QspPtr) += here->BSIM4v7_99);
-               (*(here->BSIM4v7QbpPtr) += here->BSIM4v7_100);
-
-               (*(here->BSIM4v7DPqPtr) += here->BSIM4v7_101);
-               (*(here->BSIM4v7SPqPtr) += here->BSIM4v7_102);
-               (*(here->BSIM4v7GPqPtr) -= here->BSIM4v7_103);
-           }
-    }
-}
-
-#endif
@@ -61,6 +61,7 @@ JOB   *job;
 #ifdef USE_OMP
 int idx, InstCount;
 BSIM4v7instance **InstArray;
+CKTstampBuf *stamps;
 #endif
 
     /* Search for a noise analysis request */
@@ -2597,8 +2598,14 @@ do { if((here->ptr = SMPmakeElt(matrix,here->first,here->second))==(double *)NUL
             InstCount++;
         }
     }
-    InstArray = TMALLOC(BSIM4v7instance*, InstCount);
     model = (BSIM4v7model*)inModel;
+    /* a repeated setup replaces the arrays shared by all models */
+    if (model) {
+        FREE(model->BSIM4v7InstanceArray);
+        CKTstampFree(&model->BSIM4v7stamps);
+    }
+    InstArray = TMALLOC(BSIM4v7instance*, InstCount);
+    stamps = CKTstampNew();
     idx = 0;
     for( ; model != NULL; model = model->BSIM4v7nextModel )
     {
@@ -2608,10 +2615,180 @@ do { if((here->ptr = SMPmakeElt(matrix,here->first,here->second))==(double *)NUL
         { 
             InstArray[idx] = here;
             idx++;
+
+            /* reserve the stamp slots written by BSIM4v7LoadOMP */
+            /* Update b for Ax = b */
+            here->BSIM4v7rhsdPrime = CKTstampRhs(stamps, here->BSIM4v7dNodePrime);
+            here->BSIM4v7rhsgPrime = CKTstampRhs(stamps, here->BSIM4v7gNodePrime);
+
+            if (here->BSIM4v7rgateMod == 2)
+                here->BSIM4v7rhsgExt = CKTstampRhs(stamps, here->BSIM4v7gNodeExt);
+            else if (here->BSIM4v7rgateMod == 3)
+                here->BSIM4v7grhsMid = CKTstampRhs(stamps, here->BSIM4v7gNodeMid);
+
+            if (!here->BSIM4v7rbodyMod)
+            {   here->BSIM4v7rhsbPrime = CKTstampRhs(stamps, here->BSIM4v7bNodePrime);
+                here->BSIM4v7rhssPrime = CKTstampRhs(stamps, here->BSIM4v7sNodePrime);
+            }
+            else
+            {   here->BSIM4v7rhsdb = CKTstampRhs(stamps, here->BSIM4v7dbNode);
+                here->BSIM4v7rhsbPrime = CKTstampRhs(stamps, here->BSIM4v7bNodePrime);
+                here->BSIM4v7rhssb = CKTstampRhs(stamps, here->BSIM4v7sbNode);
+                here->BSIM4v7rhssPrime = CKTstampRhs(stamps, here->BSIM4v7sNodePrime);
+            }
+
+            if (model->BSIM4v7rdsMod)
+            {   here->BSIM4v7rhsd = CKTstampRhs(stamps, here->BSIM4v7dNode);
+                here->BSIM4v7rhss = CKTstampRhs(stamps, here->BSIM4v7sNode);
+            }
+
+            if (here->BSIM4v7trnqsMod)
+                here->BSIM4v7rhsq = CKTstampRhs(stamps, here->BSIM4v7qNode);
+
+            /* Update A for Ax = b */
+            if (here->BSIM4v7rgateMod == 1)
+            {   here->BSIM4v7_1 = CKTstampMat(stamps, here->BSIM4v7GEgePtr);
+                here->BSIM4v7_2 = CKTstampMat(stamps, here->BSIM4v7GPgePtr);
+                here->BSIM4v7_3 = CKTstampMat(stamps, here->BSIM4v7GEgpPtr);
+                here->BSIM4v7_4 = CKTstampMat(stamps, here->BSIM4v7GPgpPtr);
+                here->BSIM4v7_5 = CKTstampMat(stamps, here->BSIM4v7GPdpPtr);
+                here->BSIM4v7_6 = CKTstampMat(stamps, here->BSIM4v7GPspPtr);
+                here->BSIM4v7_7 = CKTstampMat(stamps, here->BSIM4v7GPbpPtr);
+            }
+            else if (here->BSIM4v7rgateMod == 2)
+            {   here->BSIM4v7_8 = CKTstampMat(stamps, here->BSIM4v7GEgePtr);
+                here->BSIM4v7_9 = CKTstampMat(stamps, here->BSIM4v7GEgpPtr);
+                here->BSIM4v7_10 = CKTstampMat(stamps, here->BSIM4v7GEdpPtr);
+                here->BSIM4v7_11 = CKTstampMat(stamps, here->BSIM4v7GEspPtr);
+                here->BSIM4v7_12 = CKTstampMat(stamps, here->BSIM4v7GEbpPtr);
+
+                here->BSIM4v7_13 = CKTstampMat(stamps, here->BSIM4v7GPgePtr);
+                here->BSIM4v7_14 = CKTstampMat(stamps, here->BSIM4v7GPgpPtr);
+                here->BSIM4v7_15 = CKTstampMat(stamps, here->BSIM4v7GPdpPtr);
+                here->BSIM4v7_16 = CKTstampMat(stamps, here->BSIM4v7GPspPtr);
+                here->BSIM4v7_17 = CKTstampMat(stamps, here->BSIM4v7GPbpPtr);
+            }
+            else if (here->BSIM4v7rgateMod == 3)
+            {   here->BSIM4v7_18 = CKTstampMat(stamps, here->BSIM4v7GEgePtr);
+                here->BSIM4v7_19 = CKTstampMat(stamps, here->BSIM4v7GEgmPtr);
+                here->BSIM4v7_20 = CKTstampMat(stamps, here->BSIM4v7GMgePtr);
+                here->BSIM4v7_21 = CKTstampMat(stamps, here->BSIM4v7GMgmPtr);
+
+                here->BSIM4v7_22 = CKTstampMat(stamps, here->BSIM4v7GMdpPtr);
+                here->BSIM4v7_23 = CKTstampMat(stamps, here->BSIM4v7GMgpPtr);
+                here->BSIM4v7_24 = CKTstampMat(stamps, here->BSIM4v7GMspPtr);
+                here->BSIM4v7_25 = CKTstampMat(stamps, here->BSIM4v7GMbpPtr);
+
+                here->BSIM4v7_26 = CKTstampMat(stamps, here->BSIM4v7DPgmPtr);
+                here->BSIM4v7_27 = CKTstampMat(stamps, here->BSIM4v7GPgmPtr);
+                here->BSIM4v7_28 = CKTstampMat(stamps, here->BSIM4v7SPgmPtr);
+                here->BSIM4v7_29 = CKTstampMat(stamps, here->BSIM4v7BPgmPtr);
+
+                here->BSIM4v7_30 = CKTstampMat(stamps, here->BSIM4v7GPgpPtr);
+                here->BSIM4v7_31 = CKTstampMat(stamps, here->BSIM4v7GPdpPtr);
+                here->BSIM4v7_32 = CKTstampMat(stamps, here->BSIM4v7GPspPtr);
+                here->BSIM4v7_33 = CKTstampMat(stamps, here->BSIM4v7GPbpPtr);
+            }
+
+             else
+            {   here->BSIM4v7_34 = CKTstampMat(stamps, here->BSIM4v7GPgpPtr);
+                here->BSIM4v7_35 = CKTstampMat(stamps, here->BSIM4v7GPdpPtr);
+                here->BSIM4v7_36 = CKTstampMat(stamps, here->BSIM4v7GPspPtr);
+                here->BSIM4v7_37 = CKTstampMat(stamps, here->BSIM4v7GPbpPtr);
+            }
+
+            if (model->BSIM4v7rdsMod)
+            {   here->BSIM4v7_38 = CKTstampMat(stamps, here->BSIM4v7DgpPtr);
+                here->BSIM4v7_39 = CKTstampMat(stamps, here->BSIM4v7DspPtr);
+                here->BSIM4v7_40 = CKTstampMat(stamps, here->BSIM4v7DbpPtr);
+                here->BSIM4v7_41 = CKTstampMat(stamps, here->BSIM4v7SdpPtr);
+                here->BSIM4v7_42 = CKTstampMat(stamps, here->BSIM4v7SgpPtr);
+                here->BSIM4v7_43 = CKTstampMat(stamps, here->BSIM4v7SbpPtr);
+            }
+
+            here->BSIM4v7_44 = CKTstampMat(stamps, here->BSIM4v7DPdpPtr);
+            here->BSIM4v7_45 = CKTstampMat(stamps, here->BSIM4v7DPdPtr);
+            here->BSIM4v7_46 = CKTstampMat(stamps, here->BSIM4v7DPgpPtr);
+            here->BSIM4v7_47 = CKTstampMat(stamps, here->BSIM4v7DPspPtr);
+            here->BSIM4v7_48 = CKTstampMat(stamps, here->BSIM4v7DPbpPtr);
+
+            here->BSIM4v7_49 = CKTstampMat(stamps, here->BSIM4v7DdpPtr);
+            here->BSIM4v7_50 = CKTstampMat(stamps, here->BSIM4v7DdPtr);
+
+            here->BSIM4v7_51 = CKTstampMat(stamps, here->BSIM4v7SPdpPtr);
+            here->BSIM4v7_52 = CKTstampMat(stamps, here->BSIM4v7SPgpPtr);
+            here->BSIM4v7_53 = CKTstampMat(stamps, here->BSIM4v7SPspPtr);
+            here->BSIM4v7_54 = CKTstampMat(stamps, here->BSIM4v7SPsPtr);
+            here->BSIM4v7_55 = CKTstampMat(stamps, here->BSIM4v7SPbpPtr);
+
+            here->BSIM4v7_56 = CKTstampMat(stamps, here->BSIM4v7SspPtr);
+            here->BSIM4v7_57 = CKTstampMat(stamps, here->BSIM4v7SsPtr);
+
+            here->BSIM4v7_58 = CKTstampMat(stamps, here->BSIM4v7BPdpPtr);
+            here->BSIM4v7_59 = CKTstampMat(stamps, here->BSIM4v7BPgpPtr);
+            here->BSIM4v7_60 = CKTstampMat(stamps, here->BSIM4v7BPspPtr);
+            here->BSIM4v7_61 = CKTstampMat(stamps, here->BSIM4v7BPbpPtr);
+
+            /* stamp gidl */
+            here->BSIM4v7_62 = CKTstampMat(stamps, here->BSIM4v7DPdpPtr);
+            here->BSIM4v7_63 = CKTstampMat(stamps, here->BSIM4v7DPgpPtr);
+            here->BSIM4v7_64 = CKTstampMat(stamps, here->BSIM4v7DPspPtr);
+            here->BSIM4v7_65 = CKTstampMat(stamps, here->BSIM4v7DPbpPtr);
+            here->BSIM4v7_66 = CKTstampMat(stamps, here->BSIM4v7BPdpPtr);
+            here->BSIM4v7_67 = CKTstampMat(stamps, here->BSIM4v7BPgpPtr);
+            here->BSIM4v7_68 = CKTstampMat(stamps, here->BSIM4v7BPspPtr);
+            here->BSIM4v7_69 = CKTstampMat(stamps, here->BSIM4v7BPbpPtr);
+             /* stamp gisl */
+            here->BSIM4v7_70 = CKTstampMat(stamps, here->BSIM4v7SPdpPtr);
+            here->BSIM4v7_71 = CKTstampMat(stamps, here->BSIM4v7SPgpPtr);
+            here->BSIM4v7_72 = CKTstampMat(stamps, here->BSIM4v7SPspPtr);
+            here->BSIM4v7_73 = CKTstampMat(stamps, here->BSIM4v7SPbpPtr);
+            here->BSIM4v7_74 = CKTstampMat(stamps, here->BSIM4v7BPdpPtr);
+            here->BSIM4v7_75 = CKTstampMat(stamps, here->BSIM4v7BPgpPtr);
+            here->BSIM4v7_76 = CKTstampMat(stamps, here->BSIM4v7BPspPtr);
+            here->BSIM4v7_77 = CKTstampMat(stamps, here->BSIM4v7BPbpPtr);
+
+            if (here->BSIM4v7rbodyMod)
+            {   here->BSIM4v7_78 = CKTstampMat(stamps, here->BSIM4v7DPdbPtr);
+                here->BSIM4v7_79 = CKTstampMat(stamps, here->BSIM4v7SPsbPtr);
+
+                here->BSIM4v7_80 = CKTstampMat(stamps, here->BSIM4v7DBdpPtr);
+                here->BSIM4v7_81 = CKTstampMat(stamps, here->BSIM4v7DBdbPtr);
+                here->BSIM4v7_82 = CKTstampMat(stamps, here->BSIM4v7DBbpPtr);
+                here->BSIM4v7_83 = CKTstampMat(stamps, here->BSIM4v7DBbPtr);
+
+                here->BSIM4v7_84 = CKTstampMat(stamps, here->BSIM4v7BPdbPtr);
+                here->BSIM4v7_85 = CKTstampMat(stamps, here->BSIM4v7BPbPtr);
+                here->BSIM4v7_86 = CKTstampMat(stamps, here->BSIM4v7BPsbPtr);
+                here->BSIM4v7_87 = CKTstampMat(stamps, here->BSIM4v7BPbpPtr);
+
+                here->BSIM4v7_88 = CKTstampMat(stamps, here->BSIM4v7SBspPtr);
+                here->BSIM4v7_89 = CKTstampMat(stamps, here->BSIM4v7SBbpPtr);
+                here->BSIM4v7_90 = CKTstampMat(stamps, here->BSIM4v7SBbPtr);
+                here->BSIM4v7_91 = CKTstampMat(stamps, here->BSIM4v7SBsbPtr);
+
+                here->BSIM4v7_92 = CKTstampMat(stamps, here->BSIM4v7BdbPtr);
+                here->BSIM4v7_93 = CKTstampMat(stamps, here->BSIM4v7BbpPtr);
+                here->BSIM4v7_94 = CKTstampMat(stamps, here->BSIM4v7BsbPtr);
+                here->BSIM4v7_95 = CKTstampMat(stamps, here->BSIM4v7BbPtr);
+            }
+
+            if (here->BSIM4v7trnqsMod)
+            {   here->BSIM4v7_96 = CKTstampMat(stamps, here->BSIM4v7QqPtr);
+                here->BSIM4v7_97 = CKTstampMat(stamps, here->BSIM4v7QgpPtr);
+                here->BSIM4v7_98 = CKTstampMat(stamps, here->BSIM4v7QdpPtr);
+                here->BSIM4v7_99 = CKTstampMat(stamps, here->BSIM4v7QspPtr);
+                here->BSIM4v7_100 = CKTstampMat(stamps, here->BSIM4v7QbpPtr);
+
+                here->BSIM4v7_101 = CKTstampMat(stamps, here->BSIM4v7DPqPtr);
+                here->BSIM4v7_102 = CKTstampMat(stamps, here->BSIM4v7SPqPtr);
+                here->BSIM4v7_103 = CKTstampMat(stamps, here->BSIM4v7GPqPtr);
+            }
         }
-        /* set the array pointer and instance count into each model */
+        /* set the array pointers and instance count into each model */
         model->BSIM4v7InstCount = InstCount;
         model->BSIM4v7InstanceArray = InstArray;		
+        model->BSIM4v7stamps = stamps;
     }
 #endif
 
@@ -391,122 +391,122 @@ typedef struct sBSIM4v7instance
     double *BSIM4v7SPqPtr;
 
 #ifdef USE_OMP
-    /* per instance storage of results, to update matrix at a later stge */
-    double BSIM4v7rhsdPrime;
-    double BSIM4v7rhsgPrime;
-    double BSIM4v7rhsgExt;
-    double BSIM4v7grhsMid;
-    double BSIM4v7rhsbPrime;
-    double BSIM4v7rhssPrime;
-    double BSIM4v7rhsdb;
-    double BSIM4v7rhssb;
-    double BSIM4v7rhsd;
-    double BSIM4v7rhss;
-    double BSIM4v7rhsq;
-
-    double BSIM4v7_1;
-    double BSIM4v7_2;
-    double BSIM4v7_3;
-    double BSIM4v7_4;
-    double BSIM4v7_5;
-    double BSIM4v7_6;
-    double BSIM4v7_7;
-    double BSIM4v7_8;
-    double BSIM4v7_9;
-    double BSIM4v7_10;
-    double BSIM4v7_11;
-    double BSIM4v7_12;
-    double BSIM4v7_13;
-    double BSIM4v7_14;
-    double BSIM4v7_15;
-    double BSIM4v7_16;
-    double BSIM4v7_17;
-    double BSIM4v7_18;
-    double BSIM4v7_19;
-    double BSIM4v7_20;
-    double BSIM4v7_21;
-    double BSIM4v7_22;
-    double BSIM4v7_23;
-    double BSIM4v7_24;
-    double BSIM4v7_25;
-    double BSIM4v7_26;
-    double BSIM4v7_27;
-    double BSIM4v7_28;
-    double BSIM4v7_29;
-    double BSIM4v7_30;
-    double BSIM4v7_31;
-    double BSIM4v7_32;
-    double BSIM4v7_33;
-    double BSIM4v7_34;
-    double BSIM4v7_35;
-    double BSIM4v7_36;
-    double BSIM4v7_37;
-    double BSIM4v7_38;
-    double BSIM4v7_39;
-    double BSIM4v7_40;
-    double BSIM4v7_41;
-    double BSIM4v7_42;
-    double BSIM4v7_43;
-    double BSIM4v7_44;
-    double BSIM4v7_45;
-    double BSIM4v7_46;
-    double BSIM4v7_47;
-    double BSIM4v7_48;
-    double BSIM4v7_49;
-    double BSIM4v7_50;
-    double BSIM4v7_51;
-    double BSIM4v7_52;
-    double BSIM4v7_53;
-    double BSIM4v7_54;
-    double BSIM4v7_55;
-    double BSIM4v7_56;
-    double BSIM4v7_57;
-    double BSIM4v7_58;
-    double BSIM4v7_59;
-    double BSIM4v7_60;
-    double BSIM4v7_61;
-    double BSIM4v7_62;
-    double BSIM4v7_63;
-    double BSIM4v7_64;
-    double BSIM4v7_65;
-    double BSIM4v7_66;
-    double BSIM4v7_67;
-    double BSIM4v7_68;
-    double BSIM4v7_69;
-    double BSIM4v7_70;
-    double BSIM4v7_71;
-    double BSIM4v7_72;
-    double BSIM4v7_73;
-    double BSIM4v7_74;
-    double BSIM4v7_75;
-    double BSIM4v7_76;
-    double BSIM4v7_77;
-    double BSIM4v7_78;
-    double BSIM4v7_79;
-    double BSIM4v7_80;
-    double BSIM4v7_81;
-    double BSIM4v7_82;
-    double BSIM4v7_83;
-    double BSIM4v7_84;
-    double BSIM4v7_85;
-    double BSIM4v7_86;
-    double BSIM4v7_87;
-    double BSIM4v7_88;
-    double BSIM4v7_89;
-    double BSIM4v7_90;
-    double BSIM4v7_91;
-    double BSIM4v7_92;
-    double BSIM4v7_93;
-    double BSIM4v7_94;
-    double BSIM4v7_95;
-    double BSIM4v7_96;
-    double BSIM4v7_97;
-    double BSIM4v7_98;
-    double BSIM4v7_99;
-    double BSIM4v7_100;
-    double BSIM4v7_101;
-    double BSIM4v7_102;
-    double BSIM4v7_103;
+    /* slots of the results in the model stamp buffer */
+    int BSIM4v7rhsdPrime;
+    int BSIM4v7rhsgPrime;
+    int BSIM4v7rhsgExt;
+    int BSIM4v7grhsMid;
+    int BSIM4v7rhsbPrime;
+    int BSIM4v7rhssPrime;
+    int BSIM4v7rhsdb;
+    int BSIM4v7rhssb;
+    int BSIM4v7rhsd;
+    int BSIM4v7rhss;
+    int BSIM4v7rhsq;
+
+    int BSIM4v7_1;
+    int BSIM4v7_2;
+    int BSIM4v7_3;
+    int BSIM4v7_4;
+    int BSIM4v7_5;
+    int BSIM4v7_6;
+    int BSIM4v7_7;
+    int BSIM4v7_8;
+    int BSIM4v7_9;
+    int BSIM4v7_10;
+    int BSIM4v7_11;
+    int BSIM4v7_12;
+    int BSIM4v7_13;
+    int BSIM4v7_14;
+    int BSIM4v7_15;
+    int BSIM4v7_16;
+    int BSIM4v7_17;
+    int BSIM4v7_18;
+    int BSIM4v7_19;
+    int BSIM4v7_20;
+    int BSIM4v7_21;
+    int BSIM4v7_22;
+    int BSIM4v7_23;
+    int BSIM4v7_24;
+    int BSIM4v7_25;
+    int BSIM4v7_26;
+    int BSIM4v7_27;
+    int BSIM4v7_28;
+    int BSIM4v7_29;
+    int BSIM4v7_30;
+    int BSIM4v7_31;
+    int BSIM4v7_32;
+    int BSIM4v7_33;
+    int BSIM4v7_34;
+    int BSIM4v7_35;
+    int BSIM4v7_36;
+    int BSIM4v7_37;
+    int BSIM4v7_38;
+    int BSIM4v7_39;
+    int BSIM4v7_40;
+    int BSIM4v7_41;
+    int BSIM4v7_42;
+    int BSIM4v7_43;
+    int BSIM4v7_44;
+    int BSIM4v7_45;
+    int BSIM4v7_46;
+    int BSIM4v7_47;
+    int BSIM4v7_48;
+    int BSIM4v7_49;
+    int BSIM4v7_50;
+    int BSIM4v7_51;
+    int BSIM4v7_52;
+    int BSIM4v7_53;
+    int BSIM4v7_54;
+    int BSIM4v7_55;
+    int BSIM4v7_56;
+    int BSIM4v7_57;
+    int BSIM4v7_58;
+    int BSIM4v7_59;
+    int BSIM4v7_60;
+    int BSIM4v7_61;
+    int BSIM4v7_62;
+    int BSIM4v7_63;
+    int BSIM4v7_64;
+    int BSIM4v7_65;
+    int BSIM4v7_66;
+    int BSIM4v7_67;
+    int BSIM4v7_68;
+    int BSIM4v7_69;
+    int BSIM4v7_70;
+    int BSIM4v7_71;
+    int BSIM4v7_72;
+    int BSIM4v7_73;
+    int BSIM4v7_74;
+    int BSIM4v7_75;
+    int BSIM4v7_76;
+    int BSIM4v7_77;
+    int BSIM4v7_78;
+    int BSIM4v7_79;
+    int BSIM4v7_80;
+    int BSIM4v7_81;
+    int BSIM4v7_82;
+    int BSIM4v7_83;
+    int BSIM4v7_84;
+    int BSIM4v7_85;
+    int BSIM4v7_86;
+    int BSIM4v7_87;
+    int BSIM4v7_88;
+    int BSIM4v7_89;
+    int BSIM4v7_90;
+    int BSIM4v7_91;
+    int BSIM4v7_92;
+    int BSIM4v7_93;
+    int BSIM4v7_94;
+    int BSIM4v7_95;
+    int BSIM4v7_96;
+    int BSIM4v7_97;
+    int BSIM4v7_98;
+    int BSIM4v7_99;
+    int BSIM4v7_100;
+    int BSIM4v7_101;
+    int BSIM4v7_102;
+    int BSIM4v7_103;
 #endif
 
 #define BSIM4v7vbd BSIM4v7states+ 0
@@ -1786,6 +1786,7 @@ typedef struct sBSIM4v7model
 #ifdef USE_OMP
     int BSIM4v7InstCount;
     struct sBSIM4v7instance **BSIM4v7InstanceArray;
+    CKTstampBuf *BSIM4v7stamps;
 #endif
 
     /* Flags */
@@ -68,6 +68,8 @@ SPICEdev BSIM4v7info = {
     NULL,          /* DEVdisto       */
     BSIM4v7noise,    /* DEVnoise       */
     BSIM4v7soaCheck, /* DEVsoaCheck    */
+    NULL, /* DEVsnapSave    */
+    NULL, /* DEVsnapLoad    */
 #ifdef CIDER
     NULL,          /* DEVdump        */
     NULL,          /* DEVacct        */
@@ -539,126 +539,126 @@ typedef struct sB4SOIinstance
     double *B4SOIQjdPtr;
 
 #ifdef USE_OMP
-    /* per instance storage of results, to update matrix at a later stge */
+    /* slots of the results in the model stamp buffer */
     int B4SOINode_sh;
-    double B4SOINode_1;
-    double B4SOINode_2;
-    double B4SOINode_3;
-    double B4SOINode_4;
-    double B4SOINode_5;
-    double B4SOINode_6;
-    double B4SOINode_7;
-    double B4SOINode_8;
-    double B4SOINode_9;
-    double B4SOINode_10;
-    double B4SOINode_11;
-    double B4SOINode_12;
-    double B4SOINode_13;
-    double B4SOINode_14;
-    double B4SOINode_15;
-
-    double B4SOI_1;
-    double B4SOI_2;
-    double B4SOI_3;
-    double B4SOI_4;
-    double B4SOI_5;
-    double B4SOI_6;
-    double B4SOI_7;
-    double B4SOI_8;
-    double B4SOI_9;
-    double B4SOI_10;
-    double B4SOI_11;
-    double B4SOI_12;
-    double B4SOI_13;
-    double B4SOI_14;
-    double B4SOI_15;
-    double B4SOI_16;
-    double B4SOI_17;
-    double B4SOI_18;
-    double B4SOI_19;
-    double B4SOI_20;
-    double B4SOI_21;
-    double B4SOI_22;
-    double B4SOI_23;
-    double B4SOI_24;
-    double B4SOI_25;
-    double B4SOI_26;
-    double B4SOI_27;
-    double B4SOI_28;
-    double B4SOI_29;
-    double B4SOI_30;
-    double B4SOI_31;
-    double B4SOI_32;
-    double B4SOI_33;
-    double B4SOI_34;
-    double B4SOI_35;
-    double B4SOI_36;
-    double B4SOI_37;
-    double B4SOI_38;
-    double B4SOI_39;
-    double B4SOI_40;
-    double B4SOI_41;
-    double B4SOI_42;
-    double B4SOI_43;
-    double B4SOI_44;
-    double B4SOI_45;
-    double B4SOI_46;
-    double B4SOI_47;
-    double B4SOI_48;
-    double B4SOI_49;
-    double B4SOI_50;
-    double B4SOI_51;
-    double B4SOI_52;
-    double B4SOI_53;
-    double B4SOI_54;
-    double B4SOI_55;
-    double B4SOI_56;
-    double B4SOI_57;
-    double B4SOI_58;
-    double B4SOI_59;
-    double B4SOI_60;
-    double B4SOI_61;
-    double B4SOI_62;
-    double B4SOI_63;
-    double B4SOI_64;
-    double B4SOI_65;
-    double B4SOI_66;
-    double B4SOI_67;
-    double B4SOI_68;
-    double B4SOI_69;
-    double B4SOI_70;
-    double B4SOI_71;
-    double B4SOI_72;
-    double B4SOI_73;
-    double B4SOI_74;
-    double B4SOI_75;
-    double B4SOI_76;
-    double B4SOI_77;
-    double B4SOI_78;
-    double B4SOI_79;
-    double B4SOI_80;
-    double B4SOI_81;
-    double B4SOI_82;
-    double B4SOI_83;
-    double B4SOI_84;
-    double B4SOI_85;
-    double B4SOI_86;
-    double B4SOI_87;
-    double B4SOI_88;
-    double B4SOI_89;
-    double B4SOI_90;
-    double B4SOI_91;
-    double B4SOI_92;
-    double B4SOI_93;
-    double B4SOI_94;
-    double B4SOI_95;
-    double B4SOI_96;
-    double B4SOI_97;
-    double B4SOI_98;
-    double B4SOI_99;
-    double B4SOI_100;
-    double B4SOI_101;
-    double B4SOI_102;
+    int B4SOINode_1;
+    int B4SOINode_2;
+    int B4SOINode_3;
+    int B4SOINode_4;
+    int B4SOINode_5;
+    int B4SOINode_6;
+    int B4SOINode_7;
+    int B4SOINode_8;
+    int B4SOINode_9;
+    int B4SOINode_10;
+    int B4SOINode_11;
+    int B4SOINode_12;
+    int B4SOINode_13;
+    int B4SOINode_14;
+    int B4SOINode_15;
+
+    int B4SOI_1;
+    int B4SOI_2;
+    int B4SOI_3;
+    int B4SOI_4;
+    int B4SOI_5;
+    int B4SOI_6;
+    int B4SOI_7;
+    int B4SOI_8;
+    int B4SOI_9;
+    int B4SOI_10;
+    int B4SOI_11;
+    int B4SOI_12;
+    int B4SOI_13;
+    int B4SOI_14;
+    int B4SOI_15;
+    int B4SOI_16;
+    int B4SOI_17;
+    int B4SOI_18;
+    int B4SOI_19;
+    int B4SOI_20;
+    int B4SOI_21;
+    int B4SOI_22;
+    int B4SOI_23;
+    int B4SOI_24;
+    int B4SOI_25;
+    int B4SOI_26;
+    int B4SOI_27;
+    int B4SOI_28;
+    int B4SOI_29;
+    int B4SOI_30;
+    int B4SOI_31;
+    int B4SOI_32;
+    int B4SOI_33;
+    int B4SOI_34;
+    int B4SOI_35;
+    int B4SOI_36;
+    int B4SOI_37;
+    int B4SOI_38;
+    int B4SOI_39;
+    int B4SOI_40;
+    int B4SOI_41;
+    int B4SOI_42;
+    int B4SOI_43;
+    int B4SOI_44;
+    int B4SOI_45;
+    int B4SOI_46;
+    int B4SOI_47;
+    int B4SOI_48;
+    int B4SOI_49;
+    int B4SOI_50;
+    int B4SOI_51;
+    int B4SOI_52;
+    int B4SOI_53;
+    int B4SOI_54;
+    int B4SOI_55;
+    int B4SOI_56;
+    int B4SOI_57;
+    int B4SOI_58;
+    int B4SOI_59;
+    int B4SOI_60;
+    int B4SOI_61;
+    int B4SOI_62;
+    int B4SOI_63;
+    int B4SOI_64;
+    int B4SOI_65;
+    int B4SOI_66;
+    int B4SOI_67;
+    int B4SOI_68;
+    int B4SOI_69;
+    int B4SOI_70;
+    int B4SOI_71;
+    int B4SOI_72;
+    int B4SOI_73;
+    int B4SOI_74;
+    int B4SOI_75;
+    int B4SOI_76;
+    int B4SOI_77;
+    int B4SOI_78;
+    int B4SOI_79;
+    int B4SOI_80;
+    int B4SOI_81;
+    int B4SOI_82;
+    int B4SOI_83;
+    int B4SOI_84;
+    int B4SOI_85;
+    int B4SOI_86;
+    int B4SOI_87;
+    int B4SOI_88;
+    int B4SOI_89;
+    int B4SOI_90;
+    int B4SOI_91;
+    int B4SOI_92;
+    int B4SOI_93;
+    int B4SOI_94;
+    int B4SOI_95;
+    int B4SOI_96;
+    int B4SOI_97;
+    int B4SOI_98;
+    int B4SOI_99;
+    int B4SOI_100;
+    int B4SOI_101;
+    int B4SOI_102;
 #endif
 
 #define B4SOIvbd B4SOIstates+ 0
@@ -2141,6 +2141,7 @@ typedef struct sB4SOImodel
 #ifdef USE_OMP
     int B4SOIInstCount;
     struct sB4SOIinstance **B4SOIInstanceArray;
+    CKTstampBuf *B4SOIstamps;
 #endif
 
     /* Flags */
@@ -24,6 +24,14 @@ B4SOIdestroy(GENmodel **inModel)
 {
     B4SOImodel *mod = *(B4SOImodel**) inModel;
 
+#ifdef USE_OMP
+    /* free just once for all models */
+    if (mod) {
+        FREE(mod->B4SOIInstanceArray);
+        CKTstampFree(&mod->B4SOIstamps);
+    }
+#endif
+
     while (mod) {
         B4SOImodel *next_mod = mod->B4SOInextModel;
         B4SOIinstance *inst = mod->B4SOIinstances;
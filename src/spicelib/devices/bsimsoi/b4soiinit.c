@@ -66,6 +66,8 @@ SPICEdev B4SOIinfo = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ B4SOInoise,
  /* DEVsoaCheck   */ B4SOIsoaCheck,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
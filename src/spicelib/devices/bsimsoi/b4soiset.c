@@ -56,6 +56,7 @@ double Vbs0t, Qsi;
 #ifdef USE_OMP
 int idx, InstCount;
 B4SOIinstance **InstArray;
+CKTstampBuf *stamps;
 #endif
 
     /*  loop through all the B4SOI device models */
@@ -2734,8 +2735,14 @@ do { if((here->ptr = SMPmakeElt(matrix,here->first,here->second))==(double *)NUL
             InstCount++;
         }
     }
-    InstArray = TMALLOC(B4SOIinstance*, InstCount);
     model = (B4SOImodel*)inModel;
+    /* a repeated setup replaces the arrays shared by all models */
+    if (model) {
+        FREE(model->B4SOIInstanceArray);
+        CKTstampFree(&model->B4SOIstamps);
+    }
+    InstArray = TMALLOC(B4SOIinstance*, InstCount);
+    stamps = CKTstampNew();
     idx = 0;
     for( ; model != NULL; model = model->B4SOInextModel )
     {
@@ -2745,10 +2752,259 @@ do { if((here->ptr = SMPmakeElt(matrix,here->first,here->second))==(double *)NUL
         { 
             InstArray[idx] = here;
             idx++;
+
+            /* reserve the stamp slots written by B4SOILoadOMP */
+            /* Update b for Ax = b */
+
+            /* v3.1 */
+
+            /* v3.1 added ceqgcrg for RF */
+            here->B4SOINode_1 = CKTstampRhs(stamps, here->B4SOIgNode);
+            /* v3.1 added ceqgcrg for RF end */
+
+            here->B4SOINode_2 = CKTstampRhs(stamps, here->B4SOIdNodePrime);
+            if (!here->B4SOIrbodyMod) {
+                here->B4SOINode_3 = CKTstampRhs(stamps, here->B4SOIsNodePrime); /* v4.0 */
+            }
+            else { /* v4.0 */
+                here->B4SOINode_4 = CKTstampRhs(stamps, here->B4SOIsNodePrime);
+            }
+
+            here->B4SOINode_5 = CKTstampRhs(stamps, here->B4SOIeNode);
+
+            if (here->B4SOIrgateMod == 2)
+                here->B4SOINode_6 = CKTstampRhs(stamps, here->B4SOIgNodeExt);
+            else if (here->B4SOIrgateMod == 3)
+                here->B4SOINode_7 = CKTstampRhs(stamps, here->B4SOIgNodeMid);
+
+            if (here->B4SOIbodyMod == 1) {
+                here->B4SOINode_8 = CKTstampRhs(stamps, here->B4SOIpNode);
+            }
+
+            if ( here->B4SOIsoiMod != 2 )
+            {if (!here->B4SOIrbodyMod)
+                here->B4SOINode_9 = CKTstampRhs(stamps, here->B4SOIbNode);
+                else /* v4.0 */
+                { here->B4SOINode_10 = CKTstampRhs(stamps, here->B4SOIdbNode);
+                    here->B4SOINode_11 = CKTstampRhs(stamps, here->B4SOIbNode);
+                    here->B4SOINode_12 = CKTstampRhs(stamps, here->B4SOIsbNode);
+                }
+            }
+
+            if (here->B4SOINode_sh) {
+                here->B4SOINode_13 = CKTstampRhs(stamps, here->B4SOItempNode);
+            }
+
+            if (model->B4SOIrdsMod)
+            {   here->B4SOINode_14 = CKTstampRhs(stamps, here->B4SOIdNode);
+                here->B4SOINode_15 = CKTstampRhs(stamps, here->B4SOIsNode);
+            }
+
+            if (here->B4SOIrgateMod == 1)
+            {
+                here->B4SOI_1 = CKTstampMat(stamps, here->B4SOIGEgePtr);
+                here->B4SOI_2 = CKTstampMat(stamps, here->B4SOIGgePtr);
+                here->B4SOI_3 = CKTstampMat(stamps, here->B4SOIGEgPtr);
+            }
+            else if (here->B4SOIrgateMod == 2)
+            {
+                here->B4SOI_4 = CKTstampMat(stamps, here->B4SOIGEgePtr);
+                here->B4SOI_5 = CKTstampMat(stamps, here->B4SOIGEgPtr);
+                here->B4SOI_6 = CKTstampMat(stamps, here->B4SOIGEdpPtr);
+                here->B4SOI_7 = CKTstampMat(stamps, here->B4SOIGEspPtr);
+                here->B4SOI_8 = CKTstampMat(stamps, here->B4SOIGgePtr);
+                if (here->B4SOIsoiMod !=2) /* v3.2 */
+                    here->B4SOI_9 = CKTstampMat(stamps, here->B4SOIGEbPtr);
+            }
+            else if (here->B4SOIrgateMod == 3)
+            {
+                here->B4SOI_10 = CKTstampMat(stamps, here->B4SOIGEgePtr);
+                here->B4SOI_11 = CKTstampMat(stamps, here->B4SOIGEgmPtr);
+                here->B4SOI_12 = CKTstampMat(stamps, here->B4SOIGMgePtr);
+                here->B4SOI_13 = CKTstampMat(stamps, here->B4SOIGMgmPtr);
+
+                here->B4SOI_14 = CKTstampMat(stamps, here->B4SOIGMdpPtr);
+                here->B4SOI_15 = CKTstampMat(stamps, here->B4SOIGMgPtr);
+                here->B4SOI_16 = CKTstampMat(stamps, here->B4SOIGMspPtr);
+                here->B4SOI_17 = CKTstampMat(stamps, here->B4SOIGMePtr);
+                if (here->B4SOIsoiMod !=2) /* v3.2 */
+                    here->B4SOI_18 = CKTstampMat(stamps, here->B4SOIGMbPtr);
+
+                here->B4SOI_19 = CKTstampMat(stamps, here->B4SOIDPgmPtr);
+                here->B4SOI_20 = CKTstampMat(stamps, here->B4SOIGgmPtr);
+                here->B4SOI_21 = CKTstampMat(stamps, here->B4SOISPgmPtr);
+                here->B4SOI_22 = CKTstampMat(stamps, here->B4SOIEgmPtr);
+            }
+            /* v3.1 added for RF end*/
+
+            /* v3.0 */
+            if (here->B4SOIsoiMod != 0) /* v3.2 */
+            {
+                here->B4SOI_23 = CKTstampMat(stamps, here->B4SOIDPePtr);
+                here->B4SOI_24 = CKTstampMat(stamps, here->B4SOISPePtr);
+
+                if (here->B4SOIsoiMod != 2) /* v3.2 */
+                {
+                    here->B4SOI_25 = CKTstampMat(stamps, here->B4SOIGePtr);
+                    here->B4SOI_26 = CKTstampMat(stamps, here->B4SOIBePtr);
+                }
+            }
+
+            here->B4SOI_27 = CKTstampMat(stamps, here->B4SOIEdpPtr);
+            here->B4SOI_28 = CKTstampMat(stamps, here->B4SOIEspPtr);
+            here->B4SOI_29 = CKTstampMat(stamps, here->B4SOIDPePtr);
+            here->B4SOI_30 = CKTstampMat(stamps, here->B4SOISPePtr);
+            here->B4SOI_31 = CKTstampMat(stamps, here->B4SOIEgPtr);
+            here->B4SOI_32 = CKTstampMat(stamps, here->B4SOIGePtr);
+
+            /* v3.1 */
+            if (here->B4SOIsoiMod != 2) /* v3.2 */
+            {
+                here->B4SOI_33 = CKTstampMat(stamps, here->B4SOIEbPtr); /* 3.2 bug fix */
+
+                /* v3.1 changed GbPtr for RF */
+                if ((here->B4SOIrgateMod == 0) || (here->B4SOIrgateMod == 1))
+                    here->B4SOI_34 = CKTstampMat(stamps, here->B4SOIGbPtr);
+                else /* v3.1 for rgateMod = 2 or 3 */
+                    here->B4SOI_35 = CKTstampMat(stamps, here->B4SOIGbPtr);
+
+                here->B4SOI_36 = CKTstampMat(stamps, here->B4SOIDPbPtr); /* v4.0 */
+
+                /*                      (*(here->B4SOIDPbPtr) -= (-gddpb - Gmbs + gcdgb + gcddb
+                                        + gcdeb + gcdsb) + gcdgmb
+                                        + gIdtotb );
+                                        */
+
+                here->B4SOI_37 = CKTstampMat(stamps, here->B4SOISPbPtr); /* v4.0 */
+
+                /*                      (*(here->B4SOISPbPtr) -= (-gsspb + Gmbs + gcsgb + gcsdb
+                                        + gcseb + gcssb) + gcsgmb
+                                        + Gmin + gIstotb);
+                                        */
+                here->B4SOI_38 = CKTstampMat(stamps, here->B4SOIBePtr); /* v3.0 */
+                here->B4SOI_39 = CKTstampMat(stamps, here->B4SOIBgPtr);
+                here->B4SOI_40 = CKTstampMat(stamps, here->B4SOIBdpPtr);
+
+                here->B4SOI_41 = CKTstampMat(stamps, here->B4SOIBspPtr);
+                /*                    if (!here->B4SOIrbodyMod)
+                */
+                here->B4SOI_42 = CKTstampMat(stamps, here->B4SOIBbPtr);
+                /*                    else
+                              (*(here->B4SOIBbPtr) += -gigb - (Giib - Gbpbs) - gcbgb
+                              - gcbdb - gcbsb - gcbeb + Gmin) ;
+                              */
+                /* v4.0 */
+                if (here->B4SOIrbodyMod) {
+                    here->B4SOI_43 = CKTstampMat(stamps, here->B4SOIDPdbPtr);
+                    here->B4SOI_44 = CKTstampMat(stamps, here->B4SOISPsbPtr);
+                    here->B4SOI_45 = CKTstampMat(stamps, here->B4SOIDBdpPtr);
+                    here->B4SOI_46 = CKTstampMat(stamps, here->B4SOIDBdbPtr);
+                    here->B4SOI_47 = CKTstampMat(stamps, here->B4SOIDBbPtr);
+                    here->B4SOI_48 = CKTstampMat(stamps, here->B4SOISBspPtr);
+                    here->B4SOI_49 = CKTstampMat(stamps, here->B4SOISBbPtr);
+                    here->B4SOI_50 = CKTstampMat(stamps, here->B4SOISBsbPtr);
+                    here->B4SOI_51 = CKTstampMat(stamps, here->B4SOIBdbPtr);
+                    here->B4SOI_52 = CKTstampMat(stamps, here->B4SOIBsbPtr);
+                    here->B4SOI_53 = CKTstampMat(stamps, here->B4SOIBbPtr);
+                }
+                if (model->B4SOIrdsMod)
+                {
+                    here->B4SOI_54 = CKTstampMat(stamps, here->B4SOIDbPtr);
+                    here->B4SOI_55 = CKTstampMat(stamps, here->B4SOISbPtr);
+                }
+
+            }
+            /* v3.1 */
+            if (model->B4SOIrdsMod)
+            {   here->B4SOI_56 = CKTstampMat(stamps, here->B4SOIDgPtr);
+                here->B4SOI_57 = CKTstampMat(stamps, here->B4SOIDspPtr);
+                here->B4SOI_58 = CKTstampMat(stamps, here->B4SOISdpPtr);
+                here->B4SOI_59 = CKTstampMat(stamps, here->B4SOISgPtr);
+            }
+
+            here->B4SOI_60 = CKTstampMat(stamps, here->B4SOIEePtr);
+
+            if (here->B4SOIrgateMod == 0)
+            {
+                here->B4SOI_61 = CKTstampMat(stamps, here->B4SOIGgPtr);
+                here->B4SOI_62 = CKTstampMat(stamps, here->B4SOIGdpPtr);
+                here->B4SOI_63 = CKTstampMat(stamps, here->B4SOIGspPtr);
+            }
+            else if (here->B4SOIrgateMod == 1) /* v3.1 for RF */
+            {
+                here->B4SOI_64 = CKTstampMat(stamps, here->B4SOIGgPtr);
+                here->B4SOI_65 = CKTstampMat(stamps, here->B4SOIGdpPtr);
+                here->B4SOI_66 = CKTstampMat(stamps, here->B4SOIGspPtr);
+            }
+            else /* v3.1 for RF rgateMod == 2 or 3 */
+            {
+                here->B4SOI_67 = CKTstampMat(stamps, here->B4SOIGgPtr);
+                here->B4SOI_68 = CKTstampMat(stamps, here->B4SOIGdpPtr);
+                here->B4SOI_69 = CKTstampMat(stamps, here->B4SOIGspPtr);
+            }
+
+            here->B4SOI_70 = CKTstampMat(stamps, here->B4SOIDPgPtr); /* v4.0 */
+            here->B4SOI_71 = CKTstampMat(stamps, here->B4SOIDPdpPtr); /* v4.0 */
+            here->B4SOI_72 = CKTstampMat(stamps, here->B4SOIDPspPtr);
+
+            here->B4SOI_73 = CKTstampMat(stamps, here->B4SOIDPdPtr);
+
+            here->B4SOI_74 = CKTstampMat(stamps, here->B4SOISPgPtr); /* v4.0 */
+            here->B4SOI_75 = CKTstampMat(stamps, here->B4SOISPdpPtr); /* v4.0 */
+
+            here->B4SOI_76 = CKTstampMat(stamps, here->B4SOISPspPtr); /* v4.0 */
+
+            here->B4SOI_77 = CKTstampMat(stamps, here->B4SOISPsPtr);
+
+            here->B4SOI_78 = CKTstampMat(stamps, here->B4SOIDdPtr);
+            here->B4SOI_79 = CKTstampMat(stamps, here->B4SOIDdpPtr);
+
+            here->B4SOI_80 = CKTstampMat(stamps, here->B4SOISsPtr);
+            here->B4SOI_81 = CKTstampMat(stamps, here->B4SOISspPtr);
+
+            if (here->B4SOIbodyMod == 1)  {
+                here->B4SOI_82 = CKTstampMat(stamps, here->B4SOIBpPtr);
+                here->B4SOI_83 = CKTstampMat(stamps, here->B4SOIPbPtr);
+                here->B4SOI_84 = CKTstampMat(stamps, here->B4SOIPpPtr);
+            }
+
+            /* v4.1  Ig_agbcp2 stamping */
+            here->B4SOI_85 = CKTstampMat(stamps, here->B4SOIGgPtr); /* FIXME m or not m ?? h_vogt */
+            if (here->B4SOIbodyMod == 1)  {
+                here->B4SOI_86 = CKTstampMat(stamps, here->B4SOIPpPtr);
+                here->B4SOI_87 = CKTstampMat(stamps, here->B4SOIPgPtr);
+                here->B4SOI_88 = CKTstampMat(stamps, here->B4SOIGpPtr);
+            }
+            else if(here->B4SOIbodyMod == 2)
+            {
+                here->B4SOI_89 = CKTstampMat(stamps, here->B4SOIBbPtr);
+                here->B4SOI_90 = CKTstampMat(stamps, here->B4SOIBgPtr);
+                here->B4SOI_91 = CKTstampMat(stamps, here->B4SOIGbPtr);
+            }
+
+            if (here->B4SOINode_sh) /* selfheat */
+            {
+                here->B4SOI_92 = CKTstampMat(stamps, here->B4SOIDPtempPtr);
+                here->B4SOI_93 = CKTstampMat(stamps, here->B4SOISPtempPtr);
+                here->B4SOI_94 = CKTstampMat(stamps, here->B4SOIBtempPtr);
+                here->B4SOI_95 = CKTstampMat(stamps, here->B4SOIEtempPtr);
+                here->B4SOI_96 = CKTstampMat(stamps, here->B4SOIGtempPtr);
+                here->B4SOI_97 = CKTstampMat(stamps, here->B4SOITemptempPtr);
+                here->B4SOI_98 = CKTstampMat(stamps, here->B4SOITempgPtr);
+                here->B4SOI_99 = CKTstampMat(stamps, here->B4SOITempbPtr);
+                here->B4SOI_100 = CKTstampMat(stamps, here->B4SOITempdpPtr);
+                here->B4SOI_101 = CKTstampMat(stamps, here->B4SOITempspPtr);
+
+                /* v3.0 */
+                if (here->B4SOIsoiMod != 0) /* v3.2 */
+                    here->B4SOI_102 = CKTstampMat(stamps, here->B4SOITempePtr);
+
+            }
         }
-        /* set the array pointer and instance count into each model */
+        /* set the array pointers and instance count into each model */
         model->B4SOIInstCount = InstCount;
         model->B4SOIInstanceArray = InstArray;		
+        model->B4SOIstamps = stamps;
     }
 #endif
 
@@ -21,6 +21,7 @@
 #include "ngspice/ngspice.h"
 #include "ngspice/smpdefs.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
 #include "b4soidef.h"
 #include "ngspice/const.h"
 #include "ngspice/sperror.h"
@@ -63,6 +64,8 @@ B4SOItemp(
     double Inv_saref, Inv_sbref, Inv_sa, Inv_sb, rho, dvth0_lod;
     double W_tmp, Inv_ODeff, OD_offset, dk2_lod, deta0_lod, kvsat;
     int Size_Not_Found, i;
+    DEVsizeCache *sizeCache;
+    double sizeKey[5];
     double PowWeffWr, T10; /*v4.0 */
     double Vtm0eot, Vtmeot,vbieot,phieot,sqrtphieot,vddeot;
     double Vgs_eff,Vgsteff, V0, Vth,Vgst;
@@ -82,6 +85,8 @@ B4SOItemp(
     double epsrox, toxe, epssub;
 
 
+    sizeCache = DEVsizeCacheReset(ckt);
+
     /*  loop through all the B4SOI device models */
     for (; model != NULL; model = model->B4SOInextModel)
     {    Temp = ckt->CKTtemp;
@@ -165,23 +170,16 @@ B4SOItemp(
         {
             here->B4SOIrbodyext = here->B4SOIbodySquares *
                 model->B4SOIrbsh;
-            pSizeDependParamKnot = model->pSizeDependParamKnot;
-            Size_Not_Found = 1;
-            while ((pSizeDependParamKnot != NULL) && Size_Not_Found)
-            {
-                if ((here->B4SOIl == pSizeDependParamKnot->Length)
-                        && (here->B4SOIw == pSizeDependParamKnot->Width)
-                        && (here->B4SOIrth0 == pSizeDependParamKnot->Rth0)
-                        && (here->B4SOIcth0 == pSizeDependParamKnot->Cth0)
-                        && (here->B4SOInf == pSizeDependParamKnot->NFinger)) /*4.0*/
-                {   Size_Not_Found = 0;
-                    here->pParam = pSizeDependParamKnot;
-                    pParam = here->pParam; /* v2.2.3 bug fix */
-                }
-                else
-                {   pLastKnot = pSizeDependParamKnot;
-                    pSizeDependParamKnot = pSizeDependParamKnot->pNext;
-                }
+            sizeKey[0] = here->B4SOIl;
+            sizeKey[1] = here->B4SOIw;
+            sizeKey[2] = here->B4SOIrth0;
+            sizeKey[3] = here->B4SOIcth0;
+            sizeKey[4] = here->B4SOInf;
+            pSizeDependParamKnot = DEVsizeFind(sizeCache, model, sizeKey, 5);
+            Size_Not_Found = (pSizeDependParamKnot == NULL);
+            if (!Size_Not_Found)
+            {   here->pParam = pSizeDependParamKnot;
+                pParam = here->pParam; /* v2.2.3 bug fix */
             }
 
             if (Size_Not_Found)
@@ -193,6 +191,8 @@ B4SOItemp(
                 pLastKnot->pNext = pParam;
             pParam->pNext = NULL;
             here->pParam = pParam;
+            pLastKnot = pParam;
+            DEVsizeAdd(sizeCache, model, sizeKey, 5, pLastKnot);
 
             Ldrn = here->B4SOIl;
             Wdrn = here->B4SOIw / here->B4SOInf; /* v4.0 */
@@ -67,6 +67,8 @@ SPICEdev CAPinfo = {
  /* DEVdisto      */ NULL,	/* DISTO */
  /* DEVnoise      */ NULL,	/* NOISE */
  /* DEVsoaCheck   */ CAPsoaCheck,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
@@ -67,6 +67,8 @@ SPICEdev CCCSinfo = {
  /* DEVdisto      */ NULL,	/* DISTO */
  /* DEVnoise      */ NULL,	/* NOISE */
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
@@ -70,6 +70,8 @@ SPICEdev CSWinfo = {
  /* DEVdisto      */ NULL,	/* DISTO */
  /* DEVnoise      */ CSWnoise,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
@@ -0,0 +1,185 @@
+/* Hashed lookup of size dependent parameter sets.
+ *
+ * The BSIM family of models keeps one size dependent parameter set for
+ * every distinct instance geometry of a model, chained from
+ * model->pSizeDependParamKnot.  The temperature routines used to walk
+ * this chain for every instance, which costs instances times geometries.
+ * A DEVsizeCache indexes the sets of all models by (model, key), where
+ * the key is the exact tuple the model compares (L, W, NF, ...).  The
+ * circuit owns one cache, which every temperature routine empties with
+ * DEVsizeCacheReset() before it rebuilds the parameter sets.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/devdefs.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/suffix.h"
+
+
+typedef struct {
+    void *model;
+    double key[DEV_SIZE_MAXKEY];
+    void *param;
+    int next;
+} DEVsizeEntry;
+
+struct sDEVsizeCache {
+    CKTcircuit *ckt;
+    DEVsizeEntry *entries;
+    int count;
+    int size;
+    int *buckets;
+    int mask;
+};
+
+
+static unsigned int
+DEVsizeHash(void *model, const double *key, int n)
+{
+    unsigned int hash = 2166136261u;
+    unsigned char *p;
+    size_t i;
+    int k;
+
+    p = (unsigned char *) &model;
+    for (i = 0; i < sizeof(model); i++)
+        hash = (hash ^ p[i]) * 16777619u;
+
+    for (k = 0; k < n; k++) {
+        /* fold -0.0 onto 0.0, they compare equal */
+        double x = key[k] + 0.0;
+        p = (unsigned char *) &x;
+        for (i = 0; i < sizeof(x); i++)
+            hash = (hash ^ p[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+
+static void
+DEVsizeRehash(DEVsizeCache *cache, int nbuckets)
+{
+    int i;
+
+    tfree(cache->buckets);
+    cache->buckets = TMALLOC(int, nbuckets);
+    cache->mask = nbuckets - 1;
+
+    for (i = 0; i < nbuckets; i++)
+        cache->buckets[i] = -1;
+
+    for (i = 0; i < cache->count; i++) {
+        DEVsizeEntry *e = &cache->entries[i];
+        unsigned int h = DEVsizeHash(e->model, e->key, DEV_SIZE_MAXKEY) &
+            (unsigned int) cache->mask;
+        e->next = cache->buckets[h];
+        cache->buckets[h] = i;
+    }
+}
+
+
+/* return the cache of 'ckt', emptied for a new pass of a temperature
+ * routine
+ */
+
+DEVsizeCache *
+DEVsizeCacheReset(CKTcircuit *ckt)
+{
+    DEVsizeCache *cache = ckt->CKTsizeCache;
+    int i;
+
+    if (!cache) {
+        cache = ckt->CKTsizeCache = TMALLOC(DEVsizeCache, 1);
+        cache->ckt = ckt;
+        DEVsizeRehash(cache, 64);
+        return cache;
+    }
+
+    cache->count = 0;
+    for (i = 0; i <= cache->mask; i++)
+        cache->buckets[i] = -1;
+
+    return cache;
+}
+
+
+void
+DEVsizeCacheFree(DEVsizeCache **pcache)
+{
+    DEVsizeCache *cache = *pcache;
+
+    if (!cache)
+        return;
+
+    tfree(cache->entries);
+    tfree(cache->buckets);
+    tfree(*pcache);
+}
+
+
+/* return the parameter set stored for 'model' and the 'n' values of
+ * 'key', or NULL if there is none yet
+ */
+
+void *
+DEVsizeFind(DEVsizeCache *cache, void *model, const double *key, int n)
+{
+    double k[DEV_SIZE_MAXKEY];
+    unsigned int h;
+    int i;
+
+    for (i = 0; i < DEV_SIZE_MAXKEY; i++)
+        k[i] = (i < n) ? key[i] : 0.0;
+
+    h = DEVsizeHash(model, k, DEV_SIZE_MAXKEY) & (unsigned int) cache->mask;
+
+    for (i = cache->buckets[h]; i >= 0; i = cache->entries[i].next) {
+        DEVsizeEntry *e = &cache->entries[i];
+        int j;
+
+        if (e->model != model)
+            continue;
+        for (j = 0; j < DEV_SIZE_MAXKEY; j++)
+            if (e->key[j] != k[j])
+                break;
+        if (j == DEV_SIZE_MAXKEY) {
+            cache->ckt->CKTstat->STATsizeHits++;
+            return e->param;
+        }
+    }
+
+    cache->ckt->CKTstat->STATsizeMisses++;
+
+    return NULL;
+}
+
+
+/* store 'param' for 'model' and 'key', after DEVsizeFind() failed */
+
+void
+DEVsizeAdd(DEVsizeCache *cache, void *model, const double *key, int n,
+           void *param)
+{
+    DEVsizeEntry *e;
+    unsigned int h;
+    int i;
+
+    if (cache->count >= cache->size) {
+        cache->size = cache->size ? 2 * cache->size : 64;
+        cache->entries = TREALLOC(DEVsizeEntry, cache->entries, cache->size);
+    }
+
+    e = &cache->entries[cache->count];
+    e->model = model;
+    for (i = 0; i < DEV_SIZE_MAXKEY; i++)
+        e->key[i] = (i < n) ? key[i] : 0.0;
+    e->param = param;
+
+    h = DEVsizeHash(model, e->key, DEV_SIZE_MAXKEY) & (unsigned int) cache->mask;
+    e->next = cache->buckets[h];
+    cache->buckets[h] = cache->count++;
+
+    if (cache->count > 2 * (cache->mask + 1))
+        DEVsizeRehash(cache, 4 * (cache->mask + 1));
+}
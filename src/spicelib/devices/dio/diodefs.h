@@ -44,6 +44,12 @@ typedef struct sDIOinstance {
 
     double DIOcap;   /* stores the diode capacitance */
 
+#ifdef USE_OMP
+    /* first of the 7 matrix and 2 rhs slots in the model stamp buffer */
+    int DIOmatSlot;
+    int DIOrhsSlot;
+#endif
+
     double *DIOsens; /* stores the perturbed values of geq and ceq in ac
                          sensitivity analyis */
 
@@ -277,6 +283,12 @@ typedef struct sDIOmodel {       /* model structure for a diode */
     double DIOfv_max; /* maximum voltage in forward direction */
     double DIObv_max; /* maximum voltage in reverse direction */
 
+#ifdef USE_OMP
+    int DIOInstCount;
+    struct sDIOinstance **DIOInstanceArray;
+    CKTstampBuf *DIOstamps;
+#endif
+
 } DIOmodel;
 
 /* device parameters */
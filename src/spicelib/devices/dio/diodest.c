@@ -13,6 +13,14 @@ DIOdestroy(GENmodel **inModel)
 {
     DIOmodel *mod = *(DIOmodel**) inModel;
 
+#ifdef USE_OMP
+    /* free just once for all models */
+    if (mod) {
+        FREE(mod->DIOInstanceArray);
+        CKTstampFree(&mod->DIOstamps);
+    }
+#endif
+
     while (mod) {
         DIOmodel *next_mod = mod->DIOnextModel;
         DIOinstance *inst = mod->DIOinstances;
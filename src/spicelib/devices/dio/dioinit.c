@@ -69,6 +69,8 @@ SPICEdev DIOinfo = {
  /* DEVdisto      */ DIOdisto,
  /* DEVnoise      */ DIOnoise,
  /* DEVsoaCheck   */ DIOsoaCheck,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
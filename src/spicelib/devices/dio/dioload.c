@@ -14,14 +14,43 @@ Modified by Paolo Nenzi 2003 and Dietmar Warning 2012
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
 
+#ifdef USE_OMP
+int DIOLoadOMP(DIOinstance *here, CKTcircuit *ckt);
+#endif
+
 int
 DIOload(GENmodel *inModel, CKTcircuit *ckt)
         /* actually load the current resistance value into the
          * sparse matrix previously provided
          */
 {
+#ifdef USE_OMP
+    int idx;
+    DIOmodel *model = (DIOmodel*)inModel;
+    int error = 0;
+    DIOinstance **InstArray;
+    InstArray = model->DIOInstanceArray;
+
+#pragma omp parallel for
+    for (idx = 0; idx < model->DIOInstCount; idx++) {
+        DIOinstance *here = InstArray[idx];
+        int local_error = DIOLoadOMP(here, ckt);
+        if (local_error)
+            error = local_error;
+    }
+
+    CKTstampLoad(model->DIOstamps, ckt);
+
+    return error;
+}
+
+
+int DIOLoadOMP(DIOinstance *here, CKTcircuit *ckt) {
+    DIOmodel *model = here->DIOmodPtr;
+#else
     DIOmodel *model = (DIOmodel*)inModel;
     DIOinstance *here;
+#endif
     double arg;
     double argsw;
     double capd;
@@ -62,12 +91,26 @@ DIOload(GENmodel *inModel, CKTcircuit *ckt)
     int SenCond=0;    /* sensitivity condition */
     double diffcharge, diffchargeSW, deplcharge, deplchargeSW, diffcap, diffcapSW, deplcap, deplcapSW;
 
+#ifdef USE_OMP
+    double *rhsStamp = model->DIOstamps->rhsVal + here->DIOrhsSlot;
+    double *matStamp = model->DIOstamps->matVal + here->DIOmatSlot;
+    int i;
+
+    /* the bodies of the model and instance loops below are run once
+     * for 'here'; 'continue' leaves this do-while without a stamp */
+    rhsStamp[0] = rhsStamp[1] = 0.0;
+    for (i = 0; i < 7; i++)
+        matStamp[i] = 0.0;
+    do {
+        do {
+#else
     /*  loop through all the diode models */
     for( ; model != NULL; model = model->DIOnextModel ) {
 
         /* loop through all the instances of the model */
         for (here = model->DIOinstances; here != NULL ;
                 here=here->DIOnextInstance) {
+#endif
 
             /*
              *     this routine loads diodes for dc and transient analyses.
@@ -397,6 +440,9 @@ next1:      if (model->DIOsatSWCurGiven) {              /* sidewall current */
              */
             if ( (!(ckt->CKTmode & MODEINITFIX)) || (!(here->DIOoff))  ) {
                 if (Check == 1)  {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
                     ckt->CKTnoncon++;
                     ckt->CKTtroubleElt = (GENinstance *) here;
                 }
@@ -414,6 +460,19 @@ next2:      *(ckt->CKTstate0 + here->DIOvoltage) = vd;
              *   load current vector
              */
             cdeq=cd-gd*vd;
+#ifdef USE_OMP
+            rhsStamp[0] = cdeq;
+            rhsStamp[1] = -cdeq;
+            matStamp[0] = gspr;
+            matStamp[1] = gd;
+            matStamp[2] = gd + gspr;
+            matStamp[3] = -gspr;
+            matStamp[4] = -gd;
+            matStamp[5] = -gspr;
+            matStamp[6] = -gd;
+        } while (0);
+    } while (0);
+#else
             *(ckt->CKTrhs + here->DIOnegNode) += cdeq;
             *(ckt->CKTrhs + here->DIOposPrimeNode) -= cdeq;
             /*
@@ -428,5 +487,6 @@ next2:      *(ckt->CKTstate0 + here->DIOvoltage) = vd;
             *(here->DIOposPrimeNegPtr) -= gd;
         }
     }
+#endif
     return(OK);
 }
@@ -24,6 +24,12 @@ DIOsetup(SMPmatrix *matrix, GENmodel *inModel, CKTcircuit *ckt, int *states)
     int error;
     CKTnode *tmp;
 
+#ifdef USE_OMP
+    int idx, InstCount;
+    DIOinstance **InstArray;
+    CKTstampBuf *stamps;
+#endif
+
     /*  loop through all the diode models */
     for( ; model != NULL; model = model->DIOnextModel ) {
 
@@ -238,6 +244,50 @@ do { if((here->ptr = SMPmakeElt(matrix, here->first, here->second)) == NULL){\
             TSTALLOC(DIOposPrimePosPrimePtr,DIOposPrimeNode,DIOposPrimeNode);
         }
     }
+
+#ifdef USE_OMP
+    InstCount = 0;
+    model = (DIOmodel*)inModel;
+    /* loop through all the diode models
+       to count the number of instances */
+    for( ; model != NULL; model = model->DIOnextModel ) {
+        for (here = model->DIOinstances; here != NULL ;
+                here=here->DIOnextInstance) {
+            InstCount++;
+        }
+    }
+    model = (DIOmodel*)inModel;
+    /* a repeated setup replaces the arrays shared by all models */
+    if (model) {
+        FREE(model->DIOInstanceArray);
+        CKTstampFree(&model->DIOstamps);
+    }
+    InstArray = TMALLOC(DIOinstance*, InstCount);
+    stamps = CKTstampNew();
+    idx = 0;
+    for( ; model != NULL; model = model->DIOnextModel ) {
+        for (here = model->DIOinstances; here != NULL ;
+                here=here->DIOnextInstance) {
+            InstArray[idx] = here;
+            idx++;
+            /* same order as the stamps of the serial DIOload */
+            here->DIOrhsSlot = CKTstampRhs(stamps, here->DIOnegNode);
+            CKTstampRhs(stamps, here->DIOposPrimeNode);
+            here->DIOmatSlot = CKTstampMat(stamps, here->DIOposPosPtr);
+            CKTstampMat(stamps, here->DIOnegNegPtr);
+            CKTstampMat(stamps, here->DIOposPrimePosPrimePtr);
+            CKTstampMat(stamps, here->DIOposPosPrimePtr);
+            CKTstampMat(stamps, here->DIOnegPosPrimePtr);
+            CKTstampMat(stamps, here->DIOposPrimePosPtr);
+            CKTstampMat(stamps, here->DIOposPrimeNegPtr);
+        }
+        /* set the array pointers and instance count into each model */
+        model->DIOInstCount = InstCount;
+        model->DIOInstanceArray = InstArray;
+        model->DIOstamps = stamps;
+    }
+#endif
+
     return(OK);
 }
 
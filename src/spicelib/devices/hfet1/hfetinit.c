@@ -68,6 +68,8 @@ SPICEdev HFETAinfo = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ NULL,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
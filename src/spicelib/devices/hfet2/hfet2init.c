@@ -68,6 +68,8 @@ SPICEdev HFET2info = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ NULL,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
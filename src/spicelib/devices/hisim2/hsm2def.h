@@ -553,77 +553,77 @@ typedef struct sHSM2instance {
   double *HSM2BbPtr;   /* pointer to sparse matrix element at (bulk node,bulk node) */
 
 #ifdef USE_OMP
-    /* per instance storage of results, to update matrix and rhs at a later stage */
-    double HSM2rhsdPrime;
-    double HSM2rhsgPrime;
-    double HSM2rhsbPrime;
-    double HSM2rhssPrime;
-    double HSM2rhsdb;
-    double HSM2rhssb;
-
-    double HSM2_1;
-    double HSM2_2;
-    double HSM2_3;
-    double HSM2_4;
-    double HSM2_5;
-    double HSM2_6;
-    double HSM2_7;
-    double HSM2_8;
-    double HSM2_9;
-    double HSM2_10;
-    double HSM2_11;
-    double HSM2_12;
-    double HSM2_13;
-    double HSM2_14;
-    double HSM2_15;
-    double HSM2_16;
-    double HSM2_17;
-    double HSM2_18;
-    double HSM2_19;
-    double HSM2_20;
-    double HSM2_21;
-    double HSM2_22;
-    double HSM2_23;
-    double HSM2_24;
-    double HSM2_25;
-    double HSM2_26;
-    double HSM2_27;
-    double HSM2_28;
-    double HSM2_29;
-    double HSM2_30;
-    double HSM2_31;
-    double HSM2_32;
-    double HSM2_33;
-    double HSM2_34;
-    double HSM2_35;
-    double HSM2_36;
-    double HSM2_37;
-    double HSM2_38;
-    double HSM2_39;
-    double HSM2_40;
-    double HSM2_41;
-    double HSM2_42;
-    double HSM2_43;
-    double HSM2_44;
-    double HSM2_45;
-    double HSM2_46;
-    double HSM2_47;
-    double HSM2_48;
-    double HSM2_49;
-    double HSM2_50;
-    double HSM2_51;
-    double HSM2_52;
-    double HSM2_53;
-    double HSM2_54;
-    double HSM2_55;
-    double HSM2_56;
-    double HSM2_57;
-    double HSM2_58;
-    double HSM2_59;
-    double HSM2_60;
-    double HSM2_61;
-    double HSM2_62;
-    double HSM2_63;
+    /* slots of the results in the model stamp buffer */
+    int HSM2rhsdPrime;
+    int HSM2rhsgPrime;
+    int HSM2rhsbPrime;
+    int HSM2rhssPrime;
+    int HSM2rhsdb;
+    int HSM2rhssb;
+
+    int HSM2_1;
+    int HSM2_2;
+    int HSM2_3;
+    int HSM2_4;
+    int HSM2_5;
+    int HSM2_6;
+    int HSM2_7;
+    int HSM2_8;
+    int HSM2_9;
+    int HSM2_10;
+    int HSM2_11;
+    int HSM2_12;
+    int HSM2_13;
+    int HSM2_14;
+    int HSM2_15;
+    int HSM2_16;
+    int HSM2_17;
+    int HSM2_18;
+    int HSM2_19;
+    int HSM2_20;
+    int HSM2_21;
+    int HSM2_22;
+    int HSM2_23;
+    int HSM2_24;
+    int HSM2_25;
+    int HSM2_26;
+    int HSM2_27;
+    int HSM2_28;
+    int HSM2_29;
+    int HSM2_30;
+    int HSM2_31;
+    int HSM2_32;
+    int HSM2_33;
+    int HSM2_34;
+    int HSM2_35;
+    int HSM2_36;
+    int HSM2_37;
+    int HSM2_38;
+    int HSM2_39;
+    int HSM2_40;
+    int HSM2_41;
+    int HSM2_42;
+    int HSM2_43;
+    int HSM2_44;
+    int HSM2_45;
+    int HSM2_46;
+    int HSM2_47;
+    int HSM2_48;
+    int HSM2_49;
+    int HSM2_50;
+    int HSM2_51;
+    int HSM2_52;
+    int HSM2_53;
+    int HSM2_54;
+    int HSM2_55;
+    int HSM2_56;
+    int HSM2_57;
+    int HSM2_58;
+    int HSM2_59;
+    int HSM2_60;
+    int HSM2_61;
+    int HSM2_62;
+    int HSM2_63;
 #endif
 
   /* common state values in hisim module */
@@ -1277,6 +1277,7 @@ typedef struct sHSM2model {       	/* model structure for a resistor */
 #ifdef USE_OMP
     int HSM2InstCount;
     struct sHSM2instance **HSM2InstanceArray;
+    CKTstampBuf *HSM2stamps;
 #endif
 
   /* flag for model */
@@ -67,6 +67,7 @@ HSM2destroy(GENmodel **inModel)
 #ifdef USE_OMP
     /* free just once for all models */
     FREE(mod->HSM2InstanceArray);
+    CKTstampFree(&mod->HSM2stamps);
 #endif
 
     while (mod) {
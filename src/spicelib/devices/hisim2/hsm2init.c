@@ -66,6 +66,8 @@ SPICEdev HSM2info = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ HSM2noise,
  /* DEVsoaCheck   */ HSM2soaCheck,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
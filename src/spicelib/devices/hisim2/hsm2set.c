@@ -117,6 +117,7 @@ int HSM2setup(
 #ifdef USE_OMP
   int idx, InstCount;
   HSM2instance **InstArray;
+  CKTstampBuf *stamps;
 #endif
 
   /*  loop through all the HSM2 device models */
@@ -1276,8 +1277,14 @@ do { if((here->ptr = SMPmakeElt(matrix,here->first,here->second))==(double *)NUL
             InstCount++;
         }
     }
-    InstArray = TMALLOC(HSM2instance*, InstCount);
     model = (HSM2model*)inModel;
+    /* a repeated setup replaces the arrays shared by all models */
+    if (model) {
+        FREE(model->HSM2InstanceArray);
+        CKTstampFree(&model->HSM2stamps);
+    }
+    InstArray = TMALLOC(HSM2instance*, InstCount);
+    stamps = CKTstampNew();
     idx = 0;
     for ( ; model != NULL; model = model->HSM2nextModel )
     {
@@ -1287,10 +1294,118 @@ do { if((here->ptr = SMPmakeElt(matrix,here->first,here->second))==(double *)NUL
         {
             InstArray[idx] = here;
             idx++;
+
+            /* reserve the stamp slots written by HSM2LoadOMP */
+            /* Update b for Ax = b */
+            here->HSM2rhsdPrime = CKTstampRhs(stamps, here->HSM2dNodePrime);
+            here->HSM2rhsgPrime = CKTstampRhs(stamps, here->HSM2gNodePrime);
+
+            if ( !here->HSM2_corbnet ) {
+              here->HSM2rhsbPrime = CKTstampRhs(stamps, here->HSM2bNodePrime);
+              here->HSM2rhssPrime = CKTstampRhs(stamps, here->HSM2sNodePrime);
+            } else {
+              here->HSM2rhsdb = CKTstampRhs(stamps, here->HSM2dbNode);
+              here->HSM2rhsbPrime = CKTstampRhs(stamps, here->HSM2bNodePrime);
+              here->HSM2rhssb = CKTstampRhs(stamps, here->HSM2sbNode);
+              here->HSM2rhssPrime = CKTstampRhs(stamps, here->HSM2sNodePrime);
+            }
+
+            /* Update A for Ax = b */
+            if (here->HSM2_corg == 1) {
+             here->HSM2_1 = CKTstampMat(stamps, here->HSM2GgPtr);
+             here->HSM2_2 = CKTstampMat(stamps, here->HSM2GPgPtr);
+             here->HSM2_3 = CKTstampMat(stamps, here->HSM2GgpPtr);
+             here->HSM2_4 = CKTstampMat(stamps, here->HSM2GPgpPtr);
+             here->HSM2_5 = CKTstampMat(stamps, here->HSM2GPdpPtr);
+             here->HSM2_6 = CKTstampMat(stamps, here->HSM2GPspPtr);
+             here->HSM2_7 = CKTstampMat(stamps, here->HSM2GPbpPtr);
+            } else {
+             here->HSM2_8 = CKTstampMat(stamps, here->HSM2GPgpPtr);
+             here->HSM2_9 = CKTstampMat(stamps, here->HSM2GPdpPtr);
+             here->HSM2_10 = CKTstampMat(stamps, here->HSM2GPspPtr);
+             here->HSM2_11 = CKTstampMat(stamps, here->HSM2GPbpPtr);
+            }
+
+            here->HSM2_12 = CKTstampMat(stamps, here->HSM2DPdpPtr);
+
+            here->HSM2_13 = CKTstampMat(stamps, here->HSM2DPdPtr);
+            here->HSM2_14 = CKTstampMat(stamps, here->HSM2DPgpPtr);
+            here->HSM2_15 = CKTstampMat(stamps, here->HSM2DPspPtr);
+            here->HSM2_16 = CKTstampMat(stamps, here->HSM2DPbpPtr);
+
+            here->HSM2_17 = CKTstampMat(stamps, here->HSM2DdpPtr);
+            here->HSM2_18 = CKTstampMat(stamps, here->HSM2DdPtr);
+
+            here->HSM2_19 = CKTstampMat(stamps, here->HSM2SPdpPtr);
+            here->HSM2_20 = CKTstampMat(stamps, here->HSM2SPgpPtr);
+            here->HSM2_21 = CKTstampMat(stamps, here->HSM2SPspPtr);
+
+            here->HSM2_22 = CKTstampMat(stamps, here->HSM2SPsPtr);
+            here->HSM2_23 = CKTstampMat(stamps, here->HSM2SPbpPtr);
+
+            here->HSM2_24 = CKTstampMat(stamps, here->HSM2SspPtr);
+            here->HSM2_25 = CKTstampMat(stamps, here->HSM2SsPtr);
+
+            here->HSM2_26 = CKTstampMat(stamps, here->HSM2BPdpPtr);
+            here->HSM2_27 = CKTstampMat(stamps, here->HSM2BPgpPtr);
+            here->HSM2_28 = CKTstampMat(stamps, here->HSM2BPspPtr);
+            here->HSM2_29 = CKTstampMat(stamps, here->HSM2BPbpPtr);
+
+            if (model->HSM2_cogidl) {
+             /* stamp GIDL */
+             here->HSM2_30 = CKTstampMat(stamps, here->HSM2DPdpPtr);
+             here->HSM2_31 = CKTstampMat(stamps, here->HSM2DPgpPtr);
+             here->HSM2_32 = CKTstampMat(stamps, here->HSM2DPspPtr);
+
+             here->HSM2_33 = CKTstampMat(stamps, here->HSM2DPbpPtr);
+             here->HSM2_34 = CKTstampMat(stamps, here->HSM2BPdpPtr);
+             here->HSM2_35 = CKTstampMat(stamps, here->HSM2BPgpPtr);
+             here->HSM2_36 = CKTstampMat(stamps, here->HSM2BPspPtr);
+
+             here->HSM2_37 = CKTstampMat(stamps, here->HSM2BPbpPtr);
+             /* stamp GISL */
+             here->HSM2_38 = CKTstampMat(stamps, here->HSM2SPdpPtr);
+
+             here->HSM2_39 = CKTstampMat(stamps, here->HSM2SPgpPtr);
+             here->HSM2_40 = CKTstampMat(stamps, here->HSM2SPspPtr);
+             here->HSM2_41 = CKTstampMat(stamps, here->HSM2SPbpPtr);
+             here->HSM2_42 = CKTstampMat(stamps, here->HSM2BPdpPtr);
+
+             here->HSM2_43 = CKTstampMat(stamps, here->HSM2BPgpPtr);
+             here->HSM2_44 = CKTstampMat(stamps, here->HSM2BPspPtr);
+             here->HSM2_45 = CKTstampMat(stamps, here->HSM2BPbpPtr);
+            }
+
+            if (here->HSM2_corbnet) { /* body resistance network */
+             here->HSM2_46 = CKTstampMat(stamps, here->HSM2DPdbPtr);
+             here->HSM2_47 = CKTstampMat(stamps, here->HSM2SPsbPtr);
+
+             here->HSM2_48 = CKTstampMat(stamps, here->HSM2DBdpPtr);
+             here->HSM2_49 = CKTstampMat(stamps, here->HSM2DBdbPtr);
+
+             here->HSM2_50 = CKTstampMat(stamps, here->HSM2DBbpPtr);
+             here->HSM2_51 = CKTstampMat(stamps, here->HSM2DBbPtr);
+
+             here->HSM2_52 = CKTstampMat(stamps, here->HSM2BPdbPtr);
+             here->HSM2_53 = CKTstampMat(stamps, here->HSM2BPbPtr);
+             here->HSM2_54 = CKTstampMat(stamps, here->HSM2BPsbPtr);
+             here->HSM2_55 = CKTstampMat(stamps, here->HSM2BPbpPtr);
+
+             here->HSM2_56 = CKTstampMat(stamps, here->HSM2SBspPtr);
+             here->HSM2_57 = CKTstampMat(stamps, here->HSM2SBbpPtr);
+             here->HSM2_58 = CKTstampMat(stamps, here->HSM2SBbPtr);
+             here->HSM2_59 = CKTstampMat(stamps, here->HSM2SBsbPtr);
+
+             here->HSM2_60 = CKTstampMat(stamps, here->HSM2BdbPtr);
+             here->HSM2_61 = CKTstampMat(stamps, here->HSM2BbpPtr);
+             here->HSM2_62 = CKTstampMat(stamps, here->HSM2BsbPtr);
+             here->HSM2_63 = CKTstampMat(stamps, here->HSM2BbPtr);
+            }
         }
-        /* set the array pointer and instance count into each model */
+        /* set the array pointers and instance count into each model */
         model->HSM2InstCount = InstCount;
         model->HSM2InstanceArray = InstArray;
+        model->HSM2stamps = stamps;
     }
 #endif
 
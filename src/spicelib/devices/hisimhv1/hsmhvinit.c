@@ -66,6 +66,8 @@ SPICEdev HSMHVinfo = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ HSMHVnoise,
  /* DEVsoaCheck   */ HSMHVsoaCheck,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
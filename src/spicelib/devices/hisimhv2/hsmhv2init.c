@@ -66,6 +66,8 @@ SPICEdev HSMHV2info = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ HSMHV2noise,
  /* DEVsoaCheck   */ HSMHV2soaCheck,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
@@ -68,6 +68,8 @@ SPICEdev JFETinfo = {
  /* DEVdisto      */ JFETdisto,
  /* DEVnoise      */ JFETnoise,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
@@ -68,6 +68,8 @@ SPICEdev JFET2info = {
  /* DEVdisto      */ NULL, /* AN_disto */
  /* DEVnoise      */ JFET2noise,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
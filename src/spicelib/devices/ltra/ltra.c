@@ -50,6 +50,10 @@ IFparm LTRAmPTable[] = {	/* model parameters */
       "use N-R iterations for step calculation in LTRAtrunc"),
   IOPU("truncdontcut", LTRA_MOD_TRUNCDONTCUT, IF_FLAG,
       "don't limit timestep to keep impulse response calculation errors low"),
+  IOPU("recursive", LTRA_MOD_RECURSIVE, IF_FLAG,
+      "use recursive convolution with fitted exponentials (RLC lines)"),
+  IOPU("horizon", LTRA_MOD_HORIZON, IF_REAL,
+      "history kept for full convolution, from the tolerances if not given"),
   IOPAU("compactrel", LTRA_MOD_STLINEREL, IF_REAL,
       "special reltol for straight line checking"),
   IOPAU("compactabs", LTRA_MOD_STLINEABS, IF_REAL,
@@ -9,6 +9,85 @@ Author: 1990 Jaijeet S. Roychowdhury
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
 
+/*
+ * LTRAtrimHistory - drop the timepoints that no line can need any more
+ * from the lists of all LTRA lines. Timepoint 0 is kept, the initial
+ * values are measured from it. The lists are slid down only once the
+ * dropped part is as long as the rest, so the work per accepted point
+ * stays constant while the lists stop growing.
+ */
+
+static void
+LTRAtrimHistory(CKTcircuit *ckt, LTRAmodel *model)
+{
+  LTRAmodel *mod;
+  LTRAinstance *here;
+  double *timelist = ckt->CKTtimePoints;
+  int index = ckt->CKTtimeIndex;
+  double tkeep, tmod, horizon;
+  int lo, hi, mid, first, shift;
+  size_t count;
+
+  tkeep = timelist[index];
+  for (mod = model; mod != NULL; mod = mod->LTRAnextModel) {
+    switch (mod->LTRAspecialCase) {
+
+    case LTRA_MOD_RG:
+      continue;
+
+    case LTRA_MOD_LC:
+      tmod = timelist[index] - mod->LTRAtd;
+      break;
+
+    default:
+      if (mod->LTRApoleCount > 0)
+	tmod = timelist[mod->LTRArecDelIndex];
+      else {
+	horizon = mod->LTRAhorizonGiven ? mod->LTRAhorizon :
+	    LTRAautoHorizon(ckt, (GENmodel *) mod);
+	if (horizon <= 0.0)
+	  return;		/* full convolution over all of the past */
+	tmod = timelist[index] - MAX(horizon, mod->LTRAtd);
+      }
+      break;
+    }
+    tkeep = MIN(tkeep, tmod);
+  }
+
+  /* the last timepoint not after tkeep, less two for interpolation */
+  lo = 0;
+  hi = index;
+  while (lo < hi) {
+    mid = (lo + hi + 1) / 2;
+    if (timelist[mid] <= tkeep)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  first = lo - 2;
+
+  shift = first - 1;
+  if ((shift < 16) || (shift < index - first + 1))
+    return;
+
+  count = (size_t) (index - first + 1) * sizeof(double);
+  memmove(timelist + 1, timelist + first, count);
+  for (mod = model; mod != NULL; mod = mod->LTRAnextModel) {
+    for (here = mod->LTRAinstances; here != NULL;
+	here = here->LTRAnextInstance) {
+      memmove(here->LTRAv1 + 1, here->LTRAv1 + first, count);
+      memmove(here->LTRAi1 + 1, here->LTRAi1 + first, count);
+      memmove(here->LTRAv2 + 1, here->LTRAv2 + first, count);
+      memmove(here->LTRAi2 + 1, here->LTRAi2 + first, count);
+    }
+    if (mod->LTRApoleCount > 0) {
+      mod->LTRArecDelIndex -= shift;
+      mod->LTRArecStepIndex = -1;
+    }
+  }
+  ckt->CKTtimeIndex -= shift;
+}
+
 int
 LTRAaccept(CKTcircuit *ckt, GENmodel *inModel)
 {
@@ -31,11 +110,21 @@ LTRAaccept(CKTcircuit *ckt, GENmodel *inModel)
 	a = TMALLOC(double, b);
 
       model->LTRAmodelListSize = 10;
+      model->LTRAtailCount = 0;
+      model->LTRAmaxDevVolt = 0.0;
+      model->LTRAmaxDevCur = 0.0;
 
 
       LTRAmemMANAGE(model->LTRAh1dashCoeffs, model->LTRAmodelListSize)
 	  LTRAmemMANAGE(model->LTRAh2Coeffs, model->LTRAmodelListSize)
 	  LTRAmemMANAGE(model->LTRAh3dashCoeffs, model->LTRAmodelListSize)
+
+      if (model->LTRArecursive && (model->LTRAspecialCase == LTRA_MOD_RLC) &&
+	  !ckt->CKTtryToCompact &&
+	  LTRArlcFitSetup((GENmodel *) model, MAX(ckt->CKTfinalTime, 10.0 * model->LTRAtd)))
+	SPfrontEnd->IFerrorf (ERR_WARNING,
+	    "%s: impulse responses could not be fitted, using full convolution",
+	    model->LTRAmodName);
     }
     if (ckt->CKTtimeIndex >= model->LTRAmodelListSize) {	/* need more space */
       model->LTRAmodelListSize += ckt->CKTsizeIncr;
@@ -83,6 +172,15 @@ LTRAaccept(CKTcircuit *ckt, GENmodel *inModel)
       *(here->LTRAi2 + ckt->CKTtimeIndex) = *(ckt->CKTrhsOld +
 	  here->LTRAbrEq2);
 
+      model->LTRAmaxDevVolt = MAX(model->LTRAmaxDevVolt,
+	  fabs(*(here->LTRAv1 + ckt->CKTtimeIndex) - here->LTRAinitVolt1));
+      model->LTRAmaxDevVolt = MAX(model->LTRAmaxDevVolt,
+	  fabs(*(here->LTRAv2 + ckt->CKTtimeIndex) - here->LTRAinitVolt2));
+      model->LTRAmaxDevCur = MAX(model->LTRAmaxDevCur,
+	  fabs(*(here->LTRAi1 + ckt->CKTtimeIndex) - here->LTRAinitCur1));
+      model->LTRAmaxDevCur = MAX(model->LTRAmaxDevCur,
+	  fabs(*(here->LTRAi2 + ckt->CKTtimeIndex) - here->LTRAinitCur2));
+
       if (ckt->CKTtryToCompact && (ckt->CKTtimeIndex >= 2)) {
 
 	/*
@@ -258,6 +356,9 @@ LTRAaccept(CKTcircuit *ckt, GENmodel *inModel)
       /* ask TQ } */
 
     }				/* instance */
+
+    if (model->LTRApoleCount > 0)
+      LTRArecAccept(ckt, (GENmodel *) model);
   }				/* model */
 
 
@@ -290,5 +391,8 @@ LTRAaccept(CKTcircuit *ckt, GENmodel *inModel)
     fflush(stdout);
 #endif
   }
+
+  LTRAtrimHistory(ckt, (LTRAmodel *) inModel);
+
   return (OK);
 }
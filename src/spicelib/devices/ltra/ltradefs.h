@@ -42,6 +42,13 @@ typedef struct sLTRAinstance {
     double *LTRAi2;     /* past values of i2 */
     int LTRAinstListSize; /* size of above lists */
 
+    double *LTRAv1Rec;  /* recursive convolution states, one per pole of */
+    double *LTRAv2Rec;  /* the model: v1, v2 at the last timepoint, */
+    double *LTRAv1DelRec; /* v1, v2, i1, i2 at the model's */
+    double *LTRAv2DelRec; /* LTRArecDelIndex; all six point */
+    double *LTRAi1DelRec; /* into the block of LTRAv1Rec */
+    double *LTRAi2DelRec;
+
     double *LTRAibr1Ibr1Ptr;     /* pointer to sparse matrix */
     double *LTRAibr1Ibr2Ptr;     /* pointer to sparse matrix */
     double *LTRAibr1Pos1Ptr;     /* pointer to sparse matrix */
@@ -120,6 +127,34 @@ typedef struct sLTRAmodel {       /* model structure for a transmission lines */
     double *LTRAh3dashCoeffs; /* list of other coefficients for h3dash */
     int LTRAmodelListSize; /* size of above lists */
 
+    int LTRApoleCount;   /* number of exponentials fitted to the impulse
+                            responses, 0 if convolving the full history */
+    double *LTRApoles;   /* their decay rates; the arrays below point
+                            into this block */
+    double *LTRAh1dashResidues; /* h1dash(t) = sum res * exp(-pole t) */
+    double *LTRAh2Residues;     /* h2(T+t), likewise */
+    double *LTRAh3dashResidues; /* h3dash(T+t), likewise */
+    double *LTRArecDecay;   /* exp(-pole delta) and the weight of the */
+    double *LTRArecWeight;  /* older end, from the last timepoint to now */
+    double *LTRArecDelDecay;  /* the same from LTRAauxIndex to */
+    double *LTRArecDelWeight; /* now - LTRAtd */
+    double *LTRArecStepDecay;   /* the same, plus the weight of the */
+    double *LTRArecStepWeight0; /* newer end, between timepoints */
+    double *LTRArecStepWeight1; /* LTRArecStepIndex and the next one */
+    double *LTRArecScratch; /* delayed states advanced to LTRAauxIndex */
+    int LTRArecStepIndex;
+    int LTRArecDelIndex; /* timepoint of the delayed states */
+
+    int LTRAtailCount;   /* number of ages in the table below, 0 if not
+                            set up yet */
+    double *LTRAtailAge; /* ages of the history; the arrays below point
+                            into this block */
+    double *LTRAtailVolt; /* current from the voltage kernels past that
+                             age, per volt */
+    double *LTRAtailCur;  /* current from h2 past that age, per ampere */
+    double LTRAmaxDevVolt; /* largest change of a port voltage so far */
+    double LTRAmaxDevCur;  /* largest change of a port current so far */
+
     double LTRAconduct;  /* conductance G  - input */
     double LTRAresist;   /* resistance R  - input */
     double LTRAinduct;   /* inductance L - input */
@@ -157,7 +192,11 @@ typedef struct sLTRAmodel {       /* model structure for a transmission lines */
     unsigned LTRAabstolGiven:1;  /* flag to ind. absolute deriv. tol. given */
 	unsigned LTRAtruncNR:1; /* flag to ind. use N-R iterations for calculating step in LTRAtrunc */
 	unsigned LTRAtruncDontCut:1; /* flag to ind. don't bother about errors in impulse response calculations due to large steps*/
+	unsigned LTRArecursive:1; /* flag to ind. use recursive convolution with fitted exponentials */
 	double LTRAmaxSafeStep; /* maximum safe step for impulse response calculations */
+	double LTRAhorizon; /* history kept for full convolution, from the
+				tolerances if not given */
+	unsigned LTRAhorizonGiven:1; /* flag to ind. horizon given */
     unsigned LTRAresistGiven : 1; /* flag to indicate R was specified */
     unsigned LTRAconductGiven : 1; /* flag to indicate G was specified */
     unsigned LTRAinductGiven : 1; /* flag to indicate L was specified */
@@ -230,6 +269,8 @@ typedef struct sLTRAmodel {       /* model structure for a transmission lines */
 #define LTRA_MOD_CHOPABS 45
 #define LTRA_MOD_TRUNCNR 46
 #define LTRA_MOD_TRUNCDONTCUT	47
+#define LTRA_MOD_RECURSIVE 48
+#define LTRA_MOD_HORIZON 49
 
 
 
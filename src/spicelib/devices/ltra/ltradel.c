@@ -21,6 +21,7 @@ LTRAdelete(GENmodel *inModel, IFuid name, GENinstance **kill)
     for (here = *prev; here; here = *prev) {
       if (here->LTRAname == name || (fast && here == *fast)) {
 	*prev = here->LTRAnextInstance;
+	FREE(here->LTRAv1Rec);
 	FREE(here);
 	return (OK);
       }
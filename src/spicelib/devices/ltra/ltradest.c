@@ -18,9 +18,12 @@ LTRAdestroy(GENmodel **inModel)
         LTRAinstance *inst = mod->LTRAinstances;
         while (inst) {
             LTRAinstance *next_inst = inst->LTRAnextInstance;
+            FREE(inst->LTRAv1Rec);
             FREE(inst);
             inst = next_inst;
         }
+        FREE(mod->LTRApoles);
+        FREE(mod->LTRAtailAge);
         FREE(mod);
         mod = next_mod;
     }
@@ -16,6 +16,8 @@ extern int LTRAmDelete(GENmodel**,IFuid,GENmodel*);
 extern int LTRAparam(int,IFvalue*,GENinstance*,IFvalue*);
 extern int LTRAmParam(int,IFvalue*,GENmodel*);
 extern int LTRAsetup(SMPmatrix*,GENmodel*,CKTcircuit*,int*);
+extern void LTRAsnapSave(GENmodel*,CKTcircuit*,CKTsnap*);
+extern int LTRAsnapLoad(GENmodel*,CKTcircuit*,CKTsnap*,int);
 extern int LTRAunsetup(GENmodel*,CKTcircuit*);
 extern int LTRAtemp(GENmodel*,CKTcircuit*);
 extern int LTRAtrunc(GENmodel*,CKTcircuit*,double*);
@@ -44,3 +46,10 @@ extern double LTRAh3dashCoeffSetup(double*,int,double,double,double,double*,int,
 extern void LTRArcCoeffsSetup(double*,double*,double*,double*,double*,double*,int,double,double,double,double*,int,double);
 extern void LTRArlcCoeffsSetup(double*,double*,double*,double*,double*,double*,int,double,double,double,double,double*,int,double,int*);
 extern int LTRAstraightLineCheck(double,double,double,double,double,double,double,double);
+extern int LTRArlcFitSetup(GENmodel*,double);
+extern void LTRArecAlloc(GENmodel*,int);
+extern void LTRArecInstAlloc(GENinstance*,int);
+extern void LTRArecAccept(CKTcircuit*,GENmodel*);
+extern void LTRArecSetup(CKTcircuit*,GENmodel*);
+extern double LTRAautoHorizon(CKTcircuit*,GENmodel*);
+extern void LTRArecConvolve(CKTcircuit*,GENmodel*,GENinstance*,int,double*,double*,double*,double*,double*,double*);
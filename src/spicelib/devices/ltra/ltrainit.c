@@ -68,6 +68,8 @@ SPICEdev LTRAinfo = {
  /* DEVdisto      */ NULL,	/* disto */
  /* DEVnoise      */ NULL,	/* noise */
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ LTRAsnapSave,
+ /* DEVsnapLoad   */ LTRAsnapLoad,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
@@ -28,6 +28,8 @@ LTRAload(GENmodel *inModel, CKTcircuit *ckt)
   unsigned tdover = 0;
   int i;
   double max = 0.0, min = 0.0;
+  double recH1v1 = 0.0, recH1v2 = 0.0, recH2i2 = 0.0, recH2i1 = 0.0;
+  double recH3v2 = 0.0, recH3v1 = 0.0;
 
   /* loop through all the transmission line models */
   for (; model != NULL; model = model->LTRAnextModel) {
@@ -113,15 +115,32 @@ LTRAload(GENmodel *inModel, CKTcircuit *ckt)
 	   * all together in one procedure
 	   */
 
-	  (void)
-	      LTRArlcCoeffsSetup(&(model->LTRAh1dashFirstCoeff),
-	      &(model->LTRAh2FirstCoeff),
-	      &(model->LTRAh3dashFirstCoeff),
-	      model->LTRAh1dashCoeffs, model->LTRAh2Coeffs,
-	      model->LTRAh3dashCoeffs, model->LTRAmodelListSize,
-	      model->LTRAtd, model->LTRAalpha, model->LTRAbeta,
-	      ckt->CKTtime, ckt->CKTtimePoints, ckt->CKTtimeIndex,
-	      model->LTRAchopReltol, &(model->LTRAauxIndex));
+	  /*
+	   * with recursive convolution only the first coefficients are
+	   * needed, the states of the instances stand for the rest
+	   */
+
+	  if (model->LTRApoleCount > 0) {
+	    (void)
+		LTRArlcCoeffsSetup(&(model->LTRAh1dashFirstCoeff),
+		&(model->LTRAh2FirstCoeff),
+		&(model->LTRAh3dashFirstCoeff),
+		NULL, NULL, NULL, 0,
+		model->LTRAtd, model->LTRAalpha, model->LTRAbeta,
+		ckt->CKTtime, ckt->CKTtimePoints, ckt->CKTtimeIndex,
+		model->LTRAchopReltol, &(model->LTRAauxIndex));
+	    LTRArecSetup(ckt, (GENmodel *) model);
+	  } else {
+	    (void)
+		LTRArlcCoeffsSetup(&(model->LTRAh1dashFirstCoeff),
+		&(model->LTRAh2FirstCoeff),
+		&(model->LTRAh3dashFirstCoeff),
+		model->LTRAh1dashCoeffs, model->LTRAh2Coeffs,
+		model->LTRAh3dashCoeffs, model->LTRAmodelListSize,
+		model->LTRAtd, model->LTRAalpha, model->LTRAbeta,
+		ckt->CKTtime, ckt->CKTtimePoints, ckt->CKTtimeIndex,
+		model->LTRAchopReltol, &(model->LTRAauxIndex));
+	  }
 
 
 	case LTRA_MOD_LC:
@@ -599,15 +618,25 @@ LTRAload(GENmodel *inModel, CKTcircuit *ckt)
 	    /* convolution of h1dash with v1 and v2 */
 	    /* the matrix has already been loaded above */
 
+	    if (model->LTRApoleCount > 0)
+	      LTRArecConvolve(ckt, (GENmodel *) model, (GENinstance *) here, (int) tdover,
+		  &recH1v1, &recH1v2, &recH2i2, &recH2i1,
+		  &recH3v2, &recH3v1);
+
 	    dummy1 = dummy2 = 0.0;
-	    for (i = /* model->LTRAh1dashIndex */ ckt->CKTtimeIndex; i > 0; i--) {
-	      if (*(model->LTRAh1dashCoeffs + i) != 0.0) {
-		dummy1 += *(model->LTRAh1dashCoeffs
-		    + i) * (*(here->LTRAv1 + i) -
-		    here->LTRAinitVolt1);
-		dummy2 += *(model->LTRAh1dashCoeffs
-		    + i) * (*(here->LTRAv2 + i) -
-		    here->LTRAinitVolt2);
+	    if (model->LTRApoleCount > 0) {
+	      dummy1 = recH1v1;
+	      dummy2 = recH1v2;
+	    } else {
+	      for (i = /* model->LTRAh1dashIndex */ ckt->CKTtimeIndex; i > 0; i--) {
+		if (*(model->LTRAh1dashCoeffs + i) != 0.0) {
+		  dummy1 += *(model->LTRAh1dashCoeffs
+		      + i) * (*(here->LTRAv1 + i) -
+		      here->LTRAinitVolt1);
+		  dummy2 += *(model->LTRAh1dashCoeffs
+		      + i) * (*(here->LTRAv2 + i) -
+		      here->LTRAinitVolt2);
+		}
 	      }
 	    }
 
@@ -640,15 +669,20 @@ LTRAload(GENmodel *inModel, CKTcircuit *ckt)
 
 	      /* the rest of the convolution */
 
-	      for (i = /* model->LTRAh2Index */ model->LTRAauxIndex; i > 0; i--) {
-
-		if (*(model->LTRAh2Coeffs + i) != 0.0) {
-		  dummy1 += *(model->LTRAh2Coeffs
-		      + i) * (*(here->LTRAi2 + i) -
-		      here->LTRAinitCur2);
-		  dummy2 += *(model->LTRAh2Coeffs
-		      + i) * (*(here->LTRAi1 + i) -
-		      here->LTRAinitCur1);
+	      if (model->LTRApoleCount > 0) {
+		dummy1 += recH2i2;
+		dummy2 += recH2i1;
+	      } else {
+		for (i = /* model->LTRAh2Index */ model->LTRAauxIndex; i > 0; i--) {
+
+		  if (*(model->LTRAh2Coeffs + i) != 0.0) {
+		    dummy1 += *(model->LTRAh2Coeffs
+			+ i) * (*(here->LTRAi2 + i) -
+			here->LTRAinitCur2);
+		    dummy2 += *(model->LTRAh2Coeffs
+			+ i) * (*(here->LTRAi1 + i) -
+			here->LTRAinitCur1);
+		  }
 		}
 	      }
 	    }
@@ -678,14 +712,19 @@ LTRAload(GENmodel *inModel, CKTcircuit *ckt)
 
 	      /* the rest of the convolution */
 
-	      for (i = /* model->LTRAh3dashIndex */ model->LTRAauxIndex; i > 0; i--) {
-		if (*(model->LTRAh3dashCoeffs + i) != 0.0) {
-		  dummy1 += *(model->LTRAh3dashCoeffs
-		      + i) * (*(here->LTRAv2 + i) -
-		      here->LTRAinitVolt2);
-		  dummy2 += *(model->LTRAh3dashCoeffs
-		      + i) * (*(here->LTRAv1 + i) -
-		      here->LTRAinitVolt1);
+	      if (model->LTRApoleCount > 0) {
+		dummy1 += recH3v2;
+		dummy2 += recH3v1;
+	      } else {
+		for (i = /* model->LTRAh3dashIndex */ model->LTRAauxIndex; i > 0; i--) {
+		  if (*(model->LTRAh3dashCoeffs + i) != 0.0) {
+		    dummy1 += *(model->LTRAh3dashCoeffs
+			+ i) * (*(here->LTRAv2 + i) -
+			here->LTRAinitVolt2);
+		    dummy2 += *(model->LTRAh3dashCoeffs
+			+ i) * (*(here->LTRAv1 + i) -
+			here->LTRAinitVolt1);
+		  }
 		}
 	      }
 	    }
@@ -49,6 +49,12 @@ LTRAmAsk(CKTcircuit *ckt, GENmodel *inModel, int param, IFvalue *value)
   case LTRA_MOD_TRUNCDONTCUT:
     value->iValue = mods->LTRAtruncDontCut;
     break;
+  case LTRA_MOD_RECURSIVE:
+    value->iValue = mods->LTRArecursive;
+    break;
+  case LTRA_MOD_HORIZON:
+    value->rValue = mods->LTRAhorizon;
+    break;
   case LTRA_MOD_R:
     value->rValue = mods->LTRAresist;
     break;
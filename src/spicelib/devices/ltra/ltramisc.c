@@ -685,6 +685,12 @@ LTRArlcCoeffsSetup(double *h1dashfirstcoeff, double *h2firstcoeff, double *h3das
   *h1dashfirstcoeff = h1dummy1;
   h1relval = fabs(h1dummy1 * reltol);
 
+  /* recursive convolution needs only the first coefficients */
+
+  if (h1dashcoeffs == NULL) {
+    *auxindexptr = auxindex;
+    return;
+  }
 
   /* the coefficients for the rest of the timepoints */
 
@@ -767,6 +773,662 @@ LTRArlcCoeffsSetup(double *h1dashfirstcoeff, double *h2firstcoeff, double *h3das
   *auxindexptr = auxindex;
 }
 
+/*
+ * Recursive convolution for RLC lines
+ *
+ * h1dash(t), h2(T+t) and h3dash(T+t) are fitted to sums of exponentials
+ * sum_k res_k * exp(-pole_k t) over one set of logarithmically spaced
+ * poles, with the integral of each fit forced to the exact one. The
+ * convolution of such a sum with a piecewise linear waveform u is
+ * sum_k res_k * s_k, where s_k(t) = int exp(-pole_k (t-s)) u(s) ds obeys
+ *
+ *   s_k(t+h) = exp(-pole_k h) s_k(t) + w0_k(h) u(t) + w1_k(h) u(t+h)
+ *
+ * so the load needs one state per pole instead of the whole history.
+ * u is the deviation of a terminal variable from its initial value.
+ */
+
+#define LTRA_REC_PER_DECADE 5
+#define LTRA_REC_MAXPOLES 80
+#define LTRA_REC_TOL 1.0e-3
+
+/* e^{-x} I_0(x) and e^{-x} I_1(x) for x >= 0, free of overflow */
+
+static double
+bessI0scaled(double x)
+{
+  double y;
+
+  if (x < 3.75)
+    return (exp(-x) * bessI0(x));
+
+  y = 3.75 / x;
+  return ((0.39894228 + y * (0.1328592e-1
+	    + y * (0.225319e-2 + y * (-0.157565e-2 + y * (0.916281e-2
+			+ y * (-0.2057706e-1 + y * (0.2635537e-1 + y * (-0.1647633e-1
+				    + y * 0.392377e-2)))))))) / sqrt(x));
+}
+
+static double
+bessI1scaled(double x)
+{
+  double y, ans;
+
+  if (x < 3.75)
+    return (exp(-x) * bessI1(x));
+
+  y = 3.75 / x;
+  ans = 0.2282967e-1 + y * (-0.2895312e-1 + y * (0.1787654e-1
+	  - y * 0.420059e-2));
+  ans = 0.39894228 + y * (-0.3988024e-1 + y * (-0.362018e-2
+	  + y * (0.163801e-2 + y * (-0.1031555e-1 + y * ans))));
+  return (ans / sqrt(x));
+}
+
+/*
+ * the kernel 'which' (0: h1dash, 1: h2, 2: h3dash) at time t after its
+ * onset; unlike LTRArlcH1dashFunc() and friends these stay finite for
+ * large alpha * t
+ */
+
+static double
+LTRArecKernel(int which, double t, double T, double alpha, double beta)
+{
+  double x;
+
+  if (which == 0) {
+    x = alpha * t;
+    return (alpha * exp((alpha - beta) * t) *
+	(bessI1scaled(x) - bessI0scaled(x)));
+  }
+
+  x = alpha * sqrt(t * (t + 2.0 * T));
+  t += T;
+
+  if (which == 1) {
+    if (x < 3.75)
+      return (alpha * alpha * T * exp(-beta * t) * bessI1xOverX(x));
+    return (alpha * alpha * T * exp(x - beta * t) * bessI1scaled(x) / x);
+  }
+
+  if (x < 3.75)
+    return (alpha * exp(-beta * t) *
+	(alpha * t * bessI1xOverX(x) - bessI0(x)));
+  return (alpha * exp(x - beta * t) *
+      (alpha * t * bessI1scaled(x) / x - bessI0scaled(x)));
+}
+
+/*
+ * LTRArecLeastSquares - least squares solution x of the m by n system
+ * a x = b by Householder QR; a is stored by columns, a and b are
+ * overwritten. Returns 1 if a is rank deficient.
+ */
+
+static int
+LTRArecLeastSquares(double *a, double *b, int m, int n, double *x)
+{
+  double norm, sum, *ak, *aj;
+  int i, j, k;
+
+  for (k = 0; k < n; k++) {
+    ak = a + k * m;
+
+    norm = 0.0;
+    for (i = k; i < m; i++)
+      norm += ak[i] * ak[i];
+    norm = sqrt(norm);
+    if (norm == 0.0)
+      return (1);
+    if (ak[k] > 0.0)
+      norm = -norm;
+
+    for (i = k; i < m; i++)
+      ak[i] /= -norm;
+    ak[k] += 1.0;
+
+    for (j = k + 1; j < n; j++) {
+      aj = a + j * m;
+      sum = 0.0;
+      for (i = k; i < m; i++)
+	sum += ak[i] * aj[i];
+      sum /= -ak[k];
+      for (i = k; i < m; i++)
+	aj[i] += sum * ak[i];
+    }
+
+    sum = 0.0;
+    for (i = k; i < m; i++)
+      sum += ak[i] * b[i];
+    sum /= -ak[k];
+    for (i = k; i < m; i++)
+      b[i] += sum * ak[i];
+
+    ak[k] = norm;
+  }
+
+  for (k = n - 1; k >= 0; k--) {
+    sum = b[k];
+    for (j = k + 1; j < n; j++)
+      sum -= a[j * m + k] * x[j];
+    x[k] = sum / a[k * m + k];
+  }
+  return (0);
+}
+
+/*
+ * LTRArecAlloc - allocate the poles of 'genmodel' for n poles, and lay
+ * out the arrays pointing into their block
+ */
+
+void
+LTRArecAlloc(GENmodel *genmodel, int n)
+{
+  LTRAmodel *model = (LTRAmodel *) genmodel;
+
+  FREE(model->LTRApoles);
+  model->LTRApoles = TMALLOC(double, 15 * n);
+  model->LTRAh1dashResidues = model->LTRApoles + n;
+  model->LTRAh2Residues = model->LTRApoles + 2 * n;
+  model->LTRAh3dashResidues = model->LTRApoles + 3 * n;
+  model->LTRArecDecay = model->LTRApoles + 4 * n;
+  model->LTRArecWeight = model->LTRApoles + 5 * n;
+  model->LTRArecDelDecay = model->LTRApoles + 6 * n;
+  model->LTRArecDelWeight = model->LTRApoles + 7 * n;
+  model->LTRArecStepDecay = model->LTRApoles + 8 * n;
+  model->LTRArecStepWeight0 = model->LTRApoles + 9 * n;
+  model->LTRArecStepWeight1 = model->LTRApoles + 10 * n;
+  model->LTRArecScratch = model->LTRApoles + 11 * n;
+}
+
+/*
+ * LTRArecInstAlloc - allocate the cleared recursive convolution states
+ * of an instance for n poles
+ */
+
+void
+LTRArecInstAlloc(GENinstance *geninstance, int n)
+{
+  LTRAinstance *here = (LTRAinstance *) geninstance;
+
+  FREE(here->LTRAv1Rec);
+  here->LTRAv1Rec = TMALLOC(double, 6 * n);
+  here->LTRAv2Rec = here->LTRAv1Rec + n;
+  here->LTRAv1DelRec = here->LTRAv1Rec + 2 * n;
+  here->LTRAv2DelRec = here->LTRAv1Rec + 3 * n;
+  here->LTRAi1DelRec = here->LTRAv1Rec + 4 * n;
+  here->LTRAi2DelRec = here->LTRAv1Rec + 5 * n;
+}
+
+/*
+ * LTRArlcFitSetup - fit the impulse responses of an RLC line over
+ * [0, tmax] for recursive convolution. Sets LTRApoleCount and returns 0,
+ * or returns 1 if the fit is not accurate enough to be used.
+ */
+
+int
+LTRArlcFitSetup(GENmodel *genmodel, double tmax)
+{
+  LTRAmodel *model = (LTRAmodel *) genmodel;
+  double T = model->LTRAtd;
+  double alpha = model->LTRAalpha, beta = model->LTRAbeta;
+  double integral[3], *residues[3];
+  double *a, *b, *s;
+  double plo, phi, slo, logstep, rowweight, intweight;
+  double f, g, gmax, err, t;
+  int n, m, i, j, k, which, error = 0;
+
+  model->LTRApoleCount = 0;
+  FREE(model->LTRApoles);
+
+  if (alpha <= 0.0 || tmax <= 0.0)
+    return (1);
+
+  integral[0] = model->LTRAintH1dash;
+  integral[1] = model->LTRAintH2;
+  integral[2] = model->LTRAintH3dash;
+
+  /*
+   * the slowest pole follows the tail up to tmax, the fastest resolves
+   * the onset of the kernels
+   */
+
+  plo = 0.2 / tmax;
+  phi = 50.0 * (alpha + alpha * alpha * T);
+  if (phi < 10.0 * plo)
+    phi = 10.0 * plo;
+
+  n = (int) ceil(log10(phi / plo) * LTRA_REC_PER_DECADE) + 1;
+  if (n > LTRA_REC_MAXPOLES)
+    n = LTRA_REC_MAXPOLES;
+  m = 8 * n + 1;
+
+  LTRArecAlloc(genmodel, n);
+
+  residues[0] = model->LTRAh1dashResidues;
+  residues[1] = model->LTRAh2Residues;
+  residues[2] = model->LTRAh3dashResidues;
+
+  for (k = 0; k < n; k++)
+    model->LTRApoles[k] = plo * pow(phi / plo, (double) k / (n - 1));
+
+  /*
+   * samples at t = 0 and logarithmically spaced up to tmax, weighted by
+   * the square root of the interval each one stands for
+   */
+
+  slo = 0.01 / phi;
+  logstep = log(tmax / slo) / (m - 2);
+  s = TMALLOC(double, m);
+  s[0] = 0.0;
+  for (j = 1; j < m; j++)
+    s[j] = slo * exp(logstep * (j - 1));
+
+  a = TMALLOC(double, (m + 1) * n);
+  b = TMALLOC(double, m + 1);
+  intweight = 1.0e2 * sqrt(phi);
+
+  for (which = 0; which < 3; which++) {
+
+    for (j = 0; j < m; j++) {
+      rowweight = sqrt(j ? s[j] * logstep : slo);
+      for (k = 0; k < n; k++)
+	a[k * (m + 1) + j] = rowweight * exp(-model->LTRApoles[k] * s[j]);
+      b[j] = rowweight * LTRArecKernel(which, s[j], T, alpha, beta);
+    }
+
+    /* the last row forces the integral of the fit */
+    for (k = 0; k < n; k++)
+      a[k * (m + 1) + m] = intweight / model->LTRApoles[k];
+    b[m] = intweight * integral[which];
+
+    if (LTRArecLeastSquares(a, b, m + 1, n, residues[which])) {
+      error = 1;
+      break;
+    }
+
+    /* check the fit between the samples */
+    gmax = err = 0.0;
+    for (j = 0; j < 4 * m; j++) {
+      t = j ? slo * exp(0.25 * logstep * (j - 1)) : 0.0;
+      g = LTRArecKernel(which, t, T, alpha, beta);
+      f = 0.0;
+      for (i = 0; i < n; i++)
+	f += residues[which][i] * exp(-model->LTRApoles[i] * t);
+      gmax = MAX(gmax, fabs(g));
+      err = MAX(err, fabs(f - g));
+    }
+    if (err > LTRA_REC_TOL * gmax) {
+      error = 1;
+      break;
+    }
+  }
+
+  FREE(s);
+  FREE(a);
+  FREE(b);
+
+  if (error) {
+    FREE(model->LTRApoles);
+    return (1);
+  }
+
+  model->LTRApoleCount = n;
+  model->LTRArecStepIndex = -1;
+  return (0);
+}
+
+/*
+ * LTRArecWeights - decay of the states and weights of the older (w0)
+ * and newer (w1) end of a linear segment of length delta; w1 may be NULL
+ */
+
+static void
+LTRArecWeights(double *poles, int n, double delta, double *decay, double *w0, double *w1)
+{
+  double z, e, c0, c1;
+  int k;
+
+  for (k = 0; k < n; k++) {
+    z = poles[k] * delta;
+    e = exp(-z);
+    if (z < 1.0e-2) {
+      c0 = 0.5 - z * (1.0 / 3.0 - z * (1.0 / 8.0 - z / 30.0));
+      c1 = 0.5 - z * (1.0 / 6.0 - z * (1.0 / 24.0 - z / 120.0));
+    } else {
+      c0 = (1.0 - e - z * e) / (z * z);
+      c1 = (1.0 - e) / z - c0;
+    }
+    decay[k] = e;
+    w0[k] = delta * c0;
+    if (w1)
+      w1[k] = delta * c1;
+  }
+}
+
+/* make the step weights those from timepoint 'index' to the next one */
+
+static void
+LTRArecStep(LTRAmodel *model, double *timelist, int index)
+{
+  if (model->LTRArecStepIndex == index)
+    return;
+
+  LTRArecWeights(model->LTRApoles, model->LTRApoleCount,
+      timelist[index + 1] - timelist[index], model->LTRArecStepDecay,
+      model->LTRArecStepWeight0, model->LTRArecStepWeight1);
+  model->LTRArecStepIndex = index;
+}
+
+static void
+LTRArecAdvance(LTRAmodel *model, double *state, double u0, double u1)
+{
+  int k;
+
+  for (k = 0; k < model->LTRApoleCount; k++)
+    state[k] = model->LTRArecStepDecay[k] * state[k] +
+	model->LTRArecStepWeight0[k] * u0 + model->LTRArecStepWeight1[k] * u1;
+}
+
+/* deviation of x at timepoint i from its initial value */
+
+#define LTRArecDev(x, i, init) ((i) ? *((x) + (i)) - (init) : 0.0)
+
+/*
+ * LTRArecAccept - advance the states of all instances of 'model' to the
+ * timepoint just accepted, and the delayed states as far as no later
+ * timepoint can need them earlier
+ */
+
+void
+LTRArecAccept(CKTcircuit *ckt, GENmodel *genmodel)
+{
+  LTRAmodel *model = (LTRAmodel *) genmodel;
+  LTRAinstance *here;
+  double *timelist = ckt->CKTtimePoints;
+  int index = ckt->CKTtimeIndex;
+  int n = model->LTRApoleCount;
+
+  if (index == 0) {
+    for (here = model->LTRAinstances; here != NULL;
+	here = here->LTRAnextInstance) {
+      LTRArecInstAlloc((GENinstance *) here, n);
+    }
+    model->LTRArecDelIndex = 0;
+    model->LTRArecStepIndex = -1;
+    return;
+  }
+
+  LTRArecStep(model, timelist, index - 1);
+  for (here = model->LTRAinstances; here != NULL;
+      here = here->LTRAnextInstance) {
+    LTRArecAdvance(model, here->LTRAv1Rec,
+	LTRArecDev(here->LTRAv1, index - 1, here->LTRAinitVolt1),
+	LTRArecDev(here->LTRAv1, index, here->LTRAinitVolt1));
+    LTRArecAdvance(model, here->LTRAv2Rec,
+	LTRArecDev(here->LTRAv2, index - 1, here->LTRAinitVolt2),
+	LTRArecDev(here->LTRAv2, index, here->LTRAinitVolt2));
+  }
+
+  while ((model->LTRArecDelIndex < index) &&
+      (timelist[model->LTRArecDelIndex + 1] <=
+	  timelist[index] - model->LTRAtd)) {
+    int i = model->LTRArecDelIndex;
+
+    LTRArecStep(model, timelist, i);
+    for (here = model->LTRAinstances; here != NULL;
+	here = here->LTRAnextInstance) {
+      LTRArecAdvance(model, here->LTRAv1DelRec,
+	  LTRArecDev(here->LTRAv1, i, here->LTRAinitVolt1),
+	  LTRArecDev(here->LTRAv1, i + 1, here->LTRAinitVolt1));
+      LTRArecAdvance(model, here->LTRAv2DelRec,
+	  LTRArecDev(here->LTRAv2, i, here->LTRAinitVolt2),
+	  LTRArecDev(here->LTRAv2, i + 1, here->LTRAinitVolt2));
+      LTRArecAdvance(model, here->LTRAi1DelRec,
+	  LTRArecDev(here->LTRAi1, i, here->LTRAinitCur1),
+	  LTRArecDev(here->LTRAi1, i + 1, here->LTRAinitCur1));
+      LTRArecAdvance(model, here->LTRAi2DelRec,
+	  LTRArecDev(here->LTRAi2, i, here->LTRAinitCur2),
+	  LTRArecDev(here->LTRAi2, i + 1, here->LTRAinitCur2));
+    }
+    model->LTRArecDelIndex++;
+  }
+}
+
+/*
+ * LTRArecSetup - weights from the last timepoint to the current time, and
+ * from LTRAauxIndex to the current time less the delay
+ */
+
+void
+LTRArecSetup(CKTcircuit *ckt, GENmodel *genmodel)
+{
+  LTRAmodel *model = (LTRAmodel *) genmodel;
+  double *timelist = ckt->CKTtimePoints;
+
+  LTRArecWeights(model->LTRApoles, model->LTRApoleCount,
+      ckt->CKTtime - timelist[ckt->CKTtimeIndex],
+      model->LTRArecDecay, model->LTRArecWeight, NULL);
+
+  if (ckt->CKTtime > model->LTRAtd)
+    LTRArecWeights(model->LTRApoles, model->LTRApoleCount,
+	ckt->CKTtime - model->LTRAtd - timelist[model->LTRAauxIndex],
+	model->LTRArecDelDecay, model->LTRArecDelWeight, NULL);
+}
+
+/*
+ * LTRArecConvolve - the history parts of the convolutions of h1dash with
+ * v1 and v2, and, if the delay is over, of h2 with i2 and i1 and of h3dash
+ * with v2 and v1; the counterparts of the sums over the coefficient lists
+ * in LTRAload
+ */
+
+void
+LTRArecConvolve(CKTcircuit *ckt, GENmodel *genmodel, GENinstance *geninstance, int tdover,
+                double *h1v1, double *h1v2, double *h2i2, double *h2i1,
+                double *h3v2, double *h3v1)
+{
+  LTRAmodel *model = (LTRAmodel *) genmodel;
+  LTRAinstance *here = (LTRAinstance *) geninstance;
+  double *timelist = ckt->CKTtimePoints;
+  double *v1del, *v2del, *i1del, *i2del;
+  double u1, u2, u3, u4;
+  int index = ckt->CKTtimeIndex;
+  int aux = model->LTRAauxIndex;
+  int n = model->LTRApoleCount;
+  int i, k;
+
+  u1 = LTRArecDev(here->LTRAv1, index, here->LTRAinitVolt1);
+  u2 = LTRArecDev(here->LTRAv2, index, here->LTRAinitVolt2);
+
+  *h1v1 = *h1v2 = 0.0;
+  for (k = 0; k < n; k++) {
+    *h1v1 += model->LTRAh1dashResidues[k] * (model->LTRArecDecay[k] *
+	here->LTRAv1Rec[k] + model->LTRArecWeight[k] * u1);
+    *h1v2 += model->LTRAh1dashResidues[k] * (model->LTRArecDecay[k] *
+	here->LTRAv2Rec[k] + model->LTRArecWeight[k] * u2);
+  }
+
+  *h2i2 = *h2i1 = *h3v2 = *h3v1 = 0.0;
+  if (!tdover)
+    return;
+
+  /* bring the delayed states from LTRArecDelIndex up to aux */
+
+  v1del = model->LTRArecScratch;
+  v2del = v1del + n;
+  i1del = v1del + 2 * n;
+  i2del = v1del + 3 * n;
+  for (k = 0; k < n; k++) {
+    v1del[k] = here->LTRAv1DelRec[k];
+    v2del[k] = here->LTRAv2DelRec[k];
+    i1del[k] = here->LTRAi1DelRec[k];
+    i2del[k] = here->LTRAi2DelRec[k];
+  }
+
+  for (i = model->LTRArecDelIndex; i < aux; i++) {
+    LTRArecStep(model, timelist, i);
+    LTRArecAdvance(model, v1del,
+	LTRArecDev(here->LTRAv1, i, here->LTRAinitVolt1),
+	LTRArecDev(here->LTRAv1, i + 1, here->LTRAinitVolt1));
+    LTRArecAdvance(model, v2del,
+	LTRArecDev(here->LTRAv2, i, here->LTRAinitVolt2),
+	LTRArecDev(here->LTRAv2, i + 1, here->LTRAinitVolt2));
+    LTRArecAdvance(model, i1del,
+	LTRArecDev(here->LTRAi1, i, here->LTRAinitCur1),
+	LTRArecDev(here->LTRAi1, i + 1, here->LTRAinitCur1));
+    LTRArecAdvance(model, i2del,
+	LTRArecDev(here->LTRAi2, i, here->LTRAinitCur2),
+	LTRArecDev(here->LTRAi2, i + 1, here->LTRAinitCur2));
+  }
+
+  u1 = LTRArecDev(here->LTRAv1, aux, here->LTRAinitVolt1);
+  u2 = LTRArecDev(here->LTRAv2, aux, here->LTRAinitVolt2);
+  u3 = LTRArecDev(here->LTRAi1, aux, here->LTRAinitCur1);
+  u4 = LTRArecDev(here->LTRAi2, aux, here->LTRAinitCur2);
+
+  for (k = 0; k < n; k++) {
+    double decay = model->LTRArecDelDecay[k];
+    double weight = model->LTRArecDelWeight[k];
+
+    *h2i2 += model->LTRAh2Residues[k] * (decay * i2del[k] + weight * u4);
+    *h2i1 += model->LTRAh2Residues[k] * (decay * i1del[k] + weight * u3);
+    *h3v2 += model->LTRAh3dashResidues[k] * (decay * v2del[k] + weight * u2);
+    *h3v1 += model->LTRAh3dashResidues[k] * (decay * v1del[k] + weight * u1);
+  }
+}
+
+/*
+ * History horizon for full convolution
+ *
+ * Cutting the history of a line at some age neglects the parts of the
+ * impulse responses past that age. Applied to port voltages and
+ * currents that never changed by more than dv and di from their
+ * initial values, this puts at most
+ *
+ *   tailVolt(age) * dv + tailCur(age) * di
+ *
+ * into the line currents, where tailVolt is the integral of |h1dash|
+ * and |h3dash| past the age, times the admittance, and tailCur the one
+ * of |h2|. Both are tabulated once per run over logarithmically spaced
+ * ages up to the final time.
+ */
+
+#define LTRA_TAIL_PER_DECADE 8
+
+static void
+LTRAtailSetup(CKTcircuit *ckt, LTRAmodel *model)
+{
+  double T = model->LTRAtd;
+  double alpha = model->LTRAalpha, beta = model->LTRAbeta;
+  double slo, shi, s, a, f, fpeak, h, t, h2tail, h3tail;
+  double *age, *volt, *cur;
+  double g2[5], g3[5];
+  int n, j, k;
+
+  a = 0.25 * model->LTRArclsqr;
+  if (model->LTRAspecialCase == LTRA_MOD_RC) {
+    slo = 1.0e-3 * a;
+    shi = MAX(ckt->CKTfinalTime, 10.0 * a);
+  } else {
+    slo = 1.0e-3 * MIN(1.0 / alpha, T);
+    shi = MAX(ckt->CKTfinalTime, 10.0 * T);
+  }
+  n = (int) ceil(log10(shi / slo) * LTRA_TAIL_PER_DECADE) + 2;
+
+  FREE(model->LTRAtailAge);
+  model->LTRAtailAge = age = TMALLOC(double, 3 * n);
+  model->LTRAtailVolt = volt = age + n;
+  model->LTRAtailCur = cur = age + 2 * n;
+  model->LTRAtailCount = n;
+
+  for (j = 0; j < n; j++)
+    age[j] = slo * pow(shi / slo, (double) j / (n - 1));
+
+  if (model->LTRAspecialCase == LTRA_MOD_RC) {
+
+    /*
+     * closed forms: past t, h1dash leaves sqrt(C/(R pi t)), h2 leaves
+     * erf(sqrt(a/t)), and h3dash, which peaks at t = 2a, leaves
+     * sqrt(C/(R pi)) exp(-a/t)/sqrt(t) once past its peak
+     */
+
+    fpeak = exp(-0.5) / sqrt(2.0 * a);
+    for (j = 0; j < n; j++) {
+      t = age[j];
+      f = exp(-a / t) / sqrt(t);
+      volt[j] = sqrt(model->LTRAcByR / M_PI) *
+	  (1.0 / sqrt(t) + ((t >= 2.0 * a) ? f : 2.0 * fpeak - f));
+      cur[j] = erf(sqrt(a / t));
+    }
+    return;
+  }
+
+  /*
+   * h2 and h3dash start at the delay, the ages are T + s; the table
+   * starts at s = 0. They are integrated backwards by Simpson's rule,
+   * the part past the last age is that of a t^{-3/2} decay. The tail
+   * of h1dash is exp(-alpha t) I_0(alpha t).
+   */
+
+  age[0] = 0.0;
+  s = age[n - 1];
+  h2tail = 2.0 * (T + s) * fabs(LTRArecKernel(1, s, T, alpha, beta));
+  h3tail = 2.0 * (T + s) * fabs(LTRArecKernel(2, s, T, alpha, beta));
+  for (j = n - 1; j >= 0; j--) {
+    if (j < n - 1) {
+      h = age[j + 1] - age[j];
+      for (k = 0; k < 5; k++) {
+	s = age[j] + 0.25 * k * h;
+	g2[k] = fabs(LTRArecKernel(1, s, T, alpha, beta));
+	g3[k] = fabs(LTRArecKernel(2, s, T, alpha, beta));
+      }
+      h2tail += h / 12.0 * (g2[0] + 4.0 * g2[1] + 2.0 * g2[2]
+	  + 4.0 * g2[3] + g2[4]);
+      h3tail += h / 12.0 * (g3[0] + 4.0 * g3[1] + 2.0 * g3[2]
+	  + 4.0 * g3[3] + g3[4]);
+    }
+    cur[j] = h2tail;
+    volt[j] = model->LTRAadmit *
+	(bessI0scaled(alpha * (T + age[j])) + h3tail);
+  }
+  for (j = 0; j < n; j++)
+    age[j] += T;
+}
+
+/*
+ * LTRAautoHorizon - the age of history a full convolution line needs, so
+ * that the rest adds less than reltol times the largest current change
+ * plus abstol. These are the tolerances of the circuit; those of the
+ * line are meant for breakpoints and default to 1, so they can only
+ * make them tighter. Returns 0 if all of the history up to the final
+ * time is needed.
+ */
+
+double
+LTRAautoHorizon(CKTcircuit *ckt, GENmodel *genmodel)
+{
+  LTRAmodel *model = (LTRAmodel *) genmodel;
+  double reltol, abstol, tol;
+  int j;
+
+  if (model->LTRAtailCount == 0)
+    LTRAtailSetup(ckt, model);
+
+  reltol = ckt->CKTreltol;
+  if (model->LTRAreltolGiven)
+    reltol = MIN(reltol, model->LTRAreltol);
+  abstol = ckt->CKTabstol;
+  if (model->LTRAabstolGiven)
+    abstol = MIN(abstol, model->LTRAabstol);
+  tol = reltol * model->LTRAmaxDevCur + abstol;
+
+  for (j = 0; j < model->LTRAtailCount; j++)
+    if (model->LTRAtailVolt[j] * model->LTRAmaxDevVolt +
+	model->LTRAtailCur[j] * model->LTRAmaxDevCur <= tol)
+      return (model->LTRAtailAge[j]);
+  return (0.0);
+}
+
 /*
  * LTRAstraightLineCheck - takes the co-ordinates of three points, finds the
  * area of the triangle enclosed by these points and compares this area with
@@ -48,6 +48,13 @@ LTRAmParam(int param, IFvalue *value, GENmodel *inModel)
   case LTRA_MOD_TRUNCDONTCUT:
     mods->LTRAtruncDontCut = TRUE;
     break;
+  case LTRA_MOD_RECURSIVE:
+    mods->LTRArecursive = TRUE;
+    break;
+  case LTRA_MOD_HORIZON:
+    mods->LTRAhorizon = value->rValue;
+    mods->LTRAhorizonGiven = TRUE;
+    break;
   case LTRA_MOD_R:
     mods->LTRAresist = value->rValue;
     mods->LTRAresistGiven = TRUE;
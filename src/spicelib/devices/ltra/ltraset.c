@@ -168,6 +168,16 @@ LTRAsetup(SMPmatrix *matrix, GENmodel *inModel, CKTcircuit *ckt, int *state)
 	  model->LTRAmodName);
       return (E_BADPARM);
     }
+    if (model->LTRArecursive) {
+      if (model->LTRAspecialCase != LTRA_MOD_RLC)
+	SPfrontEnd->IFerrorf (ERR_WARNING,
+	    "%s: recursive convolution is only done for RLC lines, ignored",
+	    model->LTRAmodName);
+      else if (ckt->CKTtryToCompact)
+	SPfrontEnd->IFerrorf (ERR_WARNING,
+	    "%s: recursive convolution not used because trytocompact option specified",
+	    model->LTRAmodName);
+    }
     /* loop through all the instances of the model */
     for (here = model->LTRAinstances; here != NULL;
 	here = here->LTRAnextInstance) {
@@ -0,0 +1,206 @@
+/*
+ * The history of lossy lines in snapshots, see cktsnap.c.
+ *
+ * Each model saves its fitted poles, the indices of its recursive
+ * convolution and the largest port changes its history horizon is
+ * derived from, each instance its port voltages and currents at the
+ * accepted timepoints, its initial values and its recursive states.
+ * The coefficient lists of the model are computed anew at every load,
+ * only their size is restored.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ltradefs.h"
+#include "ngspice/sperror.h"
+#include "ngspice/suffix.h"
+
+void
+LTRAsnapSave(GENmodel *inModel, CKTcircuit *ckt, CKTsnap *snap)
+{
+  LTRAmodel *model = (LTRAmodel *) inModel;
+  LTRAinstance *here;
+  int count = ckt->CKTtimeIndex + 1;
+  int n, i;
+  double value[6], *history;
+  char *name;
+
+  for (; model != NULL; model = model->LTRAnextModel) {
+    n = model->LTRApoleCount;
+
+    value[0] = n;
+    value[1] = model->LTRArecDelIndex;
+    value[2] = model->LTRAauxIndex;
+    value[3] = model->LTRAmaxDevVolt;
+    value[4] = model->LTRAmaxDevCur;
+    name = tprintf("LTRA model:%s:rec", model->LTRAmodName);
+    CKTsnapPut(snap, name, value, 5);
+    tfree(name);
+
+    if (n > 0) {
+      name = tprintf("LTRA model:%s:poles", model->LTRAmodName);
+      CKTsnapPut(snap, name, model->LTRApoles, 15 * n);
+      tfree(name);
+    }
+
+    for (here = model->LTRAinstances; here != NULL;
+	here = here->LTRAnextInstance) {
+
+      if (here->LTRAv1) {
+	history = TMALLOC(double, 4 * count);
+	for (i = 0; i < count; i++) {
+	  history[i] = here->LTRAv1[i];
+	  history[count + i] = here->LTRAi1[i];
+	  history[2 * count + i] = here->LTRAv2[i];
+	  history[3 * count + i] = here->LTRAi2[i];
+	}
+	name = tprintf("LTRA:%s:history", here->LTRAname);
+	CKTsnapPut(snap, name, history, 4 * count);
+	tfree(name);
+	tfree(history);
+      }
+
+      value[0] = here->LTRAinitVolt1;
+      value[1] = here->LTRAinitCur1;
+      value[2] = here->LTRAinitVolt2;
+      value[3] = here->LTRAinitCur2;
+      value[4] = here->LTRAinput1;
+      value[5] = here->LTRAinput2;
+      name = tprintf("LTRA:%s:init", here->LTRAname);
+      CKTsnapPut(snap, name, value, 6);
+      tfree(name);
+
+      if (n > 0 && here->LTRAv1Rec) {
+	name = tprintf("LTRA:%s:rec", here->LTRAname);
+	CKTsnapPut(snap, name, here->LTRAv1Rec, 6 * n);
+	tfree(name);
+      }
+    }
+  }
+}
+
+/*
+ * the arrays of the models and instances are looked up in a first pass,
+ * and only taken over in the second one, if 'commit' is set.  The
+ * circuit may not have taken the snapshot over yet, so the number of
+ * timepoints comes from the snapshot.
+ */
+
+int
+LTRAsnapLoad(GENmodel *inModel, CKTcircuit *ckt, CKTsnap *snap, int commit)
+{
+  LTRAmodel *model;
+  LTRAinstance *here;
+  double *index = CKTsnapGet(snap, "CKTtimeIndex", 1);
+  int count, size;
+  int n, i, pass;
+  double *rec, *poles, *history, *init, *states;
+  char *name;
+
+  NG_IGNORE(ckt);
+
+  if (!index)
+    return (E_BADPARM);
+  count = (int) *index + 1;
+  size = MAX(count, 10);
+
+  for (pass = 0; pass <= commit; pass++)
+    for (model = (LTRAmodel *) inModel; model != NULL;
+	model = model->LTRAnextModel) {
+
+      name = tprintf("LTRA model:%s:rec", model->LTRAmodName);
+      rec = CKTsnapGet(snap, name, 5);
+      tfree(name);
+      if (!rec || rec[0] < 0 || rec[1] < 0 || rec[1] >= count ||
+	  rec[2] < 0 || rec[2] >= count)
+	return (E_BADPARM);
+      n = (int) rec[0];
+
+      poles = NULL;
+      if (n > 0) {
+	name = tprintf("LTRA model:%s:poles", model->LTRAmodName);
+	poles = CKTsnapGet(snap, name, 15 * n);
+	tfree(name);
+	if (!poles)
+	  return (E_BADPARM);
+      }
+
+      if (pass) {
+	if (n > 0) {
+	  LTRArecAlloc((GENmodel *) model, n);
+	  memcpy(model->LTRApoles, poles, (size_t) (15 * n) * sizeof(double));
+	} else {
+	  FREE(model->LTRApoles);
+	}
+	model->LTRApoleCount = n;
+	model->LTRArecDelIndex = (int) rec[1];
+	model->LTRArecStepIndex = -1;
+	model->LTRAauxIndex = (int) rec[2];
+	model->LTRAmaxDevVolt = rec[3];
+	model->LTRAmaxDevCur = rec[4];
+	model->LTRAtailCount = 0;
+
+	model->LTRAmodelListSize = size;
+	FREE(model->LTRAh1dashCoeffs);
+	FREE(model->LTRAh2Coeffs);
+	FREE(model->LTRAh3dashCoeffs);
+	model->LTRAh1dashCoeffs = TMALLOC(double, size);
+	model->LTRAh2Coeffs = TMALLOC(double, size);
+	model->LTRAh3dashCoeffs = TMALLOC(double, size);
+      }
+
+      for (here = model->LTRAinstances; here != NULL;
+	  here = here->LTRAnextInstance) {
+
+	name = tprintf("LTRA:%s:history", here->LTRAname);
+	history = CKTsnapGet(snap, name, 4 * count);
+	tfree(name);
+	name = tprintf("LTRA:%s:init", here->LTRAname);
+	init = CKTsnapGet(snap, name, 6);
+	tfree(name);
+	states = NULL;
+	if (n > 0) {
+	  name = tprintf("LTRA:%s:rec", here->LTRAname);
+	  states = CKTsnapGet(snap, name, 6 * n);
+	  tfree(name);
+	}
+	if (!history || !init || (n > 0 && !states))
+	  return (E_BADPARM);
+
+	if (!pass)
+	  continue;
+
+	here->LTRAinstListSize = size;
+	FREE(here->LTRAv1);
+	FREE(here->LTRAi1);
+	FREE(here->LTRAv2);
+	FREE(here->LTRAi2);
+	here->LTRAv1 = TMALLOC(double, size);
+	here->LTRAi1 = TMALLOC(double, size);
+	here->LTRAv2 = TMALLOC(double, size);
+	here->LTRAi2 = TMALLOC(double, size);
+	for (i = 0; i < count; i++) {
+	  here->LTRAv1[i] = history[i];
+	  here->LTRAi1[i] = history[count + i];
+	  here->LTRAv2[i] = history[2 * count + i];
+	  here->LTRAi2[i] = history[3 * count + i];
+	}
+
+	here->LTRAinitVolt1 = init[0];
+	here->LTRAinitCur1 = init[1];
+	here->LTRAinitVolt2 = init[2];
+	here->LTRAinitCur2 = init[3];
+	here->LTRAinput1 = init[4];
+	here->LTRAinput2 = init[5];
+
+	if (n > 0) {
+	  LTRArecInstAlloc((GENinstance *) here, n);
+	  memcpy(here->LTRAv1Rec, states, (size_t) (6 * n) * sizeof(double));
+	} else {
+	  FREE(here->LTRAv1Rec);
+	}
+      }
+    }
+
+  return (OK);
+}
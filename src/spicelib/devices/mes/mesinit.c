@@ -68,6 +68,8 @@ SPICEdev MESinfo = {
  /* DEVdisto      */ MESdisto,
  /* DEVnoise      */ MESnoise,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
@@ -68,6 +68,8 @@ SPICEdev MESAinfo = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ NULL,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
@@ -68,6 +68,8 @@ SPICEdev MOS1info = {
  /* DEVdisto      */ MOS1disto,
  /* DEVnoise      */ MOS1noise,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
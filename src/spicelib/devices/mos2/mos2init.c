@@ -68,6 +68,8 @@ SPICEdev MOS2info = {
  /* DEVdisto      */ MOS2disto,
  /* DEVnoise      */ MOS2noise,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
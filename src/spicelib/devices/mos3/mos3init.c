@@ -68,6 +68,8 @@ SPICEdev MOS3info = {
  /* DEVdisto      */ MOS3disto,
  /* DEVnoise      */ MOS3noise,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
@@ -68,6 +68,8 @@ SPICEdev MOS6info = {
  /* DEVdisto      */ NULL, /* Distortion routine */
  /* DEVnoise      */ NULL, /* Noise routine */
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
@@ -68,6 +68,8 @@ SPICEdev MOS9info = {
  /* DEVdisto      */ MOS9disto,
  /* DEVnoise      */ MOS9noise,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
@@ -68,6 +68,8 @@ SPICEdev NBJTinfo = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ NULL,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NBJTdump,
  /* DEVacct       */ NBJTacct,
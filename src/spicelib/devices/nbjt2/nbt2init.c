@@ -68,6 +68,8 @@ SPICEdev NBJT2info = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ NULL,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NBJT2dump,
  /* DEVacct       */ NBJT2acct,
@@ -68,6 +68,8 @@ SPICEdev NUMDinfo = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ NULL,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump	  */ NUMDdump,
  /* DEVacct       */ NUMDacct,
@@ -68,6 +68,8 @@ SPICEdev NUMD2info = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ NULL,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NUMD2dump,
  /* DEVacct       */ NUMD2acct,
@@ -68,6 +68,8 @@ SPICEdev NUMOSinfo = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ NULL,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NUMOSdump,
  /* DEVacct       */ NUMOSacct,
@@ -68,6 +68,8 @@ SPICEdev RESinfo = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ RESnoise,
  /* DEVsoaCheck   */ RESsoaCheck,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
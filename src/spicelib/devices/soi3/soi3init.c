@@ -68,6 +68,8 @@ SPICEdev SOI3info = {
  /* DEVdisto      */ NULL,
  /* DEVnoise      */ SOI3noise,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
@@ -69,6 +69,8 @@ SPICEdev SWinfo = {
  /* DEVdisto      */ NULL, /* DISTO */
  /* DEVnoise      */ SWnoise,
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
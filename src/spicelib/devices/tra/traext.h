@@ -13,6 +13,8 @@ extern int TRAmAsk(CKTcircuit*,GENmodel*,int,IFvalue*);
 extern int TRAmDelete(GENmodel**,IFuid,GENmodel*);
 extern int TRAparam(int,IFvalue*,GENinstance*,IFvalue*);
 extern int TRAsetup(SMPmatrix*,GENmodel*,CKTcircuit*,int*);
+extern void TRAsnapSave(GENmodel*,CKTcircuit*,CKTsnap*);
+extern int TRAsnapLoad(GENmodel*,CKTcircuit*,CKTsnap*,int);
 extern int TRAunsetup(GENmodel*,CKTcircuit*);
 extern int TRAtemp(GENmodel*,CKTcircuit*);
 extern int TRAtrunc(GENmodel*,CKTcircuit*,double*);
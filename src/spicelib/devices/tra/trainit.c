@@ -68,6 +68,8 @@ SPICEdev TRAinfo = {
  /* DEVdisto      */ NULL,	/* DISTO */
  /* DEVnoise      */ NULL,	/* NOISE */
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ TRAsnapSave,
+ /* DEVsnapLoad   */ TRAsnapLoad,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
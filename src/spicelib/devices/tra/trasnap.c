@@ -0,0 +1,85 @@
+/* The history of lossless lines in snapshots, see cktsnap.c.
+ *
+ * Each instance saves its table of delayed excitations and the
+ * excitations themselves under its name.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "tradefs.h"
+#include "ngspice/sperror.h"
+#include "ngspice/suffix.h"
+
+
+void
+TRAsnapSave(GENmodel *inModel, CKTcircuit *ckt, CKTsnap *snap)
+{
+    TRAmodel *model = (TRAmodel *)inModel;
+    TRAinstance *here;
+    double input[2];
+    char *name;
+
+    NG_IGNORE(ckt);
+
+    for( ; model != NULL; model = model->TRAnextModel) {
+        for (here = model->TRAinstances; here != NULL;
+                here = here->TRAnextInstance) {
+            name = tprintf("Tranline:%s:delays", here->TRAname);
+            CKTsnapPut(snap, name, here->TRAdelays, 3 * (here->TRAsizeDelay + 1));
+            tfree(name);
+
+            input[0] = here->TRAinput1;
+            input[1] = here->TRAinput2;
+            name = tprintf("Tranline:%s:input", here->TRAname);
+            CKTsnapPut(snap, name, input, 2);
+            tfree(name);
+        }
+    }
+}
+
+
+int
+TRAsnapLoad(GENmodel *inModel, CKTcircuit *ckt, CKTsnap *snap, int commit)
+{
+    TRAmodel *model;
+    TRAinstance *here;
+    double *data;
+    char *name;
+    int count, pass;
+
+    NG_IGNORE(ckt);
+
+    /* check that every line is there before changing any */
+    for (pass = 0; pass <= commit; pass++)
+        for (model = (TRAmodel *)inModel; model != NULL;
+                model = model->TRAnextModel) {
+            for (here = model->TRAinstances; here != NULL;
+                    here = here->TRAnextInstance) {
+                name = tprintf("Tranline:%s:delays", here->TRAname);
+                count = CKTsnapLength(snap, name);
+                data = CKTsnapGet(snap, name, count);
+                tfree(name);
+                if (!data || count < 9 || count % 3 != 0)
+                    return(E_BADPARM);
+                if (pass) {
+                    FREE(here->TRAdelays);
+                    here->TRAdelays = TMALLOC(double, count);
+                    memcpy(here->TRAdelays, data, (size_t) count * sizeof(double));
+                    here->TRAsizeDelay = count / 3 - 1;
+                    here->TRAallocDelay = here->TRAsizeDelay;
+                }
+
+                name = tprintf("Tranline:%s:input", here->TRAname);
+                data = CKTsnapGet(snap, name, 2);
+                tfree(name);
+                if (!data)
+                    return(E_BADPARM);
+                if (pass) {
+                    here->TRAinput1 = data[0];
+                    here->TRAinput2 = data[1];
+                }
+            }
+        }
+
+    return(OK);
+}
@@ -73,6 +73,8 @@ SPICEdev VBICinfo = {
     NULL,         /* DEVdisto       */
     VBICnoise,    /* DEVnoise       */
     VBICsoaCheck, /* DEVsoaCheck    */
+    NULL, /* DEVsnapSave    */
+    NULL, /* DEVsnapLoad    */
 #ifdef CIDER
     NULL,         /* DEVdump       */
     NULL,         /* DEVacct       */
@@ -68,6 +68,8 @@ SPICEdev VSRCinfo = {
  /* DEVdisto      */ NULL, /* DISTO */
  /* DEVnoise      */ NULL, /* NOISE */
  /* DEVsoaCheck   */ NULL,
+ /* DEVsnapSave   */ NULL,
+ /* DEVsnapLoad   */ NULL,
 #ifdef CIDER
  /* DEVdump       */ NULL,
  /* DEVacct       */ NULL,
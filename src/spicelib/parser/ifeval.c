@@ -21,6 +21,10 @@ extern double PTfudge_factor;
 
 static int PTeval(INPparseNode * tree, double gmin, double *res,
 		  double *vals);
+static int PTrun(PTprogram *prog, double gmin, double *result,
+		 double *vals, double *derivs);
+static int IFevalTree(INPparseTree *myTree, double gmin, double *result,
+		      double *vals, double *derivs);
 
 
 
@@ -28,16 +32,41 @@ int
 IFeval(IFparseTree * tree, double gmin, double *result, double *vals,
        double *derivs)
 {
-    int i, err;
     INPparseTree *myTree = (INPparseTree *) tree;
 
 #ifdef TRACE
+    int i;
+
     INPptPrint("calling PTeval, tree = ", tree);
     printf("values:");
     for (i = 0; i < myTree->p.numVars; i++)
 	printf("\tvar%d = %lg\n", i, vals[i]);
 #endif
 
+    /* An argument out of range makes the program bail out, the trees
+     * are then walked again to report the offending function.
+     */
+    if (!myTree->prog ||
+        PTrun(myTree->prog, gmin, result, vals, derivs) != OK)
+        return IFevalTree(myTree, gmin, result, vals, derivs);
+
+#ifdef TRACE
+    printf("results: function = %lg\n", *result);
+    for (i = 0; i < myTree->p.numVars; i++)
+	printf("\td / d var%d = %lg\n", i, derivs[i]);
+#endif
+
+    return (OK);
+}
+
+
+static int
+IFevalTree(INPparseTree *myTree, double gmin, double *result, double *vals,
+           double *derivs)
+{
+    IFparseTree *tree = &myTree->p;
+    int i, err;
+
     if ((err = PTeval(myTree->tree, gmin, result, vals)) != OK) {
         if (ft_ngdebug) {
             INPptPrint("calling PTeval, tree = ", tree);
@@ -63,12 +92,6 @@ IFeval(IFparseTree * tree, double gmin, double *result, double *vals,
             return err;
         }
 
-#ifdef TRACE
-    printf("results: function = %lg\n", *result);
-    for (i = 0; i < myTree->p.numVars; i++)
-	printf("\td / d var%d = %lg\n", i, derivs[i]);
-#endif
-
     return (OK);
 }
 
@@ -183,3 +206,541 @@ PTeval(INPparseNode * tree, double gmin, double *res, double *vals)
 
     return (OK);
 }
+
+
+/*
+ * The trees of the value and of the derivatives share many subtrees, and
+ * walking them recomputes every shared part once per tree.  PTcompile()
+ * lowers all of them into one linear program working on a register file.
+ * Every node gets its own register and structurally equal nodes share one,
+ * so each distinct subexpression is computed once per evaluation.  Constants
+ * are preloaded into their registers and take no instruction at all.
+ *
+ * A ternary is compiled into a conditional jump around its two branches,
+ * only the selected branch is computed as in PTeval().  Subexpressions
+ * first met inside a branch are forgotten when leaving it, because the
+ * other branch and the code after the ternary can not rely on them.
+ *
+ * The program refers to variables by their index only, so the many B
+ * sources expanded from one subcircuit body compile to identical programs.
+ * Those are kept once in a table and shared by reference count, which
+ * keeps a single copy of the code and registers in the cache however
+ * often the body is instantiated.
+ */
+
+enum {
+    PTOP_LOAD,          /* regs[dest] = vals[a] */
+    PTOP_TIME,
+    PTOP_TEMPERATURE,
+    PTOP_FREQUENCY,
+    PTOP_PLUS,          /* regs[dest] = regs[a] op regs[b] */
+    PTOP_MINUS,
+    PTOP_TIMES,
+    PTOP_UMINUS,        /* regs[dest] = - regs[a] */
+    PTOP_BINARY,        /* regs[dest] = function(regs[a], regs[b]) */
+    PTOP_UNARY,         /* regs[dest] = function(regs[a]) */
+    PTOP_UNARY_DATA,    /* regs[dest] = function(regs[a], data) */
+    PTOP_MOVE,          /* regs[dest] = regs[a] */
+    PTOP_JUMPZ,         /* if (regs[a] == 0.0) goto b */
+    PTOP_JUMP,          /* goto b */
+    PTOP_CONSTANT,      /* only used as a key, preloaded register */
+    PTOP_TERN           /* only used as a key, the node itself */
+};
+
+typedef struct {
+    int op;
+    int dest;
+    int a, b;
+    void (*function)(void);
+    void *data;
+} PTinstr;
+
+struct PTprogram {
+    PTinstr *code;
+    int ncode;
+    double *regs;
+    int nregs;
+    int result;         /* register of the value */
+    int *dresult;       /* registers of the derivatives */
+    int numVars;
+    double *init;       /* registers as compiled, constants preloaded */
+    unsigned int hash;
+    int usecnt;
+    PTprogram *next;    /* in PTprograms[] */
+};
+
+#define PT_PROGRAM_BUCKETS 1024
+
+static PTprogram *PTprograms[PT_PROGRAM_BUCKETS];
+
+/* key of an already computed subexpression */
+typedef struct {
+    int op, a, b;
+    void (*function)(void);
+    void *data;
+    double constant;
+    int reg;
+    int next;
+} PTcse;
+
+#define PT_CSE_BUCKETS 1024
+
+typedef struct {
+    PTprogram *prog;
+    int maxcode, maxregs;
+    PTcse *cse;
+    int ncse, maxcse;
+    int buckets[PT_CSE_BUCKETS];
+} PTcompiler;
+
+
+static unsigned int
+PTcseHash(const PTcse *k)
+{
+    unsigned int hash = 2166136261u;
+    unsigned char *p = (unsigned char *) &k->constant;
+    size_t i;
+
+    hash = (hash ^ (unsigned int) k->op) * 16777619u;
+    hash = (hash ^ (unsigned int) k->a) * 16777619u;
+    hash = (hash ^ (unsigned int) k->b) * 16777619u;
+    hash = (hash ^ (unsigned int) (size_t) k->function) * 16777619u;
+    hash = (hash ^ (unsigned int) (size_t) k->data) * 16777619u;
+    for (i = 0; i < sizeof(k->constant); i++)
+        hash = (hash ^ p[i]) * 16777619u;
+
+    return hash % PT_CSE_BUCKETS;
+}
+
+
+/* return the register holding 'k', or -1 */
+
+static int
+PTcseFind(PTcompiler *c, PTcse *k)
+{
+    int i;
+
+    for (i = c->buckets[PTcseHash(k)]; i >= 0; i = c->cse[i].next) {
+        PTcse *e = &c->cse[i];
+        if (e->op == k->op && e->a == k->a && e->b == k->b &&
+            e->function == k->function && e->data == k->data &&
+            /* bitwise, 0.0 and -0.0 differ */
+            memcmp(&e->constant, &k->constant, sizeof(double)) == 0)
+            return e->reg;
+    }
+
+    return -1;
+}
+
+
+static void
+PTcseAdd(PTcompiler *c, PTcse *k, int reg)
+{
+    unsigned int h = PTcseHash(k);
+
+    if (c->ncse >= c->maxcse) {
+        c->maxcse = c->maxcse ? 2 * c->maxcse : 64;
+        c->cse = TREALLOC(PTcse, c->cse, c->maxcse);
+    }
+
+    c->cse[c->ncse] = *k;
+    c->cse[c->ncse].reg = reg;
+    c->cse[c->ncse].next = c->buckets[h];
+    c->buckets[h] = c->ncse++;
+}
+
+
+/* forget the subexpressions added after the first 'n' ones */
+
+static void
+PTcsePop(PTcompiler *c, int n)
+{
+    while (c->ncse > n) {
+        PTcse *e = &c->cse[--c->ncse];
+        c->buckets[PTcseHash(e)] = e->next;
+    }
+}
+
+
+static int
+PTnewReg(PTcompiler *c)
+{
+    PTprogram *prog = c->prog;
+
+    if (prog->nregs >= c->maxregs) {
+        c->maxregs = c->maxregs ? 2 * c->maxregs : 16;
+        prog->regs = TREALLOC(double, prog->regs, c->maxregs);
+    }
+
+    prog->regs[prog->nregs] = 0.0;
+
+    return prog->nregs++;
+}
+
+
+static int
+PTemit(PTcompiler *c, int op, int dest, int a, int b,
+       void (*function)(void), void *data)
+{
+    PTprogram *prog = c->prog;
+    PTinstr *ip;
+
+    if (prog->ncode >= c->maxcode) {
+        c->maxcode = c->maxcode ? 2 * c->maxcode : 32;
+        prog->code = TREALLOC(PTinstr, prog->code, c->maxcode);
+    }
+
+    ip = &prog->code[prog->ncode];
+    ip->op = op;
+    ip->dest = dest;
+    ip->a = a;
+    ip->b = b;
+    ip->function = function;
+    ip->data = data;
+
+    return prog->ncode++;
+}
+
+
+/* return the register of 'k', emitting its instruction if it is new */
+
+static int
+PTcseEmit(PTcompiler *c, PTcse *k)
+{
+    int reg = PTcseFind(c, k);
+
+    if (reg < 0) {
+        reg = PTnewReg(c);
+        PTemit(c, k->op, reg, k->a, k->b, k->function, k->data);
+        PTcseAdd(c, k, reg);
+    }
+
+    return reg;
+}
+
+
+/* compile 'tree', return the register of its value or -1 */
+
+static int
+PTcompileNode(PTcompiler *c, INPparseNode *tree)
+{
+    PTcse k;
+    int reg;
+
+    if (!tree)
+        return -1;
+
+    memset(&k, 0, sizeof(k));
+
+    switch (tree->type) {
+    case PT_CONSTANT:
+        k.op = PTOP_CONSTANT;
+        k.constant = tree->constant;
+        reg = PTcseFind(c, &k);
+        if (reg < 0) {
+            reg = PTnewReg(c);
+            c->prog->regs[reg] = tree->constant;
+            PTcseAdd(c, &k, reg);
+        }
+        return reg;
+
+    case PT_VAR:
+        k.op = PTOP_LOAD;
+        k.a = tree->valueIndex;
+        return PTcseEmit(c, &k);
+
+    case PT_TIME:
+    case PT_TEMPERATURE:
+    case PT_FREQUENCY:
+        k.op = (tree->type == PT_TIME) ? PTOP_TIME :
+            (tree->type == PT_TEMPERATURE) ? PTOP_TEMPERATURE : PTOP_FREQUENCY;
+        k.data = tree->data;
+        return PTcseEmit(c, &k);
+
+    case PT_FUNCTION:
+        switch (tree->funcnum) {
+        case PTF_POW:
+        case PTF_PWR:
+        case PTF_MIN:
+        case PTF_MAX:
+            k.op = PTOP_BINARY;
+            if (!tree->left)
+                return -1;
+            k.a = PTcompileNode(c, tree->left->left);
+            k.b = PTcompileNode(c, tree->left->right);
+            break;
+        default:
+            k.op = (tree->funcnum == PTF_UMINUS) ? PTOP_UMINUS :
+                tree->data ? PTOP_UNARY_DATA : PTOP_UNARY;
+            k.a = PTcompileNode(c, tree->left);
+            k.b = 0;
+            k.data = tree->data;
+            break;
+        }
+        if (k.a < 0 || k.b < 0)
+            return -1;
+        k.function = tree->function;
+        return PTcseEmit(c, &k);
+
+    case PT_PLUS:
+    case PT_MINUS:
+    case PT_TIMES:
+    case PT_DIVIDE:
+    case PT_POWER:
+        k.op = (tree->type == PT_PLUS) ? PTOP_PLUS :
+            (tree->type == PT_MINUS) ? PTOP_MINUS :
+            (tree->type == PT_TIMES) ? PTOP_TIMES : PTOP_BINARY;
+        k.a = PTcompileNode(c, tree->left);
+        k.b = PTcompileNode(c, tree->right);
+        if (k.a < 0 || k.b < 0)
+            return -1;
+        k.function = tree->function;
+        return PTcseEmit(c, &k);
+
+    case PT_TERN: {
+        int cond, r2, r3, jumpz, jump, ncse;
+
+        /* the derivatives refer to the very same ternary node */
+        k.op = PTOP_TERN;
+        k.data = tree;
+        reg = PTcseFind(c, &k);
+        if (reg >= 0)
+            return reg;
+
+        if (!tree->right)
+            return -1;
+        cond = PTcompileNode(c, tree->left);
+        if (cond < 0)
+            return -1;
+        reg = PTnewReg(c);
+
+        jumpz = PTemit(c, PTOP_JUMPZ, 0, cond, 0, NULL, NULL);
+        ncse = c->ncse;
+        r2 = PTcompileNode(c, tree->right->left);
+        PTcsePop(c, ncse);
+        if (r2 < 0)
+            return -1;
+        PTemit(c, PTOP_MOVE, reg, r2, 0, NULL, NULL);
+        jump = PTemit(c, PTOP_JUMP, 0, 0, 0, NULL, NULL);
+
+        c->prog->code[jumpz].b = c->prog->ncode;
+        r3 = PTcompileNode(c, tree->right->right);
+        PTcsePop(c, ncse);
+        if (r3 < 0)
+            return -1;
+        PTemit(c, PTOP_MOVE, reg, r3, 0, NULL, NULL);
+        c->prog->code[jump].b = c->prog->ncode;
+
+        PTcseAdd(c, &k, reg);
+        return reg;
+    }
+
+    default:
+        return -1;
+    }
+}
+
+
+static unsigned int
+PTprogramHash(PTprogram *prog)
+{
+    unsigned int hash = 2166136261u;
+    int i;
+
+    hash = (hash ^ (unsigned int) prog->ncode) * 16777619u;
+    hash = (hash ^ (unsigned int) prog->nregs) * 16777619u;
+    hash = (hash ^ (unsigned int) prog->result) * 16777619u;
+    for (i = 0; i < prog->numVars; i++)
+        hash = (hash ^ (unsigned int) prog->dresult[i]) * 16777619u;
+    for (i = 0; i < prog->ncode; i++) {
+        PTinstr *ip = &prog->code[i];
+        hash = (hash ^ (unsigned int) ip->op) * 16777619u;
+        hash = (hash ^ (unsigned int) ip->a) * 16777619u;
+        hash = (hash ^ (unsigned int) ip->b) * 16777619u;
+        hash = (hash ^ (unsigned int) (size_t) ip->function) * 16777619u;
+        hash = (hash ^ (unsigned int) (size_t) ip->data) * 16777619u;
+    }
+
+    return hash;
+}
+
+
+static bool
+PTprogramEqual(PTprogram *p, PTprogram *q)
+{
+    int i;
+
+    if (p->hash != q->hash || p->ncode != q->ncode || p->nregs != q->nregs ||
+        p->numVars != q->numVars || p->result != q->result)
+        return FALSE;
+
+    for (i = 0; i < p->numVars; i++)
+        if (p->dresult[i] != q->dresult[i])
+            return FALSE;
+
+    for (i = 0; i < p->ncode; i++) {
+        PTinstr *a = &p->code[i], *b = &q->code[i];
+        if (a->op != b->op || a->dest != b->dest || a->a != b->a ||
+            a->b != b->b || a->function != b->function || a->data != b->data)
+            return FALSE;
+    }
+
+    /* bitwise, 0.0 and -0.0 differ */
+    return memcmp(p->init, q->init, (size_t) p->nregs * sizeof(double)) == 0;
+}
+
+
+/* compile the value 'tree' and its 'numVars' derivative trees into one
+ * program, return NULL if some node can not be compiled
+ */
+
+PTprogram *
+PTcompile(INPparseNode *tree, INPparseNode **derivs, int numVars)
+{
+    PTcompiler c;
+    PTprogram *prog = TMALLOC(PTprogram, 1);
+    int i;
+
+    memset(&c, 0, sizeof(c));
+    for (i = 0; i < PT_CSE_BUCKETS; i++)
+        c.buckets[i] = -1;
+    c.prog = prog;
+
+    prog->numVars = numVars;
+    prog->dresult = TMALLOC(int, numVars);
+
+    prog->result = PTcompileNode(&c, tree);
+    for (i = 0; i < numVars && prog->result >= 0; i++)
+        if ((prog->dresult[i] = PTcompileNode(&c, derivs[i])) < 0)
+            prog->result = -1;
+
+    tfree(c.cse);
+
+    prog->usecnt = 1;
+
+    if (prog->result < 0) {
+        PTfreeProgram(prog);
+        return NULL;
+    }
+
+    prog->init = TMALLOC(double, prog->nregs);
+    if (prog->nregs > 0)
+        memcpy(prog->init, prog->regs, (size_t) prog->nregs * sizeof(double));
+    prog->hash = PTprogramHash(prog);
+
+    /* share an identical program compiled before */
+    {
+        PTprogram **bucket = &PTprograms[prog->hash % PT_PROGRAM_BUCKETS];
+        PTprogram *p;
+
+        for (p = *bucket; p; p = p->next)
+            if (PTprogramEqual(p, prog)) {
+                p->usecnt++;
+                PTfreeProgram(prog);
+                return p;
+            }
+
+        prog->next = *bucket;
+        *bucket = prog;
+    }
+
+    return prog;
+}
+
+
+void
+PTfreeProgram(PTprogram *prog)
+{
+    PTprogram **pp;
+
+    if (!prog || --prog->usecnt > 0)
+        return;
+
+    for (pp = &PTprograms[prog->hash % PT_PROGRAM_BUCKETS]; *pp; pp = &(*pp)->next)
+        if (*pp == prog) {
+            *pp = prog->next;
+            break;
+        }
+
+    tfree(prog->code);
+    tfree(prog->regs);
+    tfree(prog->init);
+    tfree(prog->dresult);
+    tfree(prog);
+}
+
+
+static int
+PTrun(PTprogram *prog, double gmin, double *result, double *vals,
+      double *derivs)
+{
+    double *regs = prog->regs;
+    PTinstr *code = prog->code;
+    int pc = 0;
+    int i;
+
+    PTfudge_factor = gmin * 1.0e-20;
+
+    while (pc < prog->ncode) {
+        PTinstr *ip = &code[pc++];
+        double r;
+
+        switch (ip->op) {
+        case PTOP_LOAD:
+            regs[ip->dest] = vals[ip->a];
+            continue;
+        case PTOP_TIME:
+            regs[ip->dest] = ((CKTcircuit *) ip->data)->CKTtime;
+            continue;
+        case PTOP_TEMPERATURE:
+            regs[ip->dest] = ((CKTcircuit *) ip->data)->CKTtemp - CONSTCtoK;
+            continue;
+        case PTOP_FREQUENCY:
+            regs[ip->dest] = (((CKTcircuit *) ip->data)->CKTomega)/2./M_PI;
+            continue;
+        case PTOP_MOVE:
+            regs[ip->dest] = regs[ip->a];
+            continue;
+        case PTOP_JUMPZ:
+            if (regs[ip->a] == 0.0)
+                pc = ip->b;
+            continue;
+        case PTOP_JUMP:
+            pc = ip->b;
+            continue;
+        case PTOP_PLUS:
+            r = regs[ip->a] + regs[ip->b];
+            break;
+        case PTOP_MINUS:
+            r = regs[ip->a] - regs[ip->b];
+            break;
+        case PTOP_TIMES:
+            r = regs[ip->a] * regs[ip->b];
+            break;
+        case PTOP_UMINUS:
+            r = - regs[ip->a];
+            break;
+        case PTOP_BINARY:
+            r = PTbinary(ip->function) (regs[ip->a], regs[ip->b]);
+            break;
+        case PTOP_UNARY:
+            r = PTunary(ip->function) (regs[ip->a]);
+            break;
+        case PTOP_UNARY_DATA:
+            r = PTunary_with_private(ip->function) (regs[ip->a], ip->data);
+            break;
+        default:
+            return (E_PANIC);
+        }
+
+        if (r == HUGE)
+            return (E_PARMVAL);
+        regs[ip->dest] = r;
+    }
+
+    *result = regs[prog->result];
+    for (i = 0; i < prog->numVars; i++)
+        derivs[i] = regs[prog->dresult[i]];
+
+    return (OK);
+}
@@ -228,6 +228,8 @@ INPgetTree(char **line, INPparseTree ** pt, CKTcircuit *ckt, INPtables * tab)
         for (i = 0; i < numvalues; i++)
             (*pt)->derivs[i] = inc_usage(PTdifferentiate(p, i));
 
+        (*pt)->prog = PTcompile((*pt)->tree, (*pt)->derivs, numvalues);
+
     }
 
     values = NULL;
@@ -1411,6 +1413,8 @@ void INPfreeTree(IFparseTree *ptree)
     if (!pt)
         return;
 
+    PTfreeProgram(pt->prog);
+
     for (i = 0; i < pt->p.numVars; i++)
         dec_usage(pt->derivs[i]);
 
@@ -20,6 +20,8 @@ Author: 1985 Wayne A. Christopher, U. C. Berkeley CAD Group
 
 
 static int hash(char *name, int tsize);
+static void INPgrowSymtab(INPtables *tab);
+static void INPgrowTermtab(INPtables *tab);
 
 /* Initialize the symbol tables. */
 
@@ -34,6 +36,8 @@ INPtables *INPtabInit(int numlines)
     ZERO(tab->INPtermsymtab, numlines * sizeof(struct INPnTab *));
     tab->INPsize = numlines / 4 + 1;
     tab->INPtermsize = numlines;
+    tab->INPnumsyms = 0;
+    tab->INPnumterms = 0;
     return (tab);
 }
 
@@ -68,6 +72,8 @@ int INPtermInsert(CKTcircuit *ckt, char **token, INPtables * tab, CKTnode **node
     t->t_ent = *token;
     t->t_next = tab->INPtermsymtab[key];
     tab->INPtermsymtab[key] = t;
+    if (++tab->INPnumterms > 2 * tab->INPtermsize)
+        INPgrowTermtab(tab);
     return (OK);
 }
 
@@ -101,6 +107,8 @@ int INPmkTerm(CKTcircuit *ckt, char **token, INPtables * tab, CKTnode **node)
     t->t_ent = *token;
     t->t_next = tab->INPtermsymtab[key];
     tab->INPtermsymtab[key] = t;
+    if (++tab->INPnumterms > 2 * tab->INPtermsize)
+        INPgrowTermtab(tab);
     return (OK);
 }
 
@@ -134,6 +142,8 @@ int INPgndInsert(CKTcircuit *ckt, char **token, INPtables * tab, CKTnode **node)
     t->t_ent = *token;
     t->t_next = tab->INPtermsymtab[key];
     tab->INPtermsymtab[key] = t;
+    if (++tab->INPnumterms > 2 * tab->INPtermsize)
+        INPgrowTermtab(tab);
     return (OK);
 }
 
@@ -175,6 +185,8 @@ int INPinsert(char **token, INPtables * tab)
     t->t_ent = *token;
     t->t_next = tab->INPsymtab[key];
     tab->INPsymtab[key] = t;
+    if (++tab->INPnumsyms > 2 * tab->INPsize)
+        INPgrowSymtab(tab);
     return (OK);
 }
 
@@ -202,6 +214,8 @@ int INPinsertNofree(char **token, INPtables * tab)
     t->t_ent = *token;
     t->t_next = tab->INPsymtab[key];
     tab->INPsymtab[key] = t;
+    if (++tab->INPnumsyms > 2 * tab->INPsize)
+        INPgrowSymtab(tab);
     return (OK);
 }
 
@@ -221,6 +235,7 @@ int INPremove(char *token, INPtables * tab)
     *prevp = t->t_next;
     tfree(t->t_ent);
     tfree(t);
+    tab->INPnumsyms--;
 
     return OK;
 }
@@ -241,10 +256,56 @@ int INPremTerm(char *token, INPtables * tab)
     *prevp = t->t_next;
     tfree(t->t_ent);
     tfree(t);
+    tab->INPnumterms--;
 
     return OK;
 }
 
+/* The tables are sized by the number of input lines, which after
+ * subcircuit expansion may be far fewer than the names stored.
+ * Rehash into a larger table when the chains get long.
+ */
+
+static void INPgrowSymtab(INPtables * tab)
+{
+    int size = 4 * tab->INPsize + 1;
+    struct INPtab **symtab = TMALLOC(struct INPtab *, size);
+    struct INPtab *t, *lt;
+    int i;
+
+    ZERO(symtab, size * sizeof(struct INPtab *));
+    for (i = 0; i < tab->INPsize; i++)
+        for (t = tab->INPsymtab[i]; t; t = lt) {
+            int key = hash(t->t_ent, size);
+            lt = t->t_next;
+            t->t_next = symtab[key];
+            symtab[key] = t;
+        }
+    FREE(tab->INPsymtab);
+    tab->INPsymtab = symtab;
+    tab->INPsize = size;
+}
+
+static void INPgrowTermtab(INPtables * tab)
+{
+    int size = 4 * tab->INPtermsize + 1;
+    struct INPnTab **termtab = TMALLOC(struct INPnTab *, size);
+    struct INPnTab *n, *ln;
+    int i;
+
+    ZERO(termtab, size * sizeof(struct INPnTab *));
+    for (i = 0; i < tab->INPtermsize; i++)
+        for (n = tab->INPtermsymtab[i]; n; n = ln) {
+            int key = hash(n->t_ent, size);
+            ln = n->t_next;
+            n->t_next = termtab[key];
+            termtab[key] = n;
+        }
+    FREE(tab->INPtermsymtab);
+    tab->INPtermsymtab = termtab;
+    tab->INPtermsize = size;
+}
+
 /* Free the space used by the symbol tables. */
 
 void INPtabEnd(INPtables * tab)
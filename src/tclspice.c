@@ -954,6 +954,7 @@ plot_get_value TCL_CMDPROCARGS(clientData, interp, argc, argv)
     }
     for (v = pl->pl_dvecs; v; v = v->v_next)
         if (!strcmp(v->v_name, name)) {
+            raw_loadvec(v);
             if (index < v->v_length) {
                 Tcl_SetObjResult(interp, Tcl_NewDoubleObj((double) v->v_realdata[index]));
                 return TCL_OK;
@@ -1186,6 +1187,8 @@ plot_getvector TCL_CMDPROCARGS(clientData, interp, argc, argv)
         return TCL_ERROR;
     }
 
+    raw_loadvec(v);
+
     if (Blt_GetVector(interp, blt, &vec)) {
         Tcl_SetResult(interp, "Bad blt vector ", TCL_STATIC);
         Tcl_AppendResult(interp, (char *)blt, TCL_STATIC);
@@ -943,6 +943,8 @@ static void  write_SPICEdev(
     fprintf(fp, "NULL,          \n");  /* DEVdisto */
     fprintf(fp, "NULL,          \n");  /* DEVnoise */
     fprintf(fp, "NULL,          \n");  /* DEVsoaCheck */
+    fprintf(fp, "NULL,          \n");  /* DEVsnapSave */
+    fprintf(fp, "NULL,          \n");  /* DEVsnapLoad */
     fprintf(fp, "#ifdef CIDER   \n");  /* CIDER enhancements */
     fprintf(fp, "NULL,          \n");  /* DEVdump */
     fprintf(fp, "NULL,          \n");  /* DEVacct */